@@ -1388,6 +1388,19 @@ struct RTC_EXPORT PeerConnectionDependencies final {
   // Optional field trials to use.
   // Overrides those from PeerConnectionFactoryDependencies.
   std::unique_ptr<FieldTrialsView> trials;
+  // Optional network thread to use for this PeerConnection instead of the
+  // network thread of the PeerConnectionFactory. All transports of the
+  // PeerConnection (ICE, DTLS, SRTP and SCTP) and their sockets live on this
+  // thread. Spreading PeerConnections over several such threads, each with its
+  // own socket server, shards network I/O over several cores while every
+  // transport keeps a single thread and thus packet order.
+  // The thread must outlive the PeerConnection. Since the default port
+  // allocator is bound to the factory's network thread, `allocator` must be
+  // set, with a PacketSocketFactory and NetworkManager that run on this
+  // thread. An SCTP transport factory injected into the
+  // PeerConnectionFactoryDependencies is used as is and must support creating
+  // transports on this thread.
+  rtc::Thread* network_thread = nullptr;
 };
 
 // PeerConnectionFactoryDependencies holds all of the PeerConnectionFactory
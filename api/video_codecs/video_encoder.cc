@@ -101,7 +101,8 @@ VideoEncoder::EncoderInfo::EncoderInfo()
           1,
           kMaxFramerateFraction)},
       supports_simulcast(false),
-      preferred_pixel_formats{VideoFrameBuffer::Type::kI420} {}
+      preferred_pixel_formats{VideoFrameBuffer::Type::kI420},
+      num_input_conversions(0) {}
 
 VideoEncoder::EncoderInfo::EncoderInfo(const EncoderInfo&) = default;
 
@@ -186,6 +187,7 @@ std::string VideoEncoder::EncoderInfo::ToString() const {
   if (is_qp_trusted.has_value()) {
     oss << ", is_qp_trusted = " << is_qp_trusted.value();
   }
+  oss << ", num_input_conversions = " << num_input_conversions;
   oss << "}";
   return oss.str();
 }
@@ -259,6 +259,10 @@ class RTC_EXPORT VideoEncoder {
     // Indicates whether or not QP value encoder writes into frame/slice/tile
     // header can be interpreted as average frame/slice/tile QP.
     absl::optional<bool> is_qp_trusted;
+
+    // Number of input frames that the encoder has converted to another pixel
+    // format before encoding them, because it couldn't read them in place.
+    int64_t num_input_conversions;
   };
 
   struct RTC_EXPORT RateControlParameters {
@@ -989,7 +989,8 @@ webrtc::VideoReceiveStreamInterface* Call::CreateVideoReceiveStream(
       env_, this, num_cpu_cores_, transport_send_->packet_router(),
       std::move(configuration), call_stats_.get(),
       std::make_unique<VCMTiming>(&env_.clock(), trials()),
-      &nack_periodic_processor_, decode_sync_.get());
+      &nack_periodic_processor_, decode_sync_.get(),
+      config_.decode_thread_pool);
   // TODO(bugs.webrtc.org/11993): Set this up asynchronously on the network
   // thread.
   receive_stream->RegisterWithTransport(&video_receiver_controller_);
@@ -29,6 +29,7 @@ RtpTransportConfig CallConfig::ExtractTransportConfig() const {
   transport_config.network_state_predictor_factory =
       network_state_predictor_factory;
   transport_config.pacer_burst_interval = pacer_burst_interval;
+  transport_config.shared_pacing_scheduler = shared_pacing_scheduler;
 
   return transport_config;
 }
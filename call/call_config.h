@@ -24,6 +24,8 @@
 namespace webrtc {
 
 class AudioProcessing;
+class DecodeThreadPool;
+class SharedPacingScheduler;
 
 struct CallConfig {
   // If `network_task_queue` is set to nullptr, Call will assume that network
@@ -74,6 +76,14 @@ struct CallConfig {
   // The burst interval of the pacer, see TaskQueuePacedSender constructor.
   absl::optional<TimeDelta> pacer_burst_interval;
 
+  // Scheduler shared by the pacers of calls on the same task queue, see
+  // RtpTransportConfig.
+  SharedPacingScheduler* shared_pacing_scheduler = nullptr;
+
+  // Thread pool that runs the decode queues of the video receive streams, see
+  // DecodeThreadPool. If null, each stream decodes on its own task queue.
+  DecodeThreadPool* decode_thread_pool = nullptr;
+
   // Enables send packet batching from the egress RTP sender.
   bool enable_send_packet_batching = false;
 };
@@ -10,6 +10,9 @@
 
 #include "call/rtp_demuxer.h"
 
+#include <algorithm>
+#include <utility>
+
 #include "absl/strings/string_view.h"
 #include "call/rtp_packet_sink_interface.h"
 #include "modules/rtp_rtcp/source/rtp_header_extensions.h"
@@ -53,8 +56,109 @@ std::string CheckMidLength(absl::string_view mid) {
   return new_mid;
 }
 
+// Must be a power of two.
+constexpr size_t kMinSsrcSinkTableSize = 16;
+constexpr int kMinSsrcSinkTableSizeLog2 = 4;
+static_assert(size_t{1} << kMinSsrcSinkTableSizeLog2 == kMinSsrcSinkTableSize);
+
 }  // namespace
 
+RtpDemuxer::SsrcSinkTable::SsrcSinkTable() = default;
+RtpDemuxer::SsrcSinkTable::~SsrcSinkTable() = default;
+
+size_t RtpDemuxer::SsrcSinkTable::HomeIndex(uint32_t ssrc) const {
+  // Fibonacci hashing spreads sequential SSRCs over the table.
+  return (uint64_t{ssrc} * 0x9E3779B97F4A7C15u) >> shift_;
+}
+
+RtpPacketSinkInterface* RtpDemuxer::SsrcSinkTable::Find(uint32_t ssrc) const {
+  if (size_ == 0) {
+    return nullptr;
+  }
+  const size_t mask = slots_.size() - 1;
+  for (size_t i = HomeIndex(ssrc);; i = (i + 1) & mask) {
+    const Slot& slot = slots_[i];
+    if (slot.sink == nullptr) {
+      return nullptr;
+    }
+    if (slot.ssrc == ssrc) {
+      return slot.sink;
+    }
+  }
+}
+
+void RtpDemuxer::SsrcSinkTable::Insert(uint32_t ssrc,
+                                       RtpPacketSinkInterface* sink) {
+  RTC_DCHECK(sink);
+  // Keep the load factor at or below 1/2, so that probe sequences stay short.
+  if (2 * (size_ + 1) > slots_.size()) {
+    Grow();
+  }
+  const size_t mask = slots_.size() - 1;
+  for (size_t i = HomeIndex(ssrc);; i = (i + 1) & mask) {
+    Slot& slot = slots_[i];
+    if (slot.sink == nullptr) {
+      slot = {.ssrc = ssrc, .sink = sink};
+      ++size_;
+      return;
+    }
+    if (slot.ssrc == ssrc) {
+      slot.sink = sink;
+      return;
+    }
+  }
+}
+
+void RtpDemuxer::SsrcSinkTable::Erase(uint32_t ssrc) {
+  if (size_ == 0) {
+    return;
+  }
+  const size_t mask = slots_.size() - 1;
+  size_t hole = HomeIndex(ssrc);
+  while (slots_[hole].ssrc != ssrc) {
+    if (slots_[hole].sink == nullptr) {
+      return;
+    }
+    hole = (hole + 1) & mask;
+  }
+  if (slots_[hole].sink == nullptr) {
+    return;
+  }
+  // Shift later entries of the probe sequence back into the hole, so that
+  // lookups need no tombstones.
+  for (size_t i = (hole + 1) & mask; slots_[i].sink != nullptr;
+       i = (i + 1) & mask) {
+    const size_t home = HomeIndex(slots_[i].ssrc);
+    // Move the entry unless its home lies cyclically in (hole, i].
+    if (((i - home) & mask) >= ((i - hole) & mask)) {
+      slots_[hole] = slots_[i];
+      hole = i;
+    }
+  }
+  slots_[hole] = Slot();
+  --size_;
+}
+
+void RtpDemuxer::SsrcSinkTable::Clear() {
+  slots_.clear();
+  shift_ = 64;
+  size_ = 0;
+}
+
+void RtpDemuxer::SsrcSinkTable::Grow() {
+  std::vector<Slot> old_slots = std::exchange(
+      slots_, std::vector<Slot>(
+                  std::max(kMinSsrcSinkTableSize, 2 * slots_.size())));
+  // The hash keeps the log2(slots_.size()) most significant bits.
+  shift_ = old_slots.empty() ? 64 - kMinSsrcSinkTableSizeLog2 : shift_ - 1;
+  size_ = 0;
+  for (const Slot& slot : old_slots) {
+    if (slot.sink != nullptr) {
+      Insert(slot.ssrc, slot.sink);
+    }
+  }
+}
+
 RtpDemuxerCriteria::RtpDemuxerCriteria(
     absl::string_view mid,
     absl::string_view rsid /*= absl::string_view()*/)
@@ -152,6 +256,7 @@ bool RtpDemuxer::AddSink(const RtpDemuxerCriteria& criteria,
 
   for (uint32_t ssrc : criteria.ssrcs()) {
     sink_by_ssrc_.emplace(ssrc, sink);
+    MaybeAddFastSsrcSinkBinding(ssrc, sink);
   }
 
   for (uint8_t payload_type : criteria.payload_types()) {
@@ -233,6 +338,20 @@ void RtpDemuxer::RefreshKnownMids() {
   }
 }
 
+void RtpDemuxer::RefreshFastSinkBySsrc() {
+  fast_sink_by_ssrc_.Clear();
+  for (const auto& [ssrc, sink] : sink_by_ssrc_) {
+    MaybeAddFastSsrcSinkBinding(ssrc, sink);
+  }
+}
+
+void RtpDemuxer::MaybeAddFastSsrcSinkBinding(uint32_t ssrc,
+                                             RtpPacketSinkInterface* sink) {
+  if (!mid_by_ssrc_.contains(ssrc) && !rsid_by_ssrc_.contains(ssrc)) {
+    fast_sink_by_ssrc_.Insert(ssrc, sink);
+  }
+}
+
 bool RtpDemuxer::AddSink(uint32_t ssrc, RtpPacketSinkInterface* sink) {
   RtpDemuxerCriteria criteria;
   criteria.ssrcs().insert(ssrc);
@@ -252,6 +371,7 @@ bool RtpDemuxer::RemoveSink(const RtpPacketSinkInterface* sink) {
                        RemoveFromMapByValue(&sink_by_mid_and_rsid_, sink) +
                        RemoveFromMapByValue(&sink_by_rsid_, sink);
   RefreshKnownMids();
+  RefreshFastSinkBySsrc();
   return num_removed > 0;
 }
 
@@ -282,6 +402,17 @@ RtpPacketSinkInterface* RtpDemuxer::ResolveSink(
   // See the BUNDLE spec for high level reference to this algorithm:
   // https://tools.ietf.org/html/draft-ietf-mmusic-sdp-bundle-negotiation-38#section-10.2
 
+  uint32_t ssrc = packet.Ssrc();
+  if ((use_mid_ && packet.HasExtension<RtpMid>()) ||
+      packet.HasExtension<RepairedRtpStreamId>() ||
+      packet.HasExtension<RtpStreamId>()) {
+    // The SSRC is about to be latched to the MID or RSID.
+    fast_sink_by_ssrc_.Erase(ssrc);
+  } else if (RtpPacketSinkInterface* sink = fast_sink_by_ssrc_.Find(ssrc)) {
+    // The full algorithm would find no MID or RSID and demux by SSRC.
+    return sink;
+  }
+
   // RSID and RRID are routed to the same sinks. If an RSID is specified on a
   // repair packet, it should be ignored and the RRID should be used.
   std::string packet_mid, packet_rsid;
@@ -290,7 +421,6 @@ RtpPacketSinkInterface* RtpDemuxer::ResolveSink(
   if (!has_rsid) {
     has_rsid = packet.GetExtension<RtpStreamId>(&packet_rsid);
   }
-  uint32_t ssrc = packet.Ssrc();
 
   // The BUNDLE spec says to drop any packets with unknown MIDs, even if the
   // SSRC is known/latched.
@@ -436,6 +566,7 @@ void RtpDemuxer::AddSsrcSinkBinding(uint32_t ssrc,
     return;
   }
 
+  MaybeAddFastSsrcSinkBinding(ssrc, sink);
   auto result = sink_by_ssrc_.emplace(ssrc, sink);
   auto it = result.first;
   bool inserted = result.second;
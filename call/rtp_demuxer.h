@@ -159,6 +159,33 @@ class RtpDemuxer {
   bool OnRtpPacket(const RtpPacketReceived& packet);
 
  private:
+  // Open addressing hash table from SSRC to sink.
+  class SsrcSinkTable {
+   public:
+    SsrcSinkTable();
+    ~SsrcSinkTable();
+
+    // Returns null if `ssrc` is not in the table.
+    RtpPacketSinkInterface* Find(uint32_t ssrc) const;
+    void Insert(uint32_t ssrc, RtpPacketSinkInterface* sink);
+    void Erase(uint32_t ssrc);
+    void Clear();
+
+   private:
+    // Slots without a sink are empty.
+    struct Slot {
+      uint32_t ssrc = 0;
+      RtpPacketSinkInterface* sink = nullptr;
+    };
+
+    size_t HomeIndex(uint32_t ssrc) const;
+    void Grow();
+
+    std::vector<Slot> slots_;
+    int shift_ = 64;
+    size_t size_ = 0;
+  };
+
   // Returns true if adding a sink with the given criteria would cause conflicts
   // with the existing criteria and should be rejected.
   bool CriteriaWouldConflict(const RtpDemuxerCriteria& criteria) const;
@@ -167,6 +194,8 @@ class RtpDemuxer {
   // should receive the packet.
   // Will record any SSRC<->ID associations along the way.
   // If the packet should be dropped, this method returns null.
+  // Packets without MID and RSID header extensions are demuxed through
+  // `fast_sink_by_ssrc_` when possible.
   RtpPacketSinkInterface* ResolveSink(const RtpPacketReceived& packet);
 
   // Used by the ResolveSink algorithm.
@@ -184,6 +213,14 @@ class RtpDemuxer {
   // sink_by_mid_and_rsid_ maps.
   void RefreshKnownMids();
 
+  // Regenerate `fast_sink_by_ssrc_` from the SSRC bindings of SSRCs without a
+  // latched MID or RSID.
+  void RefreshFastSinkBySsrc();
+
+  // Adds the binding of `ssrc` to `fast_sink_by_ssrc_` if no MID or RSID has
+  // been latched for it.
+  void MaybeAddFastSsrcSinkBinding(uint32_t ssrc, RtpPacketSinkInterface* sink);
+
   // Map each sink by its component attributes to facilitate quick lookups.
   // Payload Type mapping is a multimap because if two sinks register for the
   // same payload type, both AddSinks succeed but we must know not to demux on
@@ -210,6 +247,12 @@ class RtpDemuxer {
   flat_map<uint32_t, std::string> mid_by_ssrc_;
   flat_map<uint32_t, std::string> rsid_by_ssrc_;
 
+  // Sinks of packets without MID and RSID header extensions, by SSRC.
+  // Holds the entries of `sink_by_ssrc_` for SSRCs that are in neither
+  // `mid_by_ssrc_` nor `rsid_by_ssrc_`, which saves the string parsing and
+  // lookups of the full algorithm for the bulk of packets.
+  SsrcSinkTable fast_sink_by_ssrc_;
+
   // Adds a binding from the SSRC to the given sink.
   void AddSsrcSinkBinding(uint32_t ssrc, RtpPacketSinkInterface* sink);
 
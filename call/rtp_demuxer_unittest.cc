@@ -13,6 +13,7 @@
 #include <memory>
 #include <set>
 #include <string>
+#include <vector>
 
 #include "absl/strings/string_view.h"
 #include "call/test/mock_rtp_packet_sink_interface.h"
@@ -1090,6 +1091,73 @@ TEST_F(RtpDemuxerTest, SignaledMidShouldOverwriteSignalledSsrcPersistent) {
   EXPECT_TRUE(demuxer_.OnRtpPacket(*packet_without_mid));
 }
 
+// Packets of an SSRC without MID are routed to the MID sink once a packet of
+// the SSRC has been received with the MID, even if earlier packets of the SSRC
+// without MID were routed to a sink bound to the SSRC.
+TEST_F(RtpDemuxerTest, SsrcRoutedByMidAfterRoutedBySsrc) {
+  constexpr uint32_t ssrc = 11;
+  const std::string mid = "mid";
+
+  MockRtpPacketSink ssrc_sink;
+  AddSinkOnlySsrc(ssrc, &ssrc_sink);
+
+  auto packet = CreatePacketWithSsrc(ssrc);
+  EXPECT_CALL(ssrc_sink, OnRtpPacket(SamePacketAs(*packet))).Times(1);
+  EXPECT_TRUE(demuxer_.OnRtpPacket(*packet));
+
+  NiceMock<MockRtpPacketSink> mid_sink;
+  AddSinkOnlyMid(mid, &mid_sink);
+  auto packet_with_mid = CreatePacketWithSsrcMid(ssrc, mid);
+  demuxer_.OnRtpPacket(*packet_with_mid);
+
+  auto packet_without_mid = CreatePacketWithSsrc(ssrc);
+  EXPECT_CALL(ssrc_sink, OnRtpPacket(SamePacketAs(*packet_without_mid)))
+      .Times(0);
+  EXPECT_CALL(mid_sink, OnRtpPacket(SamePacketAs(*packet_without_mid)))
+      .Times(1);
+  EXPECT_TRUE(demuxer_.OnRtpPacket(*packet_without_mid));
+}
+
+TEST_F(RtpDemuxerTest, ManySsrcsRoutedBySsrcAfterSomeLatchedToRsid) {
+  constexpr uint32_t kNumSsrcs = 300;
+  const std::string rsid = "1";
+
+  std::vector<NiceMock<MockRtpPacketSink>> sinks(kNumSsrcs);
+  for (uint32_t i = 0; i < kNumSsrcs; ++i) {
+    ASSERT_TRUE(AddSinkOnlySsrc(1000 + i, &sinks[i]));
+  }
+  for (uint32_t i = 0; i < kNumSsrcs; i += 2) {
+    auto packet = CreatePacketWithSsrcRsid(1000 + i, rsid);
+    EXPECT_CALL(sinks[i], OnRtpPacket(SamePacketAs(*packet))).Times(1);
+    EXPECT_TRUE(demuxer_.OnRtpPacket(*packet));
+  }
+
+  MockRtpPacketSink rsid_sink;
+  AddSinkOnlyRsid(rsid, &rsid_sink);
+  for (uint32_t i = 0; i < kNumSsrcs; ++i) {
+    auto packet = CreatePacketWithSsrc(1000 + i);
+    if (i % 2 == 0) {
+      EXPECT_CALL(rsid_sink, OnRtpPacket(SamePacketAs(*packet))).Times(1);
+    } else {
+      EXPECT_CALL(sinks[i], OnRtpPacket(SamePacketAs(*packet))).Times(1);
+    }
+    EXPECT_TRUE(demuxer_.OnRtpPacket(*packet));
+  }
+}
+
+TEST_F(RtpDemuxerTest, NoRepeatedRoutingBySsrcAfterSinkRemoved) {
+  constexpr uint32_t ssrc = 10;
+
+  MockRtpPacketSink sink;
+  AddSinkOnlySsrc(ssrc, &sink);
+  auto packet = CreatePacketWithSsrc(ssrc);
+  EXPECT_CALL(sink, OnRtpPacket(SamePacketAs(*packet))).Times(1);
+  EXPECT_TRUE(demuxer_.OnRtpPacket(*packet));
+
+  ASSERT_TRUE(RemoveSink(&sink));
+  EXPECT_FALSE(demuxer_.OnRtpPacket(*CreatePacketWithSsrc(ssrc)));
+}
+
 TEST_F(RtpDemuxerTest, RouteByPayloadTypeMultipleMatch) {
   constexpr uint32_t ssrc = 10;
   constexpr uint8_t pt1 = 30;
@@ -22,6 +22,8 @@
 
 namespace webrtc {
 
+class SharedPacingScheduler;
+
 struct RtpTransportConfig {
   Environment env;
 
@@ -38,6 +40,11 @@ struct RtpTransportConfig {
 
   // The burst interval of the pacer, see TaskQueuePacedSender constructor.
   absl::optional<TimeDelta> pacer_burst_interval;
+
+  // Scheduler to wake the pacer together with those of other transports on
+  // the same task queue, see TaskQueuePacedSender constructor. Must outlive
+  // the transport controller.
+  SharedPacingScheduler* shared_pacing_scheduler = nullptr;
 };
 }  // namespace webrtc
 
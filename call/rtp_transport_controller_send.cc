@@ -80,7 +80,8 @@ RtpTransportControllerSend::RtpTransportControllerSend(
              &packet_router_,
              env_.field_trials(),
              TimeDelta::Millis(5),
-             3),
+             3,
+             config.shared_pacing_scheduler),
       observer_(nullptr),
       controller_factory_override_(config.network_controller_factory),
       controller_factory_fallback_(
@@ -418,6 +419,15 @@ absl::optional<Timestamp> RtpTransportControllerSend::GetFirstPacketTime()
     const {
   return pacer_.FirstSentPacketTime();
 }
+void RtpTransportControllerSend::SetPacerProfilingEnabled(bool enabled) {
+  RTC_DCHECK_RUN_ON(&sequence_checker_);
+  pacer_.SetProfilingEnabled(enabled);
+}
+absl::optional<PacingProfiler::Profile>
+RtpTransportControllerSend::GetPacerProfile() const {
+  RTC_DCHECK_RUN_ON(&sequence_checker_);
+  return pacer_.GetProfile();
+}
 void RtpTransportControllerSend::EnablePeriodicAlrProbing(bool enable) {
   RTC_DCHECK_RUN_ON(&sequence_checker_);
 
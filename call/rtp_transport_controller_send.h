@@ -95,6 +95,8 @@ class RtpTransportControllerSend final
   int64_t GetPacerQueuingDelayMs() const override;
   absl::optional<Timestamp> GetFirstPacketTime() const override;
   void EnablePeriodicAlrProbing(bool enable) override;
+  void SetPacerProfilingEnabled(bool enabled) override;
+  absl::optional<PacingProfiler::Profile> GetPacerProfile() const override;
   void OnSentPacket(const rtc::SentPacket& sent_packet) override;
   void OnReceivedPacket(const ReceivedPacket& packet_msg) override;
 
@@ -29,6 +29,7 @@
 #include "api/units/timestamp.h"
 #include "call/rtp_config.h"
 #include "common_video/frame_counts.h"
+#include "modules/pacing/pacing_profiler.h"
 #include "modules/rtp_rtcp/include/report_block_data.h"
 #include "modules/rtp_rtcp/include/rtcp_statistics.h"
 #include "modules/rtp_rtcp/include/rtp_packet_sender.h"
@@ -141,6 +142,13 @@ class RtpTransportControllerSendInterface {
   virtual absl::optional<Timestamp> GetFirstPacketTime() const = 0;
   virtual void EnablePeriodicAlrProbing(bool enable) = 0;
 
+  // Enables or disables measuring where the pacer spends its time, see
+  // `PacingProfiler`. Disabled by default.
+  virtual void SetPacerProfilingEnabled(bool enabled) = 0;
+  // Returns the profile collected since pacer profiling was enabled, or nullopt
+  // if it isn't.
+  virtual absl::optional<PacingProfiler::Profile> GetPacerProfile() const = 0;
+
   // Called when a packet has been sent.
   // The call should arrive on the network thread, but may not in all cases
   // (some tests don't adhere to this). Implementations today should not block
@@ -91,6 +91,11 @@ class MockRtpTransportControllerSend
               (),
               (const, override));
   MOCK_METHOD(void, EnablePeriodicAlrProbing, (bool), (override));
+  MOCK_METHOD(void, SetPacerProfilingEnabled, (bool), (override));
+  MOCK_METHOD(absl::optional<PacingProfiler::Profile>,
+              GetPacerProfile,
+              (),
+              (const, override));
   MOCK_METHOD(void, OnSentPacket, (const rtc::SentPacket&), (override));
   MOCK_METHOD(void,
               SetSdpBitrateParameters,
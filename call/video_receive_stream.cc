@@ -88,6 +88,9 @@ std::string VideoReceiveStreamInterface::Stats::ToString(
   ss << "totalDecodeTime: " << total_decode_time.seconds<double>() << ", ";
   ss << "totalProcessingDelay: " << total_processing_delay.seconds<double>()
      << ", ";
+  ss << "totalDecodeQueueDelay: " << total_decode_queue_delay.seconds<double>()
+     << ", ";
+  ss << "framesQueuedForDecode: " << frames_queued_for_decode << ", ";
   ss << "min_playout_delay_ms: " << min_playout_delay_ms << ", ";
   ss << "sync_offset_ms: " << sync_offset_ms << ", ";
   ss << "cum_loss: " << rtp_stats.packets_lost << ", ";
@@ -115,6 +115,11 @@ class VideoReceiveStreamInterface : public MediaReceiveStreamInterface {
     TimeDelta total_decode_time = TimeDelta::Zero();
     // https://w3c.github.io/webrtc-stats/#dom-rtcinboundrtpstreamstats-totalprocessingdelay
     TimeDelta total_processing_delay = TimeDelta::Zero();
+    // Total time that frames waited on the decode queue before decoding
+    // started, e.g. for a thread of a shared DecodeThreadPool, and the number
+    // of frames it was measured for.
+    TimeDelta total_decode_queue_delay = TimeDelta::Zero();
+    uint32_t frames_queued_for_decode = 0;
 
     // https://w3c.github.io/webrtc-stats/#dom-rtcinboundrtpstreamstats-totalassemblytime
     TimeDelta total_assembly_time = TimeDelta::Zero();
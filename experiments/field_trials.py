@@ -128,6 +128,15 @@ ACTIVE_FIELD_TRIALS: FrozenSet[FieldTrial] = frozenset([
     FieldTrial('WebRTC-TaskQueue-ReplaceLibeventWithStdlib',
                42224654,
                date(2024, 4, 1)),
+    FieldTrial('WebRTC-UdpBatchReceive',
+               372012750,
+               date(2027, 4, 1)),
+    FieldTrial('WebRTC-UdpBatchSend',
+               372012751,
+               date(2027, 4, 1)),
+    FieldTrial('WebRTC-UdpZeroCopyReceive',
+               372012752,
+               date(2027, 4, 1)),
     FieldTrial('WebRTC-UseNtpTimeAbsoluteSendTime',
                42226305,
                date(2024, 9, 1)),
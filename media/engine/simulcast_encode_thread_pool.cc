@@ -0,0 +1,84 @@
+/*
+ *  Copyright (c) 2024 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "media/engine/simulcast_encode_thread_pool.h"
+
+#include <utility>
+
+#include "rtc_base/checks.h"
+#include "rtc_base/strings/string_builder.h"
+
+namespace webrtc {
+
+SimulcastEncodeThreadPool::SimulcastEncodeThreadPool(int num_threads) {
+  RTC_DCHECK_GT(num_threads, 0);
+  threads_.reserve(num_threads);
+  for (int i = 0; i < num_threads; ++i) {
+    rtc::StringBuilder name;
+    name << "SimulcastEncode" << i;
+    threads_.push_back(rtc::PlatformThread::SpawnJoinable(
+        [this] { RunWorker(); }, name.str()));
+  }
+}
+
+SimulcastEncodeThreadPool::~SimulcastEncodeThreadPool() {
+  std::deque<absl::AnyInvocable<void() &&>> dropped_tasks;
+  {
+    MutexLock lock(&mutex_);
+    stopping_ = true;
+    dropped_tasks.swap(tasks_);
+  }
+  work_available_.Set();
+  // Joins the threads.
+  threads_.clear();
+}
+
+void SimulcastEncodeThreadPool::PostTask(absl::AnyInvocable<void() &&> task) {
+  {
+    MutexLock lock(&mutex_);
+    if (stopping_) {
+      return;
+    }
+    tasks_.push_back(std::move(task));
+  }
+  work_available_.Set();
+}
+
+void SimulcastEncodeThreadPool::RunWorker() {
+  while (true) {
+    absl::AnyInvocable<void() &&> task;
+    bool more_tasks = false;
+    {
+      MutexLock lock(&mutex_);
+      if (stopping_) {
+        break;
+      }
+      if (!tasks_.empty()) {
+        task = std::move(tasks_.front());
+        tasks_.pop_front();
+        more_tasks = !tasks_.empty();
+      }
+    }
+    if (!task) {
+      work_available_.Wait(rtc::Event::kForever);
+      continue;
+    }
+    // Wake another worker for the remaining tasks, since `work_available_`
+    // wakes a single waiter per signal.
+    if (more_tasks) {
+      work_available_.Set();
+    }
+    std::move(task)();
+  }
+  // Let the next worker see that the pool is stopping.
+  work_available_.Set();
+}
+
+}  // namespace webrtc
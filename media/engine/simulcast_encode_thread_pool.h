@@ -0,0 +1,62 @@
+/*
+ *  Copyright (c) 2024 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef MEDIA_ENGINE_SIMULCAST_ENCODE_THREAD_POOL_H_
+#define MEDIA_ENGINE_SIMULCAST_ENCODE_THREAD_POOL_H_
+
+#include <deque>
+#include <vector>
+
+#include "absl/functional/any_invocable.h"
+#include "rtc_base/event.h"
+#include "rtc_base/platform_thread.h"
+#include "rtc_base/synchronization/mutex.h"
+#include "rtc_base/system/rtc_export.h"
+#include "rtc_base/thread_annotations.h"
+
+namespace webrtc {
+
+// A fixed number of threads on which `SimulcastEncoderAdapter`s encode the
+// streams of a frame in parallel, see
+// `SimulcastEncoderAdapter::Config::stream_encode_pool`. One pool is meant to
+// be owned by the encoder factory, or whoever else creates the adapters, and
+// shared by all of them, so that the number of encode threads doesn't grow
+// with the number of adapters.
+//
+// Tasks run in the order they were posted, on any of the threads. Tasks that
+// haven't run when the pool is destroyed are dropped. The pool must outlive
+// the adapters using it.
+class RTC_EXPORT SimulcastEncodeThreadPool {
+ public:
+  explicit SimulcastEncodeThreadPool(int num_threads);
+  ~SimulcastEncodeThreadPool();
+
+  SimulcastEncodeThreadPool(const SimulcastEncodeThreadPool&) = delete;
+  SimulcastEncodeThreadPool& operator=(const SimulcastEncodeThreadPool&) =
+      delete;
+
+  void PostTask(absl::AnyInvocable<void() &&> task);
+
+  int num_threads() const { return static_cast<int>(threads_.size()); }
+
+ private:
+  void RunWorker();
+
+  Mutex mutex_;
+  // Signaled when a task is posted, or when the pool is stopping.
+  rtc::Event work_available_;
+  bool stopping_ RTC_GUARDED_BY(mutex_) = false;
+  std::deque<absl::AnyInvocable<void() &&>> tasks_ RTC_GUARDED_BY(mutex_);
+  std::vector<rtc::PlatformThread> threads_;
+};
+
+}  // namespace webrtc
+
+#endif  // MEDIA_ENGINE_SIMULCAST_ENCODE_THREAD_POOL_H_
@@ -21,8 +21,11 @@
 #include "absl/algorithm/container.h"
 #include "absl/types/optional.h"
 #include "api/field_trials_view.h"
+#include "api/make_ref_counted.h"
+#include "api/ref_counted_base.h"
 #include "api/scoped_refptr.h"
 #include "api/video/i420_buffer.h"
+#include "api/video/nv12_buffer.h"
 #include "api/video/video_codec_constants.h"
 #include "api/video/video_frame_buffer.h"
 #include "api/video/video_rotation.h"
@@ -36,8 +39,11 @@
 #include "modules/video_coding/include/video_error_codes_utils.h"
 #include "modules/video_coding/utility/simulcast_rate_allocator.h"
 #include "rtc_base/checks.h"
+#include "rtc_base/event.h"
 #include "rtc_base/experiments/rate_control_settings.h"
 #include "rtc_base/logging.h"
+#include "rtc_base/synchronization/mutex.h"
+#include "rtc_base/thread_annotations.h"
 
 namespace webrtc {
 namespace {
@@ -45,6 +51,10 @@ namespace {
 // Max qp for lowest spatial resolution when doing simulcast.
 const unsigned int kLowestResMaxQp = 45;
 
+// Scaled buffers that may be held by a stream's encoder at the same time
+// before the stream stops pooling them.
+constexpr size_t kMaxPooledBuffersPerStream = 4;
+
 uint32_t SumStreamMaxBitrate(int streams, const VideoCodec& codec) {
   uint32_t bitrate_sum = 0;
   for (int i = 0; i < streams; ++i) {
@@ -168,7 +178,10 @@ SimulcastEncoderAdapter::StreamContext::StreamContext(
       width_(width),
       height_(height),
       is_keyframe_needed_(false),
-      is_paused_(is_paused) {
+      is_paused_(is_paused),
+      buffer_pool_(std::make_unique<VideoFrameBufferPool>(
+          /*zero_initialize=*/false,
+          kMaxPooledBuffersPerStream)) {
   if (parent_) {
     encoder_context_->encoder().RegisterEncodeCompleteCallback(this);
   }
@@ -182,7 +195,8 @@ SimulcastEncoderAdapter::StreamContext::StreamContext(StreamContext&& rhs)
       width_(rhs.width_),
       height_(rhs.height_),
       is_keyframe_needed_(rhs.is_keyframe_needed_),
-      is_paused_(rhs.is_paused_) {
+      is_paused_(rhs.is_paused_),
+      buffer_pool_(std::move(rhs.buffer_pool_)) {
   if (parent_) {
     encoder_context_->encoder().RegisterEncodeCompleteCallback(this);
   }
@@ -215,15 +229,62 @@ bool SimulcastEncoderAdapter::StreamContext::ShouldDropFrame(
   return framerate_controller_->ShouldDropFrame(timestamp.us() * 1000);
 }
 
+rtc::scoped_refptr<VideoFrameBuffer>
+SimulcastEncoderAdapter::StreamContext::ScaleToStream(
+    VideoFrameBuffer& source) {
+  switch (source.type()) {
+    case VideoFrameBuffer::Type::kI420: {
+      rtc::scoped_refptr<I420Buffer> buffer =
+          buffer_pool_->CreateI420Buffer(width_, height_);
+      if (buffer) {
+        buffer->ScaleFrom(*source.GetI420());
+        return buffer;
+      }
+      break;
+    }
+    case VideoFrameBuffer::Type::kNV12: {
+      rtc::scoped_refptr<NV12Buffer> buffer =
+          buffer_pool_->CreateNV12Buffer(width_, height_);
+      if (buffer) {
+        buffer->CropAndScaleFrom(*source.GetNV12(), 0, 0, source.width(),
+                                 source.height());
+        return buffer;
+      }
+      break;
+    }
+    default:
+      break;
+  }
+  return source.Scale(width_, height_);
+}
+
 EncodedImageCallback::Result
 SimulcastEncoderAdapter::StreamContext::OnEncodedImage(
     const EncodedImage& encoded_image,
     const CodecSpecificInfo* codec_specific_info) {
   RTC_CHECK(parent_);  // If null, this method should never be called.
+  if (is_buffering_) {
+    buffered_images_.emplace_back(encoded_image, *codec_specific_info);
+    return Result(Result::OK, encoded_image.RtpTimestamp());
+  }
   return parent_->OnEncodedImage(stream_idx_, encoded_image,
                                  codec_specific_info);
 }
 
+void SimulcastEncoderAdapter::StreamContext::StartBuffering() {
+  RTC_DCHECK(parent_);
+  RTC_DCHECK(buffered_images_.empty());
+  is_buffering_ = true;
+}
+
+void SimulcastEncoderAdapter::StreamContext::DeliverBufferedImages() {
+  is_buffering_ = false;
+  for (const auto& [encoded_image, codec_specific_info] : buffered_images_) {
+    parent_->OnEncodedImage(stream_idx_, encoded_image, &codec_specific_info);
+  }
+  buffered_images_.clear();
+}
+
 void SimulcastEncoderAdapter::StreamContext::OnDroppedFrame(
     DropReason /*reason*/) {
   RTC_CHECK(parent_);  // If null, this method should never be called.
@@ -235,6 +296,18 @@ SimulcastEncoderAdapter::SimulcastEncoderAdapter(
     absl::Nonnull<VideoEncoderFactory*> primary_factory,
     absl::Nullable<VideoEncoderFactory*> fallback_factory,
     const SdpVideoFormat& format)
+    : SimulcastEncoderAdapter(env,
+                              primary_factory,
+                              fallback_factory,
+                              format,
+                              Config()) {}
+
+SimulcastEncoderAdapter::SimulcastEncoderAdapter(
+    const Environment& env,
+    absl::Nonnull<VideoEncoderFactory*> primary_factory,
+    absl::Nullable<VideoEncoderFactory*> fallback_factory,
+    const SdpVideoFormat& format,
+    const Config& config)
     : env_(env),
       inited_(0),
       primary_encoder_factory_(primary_factory),
@@ -248,6 +321,7 @@ SimulcastEncoderAdapter::SimulcastEncoderAdapter(
       prefer_temporal_support_on_base_layer_(env_.field_trials().IsEnabled(
           "WebRTC-Video-PreferTemporalSupportOnBaseLayer")),
       per_layer_pli_(SupportsPerLayerPictureLossIndication(format.parameters)),
+      stream_encode_pool_(config.stream_encode_pool),
       encoder_info_override_(env.field_trials()) {
   RTC_DCHECK(primary_factory);
 
@@ -472,10 +546,7 @@ int SimulcastEncoderAdapter::Encode(
     }
   }
 
-  // Temporary thay may hold the result of texture to i420 buffer conversion.
-  rtc::scoped_refptr<VideoFrameBuffer> src_buffer;
-  int src_width = input_image.width();
-  int src_height = input_image.height();
+  std::vector<StreamEncode> encodes;
 
   for (auto& layer : stream_contexts_) {
     // Don't encode frames in resolutions that we don't intend to send.
@@ -535,40 +606,248 @@ int SimulcastEncoderAdapter::Encode(
     // correctly sample/scale the source texture.
     // TODO(perkj): ensure that works going forward, and figure out how this
     // affects webrtc:5683.
-    if ((layer.width() == src_width && layer.height() == src_height) ||
-        (input_image.video_frame_buffer()->type() ==
-             VideoFrameBuffer::Type::kNative &&
-         layer.encoder().GetEncoderInfo().supports_native_handle)) {
-      int ret = layer.encoder().Encode(input_image, &stream_frame_types);
-      if (ret != WEBRTC_VIDEO_CODEC_OK) {
-        return ret;
+    bool needs_scaling =
+        (layer.width() != input_image.width() ||
+         layer.height() != input_image.height()) &&
+        (input_image.video_frame_buffer()->type() !=
+             VideoFrameBuffer::Type::kNative ||
+         !layer.encoder().GetEncoderInfo().supports_native_handle);
+    encodes.push_back({.layer = &layer,
+                       .frame_types = std::move(stream_frame_types),
+                       .needs_scaling = needs_scaling});
+  }
+
+  // Native buffers may be bound to the thread that produced them.
+  if (stream_encode_pool_ != nullptr && !bypass_mode_ && encodes.size() > 1 &&
+      input_image.video_frame_buffer()->type() !=
+          VideoFrameBuffer::Type::kNative) {
+    return EncodeStreamsInParallel(input_image, encodes);
+  }
+
+  for (size_t index : PlanScaling(encodes)) {
+    if (!ScaleStream(*input_image.video_frame_buffer(), encodes, index)) {
+      RTC_LOG(LS_ERROR) << "Failed to scale video frame";
+      return WEBRTC_VIDEO_CODEC_ENCODER_FAILURE;
+    }
+  }
+  for (StreamEncode& encode : encodes) {
+    int ret = EncodeStream(input_image, encode);
+    if (ret != WEBRTC_VIDEO_CODEC_OK) {
+      return ret;
+    }
+  }
+  return WEBRTC_VIDEO_CODEC_OK;
+}
+
+std::vector<size_t> SimulcastEncoderAdapter::PlanScaling(
+    std::vector<StreamEncode>& encodes) {
+  std::vector<size_t> scaled;
+  for (size_t i = 0; i < encodes.size(); ++i) {
+    if (encodes[i].needs_scaling) {
+      scaled.push_back(i);
+    }
+  }
+  absl::c_stable_sort(scaled, [&encodes](size_t a, size_t b) {
+    const StreamContext& layer_a = *encodes[a].layer;
+    const StreamContext& layer_b = *encodes[b].layer;
+    return layer_a.width() * layer_a.height() >
+           layer_b.width() * layer_b.height();
+  });
+
+  for (size_t i = 0; i < scaled.size(); ++i) {
+    StreamEncode& encode = encodes[scaled[i]];
+    // Scale from the smallest stream that is at least as large, which is the
+    // last such stream since they are ordered by decreasing size.
+    encode.scale_source = -1;
+    for (size_t j = 0; j < i; ++j) {
+      const StreamContext& larger = *encodes[scaled[j]].layer;
+      if (larger.width() >= encode.layer->width() &&
+          larger.height() >= encode.layer->height()) {
+        encode.scale_source = static_cast<int>(scaled[j]);
       }
-    } else {
-      if (src_buffer == nullptr) {
-        src_buffer = input_image.video_frame_buffer();
+    }
+  }
+  return scaled;
+}
+
+bool SimulcastEncoderAdapter::ScaleStream(VideoFrameBuffer& input_buffer,
+                                          std::vector<StreamEncode>& encodes,
+                                          size_t index) {
+  StreamEncode& encode = encodes[index];
+  RTC_DCHECK(encode.needs_scaling);
+  VideoFrameBuffer* source = &input_buffer;
+  if (encode.scale_source >= 0) {
+    source = encodes[encode.scale_source].scaled_buffer.get();
+  }
+  // The source is null if scaling it failed.
+  if (source != nullptr) {
+    encode.scaled_buffer = encode.layer->ScaleToStream(*source);
+  }
+  return encode.scaled_buffer != nullptr;
+}
+
+int SimulcastEncoderAdapter::EncodeStream(const VideoFrame& input_image,
+                                          const StreamEncode& encode) {
+  VideoEncoder& encoder = encode.layer->encoder();
+  if (!encode.scaled_buffer) {
+    return encoder.Encode(input_image, &encode.frame_types);
+  }
+
+  // UpdateRect is not propagated to lower simulcast layers currently.
+  // TODO(ilnik): Consider scaling UpdateRect together with the buffer.
+  VideoFrame frame(input_image);
+  frame.set_video_frame_buffer(encode.scaled_buffer);
+  frame.set_rotation(webrtc::kVideoRotation_0);
+  frame.set_update_rect(
+      VideoFrame::UpdateRect{0, 0, frame.width(), frame.height()});
+  return encoder.Encode(frame, &encode.frame_types);
+}
+
+// The streams of a frame that is encoded in parallel. Shared with the tasks
+// posted to the pool, which may run after `EncodeStreamsInParallel()` has
+// returned, and then find no stream left to run. `adapter`, `input_image` and
+// `encodes` are only used while a stream is running.
+struct SimulcastEncoderAdapter::ParallelEncodeState
+    : public rtc::RefCountedNonVirtual<ParallelEncodeState> {
+  SimulcastEncoderAdapter* adapter;
+  const VideoFrame* input_image;
+  std::vector<StreamEncode>* encodes;
+
+  Mutex mutex;
+  // Signaled when a stream becomes ready to run, and when the last stream has
+  // been encoded.
+  rtc::Event progress;
+  // Streams that can be run, because they don't need scaling or the stream
+  // they are scaled from has been scaled.
+  std::vector<size_t> ready RTC_GUARDED_BY(mutex);
+  size_t unfinished RTC_GUARDED_BY(mutex) = 0;
+};
+
+int SimulcastEncoderAdapter::EncodeStreamsInParallel(
+    const VideoFrame& input_image,
+    std::vector<StreamEncode>& encodes) {
+  PlanScaling(encodes);
+  auto state = rtc::make_ref_counted<ParallelEncodeState>();
+  state->adapter = this;
+  state->input_image = &input_image;
+  state->encodes = &encodes;
+  {
+    MutexLock lock(&state->mutex);
+    state->unfinished = encodes.size();
+    for (size_t i = 0; i < encodes.size(); ++i) {
+      if (!encodes[i].needs_scaling || encodes[i].scale_source < 0) {
+        state->ready.push_back(i);
       }
-      rtc::scoped_refptr<VideoFrameBuffer> dst_buffer =
-          src_buffer->Scale(layer.width(), layer.height());
-      if (!dst_buffer) {
-        RTC_LOG(LS_ERROR) << "Failed to scale video frame";
-        return WEBRTC_VIDEO_CODEC_ENCODER_FAILURE;
+    }
+  }
+  for (size_t i = 1; i < encodes.size(); ++i) {
+    // Only the first stream in `stream_contexts_` may bypass the adapter's
+    // callback, so the others can always be buffered.
+    encodes[i].layer->StartBuffering();
+  }
+  for (size_t i = 1; i < encodes.size(); ++i) {
+    if (!encodes[i].needs_scaling || encodes[i].scale_source < 0) {
+      stream_encode_pool_->PostTask(
+          [state] { RunParallelEncodeJob(state, /*on_encoder_queue=*/false); });
+    }
+  }
+
+  // The images of the first stream are delivered as they are produced, since
+  // they come first anyway. Rather than waiting for the pool, this queue runs
+  // every stream that is ready, so it only waits for streams that are
+  // running on the pool. That way a pool that is busy with the streams of
+  // other adapters only delays the encode, and can't block it.
+  while (true) {
+    while (RunParallelEncodeJob(state, /*on_encoder_queue=*/true)) {
+    }
+    {
+      MutexLock lock(&state->mutex);
+      if (state->unfinished == 0) {
+        break;
       }
+    }
+    state->progress.Wait(rtc::Event::kForever);
+  }
 
-      // UpdateRect is not propagated to lower simulcast layers currently.
-      // TODO(ilnik): Consider scaling UpdateRect together with the buffer.
-      VideoFrame frame(input_image);
-      frame.set_video_frame_buffer(dst_buffer);
-      frame.set_rotation(webrtc::kVideoRotation_0);
-      frame.set_update_rect(
-          VideoFrame::UpdateRect{0, 0, frame.width(), frame.height()});
-      int ret = layer.encoder().Encode(frame, &stream_frame_types);
-      if (ret != WEBRTC_VIDEO_CODEC_OK) {
-        return ret;
+  int result = WEBRTC_VIDEO_CODEC_OK;
+  for (StreamEncode& encode : encodes) {
+    if (&encode != &encodes[0]) {
+      encode.layer->DeliverBufferedImages();
+    }
+    if (result == WEBRTC_VIDEO_CODEC_OK) {
+      result = encode.result;
+    }
+  }
+  return result;
+}
+
+bool SimulcastEncoderAdapter::RunParallelEncodeJob(
+    const rtc::scoped_refptr<ParallelEncodeState>& state_ref,
+    bool on_encoder_queue) {
+  ParallelEncodeState& state = *state_ref;
+  size_t index;
+  {
+    MutexLock lock(&state.mutex);
+    auto it = on_encoder_queue ? absl::c_find(state.ready, size_t{0})
+                               : state.ready.end();
+    if (it == state.ready.end()) {
+      it = absl::c_find_if(state.ready, [](size_t i) { return i != 0; });
+    }
+    if (it == state.ready.end()) {
+      return false;
+    }
+    index = *it;
+    state.ready.erase(it);
+  }
+
+  std::vector<StreamEncode>& encodes = *state.encodes;
+  StreamEncode& encode = encodes[index];
+  if (encode.needs_scaling &&
+      !ScaleStream(*state.input_image->video_frame_buffer(), encodes, index)) {
+    RTC_LOG(LS_ERROR) << "Failed to scale video frame";
+    encode.result = WEBRTC_VIDEO_CODEC_ENCODER_FAILURE;
+  }
+
+  // The streams scaled from this one can run now. If scaling failed, they
+  // fail as well.
+  size_t num_ready = 0;
+  bool first_stream_ready = false;
+  {
+    MutexLock lock(&state.mutex);
+    for (size_t i = 0; i < encodes.size(); ++i) {
+      if (encodes[i].needs_scaling &&
+          encodes[i].scale_source == static_cast<int>(index)) {
+        state.ready.push_back(i);
+        if (i == 0) {
+          first_stream_ready = true;
+        } else {
+          ++num_ready;
+        }
       }
     }
   }
+  for (size_t i = 0; i < num_ready; ++i) {
+    state.adapter->stream_encode_pool_->PostTask([state_ref] {
+      RunParallelEncodeJob(state_ref, /*on_encoder_queue=*/false);
+    });
+  }
+  if (first_stream_ready || num_ready > 0) {
+    state.progress.Set();
+  }
 
-  return WEBRTC_VIDEO_CODEC_OK;
+  if (encode.result == WEBRTC_VIDEO_CODEC_OK) {
+    encode.result = state.adapter->EncodeStream(*state.input_image, encode);
+  }
+
+  bool finished;
+  {
+    MutexLock lock(&state.mutex);
+    finished = --state.unfinished == 0;
+  }
+  if (finished) {
+    state.progress.Set();
+  }
+  return true;
 }
 
 int SimulcastEncoderAdapter::RegisterEncodeCompleteCallback(
@@ -954,6 +1233,8 @@ VideoEncoder::EncoderInfo SimulcastEncoderAdapter::GetEncoderInfo() const {
           encoder_impl_info.is_qp_trusted.value_or(true);
     }
     encoder_info.fps_allocation[i] = encoder_impl_info.fps_allocation[0];
+    encoder_info.num_input_conversions +=
+        encoder_impl_info.num_input_conversions;
     encoder_info.requested_resolution_alignment = cricket::LeastCommonMultiple(
         encoder_info.requested_resolution_alignment,
         encoder_impl_info.requested_resolution_alignment);
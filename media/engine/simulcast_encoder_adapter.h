@@ -25,11 +25,14 @@
 #include "api/environment/environment.h"
 #include "api/fec_controller_override.h"
 #include "api/field_trials_view.h"
+#include "api/scoped_refptr.h"
 #include "api/sequence_checker.h"
 #include "api/video_codecs/sdp_video_format.h"
 #include "api/video_codecs/video_encoder.h"
 #include "api/video_codecs/video_encoder_factory.h"
 #include "common_video/framerate_controller.h"
+#include "common_video/include/video_frame_buffer_pool.h"
+#include "media/engine/simulcast_encode_thread_pool.h"
 #include "modules/video_coding/include/video_codec_interface.h"
 #include "rtc_base/experiments/encoder_info_settings.h"
 #include "rtc_base/system/no_unique_address.h"
@@ -43,6 +46,20 @@ namespace webrtc {
 // interfaces should be called from the encoder task queue.
 class RTC_EXPORT SimulcastEncoderAdapter : public VideoEncoder {
  public:
+  struct Config {
+    // If set and the adapter uses one encoder per stream, the streams of a
+    // frame are encoded concurrently on the threads of the pool, instead of
+    // one after the other on the encoder queue. Each stream is scaled as part
+    // of its encode, once the larger stream it is scaled from has been
+    // scaled. Encode() still returns once all streams have been encoded, and
+    // the encoded images produced during the call are delivered on the
+    // encoder queue in stream order. Frames with native buffers are encoded
+    // sequentially. Requires that the underlying encoders may be called on
+    // another sequence for Encode() than for their other methods. The pool
+    // must outlive the adapter.
+    absl::Nullable<SimulcastEncodeThreadPool*> stream_encode_pool = nullptr;
+  };
+
   // `primary_factory` produces the first-choice encoders to use.
   // `fallback_factory`, if non-null, is used to create fallback encoder that
   // will be used if InitEncode() fails for the primary encoder.
@@ -50,6 +67,11 @@ class RTC_EXPORT SimulcastEncoderAdapter : public VideoEncoder {
                           absl::Nonnull<VideoEncoderFactory*> primary_factory,
                           absl::Nullable<VideoEncoderFactory*> fallback_factory,
                           const SdpVideoFormat& format);
+  SimulcastEncoderAdapter(const Environment& env,
+                          absl::Nonnull<VideoEncoderFactory*> primary_factory,
+                          absl::Nullable<VideoEncoderFactory*> fallback_factory,
+                          const SdpVideoFormat& format,
+                          const Config& config);
 
   ~SimulcastEncoderAdapter() override;
 
@@ -136,6 +158,16 @@ class RTC_EXPORT SimulcastEncoderAdapter : public VideoEncoder {
     void OnKeyframe(Timestamp timestamp);
     bool ShouldDropFrame(Timestamp timestamp);
 
+    // Returns `source` scaled to the resolution of the stream. I420 and NV12
+    // buffers are scaled into buffers from a pool owned by the stream.
+    rtc::scoped_refptr<VideoFrameBuffer> ScaleToStream(
+        VideoFrameBuffer& source);
+
+    // While buffering, encoded images are kept until `DeliverBufferedImages()`
+    // instead of being passed on to the parent.
+    void StartBuffering();
+    void DeliverBufferedImages();
+
    private:
     SimulcastEncoderAdapter* const parent_;
     std::unique_ptr<EncoderContext> encoder_context_;
@@ -145,8 +177,27 @@ class RTC_EXPORT SimulcastEncoderAdapter : public VideoEncoder {
     const uint16_t height_;
     bool is_keyframe_needed_;
     bool is_paused_;
+    std::unique_ptr<VideoFrameBufferPool> buffer_pool_;
+    bool is_buffering_ = false;
+    std::vector<std::pair<EncodedImage, CodecSpecificInfo>> buffered_images_;
+  };
+
+  // A stream to encode and the frame types to encode it with.
+  struct StreamEncode {
+    StreamContext* layer;
+    std::vector<VideoFrameType> frame_types;
+    bool needs_scaling = false;
+    // Index of the stream whose scaled buffer this stream is scaled from, or
+    // -1 to scale from the input.
+    int scale_source = -1;
+    // The input scaled to the stream's resolution, or null if the input is
+    // encoded as is.
+    rtc::scoped_refptr<VideoFrameBuffer> scaled_buffer;
+    int result = WEBRTC_VIDEO_CODEC_OK;
   };
 
+  struct ParallelEncodeState;
+
   bool Initialized() const;
 
   // This method creates encoder. May reuse previously created encoders from
@@ -168,6 +219,34 @@ class RTC_EXPORT SimulcastEncoderAdapter : public VideoEncoder {
 
   void OnDroppedFrame(size_t stream_idx);
 
+  // Sets `scale_source` of the streams that need scaling. Each stream is
+  // scaled from the smallest stream that is at least as large, so that the
+  // full resolution input is only read for the largest stream. Returns the
+  // streams that need scaling, largest first, which is an order in which each
+  // stream comes after the one it is scaled from.
+  static std::vector<size_t> PlanScaling(std::vector<StreamEncode>& encodes);
+  // Sets `scaled_buffer` of `encodes[index]` from `input_buffer` or from the
+  // scaled buffer of its `scale_source`, which must have been scaled. Returns
+  // false if scaling failed.
+  static bool ScaleStream(VideoFrameBuffer& input_buffer,
+                          std::vector<StreamEncode>& encodes,
+                          size_t index);
+  // Encodes `input_image`, or its scaled buffer, on the stream of `encode`.
+  int EncodeStream(const VideoFrame& input_image, const StreamEncode& encode);
+  // Scales and encodes the streams on `stream_encode_pool_`, then delivers the
+  // buffered images of all but the first stream in order. The first stream is
+  // encoded on the calling queue, which also takes any other stream that is
+  // ready to run rather than waiting for a pool thread. Returns the first
+  // error in stream order.
+  int EncodeStreamsInParallel(const VideoFrame& input_image,
+                              std::vector<StreamEncode>& encodes);
+  // Scales and encodes one stream of `state` that is ready to run. Only the
+  // encoder queue runs the first stream. Returns false if there was no stream
+  // to run.
+  static bool RunParallelEncodeJob(
+      const rtc::scoped_refptr<ParallelEncodeState>& state,
+      bool on_encoder_queue);
+
   void OverrideFromFieldTrial(VideoEncoder::EncoderInfo* info) const;
 
   const Environment env_;
@@ -193,6 +272,7 @@ class RTC_EXPORT SimulcastEncoderAdapter : public VideoEncoder {
   const bool boost_base_layer_quality_;
   const bool prefer_temporal_support_on_base_layer_;
   const bool per_layer_pli_;
+  SimulcastEncodeThreadPool* const stream_encode_pool_;
 
   const SimulcastEncoderAdapterEncoderInfoSettings encoder_info_override_;
 };
@@ -28,15 +28,18 @@
 #include "common_video/include/video_frame_buffer.h"
 #include "media/base/media_constants.h"
 #include "media/engine/internal_encoder_factory.h"
+#include "media/engine/simulcast_encode_thread_pool.h"
 #include "modules/video_coding/codecs/vp8/include/vp8.h"
 #include "modules/video_coding/include/video_codec_interface.h"
 #include "modules/video_coding/utility/simulcast_test_fixture_impl.h"
 #include "rtc_base/checks.h"
+#include "rtc_base/event.h"
 #include "test/gmock.h"
 #include "test/gtest.h"
 #include "test/scoped_key_value_config.h"
 
 using ::testing::_;
+using ::testing::ElementsAre;
 using ::testing::Return;
 using EncoderInfo = webrtc::VideoEncoder::EncoderInfo;
 using FramerateFractions =
@@ -256,6 +259,7 @@ class MockVideoEncoder : public VideoEncoder {
     info.supports_simulcast = supports_simulcast_;
     info.is_qp_trusted = is_qp_trusted_;
     info.resolution_bitrate_limits = resolution_bitrate_limits;
+    info.num_input_conversions = num_input_conversions_;
     return info;
   }
 
@@ -329,6 +333,10 @@ class MockVideoEncoder : public VideoEncoder {
     resolution_bitrate_limits = limits;
   }
 
+  void set_num_input_conversions(int64_t num_input_conversions) {
+    num_input_conversions_ = num_input_conversions;
+  }
+
   bool supports_simulcast() const { return supports_simulcast_; }
 
   SdpVideoFormat video_format() const { return video_format_; }
@@ -349,6 +357,7 @@ class MockVideoEncoder : public VideoEncoder {
   absl::optional<bool> is_qp_trusted_;
   SdpVideoFormat video_format_;
   std::vector<VideoEncoder::ResolutionBitrateLimits> resolution_bitrate_limits;
+  int64_t num_input_conversions_ = 0;
 
   VideoCodec codec_;
   EncodedImageCallback* callback_;
@@ -415,9 +424,11 @@ class TestSimulcastEncoderAdapterFakeHelper {
                               : nullptr),
         video_format_(video_format) {}
 
-  std::unique_ptr<VideoEncoder> CreateMockEncoderAdapter() {
+  std::unique_ptr<VideoEncoder> CreateMockEncoderAdapter(
+      const SimulcastEncoderAdapter::Config& config = {}) {
     return std::make_unique<SimulcastEncoderAdapter>(
-        env_, &primary_factory_, fallback_factory_.get(), video_format_);
+        env_, &primary_factory_, fallback_factory_.get(), video_format_,
+        config);
   }
 
   MockVideoEncoderFactory* factory() { return &primary_factory_; }
@@ -449,7 +460,8 @@ class TestSimulcastEncoderAdapterFake : public ::testing::Test,
     helper_ = std::make_unique<TestSimulcastEncoderAdapterFakeHelper>(
         env_, use_fallback_factory_,
         SdpVideoFormat("VP8", sdp_video_parameters_));
-    adapter_ = helper_->CreateMockEncoderAdapter();
+    adapter_ = helper_->CreateMockEncoderAdapter(adapter_config_);
+    encoded_image_widths_.clear();
     last_encoded_image_width_ = absl::nullopt;
     last_encoded_image_height_ = absl::nullopt;
     last_encoded_image_simulcast_index_ = absl::nullopt;
@@ -467,6 +479,7 @@ class TestSimulcastEncoderAdapterFake : public ::testing::Test,
 
   Result OnEncodedImage(const EncodedImage& encoded_image,
                         const CodecSpecificInfo* codec_specific_info) override {
+    encoded_image_widths_.push_back(encoded_image._encodedWidth);
     last_encoded_image_width_ = encoded_image._encodedWidth;
     last_encoded_image_height_ = encoded_image._encodedHeight;
     last_encoded_image_simulcast_index_ = encoded_image.SimulcastIndex();
@@ -582,8 +595,12 @@ class TestSimulcastEncoderAdapterFake : public ::testing::Test,
   test::ScopedKeyValueConfig field_trials_;
   const Environment env_ = CreateEnvironment(&field_trials_);
   std::unique_ptr<TestSimulcastEncoderAdapterFakeHelper> helper_;
+  // Declared before `adapter_`, which must not outlive it.
+  std::unique_ptr<SimulcastEncodeThreadPool> stream_encode_pool_;
+  SimulcastEncoderAdapter::Config adapter_config_;
   std::unique_ptr<VideoEncoder> adapter_;
   VideoCodec codec_;
+  std::vector<int> encoded_image_widths_;
   absl::optional<int> last_encoded_image_width_;
   absl::optional<int> last_encoded_image_height_;
   absl::optional<int> last_encoded_image_simulcast_index_;
@@ -1216,6 +1233,235 @@ TEST_F(TestSimulcastEncoderAdapterFake, TestFailureReturnCodesFromEncodeCalls) {
             adapter_->Encode(input_frame, &frame_types));
 }
 
+TEST_F(TestSimulcastEncoderAdapterFake,
+       ParallelStreamEncodingDeliversImagesInStreamOrder) {
+  stream_encode_pool_ = std::make_unique<SimulcastEncodeThreadPool>(2);
+  adapter_config_.stream_encode_pool = stream_encode_pool_.get();
+  ReSetUp();
+  SetupCodec();
+  adapter_->SetRates(VideoEncoder::RateControlParameters(
+      rate_allocator_->Allocate(VideoBitrateAllocationParameters(10000000, 30)),
+      30.0));
+  std::vector<MockVideoEncoder*> encoders = helper_->factory()->encoders();
+  ASSERT_EQ(3u, encoders.size());
+
+  // The middle stream can only finish once the top stream has, so the streams
+  // must be encoded concurrently, and complete out of order.
+  rtc::Event top_stream_encoded;
+  EXPECT_CALL(*encoders[0], Encode).WillOnce([&] {
+    encoders[0]->SendEncodedImage(320, 180);
+    return WEBRTC_VIDEO_CODEC_OK;
+  });
+  EXPECT_CALL(*encoders[1], Encode).WillOnce([&] {
+    EXPECT_TRUE(top_stream_encoded.Wait(TimeDelta::Seconds(10)));
+    encoders[1]->SendEncodedImage(640, 360);
+    return WEBRTC_VIDEO_CODEC_OK;
+  });
+  EXPECT_CALL(*encoders[2], Encode).WillOnce([&] {
+    encoders[2]->SendEncodedImage(1280, 720);
+    top_stream_encoded.Set();
+    return WEBRTC_VIDEO_CODEC_OK;
+  });
+
+  rtc::scoped_refptr<I420Buffer> input_buffer =
+      I420Buffer::Create(kDefaultWidth, kDefaultHeight);
+  input_buffer->InitializeData();
+  VideoFrame input_frame = VideoFrame::Builder()
+                               .set_video_frame_buffer(input_buffer)
+                               .set_rtp_timestamp(0)
+                               .set_timestamp_us(0)
+                               .build();
+  std::vector<VideoFrameType> frame_types(3, VideoFrameType::kVideoFrameKey);
+  EXPECT_EQ(0, adapter_->Encode(input_frame, &frame_types));
+  EXPECT_THAT(encoded_image_widths_, ElementsAre(320, 640, 1280));
+  EXPECT_EQ(last_encoded_image_simulcast_index_, 2);
+}
+
+TEST_F(TestSimulcastEncoderAdapterFake,
+       ParallelStreamEncodingReturnsFirstErrorInStreamOrder) {
+  stream_encode_pool_ = std::make_unique<SimulcastEncodeThreadPool>(2);
+  adapter_config_.stream_encode_pool = stream_encode_pool_.get();
+  ReSetUp();
+  SetupCodec();
+  adapter_->SetRates(VideoEncoder::RateControlParameters(
+      rate_allocator_->Allocate(VideoBitrateAllocationParameters(10000000, 30)),
+      30.0));
+  std::vector<MockVideoEncoder*> encoders = helper_->factory()->encoders();
+  ASSERT_EQ(3u, encoders.size());
+
+  EXPECT_CALL(*encoders[0], Encode).WillOnce([&] {
+    encoders[0]->SendEncodedImage(320, 180);
+    return WEBRTC_VIDEO_CODEC_OK;
+  });
+  EXPECT_CALL(*encoders[1], Encode)
+      .WillOnce(Return(WEBRTC_VIDEO_CODEC_FALLBACK_SOFTWARE));
+  EXPECT_CALL(*encoders[2], Encode).WillOnce([&] {
+    encoders[2]->SendEncodedImage(1280, 720);
+    return WEBRTC_VIDEO_CODEC_ERROR;
+  });
+
+  rtc::scoped_refptr<I420Buffer> input_buffer =
+      I420Buffer::Create(kDefaultWidth, kDefaultHeight);
+  input_buffer->InitializeData();
+  VideoFrame input_frame = VideoFrame::Builder()
+                               .set_video_frame_buffer(input_buffer)
+                               .set_rtp_timestamp(0)
+                               .set_timestamp_us(0)
+                               .build();
+  std::vector<VideoFrameType> frame_types(3, VideoFrameType::kVideoFrameKey);
+  EXPECT_EQ(WEBRTC_VIDEO_CODEC_FALLBACK_SOFTWARE,
+            adapter_->Encode(input_frame, &frame_types));
+  // Streams that were encoded are still delivered.
+  EXPECT_THAT(encoded_image_widths_, ElementsAre(320, 1280));
+}
+
+// Counts how often the planes of the wrapped buffer are read.
+class CountingI420Buffer : public I420BufferInterface {
+ public:
+  explicit CountingI420Buffer(rtc::scoped_refptr<I420BufferInterface> buffer)
+      : buffer_(std::move(buffer)) {}
+
+  int width() const override { return buffer_->width(); }
+  int height() const override { return buffer_->height(); }
+  const uint8_t* DataY() const override {
+    ++num_reads_;
+    return buffer_->DataY();
+  }
+  const uint8_t* DataU() const override { return buffer_->DataU(); }
+  const uint8_t* DataV() const override { return buffer_->DataV(); }
+  int StrideY() const override { return buffer_->StrideY(); }
+  int StrideU() const override { return buffer_->StrideU(); }
+  int StrideV() const override { return buffer_->StrideV(); }
+
+  int num_reads() const { return num_reads_; }
+
+ private:
+  const rtc::scoped_refptr<I420BufferInterface> buffer_;
+  mutable int num_reads_ = 0;
+};
+
+TEST_F(TestSimulcastEncoderAdapterFake, ScalesStreamsFromNextLargerStream) {
+  SetupCodec();
+  adapter_->SetRates(VideoEncoder::RateControlParameters(
+      rate_allocator_->Allocate(VideoBitrateAllocationParameters(10000000, 30)),
+      30.0));
+  std::vector<MockVideoEncoder*> encoders = helper_->factory()->encoders();
+  ASSERT_EQ(3u, encoders.size());
+
+  rtc::scoped_refptr<I420Buffer> i420_buffer =
+      I420Buffer::Create(kDefaultWidth, kDefaultHeight);
+  i420_buffer->InitializeData();
+  auto input_buffer = rtc::make_ref_counted<CountingI420Buffer>(i420_buffer);
+  std::array<const VideoFrameBuffer*, 3> encoded_buffers = {};
+  for (int i = 0; i < 3; ++i) {
+    EXPECT_CALL(*encoders[i], Encode)
+        .Times(2)
+        .WillRepeatedly([&encoded_buffers, i](
+                            const VideoFrame& frame,
+                            const std::vector<VideoFrameType>* frame_types) {
+          if (encoded_buffers[i] != nullptr) {
+            // Scaled buffers are reused for the next frame.
+            EXPECT_EQ(frame.video_frame_buffer().get(), encoded_buffers[i]);
+          }
+          encoded_buffers[i] = frame.video_frame_buffer().get();
+          EXPECT_EQ(frame.width(), kDefaultWidth >> (2 - i));
+          EXPECT_EQ(frame.height(), kDefaultHeight >> (2 - i));
+          return WEBRTC_VIDEO_CODEC_OK;
+        });
+  }
+
+  std::vector<VideoFrameType> frame_types(3, VideoFrameType::kVideoFrameKey);
+  for (int i = 0; i < 2; ++i) {
+    VideoFrame input_frame = VideoFrame::Builder()
+                                 .set_video_frame_buffer(input_buffer)
+                                 .set_rtp_timestamp(i * 3000)
+                                 .set_timestamp_us(i * 33333)
+                                 .build();
+    EXPECT_EQ(0, adapter_->Encode(input_frame, &frame_types));
+  }
+  // The top stream is encoded from the input, the middle one is scaled from
+  // it and the bottom one from the middle one.
+  EXPECT_EQ(encoded_buffers[2], input_buffer.get());
+  EXPECT_EQ(input_buffer->num_reads(), 2);
+}
+
+TEST_F(TestSimulcastEncoderAdapterFake,
+       ParallelStreamEncodingScalesStreamsAfterTheirSource) {
+  stream_encode_pool_ = std::make_unique<SimulcastEncodeThreadPool>(2);
+  adapter_config_.stream_encode_pool = stream_encode_pool_.get();
+  ReSetUp();
+  SetupCodec();
+  adapter_->SetRates(VideoEncoder::RateControlParameters(
+      rate_allocator_->Allocate(VideoBitrateAllocationParameters(10000000, 30)),
+      30.0));
+  std::vector<MockVideoEncoder*> encoders = helper_->factory()->encoders();
+  ASSERT_EQ(3u, encoders.size());
+
+  for (int i = 0; i < 3; ++i) {
+    EXPECT_CALL(*encoders[i], Encode)
+        .WillOnce([i](const VideoFrame& frame,
+                      const std::vector<VideoFrameType>* frame_types) {
+          EXPECT_EQ(frame.width(), kDefaultWidth >> (2 - i));
+          EXPECT_EQ(frame.height(), kDefaultHeight >> (2 - i));
+          return WEBRTC_VIDEO_CODEC_OK;
+        });
+  }
+
+  rtc::scoped_refptr<I420Buffer> i420_buffer =
+      I420Buffer::Create(kDefaultWidth, kDefaultHeight);
+  i420_buffer->InitializeData();
+  auto input_buffer = rtc::make_ref_counted<CountingI420Buffer>(i420_buffer);
+  VideoFrame input_frame = VideoFrame::Builder()
+                               .set_video_frame_buffer(input_buffer)
+                               .set_rtp_timestamp(0)
+                               .set_timestamp_us(0)
+                               .build();
+  std::vector<VideoFrameType> frame_types(3, VideoFrameType::kVideoFrameKey);
+  EXPECT_EQ(0, adapter_->Encode(input_frame, &frame_types));
+  // Only the middle stream is scaled from the input.
+  EXPECT_EQ(input_buffer->num_reads(), 1);
+}
+
+TEST_F(TestSimulcastEncoderAdapterFake,
+       ParallelStreamEncodingCompletesWhilePoolIsBusy) {
+  stream_encode_pool_ = std::make_unique<SimulcastEncodeThreadPool>(1);
+  adapter_config_.stream_encode_pool = stream_encode_pool_.get();
+  ReSetUp();
+  SetupCodec();
+  adapter_->SetRates(VideoEncoder::RateControlParameters(
+      rate_allocator_->Allocate(VideoBitrateAllocationParameters(10000000, 30)),
+      30.0));
+  std::vector<MockVideoEncoder*> encoders = helper_->factory()->encoders();
+  ASSERT_EQ(3u, encoders.size());
+  for (MockVideoEncoder* encoder : encoders) {
+    EXPECT_CALL(*encoder, Encode).WillOnce(Return(WEBRTC_VIDEO_CODEC_OK));
+  }
+
+  // Occupy the only thread of the pool until the frame has been encoded.
+  rtc::Event pool_busy;
+  rtc::Event frame_encoded;
+  rtc::Event pool_idle;
+  stream_encode_pool_->PostTask([&] {
+    pool_busy.Set();
+    frame_encoded.Wait(rtc::Event::kForever);
+    pool_idle.Set();
+  });
+  ASSERT_TRUE(pool_busy.Wait(TimeDelta::Seconds(10)));
+
+  rtc::scoped_refptr<I420Buffer> input_buffer =
+      I420Buffer::Create(kDefaultWidth, kDefaultHeight);
+  input_buffer->InitializeData();
+  VideoFrame input_frame = VideoFrame::Builder()
+                               .set_video_frame_buffer(input_buffer)
+                               .set_rtp_timestamp(0)
+                               .set_timestamp_us(0)
+                               .build();
+  std::vector<VideoFrameType> frame_types(3, VideoFrameType::kVideoFrameKey);
+  EXPECT_EQ(0, adapter_->Encode(input_frame, &frame_types));
+  frame_encoded.Set();
+  EXPECT_TRUE(pool_idle.Wait(TimeDelta::Seconds(10)));
+}
+
 TEST_F(TestSimulcastEncoderAdapterFake, TestInitFailureCleansUpEncoders) {
   SimulcastTestFixtureImpl::DefaultSettings(
       &codec_, static_cast<const int*>(kTestTemporalLayerProfile),
@@ -1544,6 +1790,21 @@ TEST_F(TestSimulcastEncoderAdapterFake, ReportsIsQpTrusted) {
   EXPECT_FALSE(adapter_->GetEncoderInfo().is_qp_trusted.value_or(true));
 }
 
+TEST_F(TestSimulcastEncoderAdapterFake, ReportsSumOfInputConversions) {
+  SimulcastTestFixtureImpl::DefaultSettings(
+      &codec_, static_cast<const int*>(kTestTemporalLayerProfile),
+      kVideoCodecVP8);
+  codec_.numberOfSimulcastStreams = 3;
+  adapter_->RegisterEncodeCompleteCallback(this);
+  EXPECT_EQ(0, adapter_->InitEncode(&codec_, kSettings));
+  ASSERT_EQ(3u, helper_->factory()->encoders().size());
+  EXPECT_EQ(adapter_->GetEncoderInfo().num_input_conversions, 0);
+
+  helper_->factory()->encoders()[0]->set_num_input_conversions(2);
+  helper_->factory()->encoders()[2]->set_num_input_conversions(5);
+  EXPECT_EQ(adapter_->GetEncoderInfo().num_input_conversions, 7);
+}
+
 TEST_F(TestSimulcastEncoderAdapterFake, ReportsFpsAllocation) {
   SimulcastTestFixtureImpl::DefaultSettings(
       &codec_, static_cast<const int*>(kTestTemporalLayerProfile),
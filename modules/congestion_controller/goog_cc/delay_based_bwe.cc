@@ -121,15 +121,21 @@ DelayBasedBwe::Result DelayBasedBwe::IncomingPacketFeedbackVector(
   }
   bool delayed_feedback = true;
   bool recovered_from_overuse = false;
-  BandwidthUsage prev_detector_state = active_delay_detector_->State();
-  for (const auto& packet_feedback : packet_feedback_vector) {
+  if (!separate_audio_.enabled && network_state_predictor_ == nullptr) {
     delayed_feedback = false;
-    IncomingPacketFeedback(packet_feedback, msg.feedback_time);
-    if (prev_detector_state == BandwidthUsage::kBwUnderusing &&
-        active_delay_detector_->State() == BandwidthUsage::kBwNormal) {
-      recovered_from_overuse = true;
+    recovered_from_overuse = IncomingPacketFeedbackBatch(
+        packet_feedback_vector, msg.feedback_time);
+  } else {
+    BandwidthUsage prev_detector_state = active_delay_detector_->State();
+    for (const auto& packet_feedback : packet_feedback_vector) {
+      delayed_feedback = false;
+      IncomingPacketFeedback(packet_feedback, msg.feedback_time);
+      if (prev_detector_state == BandwidthUsage::kBwUnderusing &&
+          active_delay_detector_->State() == BandwidthUsage::kBwNormal) {
+        recovered_from_overuse = true;
+      }
+      prev_detector_state = active_delay_detector_->State();
     }
-    prev_detector_state = active_delay_detector_->State();
   }
 
   if (delayed_feedback) {
@@ -144,8 +150,7 @@ DelayBasedBwe::Result DelayBasedBwe::IncomingPacketFeedbackVector(
                              recovered_from_overuse, in_alr, msg.feedback_time);
 }
 
-void DelayBasedBwe::IncomingPacketFeedback(const PacketResult& packet_feedback,
-                                           Timestamp at_time) {
+void DelayBasedBwe::MaybeResetOnTimeout(Timestamp at_time) {
   // Reset if the stream has timed out.
   if (last_seen_packet_.IsInfinite() ||
       at_time - last_seen_packet_ > kStreamTimeOut) {
@@ -161,6 +166,44 @@ void DelayBasedBwe::IncomingPacketFeedback(const PacketResult& packet_feedback,
     active_delay_detector_ = video_delay_detector_.get();
   }
   last_seen_packet_ = at_time;
+}
+
+bool DelayBasedBwe::IncomingPacketFeedbackBatch(
+    rtc::ArrayView<const PacketResult> packets,
+    Timestamp at_time) {
+  RTC_DCHECK(!separate_audio_.enabled);
+  RTC_DCHECK(!network_state_predictor_);
+  // All packets have the same `at_time`, so only the first one could time out.
+  MaybeResetOnTimeout(at_time);
+  RTC_DCHECK_EQ(active_delay_detector_, video_delay_detector_.get());
+
+  group_deltas_.clear();
+  video_inter_arrival_delta_->ComputeDeltas(packets, at_time, group_deltas_);
+
+  // Without a network state predictor, the detector is only updated by
+  // packets for which deltas were computed.
+  bool recovered_from_overuse = false;
+  BandwidthUsage prev_detector_state = video_delay_detector_->State();
+  for (const InterArrivalDelta::GroupDelta& delta : group_deltas_) {
+    video_delay_detector_->Update(
+        delta.arrival_time_delta.ms<double>(),
+        delta.send_time_delta.ms<double>(),
+        delta.packet->sent_packet.send_time.ms(),
+        delta.packet->receive_time.ms(),
+        delta.packet->sent_packet.size.bytes(), /*calculated_deltas=*/true);
+    BandwidthUsage detector_state = video_delay_detector_->State();
+    if (prev_detector_state == BandwidthUsage::kBwUnderusing &&
+        detector_state == BandwidthUsage::kBwNormal) {
+      recovered_from_overuse = true;
+    }
+    prev_detector_state = detector_state;
+  }
+  return recovered_from_overuse;
+}
+
+void DelayBasedBwe::IncomingPacketFeedback(const PacketResult& packet_feedback,
+                                           Timestamp at_time) {
+  MaybeResetOnTimeout(at_time);
 
   // As an alternative to ignoring small packets, we can separate audio and
   // video packets for overuse detection.
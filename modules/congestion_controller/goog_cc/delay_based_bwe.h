@@ -17,6 +17,7 @@
 #include <vector>
 
 #include "absl/types/optional.h"
+#include "api/array_view.h"
 #include "api/field_trials_view.h"
 #include "api/network_state_predictor.h"
 #include "api/transport/bandwidth_usage.h"
@@ -90,8 +91,18 @@ class DelayBasedBwe {
 
  private:
   friend class GoogCcStatePrinter;
+  // Resets the inter-arrival and delay detector state if no feedback has been
+  // received for a while.
+  void MaybeResetOnTimeout(Timestamp at_time);
   void IncomingPacketFeedback(const PacketResult& packet_feedback,
                               Timestamp at_time);
+  // Feeds `packets`, sorted by receive time, to the video inter-arrival and
+  // delay detector in one pass. Only valid when audio packets aren't
+  // separated and there is no network state predictor, in which case the
+  // detector only needs to see the packets that complete a group. Returns true
+  // if the detector went from underusing to normal.
+  bool IncomingPacketFeedbackBatch(rtc::ArrayView<const PacketResult> packets,
+                                   Timestamp at_time);
   Result MaybeUpdateEstimate(
       absl::optional<DataRate> acked_bitrate,
       absl::optional<DataRate> probe_bitrate,
@@ -124,6 +135,8 @@ class DelayBasedBwe {
   std::unique_ptr<InterArrivalDelta> audio_inter_arrival_delta_;
   std::unique_ptr<DelayIncreaseDetectorInterface> audio_delay_detector_;
   DelayIncreaseDetectorInterface* active_delay_detector_;
+  // Reused by IncomingPacketFeedbackBatch() to avoid reallocating.
+  std::vector<InterArrivalDelta::GroupDelta> group_deltas_;
 
   Timestamp last_seen_packet_;
   bool uma_recorded_;
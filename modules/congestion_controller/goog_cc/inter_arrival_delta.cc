@@ -104,6 +104,22 @@ bool InterArrivalDelta::ComputeDeltas(Timestamp send_time,
   return calculated_deltas;
 }
 
+void InterArrivalDelta::ComputeDeltas(
+    rtc::ArrayView<const PacketResult> packets,
+    Timestamp system_time,
+    std::vector<GroupDelta>& deltas) {
+  for (const PacketResult& packet : packets) {
+    GroupDelta delta;
+    if (ComputeDeltas(packet.sent_packet.send_time, packet.receive_time,
+                      system_time, packet.sent_packet.size.bytes(),
+                      &delta.send_time_delta, &delta.arrival_time_delta,
+                      &delta.packet_size_delta)) {
+      delta.packet = &packet;
+      deltas.push_back(delta);
+    }
+  }
+}
+
 // Assumes that `timestamp` is not reordered compared to
 // `current_timestamp_group_`.
 bool InterArrivalDelta::NewTimestampGroup(Timestamp arrival_time,
@@ -12,7 +12,10 @@
 #define MODULES_CONGESTION_CONTROLLER_GOOG_CC_INTER_ARRIVAL_DELTA_H_
 
 #include <cstddef>
+#include <vector>
 
+#include "api/array_view.h"
+#include "api/transport/network_types.h"
 #include "api/units/time_delta.h"
 #include "api/units/timestamp.h"
 
@@ -54,6 +57,24 @@ class InterArrivalDelta {
                      TimeDelta* arrival_time_delta,
                      int* packet_size_delta);
 
+  // Deltas computed for a packet passed to the batch version of
+  // ComputeDeltas().
+  struct GroupDelta {
+    TimeDelta send_time_delta = TimeDelta::Zero();
+    TimeDelta arrival_time_delta = TimeDelta::Zero();
+    int packet_size_delta = 0;
+    // The packet for which the deltas were computed, i.e. the first packet of
+    // the group after the two groups that the deltas are between.
+    const PacketResult* packet = nullptr;
+  };
+
+  // Same as calling ComputeDeltas() for each of `packets`, in order, with
+  // `system_time`, except that the deltas are appended to `deltas` for only
+  // the packets for which they were computed.
+  void ComputeDeltas(rtc::ArrayView<const PacketResult> packets,
+                     Timestamp system_time,
+                     std::vector<GroupDelta>& deltas);
+
  private:
   struct SendTimeGroup {
     SendTimeGroup()
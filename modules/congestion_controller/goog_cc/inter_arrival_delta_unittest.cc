@@ -0,0 +1,100 @@
+/*
+ *  Copyright (c) 2024 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/congestion_controller/goog_cc/inter_arrival_delta.h"
+
+#include <algorithm>
+#include <vector>
+
+#include "api/transport/network_types.h"
+#include "api/units/data_size.h"
+#include "api/units/time_delta.h"
+#include "api/units/timestamp.h"
+#include "rtc_base/random.h"
+#include "test/gtest.h"
+
+namespace webrtc {
+namespace {
+
+constexpr TimeDelta kGroupLength = TimeDelta::Millis(5);
+
+std::vector<PacketResult> CreatePackets(int num_packets, Random& random) {
+  std::vector<PacketResult> packets(num_packets);
+  Timestamp send_time = Timestamp::Millis(10000);
+  Timestamp receive_time = Timestamp::Millis(20000);
+  for (PacketResult& packet : packets) {
+    send_time += TimeDelta::Micros(random.Rand(0, 3000));
+    receive_time += TimeDelta::Micros(random.Rand(0, 4000));
+    packet.sent_packet.send_time = send_time;
+    packet.sent_packet.size = DataSize::Bytes(random.Rand(100, 1200));
+    packet.receive_time = receive_time;
+  }
+  return packets;
+}
+
+TEST(InterArrivalDeltaTest, BatchMatchesPerPacketDeltas) {
+  Random random(1234);
+  std::vector<PacketResult> packets = CreatePackets(500, random);
+  const Timestamp system_time = Timestamp::Millis(30000);
+
+  InterArrivalDelta per_packet(kGroupLength);
+  std::vector<InterArrivalDelta::GroupDelta> expected;
+  for (const PacketResult& packet : packets) {
+    InterArrivalDelta::GroupDelta delta;
+    if (per_packet.ComputeDeltas(
+            packet.sent_packet.send_time, packet.receive_time, system_time,
+            packet.sent_packet.size.bytes(), &delta.send_time_delta,
+            &delta.arrival_time_delta, &delta.packet_size_delta)) {
+      delta.packet = &packet;
+      expected.push_back(delta);
+    }
+  }
+  ASSERT_GT(expected.size(), 10u);
+
+  // Feed the same packets in feedback-sized batches.
+  InterArrivalDelta batched(kGroupLength);
+  std::vector<InterArrivalDelta::GroupDelta> deltas;
+  rtc::ArrayView<const PacketResult> remaining(packets);
+  while (!remaining.empty()) {
+    size_t batch_size = std::min<size_t>(remaining.size(), 37);
+    batched.ComputeDeltas(remaining.subview(0, batch_size), system_time,
+                          deltas);
+    remaining = remaining.subview(batch_size);
+  }
+
+  ASSERT_EQ(deltas.size(), expected.size());
+  for (size_t i = 0; i < deltas.size(); ++i) {
+    EXPECT_EQ(deltas[i].send_time_delta, expected[i].send_time_delta);
+    EXPECT_EQ(deltas[i].arrival_time_delta, expected[i].arrival_time_delta);
+    EXPECT_EQ(deltas[i].packet_size_delta, expected[i].packet_size_delta);
+    EXPECT_EQ(deltas[i].packet, expected[i].packet);
+  }
+}
+
+TEST(InterArrivalDeltaTest, BatchAppendsToDeltas) {
+  Random random(42);
+  std::vector<PacketResult> packets = CreatePackets(100, random);
+  InterArrivalDelta inter_arrival(kGroupLength);
+  std::vector<InterArrivalDelta::GroupDelta> deltas;
+  inter_arrival.ComputeDeltas(rtc::ArrayView<const PacketResult>(packets)
+                                  .subview(0, 50),
+                              Timestamp::Millis(30000), deltas);
+  size_t first_batch_size = deltas.size();
+  ASSERT_GT(first_batch_size, 0u);
+  const PacketResult* first_packet = deltas[0].packet;
+  inter_arrival.ComputeDeltas(rtc::ArrayView<const PacketResult>(packets)
+                                  .subview(50),
+                              Timestamp::Millis(30000), deltas);
+  EXPECT_GT(deltas.size(), first_batch_size);
+  EXPECT_EQ(deltas[0].packet, first_packet);
+}
+
+}  // namespace
+}  // namespace webrtc
@@ -16,13 +16,14 @@
 #include <cstddef>
 #include <cstdint>
 #include <cstdio>
-#include <deque>
 #include <memory>
 #include <string>
 #include <utility>
+#include <vector>
 
 #include "absl/strings/match.h"
 #include "absl/types/optional.h"
+#include "api/array_view.h"
 #include "api/field_trials_view.h"
 #include "api/network_state_predictor.h"
 #include "api/transport/bandwidth_usage.h"
@@ -58,7 +59,7 @@ size_t ReadTrendlineFilterWindowSize(const FieldTrialsView* key_value_config) {
 }
 
 absl::optional<double> LinearFitSlope(
-    const std::deque<TrendlineEstimator::PacketTiming>& packets) {
+    rtc::ArrayView<const TrendlineEstimator::PacketTiming> packets) {
   RTC_DCHECK(packets.size() >= 2);
   // Compute the "center of mass".
   double sum_x = 0;
@@ -84,7 +85,7 @@ absl::optional<double> LinearFitSlope(
 }
 
 absl::optional<double> ComputeSlopeCap(
-    const std::deque<TrendlineEstimator::PacketTiming>& packets,
+    rtc::ArrayView<const TrendlineEstimator::PacketTiming> packets,
     const TrendlineEstimatorSettings& settings) {
   RTC_DCHECK(1 <= settings.beginning_packets &&
              settings.beginning_packets < packets.size());
@@ -176,6 +177,7 @@ TrendlineEstimator::TrendlineEstimator(
       accumulated_delay_(0),
       smoothed_delay_(0),
       delay_hist_(),
+      delay_hist_begin_(0),
       k_up_(0.0087),
       k_down_(0.039),
       overusing_time_threshold_(kOverUsingTimeThreshold),
@@ -188,6 +190,7 @@ TrendlineEstimator::TrendlineEstimator(
       hypothesis_(BandwidthUsage::kBwNormal),
       hypothesis_predicted_(BandwidthUsage::kBwNormal),
       network_state_predictor_(network_state_predictor) {
+  delay_hist_.reserve(2 * settings_.window_size + 1);
   RTC_LOG(LS_INFO)
       << "Using Trendline filter for delay change estimation with settings "
       << settings_.Parser()->Encode() << " and "
@@ -219,26 +222,33 @@ void TrendlineEstimator::UpdateTrendline(double recv_delta_ms,
       smoothed_delay_, accumulated_delay_);
   if (settings_.enable_sort) {
     for (size_t i = delay_hist_.size() - 1;
-         i > 0 &&
+         i > delay_hist_begin_ &&
          delay_hist_[i].arrival_time_ms < delay_hist_[i - 1].arrival_time_ms;
          --i) {
       std::swap(delay_hist_[i], delay_hist_[i - 1]);
     }
   }
-  if (delay_hist_.size() > settings_.window_size)
-    delay_hist_.pop_front();
+  if (delay_hist_.size() - delay_hist_begin_ > settings_.window_size) {
+    ++delay_hist_begin_;
+    if (delay_hist_begin_ == settings_.window_size) {
+      delay_hist_.erase(delay_hist_.begin(),
+                        delay_hist_.begin() + delay_hist_begin_);
+      delay_hist_begin_ = 0;
+    }
+  }
 
   // Simple linear regression.
   double trend = prev_trend_;
-  if (delay_hist_.size() == settings_.window_size) {
+  rtc::ArrayView<const PacketTiming> delay_hist = DelayHistory();
+  if (delay_hist.size() == settings_.window_size) {
     // Update trend_ if it is possible to fit a line to the data. The delay
     // trend can be seen as an estimate of (send_rate - capacity)/capacity.
     // 0 < trend < 1   ->  the delay increases, queues are filling up
     //   trend == 0    ->  the delay does not change
     //   trend < 0     ->  the delay decreases, queues are being emptied
-    trend = LinearFitSlope(delay_hist_).value_or(trend);
+    trend = LinearFitSlope(delay_hist).value_or(trend);
     if (settings_.enable_cap) {
-      absl::optional<double> cap = ComputeSlopeCap(delay_hist_, settings_);
+      absl::optional<double> cap = ComputeSlopeCap(delay_hist, settings_);
       // We only use the cap to filter out overuse detections, not
       // to detect additional underuses.
       if (trend >= 0 && cap.has_value() && trend > cap.value()) {
@@ -266,6 +276,12 @@ void TrendlineEstimator::Update(double recv_delta_ms,
   }
 }
 
+rtc::ArrayView<const TrendlineEstimator::PacketTiming>
+TrendlineEstimator::DelayHistory() const {
+  return rtc::ArrayView<const PacketTiming>(delay_hist_)
+      .subview(delay_hist_begin_);
+}
+
 BandwidthUsage TrendlineEstimator::State() const {
   return network_state_predictor_ ? hypothesis_predicted_ : hypothesis_;
 }
@@ -13,9 +13,10 @@
 #include <stddef.h>
 #include <stdint.h>
 
-#include <deque>
 #include <memory>
+#include <vector>
 
+#include "api/array_view.h"
 #include "api/field_trials_view.h"
 #include "api/network_state_predictor.h"
 #include "api/transport/bandwidth_usage.h"
@@ -93,6 +94,9 @@ class TrendlineEstimator : public DelayIncreaseDetectorInterface {
 
   void UpdateThreshold(double modified_offset, int64_t now_ms);
 
+  // The packets in the regression window, oldest first.
+  rtc::ArrayView<const PacketTiming> DelayHistory() const;
+
   // Parameters.
   TrendlineEstimatorSettings settings_;
   const double smoothing_coef_;
@@ -104,8 +108,11 @@ class TrendlineEstimator : public DelayIncreaseDetectorInterface {
   // Exponential backoff filtering.
   double accumulated_delay_;
   double smoothed_delay_;
-  // Linear least squares regression.
-  std::deque<PacketTiming> delay_hist_;
+  // Linear least squares regression. The window is kept contiguous, starting
+  // at `delay_hist_begin_`. Packets that have left the window are erased
+  // in bulk once there are as many of them as the window holds.
+  std::vector<PacketTiming> delay_hist_;
+  size_t delay_hist_begin_;
 
   const double k_up_;
   const double k_down_;
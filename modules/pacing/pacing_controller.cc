@@ -143,6 +143,21 @@ void PacingController::RemovePacketsForSsrc(uint32_t ssrc) {
   packet_queue_.RemovePacketsForSsrc(ssrc);
 }
 
+void PacingController::SetProfilingEnabled(bool enabled) {
+  if (!enabled) {
+    profiler_ = nullptr;
+  } else if (profiler_ == nullptr) {
+    profiler_ = std::make_unique<PacingProfiler>();
+  }
+}
+
+absl::optional<PacingProfiler::Profile> PacingController::GetProfile() const {
+  if (profiler_ == nullptr) {
+    return absl::nullopt;
+  }
+  return profiler_->GetProfile();
+}
+
 bool PacingController::IsProbing() const {
   return prober_.is_probing();
 }
@@ -391,6 +406,8 @@ void PacingController::ProcessPackets() {
   absl::Cleanup cleanup = [packet_sender = packet_sender_] {
     packet_sender->OnBatchComplete();
   };
+  PacingProfiler::ScopedSample process_packets_sample(
+      profiler_.get(), PacingProfiler::Stage::kProcessPackets);
   const Timestamp now = CurrentTime();
   Timestamp target_send_time = now;
 
@@ -399,12 +416,22 @@ void PacingController::ProcessPackets() {
     // We can not send padding unless a normal packet has first been sent. If
     // we do, timestamps get messed up.
     if (seen_first_packet_) {
-      std::vector<std::unique_ptr<RtpPacketToSend>> keepalive_packets =
-          packet_sender_->GeneratePadding(DataSize::Bytes(1));
+      std::vector<std::unique_ptr<RtpPacketToSend>> keepalive_packets;
+      {
+        PacingProfiler::ScopedSample sample(profiler_.get(),
+                                            PacingProfiler::Stage::kPadding);
+        keepalive_packets = packet_sender_->GeneratePadding(DataSize::Bytes(1));
+      }
       for (auto& packet : keepalive_packets) {
         keepalive_data_sent +=
             DataSize::Bytes(packet->payload_size() + packet->padding_size());
-        packet_sender_->SendPacket(std::move(packet), PacedPacketInfo());
+        {
+          PacingProfiler::ScopedSample sample(
+              profiler_.get(), PacingProfiler::Stage::kSendPacket);
+          packet_sender_->SendPacket(std::move(packet), PacedPacketInfo());
+        }
+        PacingProfiler::ScopedSample sample(profiler_.get(),
+                                            PacingProfiler::Stage::kFetchFec);
         for (auto& packet : packet_sender_->FetchFec()) {
           EnqueuePacket(std::move(packet));
         }
@@ -438,6 +465,8 @@ void PacingController::ProcessPackets() {
   DataSize recommended_probe_size = DataSize::Zero();
   bool is_probing = prober_.is_probing();
   if (is_probing) {
+    PacingProfiler::ScopedSample sample(profiler_.get(),
+                                        PacingProfiler::Stage::kProbe);
     // Probe timing is sensitive, and handled explicitly by BitrateProber, so
     // use actual send time rather than target.
     pacing_info = prober_.CurrentCluster(now).value_or(PacedPacketInfo());
@@ -457,8 +486,12 @@ void PacingController::ProcessPackets() {
   for (; iteration < circuit_breaker_threshold_; ++iteration) {
     // Fetch packet, so long as queue is not empty or budget is not
     // exhausted.
-    std::unique_ptr<RtpPacketToSend> rtp_packet =
-        GetPendingPacket(pacing_info, target_send_time, now);
+    std::unique_ptr<RtpPacketToSend> rtp_packet;
+    {
+      PacingProfiler::ScopedSample sample(profiler_.get(),
+                                          PacingProfiler::Stage::kQueuePop);
+      rtp_packet = GetPendingPacket(pacing_info, target_send_time, now);
+    }
     if (rtp_packet == nullptr) {
       // No packet available to send, check if we should send padding.
       if (now - target_send_time > kMaxPaddingReplayDuration) {
@@ -471,8 +504,12 @@ void PacingController::ProcessPackets() {
 
       DataSize padding_to_add = PaddingToAdd(recommended_probe_size, data_sent);
       if (padding_to_add > DataSize::Zero()) {
-        std::vector<std::unique_ptr<RtpPacketToSend>> padding_packets =
-            packet_sender_->GeneratePadding(padding_to_add);
+        std::vector<std::unique_ptr<RtpPacketToSend>> padding_packets;
+        {
+          PacingProfiler::ScopedSample sample(profiler_.get(),
+                                              PacingProfiler::Stage::kPadding);
+          padding_packets = packet_sender_->GeneratePadding(padding_to_add);
+        }
         if (!padding_packets.empty()) {
           padding_packets_generated += padding_packets.size();
           for (auto& packet : padding_packets) {
@@ -500,9 +537,17 @@ void PacingController::ProcessPackets() {
                        transport_overhead_per_packet_;
       }
 
-      packet_sender_->SendPacket(std::move(rtp_packet), pacing_info);
-      for (auto& packet : packet_sender_->FetchFec()) {
-        EnqueuePacket(std::move(packet));
+      {
+        PacingProfiler::ScopedSample sample(profiler_.get(),
+                                            PacingProfiler::Stage::kSendPacket);
+        packet_sender_->SendPacket(std::move(rtp_packet), pacing_info);
+      }
+      {
+        PacingProfiler::ScopedSample sample(profiler_.get(),
+                                            PacingProfiler::Stage::kFetchFec);
+        for (auto& packet : packet_sender_->FetchFec()) {
+          EnqueuePacket(std::move(packet));
+        }
       }
       data_sent += packet_size;
       ++packets_sent;
@@ -563,6 +608,8 @@ void PacingController::ProcessPackets() {
   }
 
   if (is_probing) {
+    PacingProfiler::ScopedSample sample(profiler_.get(),
+                                        PacingProfiler::Stage::kProbe);
     probing_send_failure_ = data_sent == DataSize::Zero();
     if (!probing_send_failure_) {
       prober_.ProbeSent(CurrentTime(), data_sent);
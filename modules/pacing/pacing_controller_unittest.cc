@@ -21,6 +21,7 @@
 #include "api/units/data_size.h"
 #include "api/units/time_delta.h"
 #include "api/units/timestamp.h"
+#include "modules/pacing/pacing_profiler.h"
 #include "system_wrappers/include/clock.h"
 #include "test/explicit_key_value_config.h"
 #include "test/gmock.h"
@@ -485,6 +486,32 @@ TEST_F(PacingControllerTest, FirstSentPacketTimeIsSet) {
   EXPECT_EQ(kStartTime, pacer->FirstSentPacketTime());
 }
 
+TEST_F(PacingControllerTest, ProfilesProcessPacketsWhenEnabled) {
+  auto pacer = std::make_unique<PacingController>(&clock_, &callback_, trials_);
+  pacer->SetPacingRates(kTargetRate * kPaceMultiplier, DataRate::Zero());
+  EXPECT_FALSE(pacer->GetProfile().has_value());
+
+  pacer->SetProfilingEnabled(true);
+  pacer->EnqueuePacket(video_.BuildNextPacket());
+  pacer->EnqueuePacket(video_.BuildNextPacket());
+  while (pacer->QueueSizePackets() > 0) {
+    AdvanceTimeUntil(pacer->NextSendTime());
+    pacer->ProcessPackets();
+  }
+
+  absl::optional<PacingProfiler::Profile> profile = pacer->GetProfile();
+  ASSERT_TRUE(profile.has_value());
+  using Stage = PacingProfiler::Stage;
+  EXPECT_GE((*profile)[Stage::kProcessPackets].count, 1);
+  EXPECT_EQ((*profile)[Stage::kSendPacket].count, 2);
+  EXPECT_EQ((*profile)[Stage::kFetchFec].count, 2);
+  EXPECT_GE((*profile)[Stage::kQueuePop].count, 2);
+  EXPECT_EQ((*profile)[Stage::kProbe].count, 0);
+
+  pacer->SetProfilingEnabled(false);
+  EXPECT_FALSE(pacer->GetProfile().has_value());
+}
+
 TEST_F(PacingControllerTest, QueueAndPacePacketsWithZeroBurstPeriod) {
   const uint32_t kSsrc = 12345;
   uint16_t sequence_number = 1234;
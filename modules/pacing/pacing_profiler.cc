@@ -0,0 +1,166 @@
+/*
+ *  Copyright (c) 2024 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/pacing/pacing_profiler.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+
+#include "absl/numeric/bits.h"
+#include "rtc_base/checks.h"
+
+namespace webrtc {
+namespace {
+
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+struct CalibrationStart {
+  uint64_t ticks;
+  int64_t time_ns;
+};
+
+// The tick counter and the monotonic clock, read when the first profiler of
+// the process was created.
+const CalibrationStart& GetCalibrationStart() {
+  static const CalibrationStart start = {PacingProfiler::Now(),
+                                         rtc::TimeNanos()};
+  return start;
+}
+
+// The calibrated frequency of the tick counter, or zero until the calibration
+// is done.
+std::atomic<int64_t> calibrated_ticks_per_second{0};
+#endif
+
+}  // namespace
+
+PacingProfiler::PacingProfiler() {
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+  // Starts the calibration, unless an earlier profiler has.
+  GetCalibrationStart();
+#endif
+}
+
+int64_t PacingProfiler::Histogram::Percentile(double percentile) const {
+  RTC_DCHECK_GE(percentile, 0);
+  RTC_DCHECK_LE(percentile, 100);
+  if (count == 0) {
+    return 0;
+  }
+  int64_t rank = std::max<int64_t>(
+      1, static_cast<int64_t>(std::ceil(count * percentile / 100)));
+  int64_t seen = 0;
+  for (size_t i = 0; i < kNumBuckets; ++i) {
+    seen += buckets[i];
+    if (seen >= rank) {
+      if (i == 0) {
+        return 0;
+      }
+      if (i == kNumBuckets - 1) {
+        return max_ticks;
+      }
+      return std::min((int64_t{1} << i) - 1, max_ticks);
+    }
+  }
+  return max_ticks;
+}
+
+TimeDelta PacingProfiler::Profile::ToTimeDelta(int64_t ticks) const {
+  RTC_DCHECK_GT(ticks_per_second, 0);
+  return TimeDelta::Seconds(static_cast<double>(ticks) / ticks_per_second);
+}
+
+absl::string_view PacingProfiler::StageName(Stage stage) {
+  switch (stage) {
+    case Stage::kProcessPackets:
+      return "ProcessPackets";
+    case Stage::kQueuePop:
+      return "QueuePop";
+    case Stage::kPadding:
+      return "Padding";
+    case Stage::kSendPacket:
+      return "SendPacket";
+    case Stage::kFetchFec:
+      return "FetchFec";
+    case Stage::kProbe:
+      return "Probe";
+  }
+  RTC_CHECK_NOTREACHED();
+}
+
+PacingProfiler::Profile PacingProfiler::GetProfile() const {
+  Profile profile = profile_;
+  profile.ticks_per_second = TicksPerSecond();
+  return profile;
+}
+
+int64_t PacingProfiler::EstimateTicksPerSecond(int64_t elapsed_ticks,
+                                               TimeDelta elapsed) {
+  if (elapsed < kCalibrationInterval) {
+    return 0;
+  }
+  return std::max<int64_t>(
+      static_cast<int64_t>(static_cast<double>(elapsed_ticks) *
+                           rtc::kNumNanosecsPerSec / elapsed.ns()),
+      1);
+}
+
+int64_t PacingProfiler::TicksPerSecond() {
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+  // The TSC runs at a constant rate on all CPUs of the last decade, but that
+  // rate can only be read from model specific registers, not from user space.
+  // It is instead compared to the monotonic clock, once enough time has passed
+  // for the estimate to be accurate, and then kept for the rest of the process.
+  int64_t ticks_per_second =
+      calibrated_ticks_per_second.load(std::memory_order_relaxed);
+  if (ticks_per_second != 0) {
+    return ticks_per_second;
+  }
+  const CalibrationStart& start = GetCalibrationStart();
+  ticks_per_second = EstimateTicksPerSecond(
+      static_cast<int64_t>(Now() - start.ticks),
+      TimeDelta::Micros((rtc::TimeNanos() - start.time_ns) /
+                        rtc::kNumNanosecsPerMicrosec));
+  if (ticks_per_second != 0) {
+    int64_t expected = 0;
+    // Another thread may have completed the calibration at the same time, in
+    // which case its estimate is kept.
+    if (!calibrated_ticks_per_second.compare_exchange_strong(
+            expected, ticks_per_second, std::memory_order_relaxed)) {
+      return expected;
+    }
+  }
+  return ticks_per_second;
+#elif defined(WEBRTC_ARCH_ARM_FAMILY) && defined(WEBRTC_ARCH_64_BITS) && \
+    !defined(_MSC_VER)
+  uint64_t frequency;
+  asm volatile("mrs %0, cntfrq_el0" : "=r"(frequency));
+  return static_cast<int64_t>(frequency);
+#else
+  return rtc::kNumNanosecsPerSec;
+#endif
+}
+
+void PacingProfiler::AddSample(Stage stage, uint64_t ticks) {
+  // A tick counter that isn't synchronized between cores could go backwards
+  // if the thread is migrated while sampling.
+  if (static_cast<int64_t>(ticks) < 0) {
+    ticks = 0;
+  }
+  Histogram& histogram = profile_[stage];
+  ++histogram.count;
+  histogram.total_ticks += ticks;
+  histogram.max_ticks =
+      std::max(histogram.max_ticks, static_cast<int64_t>(ticks));
+  size_t bucket = std::min<size_t>(absl::bit_width(ticks), kNumBuckets - 1);
+  ++histogram.buckets[bucket];
+}
+
+}  // namespace webrtc
@@ -0,0 +1,159 @@
+/*
+ *  Copyright (c) 2024 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef MODULES_PACING_PACING_PROFILER_H_
+#define MODULES_PACING_PACING_PROFILER_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <array>
+
+#include "absl/strings/string_view.h"
+#include "api/units/time_delta.h"
+#include "rtc_base/system/arch.h"
+#include "rtc_base/time_utils.h"
+
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+#if defined(_MSC_VER)
+#include <intrin.h>
+#else
+#include <x86intrin.h>
+#endif
+#endif
+
+namespace webrtc {
+
+// Collects the time spent in the stages of `PacingController::ProcessPackets()`
+// into histograms. Time is measured in ticks of the CPU's cycle counter where
+// one is available (the TSC on x86, the virtual counter on arm64), and in
+// nanoseconds elsewhere. `Profile::ticks_per_second` gives the frequency of the
+// counter, so that ticks can be converted to time. On x86 the frequency is
+// calibrated once per process, over at least `kCalibrationInterval` from the
+// creation of the first profiler, and is unknown until then.
+class PacingProfiler {
+ public:
+  enum class Stage {
+    // A call to `ProcessPackets()`, from start to end.
+    kProcessPackets,
+    // Fetching the next packet to send from the queue.
+    kQueuePop,
+    // Generating padding and keep-alive packets.
+    kPadding,
+    // `PacketSender::SendPacket()`.
+    kSendPacket,
+    // `PacketSender::FetchFec()`, and enqueueing the returned packets.
+    kFetchFec,
+    // Looking up the current probe cluster, and reporting sent probes.
+    kProbe,
+  };
+  static constexpr size_t kNumStages = 6;
+
+  // Bucket `i` holds the samples of [2^(i-1), 2^i) ticks, and bucket 0 those
+  // of zero ticks. The last bucket holds everything above.
+  static constexpr size_t kNumBuckets = 48;
+
+  // The minimum time over which the frequency of the tick counter is
+  // calibrated, where it can't be read from the hardware.
+  static constexpr TimeDelta kCalibrationInterval = TimeDelta::Millis(100);
+
+  struct Histogram {
+    // Returns an upper bound, in ticks, for the given percentile (0-100) of the
+    // samples, or zero if there are none.
+    int64_t Percentile(double percentile) const;
+
+    int64_t count = 0;
+    int64_t total_ticks = 0;
+    int64_t max_ticks = 0;
+    std::array<int64_t, kNumBuckets> buckets = {};
+  };
+
+  struct Profile {
+    const Histogram& operator[](Stage stage) const {
+      return stages[static_cast<size_t>(stage)];
+    }
+    Histogram& operator[](Stage stage) {
+      return stages[static_cast<size_t>(stage)];
+    }
+
+    // Converts a number of ticks, e.g. a percentile of one of the histograms,
+    // to time. Requires `ticks_per_second` to be known.
+    TimeDelta ToTimeDelta(int64_t ticks) const;
+
+    std::array<Histogram, kNumStages> stages;
+    // The frequency of the tick counter, or zero while it is being calibrated.
+    // The samples can then only be compared to each other, in ticks.
+    int64_t ticks_per_second = 0;
+  };
+
+  PacingProfiler();
+
+  // Measures the ticks spent in its scope and adds them to `profiler`. Does
+  // nothing if `profiler` is null, so that it can be left in place when
+  // profiling is disabled.
+  class ScopedSample {
+   public:
+    ScopedSample(PacingProfiler* profiler, Stage stage)
+        : profiler_(profiler),
+          stage_(stage),
+          start_(profiler != nullptr ? Now() : 0) {}
+    ScopedSample(const ScopedSample&) = delete;
+    ScopedSample& operator=(const ScopedSample&) = delete;
+    ~ScopedSample() {
+      if (profiler_ != nullptr) {
+        profiler_->AddSample(stage_, Now() - start_);
+      }
+    }
+
+   private:
+    PacingProfiler* const profiler_;
+    const Stage stage_;
+    const uint64_t start_;
+  };
+
+  // Returns the current value of the tick counter.
+  static uint64_t Now() {
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+    return __rdtsc();
+#elif defined(WEBRTC_ARCH_ARM_FAMILY) && defined(WEBRTC_ARCH_64_BITS) && \
+    !defined(_MSC_VER)
+    uint64_t ticks;
+    asm volatile("mrs %0, cntvct_el0" : "=r"(ticks));
+    return ticks;
+#else
+    return static_cast<uint64_t>(rtc::TimeNanos());
+#endif
+  }
+
+  static absl::string_view StageName(Stage stage);
+
+  // Returns the frequency of a tick counter that advanced `elapsed_ticks`
+  // during `elapsed`, or zero if `elapsed` is too short for an accurate
+  // estimate.
+  static int64_t EstimateTicksPerSecond(int64_t elapsed_ticks,
+                                        TimeDelta elapsed);
+
+  void AddSample(Stage stage, uint64_t ticks);
+
+  // Returns the samples added since construction or the last `Reset()`.
+  Profile GetProfile() const;
+  void Reset() { profile_ = Profile(); }
+
+ private:
+  // Returns the frequency of the tick counter, or zero if it hasn't been
+  // calibrated yet.
+  static int64_t TicksPerSecond();
+
+  Profile profile_;
+};
+
+}  // namespace webrtc
+
+#endif  // MODULES_PACING_PACING_PROFILER_H_
@@ -0,0 +1,151 @@
+/*
+ *  Copyright (c) 2024 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/pacing/pacing_profiler.h"
+
+#include "api/units/time_delta.h"
+#include "system_wrappers/include/sleep.h"
+#include "test/gtest.h"
+
+namespace webrtc {
+namespace {
+
+using Stage = PacingProfiler::Stage;
+
+TEST(PacingProfilerTest, StartsEmpty) {
+  PacingProfiler profiler;
+  PacingProfiler::Profile profile = profiler.GetProfile();
+  for (const PacingProfiler::Histogram& histogram : profile.stages) {
+    EXPECT_EQ(histogram.count, 0);
+    EXPECT_EQ(histogram.Percentile(50), 0);
+  }
+}
+
+TEST(PacingProfilerTest, AddsSamplesToTheirStage) {
+  PacingProfiler profiler;
+  profiler.AddSample(Stage::kSendPacket, 100);
+  profiler.AddSample(Stage::kSendPacket, 300);
+  profiler.AddSample(Stage::kQueuePop, 7);
+
+  PacingProfiler::Profile profile = profiler.GetProfile();
+  const PacingProfiler::Histogram& send = profile[Stage::kSendPacket];
+  EXPECT_EQ(send.count, 2);
+  EXPECT_EQ(send.total_ticks, 400);
+  EXPECT_EQ(send.max_ticks, 300);
+  EXPECT_EQ(profile[Stage::kQueuePop].count, 1);
+  EXPECT_EQ(profile[Stage::kPadding].count, 0);
+}
+
+TEST(PacingProfilerTest, BucketsArePowersOfTwo) {
+  PacingProfiler profiler;
+  profiler.AddSample(Stage::kProbe, 0);
+  profiler.AddSample(Stage::kProbe, 1);
+  profiler.AddSample(Stage::kProbe, 2);
+  profiler.AddSample(Stage::kProbe, 3);
+  profiler.AddSample(Stage::kProbe, 1000);
+
+  PacingProfiler::Profile profile = profiler.GetProfile();
+  const PacingProfiler::Histogram& probe = profile[Stage::kProbe];
+  EXPECT_EQ(probe.buckets[0], 1);
+  EXPECT_EQ(probe.buckets[1], 1);
+  EXPECT_EQ(probe.buckets[2], 2);
+  // 512 <= 1000 < 1024.
+  EXPECT_EQ(probe.buckets[10], 1);
+}
+
+TEST(PacingProfilerTest, PercentileReturnsUpperBoundOfBucket) {
+  PacingProfiler profiler;
+  for (int i = 0; i < 90; ++i) {
+    profiler.AddSample(Stage::kFetchFec, 100);
+  }
+  for (int i = 0; i < 10; ++i) {
+    profiler.AddSample(Stage::kFetchFec, 5000);
+  }
+
+  PacingProfiler::Profile profile = profiler.GetProfile();
+  const PacingProfiler::Histogram& fec = profile[Stage::kFetchFec];
+  EXPECT_EQ(fec.Percentile(50), 127);
+  EXPECT_EQ(fec.Percentile(90), 127);
+  // Never above the largest sample.
+  EXPECT_EQ(fec.Percentile(91), 5000);
+  EXPECT_EQ(fec.Percentile(100), 5000);
+}
+
+TEST(PacingProfilerTest, ClampsNegativeDurationsToZero) {
+  PacingProfiler profiler;
+  profiler.AddSample(Stage::kPadding, static_cast<uint64_t>(-5));
+
+  PacingProfiler::Profile profile = profiler.GetProfile();
+  const PacingProfiler::Histogram& padding = profile[Stage::kPadding];
+  EXPECT_EQ(padding.count, 1);
+  EXPECT_EQ(padding.total_ticks, 0);
+  EXPECT_EQ(padding.buckets[0], 1);
+}
+
+TEST(PacingProfilerTest, ScopedSampleDoesNothingWithoutProfiler) {
+  PacingProfiler::ScopedSample sample(nullptr, Stage::kSendPacket);
+}
+
+TEST(PacingProfilerTest, ScopedSampleAddsOneSample) {
+  PacingProfiler profiler;
+  { PacingProfiler::ScopedSample sample(&profiler, Stage::kProcessPackets); }
+  EXPECT_EQ(profiler.GetProfile()[Stage::kProcessPackets].count, 1);
+
+  profiler.Reset();
+  EXPECT_EQ(profiler.GetProfile()[Stage::kProcessPackets].count, 0);
+}
+
+TEST(PacingProfilerTest, ConvertsTicksToTime) {
+  PacingProfiler::Profile profile;
+  profile.ticks_per_second = 2'000'000'000;
+  EXPECT_EQ(profile.ToTimeDelta(0), TimeDelta::Zero());
+  EXPECT_EQ(profile.ToTimeDelta(3'000'000), TimeDelta::Micros(1'500));
+}
+
+TEST(PacingProfilerTest, EstimatesFrequencyOnlyOverCalibrationInterval) {
+  EXPECT_EQ(PacingProfiler::EstimateTicksPerSecond(1'000'000,
+                                                   TimeDelta::Millis(1)),
+            0);
+  EXPECT_EQ(PacingProfiler::EstimateTicksPerSecond(
+                99'000'000, PacingProfiler::kCalibrationInterval -
+                                TimeDelta::Millis(1)),
+            0);
+  EXPECT_EQ(PacingProfiler::EstimateTicksPerSecond(
+                300'000'000, PacingProfiler::kCalibrationInterval),
+            3'000'000'000);
+  EXPECT_EQ(PacingProfiler::EstimateTicksPerSecond(6'000'000'000,
+                                                   TimeDelta::Seconds(2)),
+            3'000'000'000);
+}
+
+TEST(PacingProfilerTest, ReportsFrequencyOfTickCounterOnceCalibrated) {
+  PacingProfiler profiler;
+  const uint64_t start = PacingProfiler::Now();
+  SleepMs(20);
+  const uint64_t end = PacingProfiler::Now();
+
+  // The frequency may need to be calibrated first.
+  PacingProfiler::Profile profile = profiler.GetProfile();
+  for (int i = 0; profile.ticks_per_second == 0 && i < 100; ++i) {
+    SleepMs(10);
+    profile = profiler.GetProfile();
+  }
+  EXPECT_GT(profile.ticks_per_second, 0);
+  TimeDelta slept = profile.ToTimeDelta(static_cast<int64_t>(end - start));
+  EXPECT_GE(slept, TimeDelta::Millis(15));
+  EXPECT_LT(slept, TimeDelta::Seconds(5));
+
+  // The calibration is done once, and applies to later profilers too.
+  EXPECT_EQ(PacingProfiler().GetProfile().ticks_per_second,
+            profile.ticks_per_second);
+}
+
+}  // namespace
+}  // namespace webrtc
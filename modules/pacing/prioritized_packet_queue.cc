@@ -13,6 +13,7 @@
 #include <algorithm>
 #include <array>
 #include <utility>
+#include <vector>
 
 #include "absl/container/inlined_vector.h"
 #include "absl/types/optional.h"
@@ -78,9 +79,45 @@ DataSize PrioritizedPacketQueue::QueuedPacket::PacketSize() const {
   return DataSize::Bytes(packet->payload_size() + packet->padding_size());
 }
 
+const PrioritizedPacketQueue::QueuedPacket&
+PrioritizedPacketQueue::PacketFifo::front() const {
+  RTC_DCHECK_GT(size_, 0);
+  return slots_[head_];
+}
+
+void PrioritizedPacketQueue::PacketFifo::push_back(QueuedPacket packet) {
+  if (size_ == slots_.size()) {
+    // Grow, and move the packets to the start of the new slots so that they
+    // don't wrap around.
+    std::vector<QueuedPacket> slots(std::max<size_t>(4, 2 * slots_.size()));
+    for (size_t i = 0; i < size_; ++i) {
+      slots[i] = std::move(slots_[(head_ + i) & (slots_.size() - 1)]);
+    }
+    slots_.swap(slots);
+    head_ = 0;
+  }
+  slots_[(head_ + size_) & (slots_.size() - 1)] = std::move(packet);
+  ++size_;
+}
+
+PrioritizedPacketQueue::QueuedPacket
+PrioritizedPacketQueue::PacketFifo::pop_front() {
+  RTC_DCHECK_GT(size_, 0);
+  QueuedPacket packet = std::move(slots_[head_]);
+  head_ = (head_ + 1) & (slots_.size() - 1);
+  --size_;
+  return packet;
+}
+
 PrioritizedPacketQueue::StreamQueue::StreamQueue(Timestamp creation_time)
     : last_enqueue_time_(creation_time), num_keyframe_packets_(0) {}
 
+void PrioritizedPacketQueue::StreamQueue::Reset(Timestamp creation_time) {
+  RTC_DCHECK(IsEmpty());
+  last_enqueue_time_ = creation_time;
+  num_keyframe_packets_ = 0;
+}
+
 bool PrioritizedPacketQueue::StreamQueue::EnqueuePacket(QueuedPacket packet,
                                                         int priority_level) {
   if (packet.packet->is_key_frame()) {
@@ -94,8 +131,7 @@ bool PrioritizedPacketQueue::StreamQueue::EnqueuePacket(QueuedPacket packet,
 PrioritizedPacketQueue::QueuedPacket
 PrioritizedPacketQueue::StreamQueue::DequeuePacket(int priority_level) {
   RTC_DCHECK(!packets_[priority_level].empty());
-  QueuedPacket packet = std::move(packets_[priority_level].front());
-  packets_[priority_level].pop_front();
+  QueuedPacket packet = packets_[priority_level].pop_front();
   if (packet.packet->is_key_frame()) {
     RTC_DCHECK_GT(num_keyframe_packets_, 0);
     --num_keyframe_packets_;
@@ -109,7 +145,7 @@ bool PrioritizedPacketQueue::StreamQueue::HasPacketsAtPrio(
 }
 
 bool PrioritizedPacketQueue::StreamQueue::IsEmpty() const {
-  for (const std::deque<QueuedPacket>& queue : packets_) {
+  for (const PacketFifo& queue : packets_) {
     if (!queue.empty()) {
       return false;
     }
@@ -120,24 +156,13 @@ bool PrioritizedPacketQueue::StreamQueue::IsEmpty() const {
 Timestamp PrioritizedPacketQueue::StreamQueue::LeadingPacketEnqueueTime(
     int priority_level) const {
   RTC_DCHECK(!packets_[priority_level].empty());
-  return packets_[priority_level].begin()->enqueue_time;
+  return packets_[priority_level].front().enqueue_time;
 }
 
 Timestamp PrioritizedPacketQueue::StreamQueue::LastEnqueueTime() const {
   return last_enqueue_time_;
 }
 
-std::array<std::deque<PrioritizedPacketQueue::QueuedPacket>,
-           PrioritizedPacketQueue::kNumPriorityLevels>
-PrioritizedPacketQueue::StreamQueue::DequeueAll() {
-  std::array<std::deque<QueuedPacket>, kNumPriorityLevels> packets_by_prio;
-  for (int i = 0; i < kNumPriorityLevels; ++i) {
-    packets_by_prio[i].swap(packets_[i]);
-  }
-  num_keyframe_packets_ = 0;
-  return packets_by_prio;
-}
-
 PrioritizedPacketQueue::PrioritizedPacketQueue(
     Timestamp creation_time,
     bool prioritize_audio_retransmission,
@@ -152,16 +177,65 @@ PrioritizedPacketQueue::PrioritizedPacketQueue(
       last_update_time_(creation_time),
       paused_(false),
       last_culling_time_(creation_time),
+      earliest_expiry_per_prio_(kNumPriorityLevels, Timestamp::PlusInfinity()),
       top_active_prio_level_(-1) {}
 
+PrioritizedPacketQueue::StreamQueue*
+PrioritizedPacketQueue::AllocateStreamQueue(Timestamp creation_time) {
+  if (free_stream_queues_.empty()) {
+    stream_pool_.push_back(std::make_unique<StreamQueue>(creation_time));
+    return stream_pool_.back().get();
+  }
+  StreamQueue* stream_queue = free_stream_queues_.back();
+  free_stream_queues_.pop_back();
+  stream_queue->Reset(creation_time);
+  return stream_queue;
+}
+
+void PrioritizedPacketQueue::LinkStreamQueue(StreamQueue* stream_queue,
+                                             int prio_level) {
+  StreamQueue*& head = streams_by_prio_[prio_level];
+  if (head == nullptr) {
+    stream_queue->next[prio_level] = stream_queue;
+    stream_queue->prev[prio_level] = stream_queue;
+    head = stream_queue;
+  } else {
+    StreamQueue* tail = head->prev[prio_level];
+    stream_queue->next[prio_level] = head;
+    stream_queue->prev[prio_level] = tail;
+    tail->next[prio_level] = stream_queue;
+    head->prev[prio_level] = stream_queue;
+  }
+  ++num_streams_by_prio_[prio_level];
+}
+
+void PrioritizedPacketQueue::UnlinkStreamQueue(StreamQueue* stream_queue,
+                                               int prio_level) {
+  RTC_DCHECK_GT(num_streams_by_prio_[prio_level], 0);
+  StreamQueue*& head = streams_by_prio_[prio_level];
+  if (--num_streams_by_prio_[prio_level] == 0) {
+    RTC_DCHECK_EQ(head, stream_queue);
+    head = nullptr;
+  } else {
+    StreamQueue* next = stream_queue->next[prio_level];
+    StreamQueue* prev = stream_queue->prev[prio_level];
+    next->prev[prio_level] = prev;
+    prev->next[prio_level] = next;
+    if (head == stream_queue) {
+      head = next;
+    }
+  }
+  stream_queue->next[prio_level] = nullptr;
+  stream_queue->prev[prio_level] = nullptr;
+}
+
 void PrioritizedPacketQueue::Push(Timestamp enqueue_time,
                                   std::unique_ptr<RtpPacketToSend> packet) {
-  StreamQueue* stream_queue;
   auto [it, inserted] = streams_.emplace(packet->Ssrc(), nullptr);
   if (inserted) {
-    it->second = std::make_unique<StreamQueue>(enqueue_time);
+    it->second = AllocateStreamQueue(enqueue_time);
   }
-  stream_queue = it->second.get();
+  StreamQueue* stream_queue = it->second;
 
   auto enqueue_time_iterator =
       enqueue_times_.insert(enqueue_times_.end(), enqueue_time);
@@ -188,10 +262,15 @@ void PrioritizedPacketQueue::Push(Timestamp enqueue_time,
   ++size_packets_;
   ++size_packets_per_media_type_[static_cast<size_t>(packet_type)];
   size_payload_ += queued_packed.PacketSize();
+  // Packets are pushed in time order, so this can only lower the bound when
+  // there were no packets at `prio_level`.
+  earliest_expiry_per_prio_[prio_level] =
+      std::min(earliest_expiry_per_prio_[prio_level],
+               queued_packed.enqueue_time + time_to_live_per_prio_[prio_level]);
 
   if (stream_queue->EnqueuePacket(std::move(queued_packed), prio_level)) {
     // Number packets at `prio_level` for this steam is now non-zero.
-    streams_by_prio_[prio_level].push_back(stream_queue);
+    LinkStreamQueue(stream_queue, prio_level);
   }
   if (top_active_prio_level_ < 0 || prio_level < top_active_prio_level_) {
     top_active_prio_level_ = prio_level;
@@ -202,6 +281,7 @@ void PrioritizedPacketQueue::Push(Timestamp enqueue_time,
     for (auto it = streams_.begin(); it != streams_.end();) {
       if (it->second->IsEmpty() &&
           it->second->LastEnqueueTime() + kTimeout < enqueue_time) {
+        free_stream_queues_.push_back(it->second);
         streams_.erase(it++);
       } else {
         ++it;
@@ -217,16 +297,17 @@ std::unique_ptr<RtpPacketToSend> PrioritizedPacketQueue::Pop() {
   }
 
   RTC_DCHECK_GE(top_active_prio_level_, 0);
-  StreamQueue& stream_queue = *streams_by_prio_[top_active_prio_level_].front();
+  StreamQueue& stream_queue = *streams_by_prio_[top_active_prio_level_];
   QueuedPacket packet = stream_queue.DequeuePacket(top_active_prio_level_);
   DequeuePacketInternal(packet);
 
-  // Remove StreamQueue from head of fifo-queue for this prio level, and
-  // and add it to the end if it still has packets.
-  streams_by_prio_[top_active_prio_level_].pop_front();
+  // Move the StreamQueue from the head of the round-robin list for this prio
+  // level to the end if it still has packets, or remove it otherwise.
   if (stream_queue.HasPacketsAtPrio(top_active_prio_level_)) {
-    streams_by_prio_[top_active_prio_level_].push_back(&stream_queue);
+    streams_by_prio_[top_active_prio_level_] =
+        stream_queue.next[top_active_prio_level_];
   } else {
+    UnlinkStreamQueue(&stream_queue, top_active_prio_level_);
     MaybeUpdateTopPrioLevel();
   }
 
@@ -254,10 +335,10 @@ Timestamp PrioritizedPacketQueue::LeadingPacketEnqueueTime(
     RtpPacketMediaType type) const {
   RTC_DCHECK(type != RtpPacketMediaType::kRetransmission);
   const int priority_level = GetPriorityForType(type, absl::nullopt);
-  if (streams_by_prio_[priority_level].empty()) {
+  if (streams_by_prio_[priority_level] == nullptr) {
     return Timestamp::MinusInfinity();
   }
-  return streams_by_prio_[priority_level].front()->LeadingPacketEnqueueTime(
+  return streams_by_prio_[priority_level]->LeadingPacketEnqueueTime(
       priority_level);
 }
 
@@ -266,10 +347,10 @@ Timestamp PrioritizedPacketQueue::LeadingPacketEnqueueTimeForRetransmission()
   if (!prioritize_audio_retransmission_) {
     const int priority_level =
         GetPriorityForType(RtpPacketMediaType::kRetransmission, absl::nullopt);
-    if (streams_by_prio_[priority_level].empty()) {
+    if (streams_by_prio_[priority_level] == nullptr) {
       return Timestamp::PlusInfinity();
     }
-    return streams_by_prio_[priority_level].front()->LeadingPacketEnqueueTime(
+    return streams_by_prio_[priority_level]->LeadingPacketEnqueueTime(
         priority_level);
   }
   const int audio_priority_level =
@@ -280,17 +361,15 @@ Timestamp PrioritizedPacketQueue::LeadingPacketEnqueueTimeForRetransmission()
                          RtpPacketToSend::OriginalType::kVideo);
 
   Timestamp next_audio =
-      streams_by_prio_[audio_priority_level].empty()
+      streams_by_prio_[audio_priority_level] == nullptr
           ? Timestamp::PlusInfinity()
-          : streams_by_prio_[audio_priority_level]
-                .front()
-                ->LeadingPacketEnqueueTime(audio_priority_level);
+          : streams_by_prio_[audio_priority_level]->LeadingPacketEnqueueTime(
+                audio_priority_level);
   Timestamp next_video =
-      streams_by_prio_[video_priority_level].empty()
+      streams_by_prio_[video_priority_level] == nullptr
           ? Timestamp::PlusInfinity()
-          : streams_by_prio_[video_priority_level]
-                .front()
-                ->LeadingPacketEnqueueTime(video_priority_level);
+          : streams_by_prio_[video_priority_level]->LeadingPacketEnqueueTime(
+                video_priority_level);
   return std::min(next_audio, next_video);
 }
 
@@ -333,39 +412,21 @@ void PrioritizedPacketQueue::RemovePacketsForSsrc(uint32_t ssrc) {
   if (kv != streams_.end()) {
     // Dequeue all packets from the queue for this SSRC.
     StreamQueue& queue = *kv->second;
-    std::array<std::deque<QueuedPacket>, kNumPriorityLevels> packets_by_prio =
-        queue.DequeueAll();
     for (int i = 0; i < kNumPriorityLevels; ++i) {
-      std::deque<QueuedPacket>& packet_queue = packets_by_prio[i];
-      if (packet_queue.empty()) {
+      if (!queue.HasPacketsAtPrio(i)) {
         continue;
       }
 
       // First erase all packets at this prio level.
-      while (!packet_queue.empty()) {
-        QueuedPacket packet = std::move(packet_queue.front());
-        packet_queue.pop_front();
+      while (queue.HasPacketsAtPrio(i)) {
+        QueuedPacket packet = queue.DequeuePacket(i);
         DequeuePacketInternal(packet);
       }
 
       // Next, deregister this `StreamQueue` from the round-robin tables.
-      RTC_DCHECK(!streams_by_prio_[i].empty());
-      if (streams_by_prio_[i].size() == 1) {
-        // This is the last and only queue that had packets for this prio level.
-        // Update the global top prio level if neccessary.
-        RTC_DCHECK(streams_by_prio_[i].front() == &queue);
-        streams_by_prio_[i].pop_front();
-      } else {
-        // More than stream had packets at this prio level, filter this one out.
-        std::deque<StreamQueue*> filtered_queue;
-        for (StreamQueue* queue_ptr : streams_by_prio_[i]) {
-          if (queue_ptr != &queue) {
-            filtered_queue.push_back(queue_ptr);
-          }
-        }
-        streams_by_prio_[i].swap(filtered_queue);
-      }
+      UnlinkStreamQueue(&queue, i);
     }
+    RTC_DCHECK(!queue.has_keyframe_packets());
   }
   MaybeUpdateTopPrioLevel();
 }
@@ -411,14 +472,14 @@ void PrioritizedPacketQueue::DequeuePacketInternal(QueuedPacket& packet) {
 
 void PrioritizedPacketQueue::MaybeUpdateTopPrioLevel() {
   if (top_active_prio_level_ != -1 &&
-      !streams_by_prio_[top_active_prio_level_].empty()) {
+      streams_by_prio_[top_active_prio_level_] != nullptr) {
     return;
   }
   // No stream queues have packets at top_active_prio_level_, find top priority
   // that is not empty.
   for (int i = 0; i < kNumPriorityLevels; ++i) {
     PurgeOldPacketsAtPriorityLevel(i, last_update_time_);
-    if (!streams_by_prio_[i].empty()) {
+    if (streams_by_prio_[i] != nullptr) {
       top_active_prio_level_ = i;
       break;
     }
@@ -438,10 +499,16 @@ void PrioritizedPacketQueue::PurgeOldPacketsAtPriorityLevel(int prio_level,
     return;
   }
 
-  std::deque<StreamQueue*>& queues = streams_by_prio_[prio_level];
-  auto iter = queues.begin();
-  while (iter != queues.end()) {
-    StreamQueue* queue_ptr = *iter;
+  if (now <= earliest_expiry_per_prio_[prio_level]) {
+    // No packet at this level can have expired yet.
+    return;
+  }
+
+  Timestamp earliest_expiry = Timestamp::PlusInfinity();
+  StreamQueue* queue_ptr = streams_by_prio_[prio_level];
+  for (int num_streams = num_streams_by_prio_[prio_level]; num_streams > 0;
+       --num_streams) {
+    StreamQueue* next = queue_ptr->next[prio_level];
     while (queue_ptr->HasPacketsAtPrio(prio_level) &&
            (now - queue_ptr->LeadingPacketEnqueueTime(prio_level)) >
                time_to_live) {
@@ -454,11 +521,15 @@ void PrioritizedPacketQueue::PurgeOldPacketsAtPriorityLevel(int prio_level,
       DequeuePacketInternal(packet);
     }
     if (!queue_ptr->HasPacketsAtPrio(prio_level)) {
-      iter = queues.erase(iter);
+      UnlinkStreamQueue(queue_ptr, prio_level);
     } else {
-      ++iter;
+      earliest_expiry = std::min(
+          earliest_expiry,
+          queue_ptr->LeadingPacketEnqueueTime(prio_level) + time_to_live);
     }
+    queue_ptr = next;
   }
+  earliest_expiry_per_prio_[prio_level] = earliest_expiry;
 }
 
 }  // namespace webrtc
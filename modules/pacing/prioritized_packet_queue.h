@@ -14,10 +14,10 @@
 #include <stddef.h>
 
 #include <array>
-#include <deque>
 #include <list>
 #include <memory>
 #include <unordered_map>
+#include <vector>
 
 #include "absl/container/inlined_vector.h"
 #include "api/units/data_size.h"
@@ -108,21 +108,43 @@ class PrioritizedPacketQueue {
     DataSize PacketSize() const;
 
     std::unique_ptr<RtpPacketToSend> packet;
-    Timestamp enqueue_time;
+    Timestamp enqueue_time = Timestamp::MinusInfinity();
     std::list<Timestamp>::iterator enqueue_time_iterator;
   };
 
+  // FIFO queue of packets, stored in a ring buffer that only grows. Unlike a
+  // `std::deque`, it doesn't allocate or free any memory once it has reached
+  // its working size.
+  class PacketFifo {
+   public:
+    bool empty() const { return size_ == 0; }
+    size_t size() const { return size_; }
+    const QueuedPacket& front() const;
+    void push_back(QueuedPacket packet);
+    QueuedPacket pop_front();
+
+   private:
+    // Size is always zero or a power of two.
+    std::vector<QueuedPacket> slots_;
+    size_t head_ = 0;
+    size_t size_ = 0;
+  };
+
   // Class containing packets for an RTP stream.
   // For each priority level, packets are simply stored in a fifo queue.
+  // StreamQueues are owned by `stream_pool_`, are reused when their stream
+  // is removed, and are linked into the round-robin lists of
+  // `streams_by_prio_` while they have packets at the priority level.
   class StreamQueue {
    public:
     explicit StreamQueue(Timestamp creation_time);
-    StreamQueue(StreamQueue&&) = default;
-    StreamQueue& operator=(StreamQueue&&) = default;
 
     StreamQueue(const StreamQueue&) = delete;
     StreamQueue& operator=(const StreamQueue&) = delete;
 
+    // Prepares a stream queue taken from the pool for a new stream.
+    void Reset(Timestamp creation_time);
+
     // Enqueue packet at the given priority level. Returns true if the packet
     // count for that priority level went from zero to non-zero.
     bool EnqueuePacket(QueuedPacket packet, int priority_level);
@@ -135,14 +157,27 @@ class PrioritizedPacketQueue {
     Timestamp LastEnqueueTime() const;
     bool has_keyframe_packets() const { return num_keyframe_packets_ > 0; }
 
-    std::array<std::deque<QueuedPacket>, kNumPriorityLevels> DequeueAll();
+    // Links of the circular, doubly linked, round-robin list of stream queues
+    // that have packets at each priority level. Only valid while the stream
+    // queue has packets at that level.
+    std::array<StreamQueue*, kNumPriorityLevels> next = {};
+    std::array<StreamQueue*, kNumPriorityLevels> prev = {};
 
    private:
-    std::deque<QueuedPacket> packets_[kNumPriorityLevels];
+    PacketFifo packets_[kNumPriorityLevels];
     Timestamp last_enqueue_time_;
     int num_keyframe_packets_;
   };
 
+  // Returns a stream queue from `stream_pool_`, allocating a new one if no
+  // unused one is available.
+  StreamQueue* AllocateStreamQueue(Timestamp creation_time);
+
+  // Adds `stream_queue` last in the round-robin list of `prio_level`.
+  void LinkStreamQueue(StreamQueue* stream_queue, int prio_level);
+  // Removes `stream_queue` from the round-robin list of `prio_level`.
+  void UnlinkStreamQueue(StreamQueue* stream_queue, int prio_level);
+
   // Remove the packet from the internal state, e.g. queue time / size etc.
   void DequeuePacketInternal(QueuedPacket& packet);
 
@@ -176,14 +211,28 @@ class PrioritizedPacketQueue {
   // Last time `streams_` was culled for inactive streams.
   Timestamp last_culling_time_;
 
-  // Map from SSRC to packet queues for the associated RTP stream.
-  std::unordered_map<uint32_t, std::unique_ptr<StreamQueue>> streams_;
+  // All stream queues ever allocated, in use or not. Unused ones are listed in
+  // `free_stream_queues_`.
+  std::vector<std::unique_ptr<StreamQueue>> stream_pool_;
+  std::vector<StreamQueue*> free_stream_queues_;
 
-  // For each priority level, a queue of StreamQueues which have at least one
-  // packet pending for that prio level.
-  std::deque<StreamQueue*> streams_by_prio_[kNumPriorityLevels];
-
-  // The first index into `stream_by_prio_` that is non-empty.
+  // Map from SSRC to packet queues for the associated RTP stream.
+  std::unordered_map<uint32_t, StreamQueue*> streams_;
+
+  // For each priority level, the head of a circular round-robin list of the
+  // StreamQueues which have at least one packet pending for that prio level,
+  // or null if there are none.
+  std::array<StreamQueue*, kNumPriorityLevels> streams_by_prio_ = {};
+  // Number of stream queues in each of the lists of `streams_by_prio_`.
+  std::array<int, kNumPriorityLevels> num_streams_by_prio_ = {};
+
+  // For each priority level, a lower bound on when the leading packet of any
+  // stream queue expires, so that it isn't necessary to visit every stream to
+  // look for expired packets. Plus infinity if there are no packets at the
+  // level, or the level has no time to live.
+  absl::InlinedVector<Timestamp, kNumPriorityLevels> earliest_expiry_per_prio_;
+
+  // The first index into `streams_by_prio_` that is non-empty.
   int top_active_prio_level_;
 
   // Ordered list of enqueue times. Additions are always increasing and added to
@@ -0,0 +1,105 @@
+/*
+ *  Copyright (c) 2024 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <stdint.h>
+
+#include <memory>
+#include <utility>
+
+#include "api/units/time_delta.h"
+#include "api/units/timestamp.h"
+#include "benchmark/benchmark.h"
+#include "modules/pacing/prioritized_packet_queue.h"
+#include "modules/rtp_rtcp/include/rtp_rtcp_defines.h"
+#include "modules/rtp_rtcp/source/rtp_packet_to_send.h"
+
+namespace webrtc {
+namespace {
+
+constexpr int kPacketsPerStream = 4;
+constexpr uint32_t kFirstSsrc = 1000;
+
+std::unique_ptr<RtpPacketToSend> CreatePacket(RtpPacketMediaType type,
+                                              uint32_t ssrc,
+                                              uint16_t seq) {
+  auto packet = std::make_unique<RtpPacketToSend>(/*extensions=*/nullptr);
+  packet->set_packet_type(type);
+  packet->SetSsrc(ssrc);
+  packet->SetSequenceNumber(seq);
+  packet->SetPayloadSize(1000);
+  return packet;
+}
+
+// Keeps `kPacketsPerStream` video packets queued on each of `state.range(0)`
+// streams, and measures popping a packet and pushing it back. If
+// `state.range(1)` is non-zero, the video packets have a time to live, so
+// that every push checks for expired packets.
+void BM_PrioritizedPacketQueuePushPop(benchmark::State& state) {
+  const int num_streams = state.range(0);
+  PacketQueueTTL ttl;
+  if (state.range(1) != 0) {
+    ttl.video = TimeDelta::Seconds(10);
+  }
+  Timestamp now = Timestamp::Seconds(1);
+  PrioritizedPacketQueue queue(now, /*prioritize_audio_retransmission=*/true,
+                               ttl);
+  for (int i = 0; i < kPacketsPerStream; ++i) {
+    for (int stream = 0; stream < num_streams; ++stream) {
+      queue.Push(now, CreatePacket(RtpPacketMediaType::kVideo,
+                                   kFirstSsrc + stream, i));
+    }
+  }
+
+  for (auto _ : state) {
+    now += TimeDelta::Micros(10);
+    queue.UpdateAverageQueueTime(now);
+    std::unique_ptr<RtpPacketToSend> packet = queue.Pop();
+    queue.Push(now, std::move(packet));
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_PrioritizedPacketQueuePushPop)
+    ->ArgsProduct({{1, 10, 100, 500, 1000, 2000}, {0, 1}});
+
+// Adds one audio and one video stream per iteration, alongside
+// `state.range(0)` video streams with queued packets, and removes them again
+// as is done when a stream's packets are flushed.
+void BM_PrioritizedPacketQueueAddRemoveStream(benchmark::State& state) {
+  const int num_streams = state.range(0);
+  Timestamp now = Timestamp::Seconds(1);
+  PrioritizedPacketQueue queue(now);
+  for (int stream = 0; stream < num_streams; ++stream) {
+    queue.Push(now,
+               CreatePacket(RtpPacketMediaType::kVideo, kFirstSsrc + stream,
+                            /*seq=*/0));
+  }
+
+  const uint32_t audio_ssrc = kFirstSsrc + num_streams;
+  const uint32_t video_ssrc = audio_ssrc + 1;
+  uint16_t seq = 0;
+  for (auto _ : state) {
+    queue.Push(now, CreatePacket(RtpPacketMediaType::kAudio, audio_ssrc, seq));
+    queue.Push(now, CreatePacket(RtpPacketMediaType::kVideo, video_ssrc, seq));
+    ++seq;
+    queue.RemovePacketsForSsrc(audio_ssrc);
+    queue.RemovePacketsForSsrc(video_ssrc);
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_PrioritizedPacketQueueAddRemoveStream)
+    ->Arg(1)
+    ->Arg(10)
+    ->Arg(100)
+    ->Arg(500)
+    ->Arg(1000)
+    ->Arg(2000);
+
+}  // namespace
+}  // namespace webrtc
@@ -430,6 +430,53 @@ TEST(PrioritizedPacketQueue, ClearPacketsAffectsOnlySpecifiedSsrc) {
   EXPECT_TRUE(queue.Empty());
 }
 
+TEST(PrioritizedPacketQueue, ClearPacketsKeepsRoundRobinOrderOfOtherSsrcs) {
+  Timestamp now = Timestamp::Zero();
+  PrioritizedPacketQueue queue(now);
+  for (uint16_t seq = 0; seq < 6; ++seq) {
+    queue.Push(now, CreatePacket(RtpPacketMediaType::kVideo, seq,
+                                 /*ssrc=*/1 + seq % 3));
+  }
+
+  // Pop from SSRC 1, then remove SSRC 2 from the middle of the round-robin.
+  EXPECT_EQ(queue.Pop()->Ssrc(), 1u);
+  queue.RemovePacketsForSsrc(2);
+  EXPECT_EQ(queue.SizeInPackets(), 3);
+
+  EXPECT_EQ(queue.Pop()->Ssrc(), 3u);
+  EXPECT_EQ(queue.Pop()->Ssrc(), 1u);
+  EXPECT_EQ(queue.Pop()->Ssrc(), 3u);
+  EXPECT_TRUE(queue.Empty());
+}
+
+TEST(PrioritizedPacketQueue, ReusesQueuesOfInactiveSsrcs) {
+  Timestamp now = Timestamp::Zero();
+  PrioritizedPacketQueue queue(now);
+  queue.Push(now, CreatePacket(RtpPacketMediaType::kVideo, /*seq=*/1,
+                               /*ssrc=*/1, /*is_key_frame=*/true));
+  EXPECT_EQ(queue.Pop()->SequenceNumber(), 1);
+
+  // SSRC 1 has been inactive long enough for its queue to be culled when the
+  // next packet is pushed, and then reused.
+  now += TimeDelta::Seconds(1);
+  queue.Push(now, CreatePacket(RtpPacketMediaType::kVideo, /*seq=*/2,
+                               /*ssrc=*/2));
+  EXPECT_FALSE(queue.HasKeyframePackets(1));
+  queue.Push(now, CreatePacket(RtpPacketMediaType::kVideo, /*seq=*/3,
+                               /*ssrc=*/1));
+  queue.Push(now, CreatePacket(RtpPacketMediaType::kVideo, /*seq=*/4,
+                               /*ssrc=*/2));
+  queue.Push(now, CreatePacket(RtpPacketMediaType::kVideo, /*seq=*/5,
+                               /*ssrc=*/1));
+  EXPECT_FALSE(queue.HasKeyframePackets(1));
+
+  EXPECT_EQ(queue.Pop()->SequenceNumber(), 2);
+  EXPECT_EQ(queue.Pop()->SequenceNumber(), 3);
+  EXPECT_EQ(queue.Pop()->SequenceNumber(), 4);
+  EXPECT_EQ(queue.Pop()->SequenceNumber(), 5);
+  EXPECT_TRUE(queue.Empty());
+}
+
 TEST(PrioritizedPacketQueue, ReportsKeyframePackets) {
   Timestamp now = Timestamp::Zero();
   PrioritizedPacketQueue queue(now);
@@ -542,6 +589,37 @@ TEST(PrioritizedPacketQueue, SendsNewVideoPacketAfterPurgingLastOldRtxPacket) {
   EXPECT_EQ(queue.SizeInPackets(), 0);
 }
 
+TEST(PrioritizedPacketQueue, DropsOnlyExpiredPacketsAcrossSsrcs) {
+  Timestamp now = Timestamp::Zero();
+  PacketQueueTTL ttls;
+  ttls.video = TimeDelta::Millis(100);
+  PrioritizedPacketQueue queue(now, /*prioritize_audio_retransmission=*/false,
+                               ttls);
+
+  queue.Push(now, CreatePacket(RtpPacketMediaType::kVideo, /*seq=*/1,
+                               /*ssrc=*/1));
+  now += TimeDelta::Millis(60);
+  queue.Push(now, CreatePacket(RtpPacketMediaType::kVideo, /*seq=*/2,
+                               /*ssrc=*/2));
+  queue.Push(now, CreatePacket(RtpPacketMediaType::kVideo, /*seq=*/3,
+                               /*ssrc=*/1));
+  EXPECT_EQ(queue.SizeInPackets(), 3);
+
+  // Only the first packet has expired.
+  now += TimeDelta::Millis(60);
+  queue.Push(now, CreatePacket(RtpPacketMediaType::kVideo, /*seq=*/4,
+                               /*ssrc=*/3));
+  EXPECT_EQ(queue.SizeInPackets(), 3);
+
+  // The remaining packets have all expired.
+  now += TimeDelta::Millis(200);
+  queue.Push(now, CreatePacket(RtpPacketMediaType::kVideo, /*seq=*/5,
+                               /*ssrc=*/2));
+  EXPECT_EQ(queue.SizeInPackets(), 1);
+  EXPECT_EQ(queue.Pop()->SequenceNumber(), 5);
+  EXPECT_TRUE(queue.Empty());
+}
+
 TEST(PrioritizedPacketQueue,
      SendsPacketsAfterTttlIfPrioHigherThanPushedPackets) {
   Timestamp now = Timestamp::Zero();
@@ -0,0 +1,135 @@
+/*
+ *  Copyright (c) 2024 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/pacing/shared_pacing_scheduler.h"
+
+#include <algorithm>
+
+#include "api/units/time_delta.h"
+#include "rtc_base/checks.h"
+
+namespace webrtc {
+
+SharedPacingScheduler::SharedPacingScheduler(Clock* clock)
+    : clock_(clock),
+      task_queue_(TaskQueueBase::Current()),
+      process_times_(clock->TimeInMicroseconds()) {
+  RTC_DCHECK(task_queue_);
+}
+
+SharedPacingScheduler::~SharedPacingScheduler() {
+  RTC_DCHECK_RUN_ON(task_queue_);
+  RTC_DCHECK_EQ(num_clients_, 0);
+}
+
+SharedPacingScheduler::ClientId SharedPacingScheduler::Register(
+    Client* client) {
+  RTC_DCHECK_RUN_ON(task_queue_);
+  RTC_DCHECK(client);
+  ClientId id;
+  if (free_ids_.empty()) {
+    id = static_cast<ClientId>(clients_.size());
+    clients_.emplace_back();
+  } else {
+    id = free_ids_.back();
+    free_ids_.pop_back();
+  }
+  clients_[id].client = client;
+  ++num_clients_;
+  return id;
+}
+
+void SharedPacingScheduler::Unregister(ClientId id) {
+  RTC_DCHECK_RUN_ON(task_queue_);
+  RTC_DCHECK_LT(id, clients_.size());
+  ClientSlot& slot = clients_[id];
+  RTC_DCHECK(slot.client);
+  slot.client = nullptr;
+  ++slot.generation;
+  slot.process_time = Timestamp::MinusInfinity();
+  free_ids_.push_back(id);
+  --num_clients_;
+}
+
+void SharedPacingScheduler::Schedule(ClientId id, Timestamp process_time) {
+  RTC_DCHECK_RUN_ON(task_queue_);
+  RTC_DCHECK_LT(id, clients_.size());
+  RTC_DCHECK(process_time.IsFinite());
+  ClientSlot& slot = clients_[id];
+  RTC_DCHECK(slot.client);
+  if (slot.process_time == process_time) {
+    return;
+  }
+  slot.process_time = process_time;
+  process_times_.Insert(process_time.us(),
+                        Entry{.id = id,
+                              .generation = slot.generation,
+                              .process_time = process_time});
+  MaybeScheduleWakeup(process_time);
+}
+
+size_t SharedPacingScheduler::num_clients() const {
+  RTC_DCHECK_RUN_ON(task_queue_);
+  return num_clients_;
+}
+
+int64_t SharedPacingScheduler::num_wakeups() const {
+  RTC_DCHECK_RUN_ON(task_queue_);
+  return num_wakeups_;
+}
+
+void SharedPacingScheduler::OnWakeup(Timestamp wakeup_time) {
+  // Ignore retired wakeups.
+  if (wakeup_time != next_wakeup_time_) {
+    return;
+  }
+  next_wakeup_time_ = Timestamp::PlusInfinity();
+  ++num_wakeups_;
+
+  const Timestamp now = clock_->CurrentTime();
+  Entry entry;
+  while (process_times_.PopExpired(now.us(), entry)) {
+    ClientSlot& slot = clients_[entry.id];
+    if (slot.generation != entry.generation ||
+        slot.process_time != entry.process_time) {
+      // The client has been unregistered or rescheduled since.
+      continue;
+    }
+    slot.process_time = Timestamp::MinusInfinity();
+    // The client may register or reschedule clients, which invalidates `slot`.
+    slot.client->OnScheduledProcess(entry.process_time);
+  }
+
+  if (!process_times_.empty()) {
+    MaybeScheduleWakeup(Timestamp::Micros(process_times_.NextExpiryUs()));
+  }
+}
+
+void SharedPacingScheduler::MaybeScheduleWakeup(Timestamp process_time) {
+  const Timestamp now = clock_->CurrentTime();
+  const TimeDelta delay = std::max(process_time - now, TimeDelta::Zero())
+                              .RoundUpTo(TimeDelta::Millis(1));
+  const Timestamp wakeup_time = now + delay;
+  if (wakeup_time >= next_wakeup_time_) {
+    // The wakeup in flight will process the client, or schedule another
+    // wakeup for it.
+    return;
+  }
+  next_wakeup_time_ = wakeup_time;
+  task_queue_->PostDelayedHighPrecisionTask(
+      SafeTask(safety_.flag(),
+               [this, wakeup_time] {
+                 RTC_DCHECK_RUN_ON(task_queue_);
+                 OnWakeup(wakeup_time);
+               }),
+      delay);
+}
+
+}  // namespace webrtc
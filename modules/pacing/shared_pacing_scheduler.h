@@ -0,0 +1,116 @@
+/*
+ *  Copyright (c) 2024 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef MODULES_PACING_SHARED_PACING_SCHEDULER_H_
+#define MODULES_PACING_SHARED_PACING_SCHEDULER_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <vector>
+
+#include "api/sequence_checker.h"
+#include "api/task_queue/pending_task_safety_flag.h"
+#include "api/task_queue/task_queue_base.h"
+#include "api/units/timestamp.h"
+#include "rtc_base/thread_annotations.h"
+#include "rtc_base/timer_wheel.h"
+#include "system_wrappers/include/clock.h"
+
+namespace webrtc {
+
+// Schedules the processing of many pacers that run on the same task queue,
+// such as those of the transports of an SFU, so that they are woken together.
+// Instead of posting a delayed task each, the pacers register with the
+// scheduler, which keeps their next process times in a timer wheel and posts
+// a single delayed task for the earliest one. When it runs, all pacers whose
+// process time has been reached are processed, in order of process time.
+//
+// The scheduler must be created and used on the task queue of its pacers, and
+// outlive them.
+class SharedPacingScheduler {
+ public:
+  class Client {
+   public:
+    virtual ~Client() = default;
+
+    // Called on the task queue when the time last passed to `Schedule()` for
+    // the client has been reached.
+    virtual void OnScheduledProcess(Timestamp scheduled_time) = 0;
+  };
+
+  // Identifies a registered client.
+  using ClientId = uint32_t;
+
+  explicit SharedPacingScheduler(Clock* clock);
+  ~SharedPacingScheduler();
+
+  SharedPacingScheduler(const SharedPacingScheduler&) = delete;
+  SharedPacingScheduler& operator=(const SharedPacingScheduler&) = delete;
+
+  ClientId Register(Client* client);
+  // The client is not called again after this.
+  void Unregister(ClientId id);
+
+  // Calls `OnScheduledProcess(process_time)` on the client once
+  // `process_time` has been reached, replacing the time of any earlier call
+  // to this method that hasn't been run yet. The wakeup is delayed to the next
+  // whole millisecond, as with `PostDelayedHighPrecisionTask()`.
+  void Schedule(ClientId id, Timestamp process_time);
+
+  TaskQueueBase* task_queue() const { return task_queue_; }
+  size_t num_clients() const;
+  // Number of times the scheduler has woken up to process clients.
+  int64_t num_wakeups() const;
+
+ private:
+  struct ClientSlot {
+    // Null if the slot is unused.
+    Client* client = nullptr;
+    // Incremented when the slot is unregistered, to detect stale entries in
+    // `process_times_`.
+    uint32_t generation = 0;
+    // The time of the pending call to the client, or minus infinity if there
+    // is none.
+    Timestamp process_time = Timestamp::MinusInfinity();
+  };
+
+  struct Entry {
+    ClientId id = 0;
+    uint32_t generation = 0;
+    Timestamp process_time = Timestamp::MinusInfinity();
+  };
+
+  void OnWakeup(Timestamp wakeup_time) RTC_RUN_ON(task_queue_);
+  void MaybeScheduleWakeup(Timestamp process_time) RTC_RUN_ON(task_queue_);
+
+  Clock* const clock_;
+  TaskQueueBase* const task_queue_;
+
+  std::vector<ClientSlot> clients_ RTC_GUARDED_BY(task_queue_);
+  std::vector<ClientId> free_ids_ RTC_GUARDED_BY(task_queue_);
+  size_t num_clients_ RTC_GUARDED_BY(task_queue_) = 0;
+
+  // Pending calls to clients, by process time. May hold entries that have
+  // been replaced or whose clients have been unregistered.
+  TimerWheel<Entry> process_times_ RTC_GUARDED_BY(task_queue_);
+
+  // Time of the delayed wakeup task in flight, or plus infinity if there is
+  // none. A task is retired when one for an earlier time is posted.
+  Timestamp next_wakeup_time_ RTC_GUARDED_BY(task_queue_) =
+      Timestamp::PlusInfinity();
+  int64_t num_wakeups_ RTC_GUARDED_BY(task_queue_) = 0;
+
+  ScopedTaskSafety safety_;
+};
+
+}  // namespace webrtc
+
+#endif  // MODULES_PACING_SHARED_PACING_SCHEDULER_H_
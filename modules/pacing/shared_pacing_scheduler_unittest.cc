@@ -0,0 +1,180 @@
+/*
+ *  Copyright (c) 2024 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/pacing/shared_pacing_scheduler.h"
+
+#include <memory>
+#include <vector>
+
+#include "api/units/time_delta.h"
+#include "api/units/timestamp.h"
+#include "test/gmock.h"
+#include "test/gtest.h"
+#include "test/time_controller/simulated_time_controller.h"
+
+namespace webrtc {
+namespace {
+
+using ::testing::ElementsAre;
+using ::testing::IsEmpty;
+
+constexpr Timestamp kStartTime = Timestamp::Millis(1234);
+
+class RecordingClient : public SharedPacingScheduler::Client {
+ public:
+  explicit RecordingClient(Clock* clock) : clock_(clock) {}
+
+  void OnScheduledProcess(Timestamp scheduled_time) override {
+    scheduled_times.push_back(scheduled_time);
+    call_times.push_back(clock_->CurrentTime());
+  }
+
+  std::vector<Timestamp> scheduled_times;
+  std::vector<Timestamp> call_times;
+
+ private:
+  Clock* const clock_;
+};
+
+TEST(SharedPacingSchedulerTest, CallsClientAtScheduledTime) {
+  GlobalSimulatedTimeController time_controller(kStartTime);
+  SharedPacingScheduler scheduler(time_controller.GetClock());
+  RecordingClient client(time_controller.GetClock());
+  auto id = scheduler.Register(&client);
+
+  scheduler.Schedule(id, kStartTime + TimeDelta::Millis(5));
+  time_controller.AdvanceTime(TimeDelta::Millis(4));
+  EXPECT_THAT(client.scheduled_times, IsEmpty());
+  time_controller.AdvanceTime(TimeDelta::Millis(1));
+  EXPECT_THAT(client.scheduled_times,
+              ElementsAre(kStartTime + TimeDelta::Millis(5)));
+  EXPECT_THAT(client.call_times,
+              ElementsAre(kStartTime + TimeDelta::Millis(5)));
+
+  scheduler.Unregister(id);
+}
+
+TEST(SharedPacingSchedulerTest, RoundsWakeupUpToWholeMillisecond) {
+  GlobalSimulatedTimeController time_controller(kStartTime);
+  SharedPacingScheduler scheduler(time_controller.GetClock());
+  RecordingClient client(time_controller.GetClock());
+  auto id = scheduler.Register(&client);
+
+  scheduler.Schedule(id, kStartTime + TimeDelta::Micros(2500));
+  time_controller.AdvanceTime(TimeDelta::Millis(10));
+  EXPECT_THAT(client.scheduled_times,
+              ElementsAre(kStartTime + TimeDelta::Micros(2500)));
+  EXPECT_THAT(client.call_times,
+              ElementsAre(kStartTime + TimeDelta::Millis(3)));
+
+  scheduler.Unregister(id);
+}
+
+TEST(SharedPacingSchedulerTest, ProcessesClientsDueAtTheSameTimeInOneWakeup) {
+  GlobalSimulatedTimeController time_controller(kStartTime);
+  SharedPacingScheduler scheduler(time_controller.GetClock());
+  std::vector<std::unique_ptr<RecordingClient>> clients;
+  std::vector<SharedPacingScheduler::ClientId> ids;
+  for (int i = 0; i < 100; ++i) {
+    clients.push_back(
+        std::make_unique<RecordingClient>(time_controller.GetClock()));
+    ids.push_back(scheduler.Register(clients.back().get()));
+    scheduler.Schedule(ids.back(),
+                       kStartTime + TimeDelta::Micros(4001 + 9 * i));
+  }
+
+  time_controller.AdvanceTime(TimeDelta::Millis(10));
+  for (const auto& client : clients) {
+    EXPECT_THAT(client->call_times,
+                ElementsAre(kStartTime + TimeDelta::Millis(5)));
+  }
+  EXPECT_EQ(scheduler.num_wakeups(), 1);
+
+  for (auto id : ids) {
+    scheduler.Unregister(id);
+  }
+}
+
+TEST(SharedPacingSchedulerTest, ProcessesClientsInOrderOfScheduledTime) {
+  GlobalSimulatedTimeController time_controller(kStartTime);
+  SharedPacingScheduler scheduler(time_controller.GetClock());
+  std::vector<int> order;
+  class OrderClient : public SharedPacingScheduler::Client {
+   public:
+    OrderClient(int index, std::vector<int>* order)
+        : index_(index), order_(order) {}
+    void OnScheduledProcess(Timestamp scheduled_time) override {
+      order_->push_back(index_);
+    }
+
+   private:
+    const int index_;
+    std::vector<int>* const order_;
+  };
+  OrderClient first(1, &order);
+  OrderClient second(2, &order);
+  auto first_id = scheduler.Register(&first);
+  auto second_id = scheduler.Register(&second);
+
+  scheduler.Schedule(second_id, kStartTime + TimeDelta::Micros(900));
+  scheduler.Schedule(first_id, kStartTime + TimeDelta::Micros(100));
+  time_controller.AdvanceTime(TimeDelta::Millis(1));
+  EXPECT_THAT(order, ElementsAre(1, 2));
+
+  scheduler.Unregister(first_id);
+  scheduler.Unregister(second_id);
+}
+
+TEST(SharedPacingSchedulerTest, RescheduleReplacesEarlierTime) {
+  GlobalSimulatedTimeController time_controller(kStartTime);
+  SharedPacingScheduler scheduler(time_controller.GetClock());
+  RecordingClient client(time_controller.GetClock());
+  auto id = scheduler.Register(&client);
+
+  scheduler.Schedule(id, kStartTime + TimeDelta::Millis(10));
+  scheduler.Schedule(id, kStartTime + TimeDelta::Millis(2));
+  time_controller.AdvanceTime(TimeDelta::Millis(20));
+  EXPECT_THAT(client.scheduled_times,
+              ElementsAre(kStartTime + TimeDelta::Millis(2)));
+
+  scheduler.Schedule(id, kStartTime + TimeDelta::Millis(25));
+  scheduler.Schedule(id, kStartTime + TimeDelta::Millis(30));
+  time_controller.AdvanceTime(TimeDelta::Millis(20));
+  EXPECT_THAT(client.scheduled_times,
+              ElementsAre(kStartTime + TimeDelta::Millis(2),
+                          kStartTime + TimeDelta::Millis(30)));
+
+  scheduler.Unregister(id);
+}
+
+TEST(SharedPacingSchedulerTest, DoesNotCallUnregisteredClient) {
+  GlobalSimulatedTimeController time_controller(kStartTime);
+  SharedPacingScheduler scheduler(time_controller.GetClock());
+  RecordingClient removed(time_controller.GetClock());
+  auto removed_id = scheduler.Register(&removed);
+  scheduler.Schedule(removed_id, kStartTime + TimeDelta::Millis(5));
+  scheduler.Unregister(removed_id);
+
+  // The slot of the removed client is reused.
+  RecordingClient added(time_controller.GetClock());
+  auto added_id = scheduler.Register(&added);
+  EXPECT_EQ(scheduler.num_clients(), 1u);
+  scheduler.Schedule(added_id, kStartTime + TimeDelta::Millis(7));
+
+  time_controller.AdvanceTime(TimeDelta::Millis(10));
+  EXPECT_THAT(removed.scheduled_times, IsEmpty());
+  EXPECT_THAT(added.scheduled_times,
+              ElementsAre(kStartTime + TimeDelta::Millis(7)));
+
+  scheduler.Unregister(added_id);
+}
+
+}  // namespace
+}  // namespace webrtc
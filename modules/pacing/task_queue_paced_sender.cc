@@ -28,11 +28,13 @@ TaskQueuePacedSender::TaskQueuePacedSender(
     PacingController::PacketSender* packet_sender,
     const FieldTrialsView& field_trials,
     TimeDelta max_hold_back_window,
-    int max_hold_back_window_in_packets)
+    int max_hold_back_window_in_packets,
+    SharedPacingScheduler* shared_scheduler)
     : clock_(clock),
       max_hold_back_window_(max_hold_back_window),
       max_hold_back_window_in_packets_(max_hold_back_window_in_packets),
       pacing_controller_(clock, packet_sender, field_trials),
+      shared_scheduler_(shared_scheduler),
       next_process_time_(Timestamp::MinusInfinity()),
       is_started_(false),
       is_shutdown_(false),
@@ -40,11 +42,18 @@ TaskQueuePacedSender::TaskQueuePacedSender(
       include_overhead_(false),
       task_queue_(TaskQueueBase::Current()) {
   RTC_DCHECK_GE(max_hold_back_window_, PacingController::kMinSleepTime);
+  if (shared_scheduler_ != nullptr) {
+    RTC_DCHECK_EQ(shared_scheduler_->task_queue(), task_queue_);
+    shared_scheduler_id_ = shared_scheduler_->Register(this);
+  }
 }
 
 TaskQueuePacedSender::~TaskQueuePacedSender() {
   RTC_DCHECK_RUN_ON(task_queue_);
   is_shutdown_ = true;
+  if (shared_scheduler_ != nullptr) {
+    shared_scheduler_->Unregister(shared_scheduler_id_);
+  }
 }
 
 void TaskQueuePacedSender::SetSendBurstInterval(TimeDelta burst_interval) {
@@ -63,6 +72,17 @@ void TaskQueuePacedSender::EnsureStarted() {
   MaybeProcessPackets(Timestamp::MinusInfinity());
 }
 
+void TaskQueuePacedSender::SetProfilingEnabled(bool enabled) {
+  RTC_DCHECK_RUN_ON(task_queue_);
+  pacing_controller_.SetProfilingEnabled(enabled);
+}
+
+absl::optional<PacingProfiler::Profile> TaskQueuePacedSender::GetProfile()
+    const {
+  RTC_DCHECK_RUN_ON(task_queue_);
+  return pacing_controller_.GetProfile();
+}
+
 void TaskQueuePacedSender::CreateProbeClusters(
     std::vector<ProbeClusterConfig> probe_cluster_configs) {
   RTC_DCHECK_RUN_ON(task_queue_);
@@ -179,6 +199,10 @@ TimeDelta TaskQueuePacedSender::OldestPacketWaitTime() const {
   return current - oldest_packet;
 }
 
+void TaskQueuePacedSender::OnScheduledProcess(Timestamp scheduled_time) {
+  MaybeProcessPackets(scheduled_time);
+}
+
 void TaskQueuePacedSender::OnStatsUpdated(const Stats& stats) {
   RTC_DCHECK_RUN_ON(task_queue_);
   current_stats_ = stats;
@@ -264,13 +288,17 @@ void TaskQueuePacedSender::MaybeProcessPackets(
   // schedule a new one. Previous in flight task will be retired.
   if (next_process_time_.IsMinusInfinity() ||
       next_process_time_ > next_send_time) {
+    next_process_time_ = next_send_time;
+    if (shared_scheduler_ != nullptr) {
+      shared_scheduler_->Schedule(shared_scheduler_id_, next_send_time);
+      return;
+    }
     // Prefer low precision if allowed and not probing.
     task_queue_->PostDelayedHighPrecisionTask(
         SafeTask(
             safety_.flag(),
             [this, next_send_time]() { MaybeProcessPackets(next_send_time); }),
         time_to_next_process.RoundUpTo(TimeDelta::Millis(1)));
-    next_process_time_ = next_send_time;
   }
 }
 
@@ -25,7 +25,9 @@
 #include "api/units/time_delta.h"
 #include "api/units/timestamp.h"
 #include "modules/pacing/pacing_controller.h"
+#include "modules/pacing/pacing_profiler.h"
 #include "modules/pacing/rtp_packet_pacer.h"
+#include "modules/pacing/shared_pacing_scheduler.h"
 #include "modules/rtp_rtcp/source/rtp_packet_to_send.h"
 #include "rtc_base/experiments/field_trial_parser.h"
 #include "rtc_base/numerics/exp_filter.h"
@@ -34,7 +36,9 @@
 namespace webrtc {
 class Clock;
 
-class TaskQueuePacedSender : public RtpPacketPacer, public RtpPacketSender {
+class TaskQueuePacedSender : public RtpPacketPacer,
+                             public RtpPacketSender,
+                             public SharedPacingScheduler::Client {
  public:
   static const int kNoPacketHoldback;
 
@@ -47,11 +51,16 @@ class TaskQueuePacedSender : public RtpPacketPacer, public RtpPacketSender {
   //
   // The taskqueue used when constructing a TaskQueuePacedSender will also be
   // used for pacing.
+  //
+  // If `shared_scheduler` is set, the pacer is woken by it, together with the
+  // other pacers on the task queue, instead of posting its own delayed tasks.
+  // It must be created on the same task queue, and outlive the pacer.
   TaskQueuePacedSender(Clock* clock,
                        PacingController::PacketSender* packet_sender,
                        const FieldTrialsView& field_trials,
                        TimeDelta max_hold_back_window,
-                       int max_hold_back_window_in_packets);
+                       int max_hold_back_window_in_packets,
+                       SharedPacingScheduler* shared_scheduler = nullptr);
 
   ~TaskQueuePacedSender() override;
 
@@ -66,6 +75,13 @@ class TaskQueuePacedSender : public RtpPacketPacer, public RtpPacketSender {
   // Ensure that necessary delayed tasks are scheduled.
   void EnsureStarted();
 
+  // Enables or disables profiling of the pacing, see
+  // `PacingController::SetProfilingEnabled()`.
+  void SetProfilingEnabled(bool enabled);
+
+  // Returns the pacing profile, or nullopt if profiling is disabled.
+  absl::optional<PacingProfiler::Profile> GetProfile() const;
+
   // Methods implementing RtpPacketSender.
 
   // Adds the packet to the queue and calls
@@ -132,6 +148,9 @@ class TaskQueuePacedSender : public RtpPacketPacer, public RtpPacketSender {
   void OnStatsUpdated(const Stats& stats);
 
  private:
+  // Implements SharedPacingScheduler::Client.
+  void OnScheduledProcess(Timestamp scheduled_time) override;
+
   // Call in response to state updates that could warrant sending out packets.
   // Protected against re-entry from packet sent receipts.
   void MaybeScheduleProcessPackets() RTC_RUN_ON(task_queue_);
@@ -154,10 +173,14 @@ class TaskQueuePacedSender : public RtpPacketPacer, public RtpPacketSender {
 
   PacingController pacing_controller_ RTC_GUARDED_BY(task_queue_);
 
+  SharedPacingScheduler* const shared_scheduler_;
+  // Set if `shared_scheduler_` is.
+  SharedPacingScheduler::ClientId shared_scheduler_id_ = 0;
+
   // We want only one (valid) delayed process task in flight at a time.
   // If the value of `next_process_time_` is finite, it is an id for a
-  // delayed task that will call MaybeProcessPackets() with that time
-  // as parameter.
+  // delayed task, or call from `shared_scheduler_`, that will call
+  // MaybeProcessPackets() with that time as parameter.
   // Timestamp::MinusInfinity() indicates no valid pending task.
   Timestamp next_process_time_ RTC_GUARDED_BY(task_queue_);
 
@@ -27,6 +27,7 @@
 #include "api/units/time_delta.h"
 #include "modules/pacing/pacing_controller.h"
 #include "modules/pacing/packet_router.h"
+#include "modules/pacing/shared_pacing_scheduler.h"
 #include "modules/rtp_rtcp/include/rtp_rtcp_defines.h"
 #include "test/gmock.h"
 #include "test/gtest.h"
@@ -164,6 +165,60 @@ TEST(TaskQueuePacedSenderTest, PacesPackets) {
   EXPECT_NEAR((end_time - start_time).ms<double>(), 1000.0, 50.0);
 }
 
+// Same test as above, but with two pacers woken by a shared scheduler.
+TEST(TaskQueuePacedSenderTest, PacesPacketsWithSharedScheduler) {
+  GlobalSimulatedTimeController time_controller(Timestamp::Millis(1234));
+  ScopedKeyValueConfig trials;
+  SharedPacingScheduler scheduler(time_controller.GetClock());
+  MockPacketRouter packet_routers[2];
+  std::vector<std::unique_ptr<TaskQueuePacedSender>> pacers;
+  for (MockPacketRouter& packet_router : packet_routers) {
+    pacers.push_back(std::make_unique<TaskQueuePacedSender>(
+        time_controller.GetClock(), &packet_router, trials,
+        PacingController::kMinSleepTime,
+        TaskQueuePacedSender::kNoPacketHoldback, &scheduler));
+  }
+  EXPECT_EQ(scheduler.num_clients(), 2u);
+
+  // Insert a number of packets, covering one second.
+  static constexpr size_t kPacketsToSend = 42;
+  for (auto& pacer : pacers) {
+    pacer->SetPacingRates(
+        DataRate::BitsPerSec(kDefaultPacketSize * 8 * kPacketsToSend),
+        DataRate::Zero());
+    pacer->EnsureStarted();
+    pacer->EnqueuePackets(
+        GeneratePackets(RtpPacketMediaType::kVideo, kPacketsToSend));
+  }
+
+  // Expect all of them to be sent.
+  size_t packets_sent[2] = {0, 0};
+  Timestamp end_time[2] = {Timestamp::PlusInfinity(),
+                           Timestamp::PlusInfinity()};
+  for (int i = 0; i < 2; ++i) {
+    EXPECT_CALL(packet_routers[i], SendPacket)
+        .WillRepeatedly([&, i](std::unique_ptr<RtpPacketToSend> packet,
+                               const PacedPacketInfo& cluster_info) {
+          if (++packets_sent[i] == kPacketsToSend) {
+            end_time[i] = time_controller.GetClock()->CurrentTime();
+          }
+        });
+  }
+
+  const Timestamp start_time = time_controller.GetClock()->CurrentTime();
+  time_controller.AdvanceTime(TimeDelta::Seconds(1));
+  for (int i = 0; i < 2; ++i) {
+    EXPECT_EQ(packets_sent[i], kPacketsToSend);
+    ASSERT_TRUE(end_time[i].IsFinite());
+    EXPECT_NEAR((end_time[i] - start_time).ms<double>(), 1000.0, 50.0);
+  }
+  // The pacers send at the same rate, and are woken together.
+  EXPECT_LE(scheduler.num_wakeups(), static_cast<int64_t>(kPacketsToSend));
+
+  pacers.clear();
+  EXPECT_EQ(scheduler.num_clients(), 0u);
+}
+
 // Same test as above, but with 0.5s of burst applied.
 TEST(TaskQueuePacedSenderTest, PacesPacketsWithBurst) {
   GlobalSimulatedTimeController time_controller(Timestamp::Millis(1234));
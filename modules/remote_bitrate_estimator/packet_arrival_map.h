@@ -15,6 +15,7 @@
 #include <cstdint>
 #include <memory>
 
+#include "api/array_view.h"
 #include "api/units/timestamp.h"
 #include "rtc_base/checks.h"
 
@@ -82,6 +83,29 @@ class PacketArrivalTimeMap {
     }
   }
 
+  // Returns the arrival times of the packets from `sequence_number` up to
+  // `end_sequence_number` (exclusive), both of which must be within
+  // [begin_sequence_number, end_sequence_number]. Not yet received packets
+  // have a negative arrival time. The returned view ends early if the range
+  // wraps around the end of the underlying circular buffer, in which case the
+  // rest of the range has to be requested separately.
+  rtc::ArrayView<const Timestamp> ContiguousArrivalTimes(
+      int64_t sequence_number,
+      int64_t end_sequence_number) const {
+    RTC_DCHECK_GE(sequence_number, begin_sequence_number());
+    RTC_DCHECK_LE(sequence_number, end_sequence_number);
+    RTC_DCHECK_LE(end_sequence_number, end_sequence_number_);
+    if (sequence_number == end_sequence_number) {
+      return {};
+    }
+    int index = Index(sequence_number);
+    int64_t size =
+        std::min<int64_t>(end_sequence_number - sequence_number,
+                          capacity() - index);
+    return rtc::ArrayView<const Timestamp>(arrival_times_.get() + index,
+                                           size);
+  }
+
   // Clamps `sequence_number` between [begin_sequence_number,
   // end_sequence_number].
   int64_t clamp(int64_t sequence_number) const {
@@ -0,0 +1,116 @@
+/*
+ *  Copyright (c) 2024 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <stdint.h>
+
+#include <memory>
+
+#include "api/array_view.h"
+#include "api/units/time_delta.h"
+#include "api/units/timestamp.h"
+#include "benchmark/benchmark.h"
+#include "modules/remote_bitrate_estimator/packet_arrival_map.h"
+#include "modules/rtp_rtcp/source/rtcp_packet/transport_feedback.h"
+#include "rtc_base/random.h"
+
+namespace webrtc {
+namespace {
+
+constexpr int64_t kFirstSequenceNumber = 0xfff0;
+
+// Fills `map` with `num_packets` packets, of which `loss_percent` percent are
+// lost. Packets arrive about every 2.5 ms, with every tenth packet
+// delayed enough to need a two-byte receive delta.
+void FillArrivalMap(PacketArrivalTimeMap& map,
+                    int num_packets,
+                    int loss_percent) {
+  Random random(0x1234);
+  Timestamp arrival_time = Timestamp::Seconds(10);
+  for (int i = 0; i < num_packets; ++i) {
+    arrival_time += TimeDelta::Micros(random.Rand(1000, 4000));
+    if (i % 10 == 9) {
+      arrival_time += TimeDelta::Millis(70);
+    }
+    // The last packet in the map is always received.
+    if (i == num_packets - 1 ||
+        random.Rand(0, 99) >= static_cast<uint32_t>(loss_percent)) {
+      map.AddPacket(kFirstSequenceNumber + i, arrival_time);
+    }
+  }
+}
+
+// Builds a feedback packet for the whole map by adding one received packet
+// at a time.
+std::unique_ptr<rtcp::TransportFeedback> BuildPerPacket(
+    const PacketArrivalTimeMap& map) {
+  int64_t seq = map.begin_sequence_number();
+  PacketArrivalTimeMap::PacketArrivalTime first = map.FindNextAtOrAfter(seq);
+  auto feedback = std::make_unique<rtcp::TransportFeedback>();
+  feedback->SetBase(static_cast<uint16_t>(seq), first.arrival_time);
+  for (; seq < map.end_sequence_number(); ++seq) {
+    PacketArrivalTimeMap::PacketArrivalTime packet = map.FindNextAtOrAfter(seq);
+    seq = packet.sequence_number;
+    if (!feedback->AddReceivedPacket(static_cast<uint16_t>(seq),
+                                     packet.arrival_time)) {
+      break;
+    }
+  }
+  return feedback;
+}
+
+// Builds a feedback packet for the whole map by adding the received packets in
+// bulk, as TransportSequenceNumberFeedbackGenenerator does.
+std::unique_ptr<rtcp::TransportFeedback> BuildInBulk(
+    const PacketArrivalTimeMap& map) {
+  int64_t seq = map.begin_sequence_number();
+  int64_t end_seq = map.end_sequence_number();
+  PacketArrivalTimeMap::PacketArrivalTime first = map.FindNextAtOrAfter(seq);
+  auto feedback = std::make_unique<rtcp::TransportFeedback>();
+  feedback->SetBase(static_cast<uint16_t>(seq), first.arrival_time);
+  while (seq < end_seq) {
+    rtc::ArrayView<const Timestamp> arrival_times =
+        map.ContiguousArrivalTimes(seq, end_seq);
+    if (feedback->AddReceivedPackets(static_cast<uint16_t>(seq),
+                                     arrival_times) < arrival_times.size()) {
+      break;
+    }
+    seq += arrival_times.size();
+  }
+  return feedback;
+}
+
+// The arguments are the number of packets in the map and the percentage of
+// them that is lost.
+void BM_TransportFeedbackAddReceivedPacket(benchmark::State& state) {
+  PacketArrivalTimeMap map;
+  FillArrivalMap(map, state.range(0), state.range(1));
+  for (auto _ : state) {
+    auto feedback = BuildPerPacket(map);
+    benchmark::DoNotOptimize(feedback);
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_TransportFeedbackAddReceivedPacket)
+    ->ArgsProduct({{50, 500, 5000}, {0, 5, 50}});
+
+void BM_TransportFeedbackAddReceivedPackets(benchmark::State& state) {
+  PacketArrivalTimeMap map;
+  FillArrivalMap(map, state.range(0), state.range(1));
+  for (auto _ : state) {
+    auto feedback = BuildInBulk(map);
+    benchmark::DoNotOptimize(feedback);
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_TransportFeedbackAddReceivedPackets)
+    ->ArgsProduct({{50, 500, 5000}, {0, 5, 50}});
+
+}  // namespace
+}  // namespace webrtc
@@ -9,12 +9,17 @@
  */
 #include "modules/remote_bitrate_estimator/packet_arrival_map.h"
 
+#include "api/array_view.h"
+#include "api/units/timestamp.h"
 #include "test/gmock.h"
 #include "test/gtest.h"
 
 namespace webrtc {
 namespace {
 
+using ::testing::IsEmpty;
+using ::testing::SizeIs;
+
 TEST(PacketArrivalMapTest, IsConsistentWhenEmpty) {
   PacketArrivalTimeMap map;
 
@@ -268,5 +273,37 @@ TEST(PacketArrivalMapTest, EraseToMissingSequenceNumber) {
   EXPECT_TRUE(map.has_received(42));
 }
 
+TEST(PacketArrivalMapTest, ReturnsContiguousArrivalTimesUpToBufferEnd) {
+  PacketArrivalTimeMap map;
+  for (int64_t seq = 100; seq <= 300; ++seq) {
+    if (seq % 3 != 0) {
+      map.AddPacket(seq, Timestamp::Millis(seq));
+    }
+  }
+
+  int64_t seq = 100;
+  int num_views = 0;
+  while (seq < map.end_sequence_number()) {
+    rtc::ArrayView<const Timestamp> arrival_times =
+        map.ContiguousArrivalTimes(seq, map.end_sequence_number());
+    ASSERT_FALSE(arrival_times.empty());
+    for (const Timestamp& arrival_time : arrival_times) {
+      if (seq % 3 != 0) {
+        EXPECT_EQ(arrival_time, Timestamp::Millis(seq));
+      } else {
+        EXPECT_LT(arrival_time, Timestamp::Zero());
+      }
+      ++seq;
+    }
+    ++num_views;
+  }
+  EXPECT_EQ(seq, 300);
+  // The range wraps around the end of the circular buffer once.
+  EXPECT_EQ(num_views, 2);
+
+  EXPECT_THAT(map.ContiguousArrivalTimes(150, 160), SizeIs(10));
+  EXPECT_THAT(map.ContiguousArrivalTimes(150, 150), IsEmpty());
+}
+
 }  // namespace
 }  // namespace webrtc
@@ -17,6 +17,7 @@
 #include <utility>
 
 #include "absl/types/optional.h"
+#include "api/array_view.h"
 #include "api/units/data_size.h"
 #include "api/units/time_delta.h"
 #include "modules/rtp_rtcp/source/rtcp_packet/remote_estimate.h"
@@ -300,53 +301,61 @@ TransportSequenceNumberFeedbackGenenerator::MaybeBuildFeedbackPacket(
 
   int64_t next_sequence_number = begin_sequence_number_inclusive;
 
-  for (int64_t seq = start_seq; seq < end_seq; ++seq) {
+  int64_t seq = end_seq;
+  Timestamp arrival_time = Timestamp::MinusInfinity();
+  if (start_seq < end_seq) {
     PacketArrivalTimeMap::PacketArrivalTime packet =
-        packet_arrival_times_.FindNextAtOrAfter(seq);
+        packet_arrival_times_.FindNextAtOrAfter(start_seq);
     seq = packet.sequence_number;
-    if (seq >= end_seq) {
-      break;
+    arrival_time = packet.arrival_time;
+  }
+
+  if (seq < end_seq) {
+    feedback_packet =
+        std::make_unique<rtcp::TransportFeedback>(include_timestamps);
+    feedback_packet->SetMediaSsrc(media_ssrc_);
+
+    // It should be possible to add `seq` to this new `feedback_packet`,
+    // If difference between `seq` and `begin_sequence_number_inclusive`,
+    // is too large, discard reporting too old missing packets.
+    static constexpr int kMaxMissingSequenceNumbers = 0x7FFE;
+    int64_t base_sequence_number = std::max(begin_sequence_number_inclusive,
+                                            seq - kMaxMissingSequenceNumbers);
+
+    // Base sequence number is the expected first sequence number. This is
+    // known, but we might not have actually received it, so the base time
+    // shall be the time of the first received packet in the feedback.
+    feedback_packet->SetBase(static_cast<uint16_t>(base_sequence_number),
+                             arrival_time);
+    feedback_packet->SetFeedbackSequenceNumber(feedback_packet_count_++);
+
+    if (!feedback_packet->AddReceivedPacket(static_cast<uint16_t>(seq),
+                                            arrival_time)) {
+      // Could not add a single received packet to the feedback.
+      RTC_DCHECK_NOTREACHED()
+          << "Failed to create an RTCP transport feedback with base sequence "
+             "number "
+          << base_sequence_number << " and 1st received " << seq;
+      periodic_window_start_seq_ = seq;
+      return nullptr;
     }
 
-    if (feedback_packet == nullptr) {
-      feedback_packet =
-          std::make_unique<rtcp::TransportFeedback>(include_timestamps);
-      feedback_packet->SetMediaSsrc(media_ssrc_);
-
-      // It should be possible to add `seq` to this new `feedback_packet`,
-      // If difference between `seq` and `begin_sequence_number_inclusive`,
-      // is too large, discard reporting too old missing packets.
-      static constexpr int kMaxMissingSequenceNumbers = 0x7FFE;
-      int64_t base_sequence_number = std::max(begin_sequence_number_inclusive,
-                                              seq - kMaxMissingSequenceNumbers);
-
-      // Base sequence number is the expected first sequence number. This is
-      // known, but we might not have actually received it, so the base time
-      // shall be the time of the first received packet in the feedback.
-      feedback_packet->SetBase(static_cast<uint16_t>(base_sequence_number),
-                               packet.arrival_time);
-      feedback_packet->SetFeedbackSequenceNumber(feedback_packet_count_++);
-
-      if (!feedback_packet->AddReceivedPacket(static_cast<uint16_t>(seq),
-                                              packet.arrival_time)) {
-        // Could not add a single received packet to the feedback.
-        RTC_DCHECK_NOTREACHED()
-            << "Failed to create an RTCP transport feedback with base sequence "
-               "number "
-            << base_sequence_number << " and 1st received " << seq;
-        periodic_window_start_seq_ = seq;
-        return nullptr;
-      }
-    } else {
-      if (!feedback_packet->AddReceivedPacket(static_cast<uint16_t>(seq),
-                                              packet.arrival_time)) {
-        // Could not add timestamp, feedback packet might be full. Return and
-        // try again with a fresh packet.
+    // Add the rest of the range straight from the arrival map, which holds it
+    // in at most two contiguous blocks. Stop if the feedback packet gets full;
+    // the remaining packets are then reported in a new packet.
+    for (++seq; seq < end_seq;) {
+      rtc::ArrayView<const Timestamp> arrival_times =
+          packet_arrival_times_.ContiguousArrivalTimes(seq, end_seq);
+      if (feedback_packet->AddReceivedPackets(static_cast<uint16_t>(seq),
+                                              arrival_times) <
+          arrival_times.size()) {
         break;
       }
+      seq += arrival_times.size();
     }
-
-    next_sequence_number = seq + 1;
+    // The feedback packet ends with the last received packet that was added.
+    next_sequence_number =
+        base_sequence_number + feedback_packet->GetPacketStatusCount();
   }
   if (is_periodic_update) {
     periodic_window_start_seq_ = next_sequence_number;
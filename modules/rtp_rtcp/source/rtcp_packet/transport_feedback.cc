@@ -11,6 +11,7 @@
 #include "modules/rtp_rtcp/source/rtcp_packet/transport_feedback.h"
 
 #include <algorithm>
+#include <array>
 #include <cstdint>
 #include <numeric>
 #include <utility>
@@ -45,6 +46,36 @@ constexpr size_t kMinPayloadSizeBytes = 8 + 8 + 2;
 constexpr TimeDelta kBaseTimeTick = TransportFeedback::kDeltaTick * (1 << 8);
 constexpr TimeDelta kTimeWrapPeriod = kBaseTimeTick * (1 << 24);
 
+// Computes the receive delta, in ticks, of a packet received at `timestamp`
+// after one received at `last_timestamp`. Returns false if it doesn't fit in
+// 16 bits.
+bool ComputeDeltaTicks(Timestamp last_timestamp,
+                       Timestamp timestamp,
+                       int16_t& delta) {
+  constexpr TimeDelta kDeltaTick = TransportFeedback::kDeltaTick;
+  // Convert to ticks and round.
+  if (last_timestamp > timestamp) {
+    timestamp += (last_timestamp - timestamp).RoundUpTo(kTimeWrapPeriod);
+  }
+  RTC_DCHECK_GE(timestamp, last_timestamp);
+  int64_t delta_full = (timestamp - last_timestamp).us() % kTimeWrapPeriod.us();
+  if (delta_full > kTimeWrapPeriod.us() / 2) {
+    delta_full -= kTimeWrapPeriod.us();
+    delta_full -= kDeltaTick.us() / 2;
+  } else {
+    delta_full += kDeltaTick.us() / 2;
+  }
+  delta_full /= kDeltaTick.us();
+
+  delta = static_cast<int16_t>(delta_full);
+  // If larger than 16bit signed, we can't represent it - need new fb packet.
+  if (delta != delta_full) {
+    RTC_LOG(LS_WARNING) << "Delta value too large ( >= 2^16 ticks )";
+    return false;
+  }
+  return true;
+}
+
 //    Message format
 //
 //     0                   1                   2                   3
@@ -125,6 +156,39 @@ void TransportFeedback::LastChunk::AddMissingPackets(size_t num_missing) {
   size_ = num_missing;
 }
 
+void TransportFeedback::LastChunk::AddAll(
+    rtc::ArrayView<const DeltaSize> delta_sizes,
+    std::vector<uint16_t>& encoded_chunks) {
+  size_t i = 0;
+  while (i < delta_sizes.size()) {
+    if (Empty()) {
+      size_t encoded = EncodeNext(delta_sizes.subview(i), encoded_chunks);
+      if (encoded > 0) {
+        i += encoded;
+        continue;
+      }
+    }
+    DeltaSize delta_size = delta_sizes[i];
+    if (!CanAdd(delta_size)) {
+      encoded_chunks.push_back(Emit());
+      continue;
+    }
+    if (all_same_ && !Empty() && delta_sizes_[0] == delta_size) {
+      size_t max_run = std::min(delta_sizes.size() - i,
+                                kMaxRunLengthCapacity - size_);
+      size_t run = 1;
+      while (run < max_run && delta_sizes[i + run] == delta_size) {
+        ++run;
+      }
+      AddRun(delta_size, run);
+      i += run;
+      continue;
+    }
+    Add(delta_size);
+    ++i;
+  }
+}
+
 uint16_t TransportFeedback::LastChunk::Emit() {
   RTC_DCHECK(!CanAdd(0) || !CanAdd(1) || !CanAdd(2));
   if (all_same_) {
@@ -272,6 +336,66 @@ void TransportFeedback::LastChunk::DecodeRunLength(uint16_t chunk,
     delta_sizes_[i] = delta_size;
 }
 
+void TransportFeedback::LastChunk::AddRun(DeltaSize delta_size, size_t count) {
+  RTC_DCHECK(Empty() || (all_same_ && delta_sizes_[0] == delta_size));
+  RTC_DCHECK_LE(size_ + count, kMaxRunLengthCapacity);
+  size_t end = std::min(size_ + count, kMaxVectorCapacity);
+  for (size_t i = size_; i < end; ++i)
+    delta_sizes_[i] = delta_size;
+  size_ += count;
+  has_large_delta_ = has_large_delta_ || delta_size == kLarge;
+}
+
+size_t TransportFeedback::LastChunk::EncodeNext(
+    rtc::ArrayView<const DeltaSize> delta_sizes,
+    std::vector<uint16_t>& encoded_chunks) {
+  RTC_DCHECK(Empty());
+  RTC_DCHECK(!delta_sizes.empty());
+  const DeltaSize first = delta_sizes[0];
+  const size_t max_run = std::min(delta_sizes.size(), kMaxRunLengthCapacity);
+  size_t run = 1;
+  while (run < max_run && delta_sizes[run] == first) {
+    ++run;
+  }
+  if (run == delta_sizes.size()) {
+    // The run may continue after `delta_sizes`.
+    AddRun(first, run);
+    return run;
+  }
+  // The delta size after the run can't be added to a run that is too long
+  // for a status vector chunk.
+  if (run >= kMaxOneBitCapacity ||
+      (run >= kMaxTwoBitCapacity &&
+       (first == kLarge || delta_sizes[run] == kLarge))) {
+    encoded_chunks.push_back((first << 13) | static_cast<uint16_t>(run));
+    return run;
+  }
+
+  // Otherwise this is a status vector chunk. It holds the first
+  // `kMaxTwoBitCapacity` delta sizes if there is a large one among the first
+  // `kMaxOneBitCapacity`, else the first `kMaxOneBitCapacity`. The chunk is
+  // only emitted when the delta size after those is added.
+  if (delta_sizes.size() <= kMaxOneBitCapacity) {
+    return 0;
+  }
+  bool has_large_delta = false;
+  for (size_t i = 0; i < kMaxOneBitCapacity; ++i) {
+    has_large_delta |= delta_sizes[i] == kLarge;
+  }
+  if (has_large_delta) {
+    uint16_t chunk = 0xc000;
+    for (size_t i = 0; i < kMaxTwoBitCapacity; ++i)
+      chunk |= delta_sizes[i] << 2 * (kMaxTwoBitCapacity - 1 - i);
+    encoded_chunks.push_back(chunk);
+    return kMaxTwoBitCapacity;
+  }
+  uint16_t chunk = 0x8000;
+  for (size_t i = 0; i < kMaxOneBitCapacity; ++i)
+    chunk |= delta_sizes[i] << (kMaxOneBitCapacity - 1 - i);
+  encoded_chunks.push_back(chunk);
+  return kMaxOneBitCapacity;
+}
+
 TransportFeedback::TransportFeedback()
     : TransportFeedback(/*include_timestamps=*/true) {}
 
@@ -321,28 +445,9 @@ bool TransportFeedback::AddReceivedPacket(uint16_t sequence_number,
   // Set delta to zero if timestamps are not included, this will simplify the
   // encoding process.
   int16_t delta = 0;
-  if (include_timestamps_) {
-    // Convert to ticks and round.
-    if (last_timestamp_ > timestamp) {
-      timestamp += (last_timestamp_ - timestamp).RoundUpTo(kTimeWrapPeriod);
-    }
-    RTC_DCHECK_GE(timestamp, last_timestamp_);
-    int64_t delta_full =
-        (timestamp - last_timestamp_).us() % kTimeWrapPeriod.us();
-    if (delta_full > kTimeWrapPeriod.us() / 2) {
-      delta_full -= kTimeWrapPeriod.us();
-      delta_full -= kDeltaTick.us() / 2;
-    } else {
-      delta_full += kDeltaTick.us() / 2;
-    }
-    delta_full /= kDeltaTick.us();
-
-    delta = static_cast<int16_t>(delta_full);
-    // If larger than 16bit signed, we can't represent it - need new fb packet.
-    if (delta != delta_full) {
-      RTC_LOG(LS_WARNING) << "Delta value too large ( >= 2^16 ticks )";
-      return false;
-    }
+  if (include_timestamps_ &&
+      !ComputeDeltaTicks(last_timestamp_, timestamp, delta)) {
+    return false;
   }
 
   uint16_t next_seq_no = base_seq_no_ + num_seq_no_;
@@ -367,6 +472,107 @@ bool TransportFeedback::AddReceivedPacket(uint16_t sequence_number,
   return true;
 }
 
+size_t TransportFeedback::AddReceivedPackets(
+    uint16_t sequence_number,
+    rtc::ArrayView<const Timestamp> arrival_times) {
+  // Packets arriving in order within this many microseconds of the previous
+  // one have a non-negative delta that fits in 16 bits, and can skip the
+  // wrap-around handling of ComputeDeltaTicks().
+  constexpr int64_t kMaxFastDeltaUs =
+      int64_t{0x7fff} * kDeltaTick.us() + kDeltaTick.us() / 2 - 1;
+  // Number of packets whose delta sizes are collected before encoding them.
+  constexpr size_t kBlockSize = 256;
+  // Upper bound on what adding a block can add to the packet size: a delta
+  // and a chunk per packet.
+  constexpr size_t kMaxBlockSizeBytes = kBlockSize * (2 + kChunkSizeBytes);
+
+  const size_t size = arrival_times.size();
+  const Timestamp* const times = arrival_times.data();
+  std::array<DeltaSize, kBlockSize> delta_sizes;
+
+  size_t index = 0;
+  while (true) {
+    // Skip the packets that were not received. They are reported as missing
+    // when the next received packet is added.
+    while (index < size && times[index] < Timestamp::Zero()) {
+      ++index;
+    }
+    if (index == size) {
+      return size;
+    }
+    // The first received packet of a block is added on its own, which takes
+    // care of any sequence number gap since the last added packet, and of
+    // deltas that need the slow path.
+    if (!AddReceivedPacket(sequence_number + static_cast<uint16_t>(index),
+                           times[index])) {
+      return index;
+    }
+    ++index;
+    if (num_seq_no_ + kBlockSize > kMaxReportedPackets ||
+        size_bytes_ + kMaxBlockSizeBytes > kMaxSizeBytes) {
+      // Close to full, fall back to adding one packet at a time.
+      continue;
+    }
+
+    // Collect the delta sizes of the following packets, including those not
+    // received, up to the last received one. `last_timestamp_` is in the
+    // wrapped time of the feedback packet. It is moved to the time of
+    // `arrival_times` by a whole number of wrap periods, which doesn't change
+    // the deltas.
+    const int64_t offset_us = last_timestamp_.us() - times[index - 1].us();
+    const int64_t wrap_offset_us =
+        (offset_us >= 0
+             ? (offset_us + kTimeWrapPeriod.us() / 2) / kTimeWrapPeriod.us()
+             : -((-offset_us + kTimeWrapPeriod.us() / 2) /
+                 kTimeWrapPeriod.us())) *
+        kTimeWrapPeriod.us();
+    int64_t last_timestamp_us = last_timestamp_.us() - wrap_offset_us;
+    size_t delta_bytes = 0;
+    size_t num_delta_sizes = 0;
+    for (size_t i = 0; i < kBlockSize && index + i < size; ++i) {
+      const Timestamp timestamp = times[index + i];
+      if (timestamp < Timestamp::Zero()) {
+        delta_sizes[i] = 0;
+        continue;
+      }
+      int16_t delta = 0;
+      if (include_timestamps_) {
+        int64_t delta_us = timestamp.us() - last_timestamp_us;
+        if (delta_us < 0 || delta_us > kMaxFastDeltaUs) {
+          break;
+        }
+        delta = static_cast<int16_t>((delta_us + kDeltaTick.us() / 2) /
+                                     kDeltaTick.us());
+      }
+      DeltaSize delta_size = delta <= 0xff ? 1 : 2;
+      delta_sizes[i] = delta_size;
+      received_packets_.emplace_back(
+          sequence_number + static_cast<uint16_t>(index + i), delta);
+      last_timestamp_us += int64_t{delta} * kDeltaTick.us();
+      delta_bytes += delta_size;
+      num_delta_sizes = i + 1;
+    }
+    if (num_delta_sizes == 0) {
+      continue;
+    }
+
+    // The size includes the last chunk once it is non-empty.
+    size_t prev_num_chunks =
+        encoded_chunks_.size() + (last_chunk_.Empty() ? 0 : 1);
+    last_chunk_.AddAll(
+        rtc::ArrayView<const DeltaSize>(delta_sizes.data(), num_delta_sizes),
+        encoded_chunks_);
+    size_t num_chunks = encoded_chunks_.size() + (last_chunk_.Empty() ? 0 : 1);
+    size_bytes_ += kChunkSizeBytes * (num_chunks - prev_num_chunks);
+    if (include_timestamps_) {
+      size_bytes_ += delta_bytes;
+    }
+    num_seq_no_ += num_delta_sizes;
+    last_timestamp_ = Timestamp::Micros(last_timestamp_us + wrap_offset_us);
+    index += num_delta_sizes;
+  }
+}
+
 const std::vector<TransportFeedback::ReceivedPacket>&
 TransportFeedback::GetReceivedPackets() const {
   return received_packets_;
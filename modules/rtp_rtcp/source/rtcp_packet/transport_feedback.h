@@ -16,6 +16,7 @@
 #include <vector>
 
 #include "absl/base/attributes.h"
+#include "api/array_view.h"
 #include "api/function_view.h"
 #include "api/units/time_delta.h"
 #include "api/units/timestamp.h"
@@ -65,6 +66,15 @@ class TransportFeedback : public Rtpfb {
   void SetFeedbackSequenceNumber(uint8_t feedback_sequence);
   // NOTE: This method requires increasing sequence numbers (excepting wraps).
   bool AddReceivedPacket(uint16_t sequence_number, Timestamp timestamp);
+  // Adds the packets with consecutive sequence numbers starting at
+  // `sequence_number`, where `arrival_times[i]` is the arrival time of packet
+  // `sequence_number + i`, or negative (e.g. minus infinity) if that packet
+  // wasn't received. Same as calling AddReceivedPacket() for each received
+  // packet in order, but the packet status chunks are encoded in a single
+  // pass. Returns the index of the first received packet that could not be
+  // added, or `arrival_times.size()` if all were added.
+  size_t AddReceivedPackets(uint16_t sequence_number,
+                            rtc::ArrayView<const Timestamp> arrival_times);
   const std::vector<ReceivedPacket>& GetReceivedPackets() const;
 
   // Calls `handler` for all packets this feedback describes.
@@ -125,6 +135,12 @@ class TransportFeedback : public Rtpfb {
     void Add(DeltaSize delta_size);
     // Equivalent to calling Add(0) `num_missing` times. Assumes `Empty()`.
     void AddMissingPackets(size_t num_missing);
+    // Equivalent to adding each of `delta_sizes` in order, appending the
+    // chunk returned by Emit() to `encoded_chunks` whenever one can't be
+    // added. Chunks that are complete within `delta_sizes` are encoded
+    // straight from it, and runs are added in bulk.
+    void AddAll(rtc::ArrayView<const DeltaSize> delta_sizes,
+                std::vector<uint16_t>& encoded_chunks);
 
     // Encode chunk as large as possible removing encoded delta sizes.
     // Assume CanAdd() == false for some valid delta_size.
@@ -152,6 +168,16 @@ class TransportFeedback : public Rtpfb {
     uint16_t EncodeRunLength() const;
     void DecodeRunLength(uint16_t chunk, size_t max_size);
 
+    // Adds `count` more of `delta_size`, which the chunk is either empty or
+    // only has. Assumes the result fits in a run length chunk.
+    void AddRun(DeltaSize delta_size, size_t count);
+    // Assuming `Empty()`, encodes the chunk that adding `delta_sizes` would
+    // start with, if that is known from them, appending it to
+    // `encoded_chunks`. Returns the number of delta sizes that were encoded or
+    // added to this chunk, or 0 if there are too few to tell.
+    size_t EncodeNext(rtc::ArrayView<const DeltaSize> delta_sizes,
+                      std::vector<uint16_t>& encoded_chunks);
+
     std::array<DeltaSize, kMaxVectorCapacity> delta_sizes_;
     size_t size_;
     bool all_same_;
@@ -10,9 +10,11 @@
 
 #include "modules/rtp_rtcp/source/rtcp_packet/transport_feedback.h"
 
+#include <algorithm>
 #include <limits>
 #include <memory>
 #include <utility>
+#include <vector>
 
 #include "absl/types/optional.h"
 #include "api/array_view.h"
@@ -20,6 +22,7 @@
 #include "api/units/timestamp.h"
 #include "modules/rtp_rtcp/source/byte_io.h"
 #include "modules/rtp_rtcp/source/rtcp_packet/common_header.h"
+#include "rtc_base/random.h"
 #include "test/gmock.h"
 #include "test/gtest.h"
 
@@ -29,6 +32,7 @@ namespace {
 using rtcp::TransportFeedback;
 using ::testing::AllOf;
 using ::testing::Each;
+using ::testing::ElementsAre;
 using ::testing::ElementsAreArray;
 using ::testing::Eq;
 using ::testing::InSequence;
@@ -664,5 +668,171 @@ TEST(TransportFeedbackTest, ReportsMissingPacketsWithoutTimestamps) {
   EXPECT_CALL(handler, Call(kBaseSeqNo + 3, Ne(TimeDelta::PlusInfinity())));
   Parse(feedback_builder.Build()).ForAllPackets(handler.AsStdFunction());
 }
+
+// Returns the arrival times of `num_packets` consecutive packets, where lost
+// packets have arrival time minus infinity. `large_delta_percent` of the
+// packets arrive late enough to need a two byte delta, and a few arrive out
+// of order.
+std::vector<Timestamp> CreateArrivalTimes(Random& random,
+                                          int num_packets,
+                                          int loss_percent,
+                                          int large_delta_percent) {
+  std::vector<Timestamp> arrival_times;
+  Timestamp arrival_time = Timestamp::Seconds(2000);
+  for (int i = 0; i < num_packets; ++i) {
+    int percent = random.Rand(0, 99);
+    if (percent < large_delta_percent) {
+      arrival_time += TimeDelta::Millis(random.Rand(64, 200));
+    } else if (percent == 99) {
+      arrival_time -= TimeDelta::Millis(random.Rand(1, 10));
+    } else {
+      arrival_time += TimeDelta::Micros(random.Rand(0, 5000));
+    }
+    arrival_times.push_back(random.Rand(0, 99) < loss_percent
+                                ? Timestamp::MinusInfinity()
+                                : arrival_time);
+  }
+  return arrival_times;
+}
+
+// Adds `arrival_times` to `feedback` one received packet at a time, like
+// TransportFeedback::AddReceivedPackets().
+size_t AddOneAtATime(TransportFeedback& feedback,
+                     uint16_t sequence_number,
+                     rtc::ArrayView<const Timestamp> arrival_times) {
+  for (size_t i = 0; i < arrival_times.size(); ++i) {
+    if (arrival_times[i] >= Timestamp::Zero() &&
+        !feedback.AddReceivedPacket(sequence_number + i, arrival_times[i])) {
+      return i;
+    }
+  }
+  return arrival_times.size();
+}
+
+TEST(TransportFeedbackTest, AddReceivedPacketsMatchesAddingOneAtATime) {
+  const uint16_t kBaseSeqNo = 65000;
+  Random random(0x5eed);
+  for (bool include_timestamps : {true, false}) {
+    for (int loss_percent : {0, 2, 30}) {
+      for (int large_delta_percent : {0, 3, 20, 100}) {
+        SCOPED_TRACE(::testing::Message()
+                     << "include_timestamps=" << include_timestamps
+                     << " loss=" << loss_percent
+                     << " large_delta=" << large_delta_percent);
+        std::vector<Timestamp> arrival_times = CreateArrivalTimes(
+            random, 3000, loss_percent, large_delta_percent);
+        arrival_times[0] = Timestamp::Seconds(2000);
+
+        TransportFeedback expected(include_timestamps);
+        expected.SetBase(kBaseSeqNo, arrival_times[0]);
+        EXPECT_EQ(AddOneAtATime(expected, kBaseSeqNo, arrival_times),
+                  arrival_times.size());
+
+        // Add in two parts, as if the arrival times wrapped around the end of
+        // a circular buffer.
+        rtc::ArrayView<const Timestamp> times(arrival_times);
+        TransportFeedback feedback(include_timestamps);
+        feedback.SetBase(kBaseSeqNo, arrival_times[0]);
+        EXPECT_EQ(feedback.AddReceivedPackets(kBaseSeqNo, times.subview(0, 1234)),
+                  1234u);
+        EXPECT_EQ(feedback.AddReceivedPackets(kBaseSeqNo + 1234,
+                                              times.subview(1234)),
+                  arrival_times.size() - 1234);
+
+        EXPECT_TRUE(feedback.IsConsistent());
+        EXPECT_EQ(feedback.GetPacketStatusCount(),
+                  expected.GetPacketStatusCount());
+        EXPECT_EQ(feedback.Build(), expected.Build());
+      }
+    }
+  }
+}
+
+TEST(TransportFeedbackTest, AddReceivedPacketsEncodesLongRunsLikeOneAtATime) {
+  const uint16_t kBaseSeqNo = 17;
+  const Timestamp kBaseTimestamp = Timestamp::Seconds(5);
+  // Runs of small deltas, large deltas and missing packets, some longer than
+  // fits in a run length chunk.
+  std::vector<Timestamp> arrival_times;
+  Timestamp arrival_time = kBaseTimestamp;
+  for (int run : {20000, 9, 13, 7, 8200, 1, 14, 6}) {
+    for (TimeDelta delta : {TimeDelta::Millis(1), TimeDelta::Millis(100),
+                            TimeDelta::PlusInfinity()}) {
+      for (int i = 0; i < run; ++i) {
+        if (delta.IsFinite()) {
+          arrival_time += delta;
+          arrival_times.push_back(arrival_time);
+        } else {
+          arrival_times.push_back(Timestamp::MinusInfinity());
+        }
+      }
+    }
+  }
+  // Stay within the number of packets a feedback can report, and end with a
+  // received packet.
+  arrival_times.resize(TransportFeedback::kMaxReportedPackets - 100,
+                       Timestamp::MinusInfinity());
+  arrival_times.back() =
+      *std::find_if(arrival_times.rbegin(), arrival_times.rend(),
+                    [](Timestamp time) { return time.IsFinite(); }) +
+      TimeDelta::Millis(1);
+
+  TransportFeedback expected;
+  expected.SetBase(kBaseSeqNo, kBaseTimestamp);
+  EXPECT_EQ(AddOneAtATime(expected, kBaseSeqNo, arrival_times),
+            arrival_times.size());
+
+  TransportFeedback feedback;
+  feedback.SetBase(kBaseSeqNo, kBaseTimestamp);
+  EXPECT_EQ(feedback.AddReceivedPackets(kBaseSeqNo, arrival_times),
+            arrival_times.size());
+  EXPECT_TRUE(feedback.IsConsistent());
+  EXPECT_EQ(feedback.GetPacketStatusCount(), expected.GetPacketStatusCount());
+  EXPECT_EQ(feedback.Build(), expected.Build());
+}
+
+TEST(TransportFeedbackTest, AddReceivedPacketsStopsAtPacketThatDoesNotFit) {
+  const uint16_t kBaseSeqNo = 100;
+  const Timestamp kBaseTimestamp = Timestamp::Seconds(5);
+  std::vector<Timestamp> arrival_times;
+  for (int i = 0; i < 300; ++i) {
+    arrival_times.push_back(kBaseTimestamp + TimeDelta::Millis(i));
+  }
+  arrival_times[299] = Timestamp::MinusInfinity();
+  arrival_times[298] = Timestamp::MinusInfinity();
+  // Too late to be represented by a delta from the previous packet.
+  arrival_times[297] = kBaseTimestamp + TimeDelta::Seconds(20);
+
+  TransportFeedback feedback;
+  feedback.SetBase(kBaseSeqNo, kBaseTimestamp);
+  EXPECT_EQ(feedback.AddReceivedPackets(kBaseSeqNo, arrival_times), 297u);
+  EXPECT_TRUE(feedback.IsConsistent());
+  EXPECT_EQ(feedback.GetPacketStatusCount(), 297u);
+  EXPECT_EQ(feedback.GetReceivedPackets().back().sequence_number(),
+            kBaseSeqNo + 296);
+}
+
+TEST(TransportFeedbackTest, AddReceivedPacketsDoesNotReportTrailingLosses) {
+  const uint16_t kBaseSeqNo = 100;
+  const Timestamp kBaseTimestamp = Timestamp::Seconds(5);
+  std::vector<Timestamp> arrival_times = {
+      Timestamp::MinusInfinity(), kBaseTimestamp, Timestamp::MinusInfinity(),
+      kBaseTimestamp + TimeDelta::Millis(1), Timestamp::MinusInfinity(),
+      Timestamp::MinusInfinity()};
+
+  TransportFeedback feedback;
+  feedback.SetBase(kBaseSeqNo, kBaseTimestamp);
+  EXPECT_EQ(feedback.AddReceivedPackets(kBaseSeqNo, arrival_times),
+            arrival_times.size());
+  EXPECT_TRUE(feedback.IsConsistent());
+  EXPECT_EQ(feedback.GetPacketStatusCount(), 4u);
+  EXPECT_THAT(feedback.GetReceivedPackets(),
+              ElementsAre(Property(&TransportFeedback::ReceivedPacket::
+                                       sequence_number,
+                                   kBaseSeqNo + 1),
+                          Property(&TransportFeedback::ReceivedPacket::
+                                       sequence_number,
+                                   kBaseSeqNo + 3)));
+}
 }  // namespace
 }  // namespace webrtc
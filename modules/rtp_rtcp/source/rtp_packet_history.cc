@@ -29,6 +29,11 @@ namespace {
 constexpr size_t kOldPayloadPaddingSizeHysteresis = 100;
 constexpr uint16_t kMaxOldPayloadPaddingSequenceNumber = 1 << 13;
 
+// Initial size of the ring of packets, grown by doubling. The ring never needs
+// more entries than there are sequence numbers.
+constexpr size_t kMinRingSize = 64;
+constexpr size_t kMaxRingSize = std::numeric_limits<uint16_t>::max() + 1;
+
 }  // namespace
 
 RtpPacketHistory::StoredPacket::StoredPacket(
@@ -56,6 +61,9 @@ RtpPacketHistory::RtpPacketHistory(Clock* clock, PaddingMode padding_mode)
       number_to_store_(0),
       mode_(StorageMode::kDisabled),
       rtt_(TimeDelta::MinusInfinity()),
+      first_sequence_number_(0),
+      window_size_(0),
+      retained_bytes_(0),
       packets_inserted_(0) {}
 
 RtpPacketHistory::~RtpPacketHistory() {}
@@ -103,27 +111,32 @@ void RtpPacketHistory::PutRtpPacket(std::unique_ptr<RtpPacketToSend> packet,
   // Store packet.
   const uint16_t rtp_seq_no = packet->SequenceNumber();
   int packet_index = GetPacketIndex(rtp_seq_no);
-  if (packet_index >= 0 &&
-      static_cast<size_t>(packet_index) < packet_history_.size() &&
-      packet_history_[packet_index].packet_ != nullptr) {
+  if (packet_index >= 0 && static_cast<size_t>(packet_index) < window_size_ &&
+      PacketAt(packet_index).packet_ != nullptr) {
     RTC_LOG(LS_WARNING) << "Duplicate packet inserted: " << rtp_seq_no;
     // Remove previous packet to avoid inconsistent state.
     RemovePacket(packet_index);
     packet_index = GetPacketIndex(rtp_seq_no);
   }
 
-  // Packet to be inserted ahead of first packet, expand front.
-  for (; packet_index < 0; ++packet_index) {
-    packet_history_.emplace_front();
-  }
-  // Packet to be inserted behind last packet, expand back.
-  while (static_cast<int>(packet_history_.size()) <= packet_index) {
-    packet_history_.emplace_back();
+  if (packet_index < 0) {
+    // Packet to be inserted ahead of first packet, expand front.
+    Reserve(window_size_ - packet_index);
+    first_sequence_number_ = rtp_seq_no;
+    window_size_ -= packet_index;
+    packet_index = 0;
+  } else if (window_size_ <= static_cast<size_t>(packet_index)) {
+    // Packet to be inserted behind last packet, expand back.
+    Reserve(packet_index + 1);
+    if (window_size_ == 0) {
+      first_sequence_number_ = rtp_seq_no;
+    }
+    window_size_ = packet_index + 1;
   }
 
   RTC_DCHECK_GE(packet_index, 0);
-  RTC_DCHECK_LT(packet_index, packet_history_.size());
-  RTC_DCHECK(packet_history_[packet_index].packet_ == nullptr);
+  RTC_DCHECK_LT(packet_index, window_size_);
+  RTC_DCHECK(PacketAt(packet_index).packet_ == nullptr);
 
   if (padding_mode_ == PaddingMode::kRecentLargePacket) {
     if ((!large_payload_packet_ ||
@@ -136,7 +149,8 @@ void RtpPacketHistory::PutRtpPacket(std::unique_ptr<RtpPacketToSend> packet,
     }
   }
 
-  packet_history_[packet_index] =
+  retained_bytes_ += packet->size();
+  PacketAt(packet_index) =
       StoredPacket(std::move(packet), send_time, packets_inserted_++);
 }
 
@@ -207,11 +221,10 @@ bool RtpPacketHistory::GetPacketState(uint16_t sequence_number) const {
   }
 
   int packet_index = GetPacketIndex(sequence_number);
-  if (packet_index < 0 ||
-      static_cast<size_t>(packet_index) >= packet_history_.size()) {
+  if (packet_index < 0 || static_cast<size_t>(packet_index) >= window_size_) {
     return false;
   }
-  const StoredPacket& packet = packet_history_[packet_index];
+  const StoredPacket& packet = PacketAt(packet_index);
   if (packet.packet_ == nullptr) {
     return false;
   }
@@ -256,14 +269,11 @@ std::unique_ptr<RtpPacketToSend> RtpPacketHistory::GetPayloadPaddingPacket(
   }
 
   StoredPacket* best_packet = nullptr;
-  if (!packet_history_.empty()) {
-    // Pick the last packet.
-    for (auto it = packet_history_.rbegin(); it != packet_history_.rend();
-         ++it) {
-      if (it->packet_ != nullptr) {
-        best_packet = &(*it);
-        break;
-      }
+  // Pick the last packet.
+  for (int i = static_cast<int>(window_size_) - 1; i >= 0; --i) {
+    if (PacketAt(i).packet_ != nullptr) {
+      best_packet = &PacketAt(i);
+      break;
     }
   }
   if (best_packet == nullptr) {
@@ -294,8 +304,7 @@ void RtpPacketHistory::CullAcknowledgedPackets(
   MutexLock lock(&lock_);
   for (uint16_t sequence_number : sequence_numbers) {
     int packet_index = GetPacketIndex(sequence_number);
-    if (packet_index < 0 ||
-        static_cast<size_t>(packet_index) >= packet_history_.size()) {
+    if (packet_index < 0 || static_cast<size_t>(packet_index) >= window_size_) {
       continue;
     }
     RemovePacket(packet_index);
@@ -307,8 +316,15 @@ void RtpPacketHistory::Clear() {
   Reset();
 }
 
+size_t RtpPacketHistory::GetRetainedBytes() const {
+  MutexLock lock(&lock_);
+  return retained_bytes_;
+}
+
 void RtpPacketHistory::Reset() {
   packet_history_.clear();
+  window_size_ = 0;
+  retained_bytes_ = 0;
   large_payload_packet_ = absl::nullopt;
 }
 
@@ -318,15 +334,15 @@ void RtpPacketHistory::CullOldPackets() {
       rtt_.IsFinite()
           ? std::max(kMinPacketDurationRtt * rtt_, kMinPacketDuration)
           : kMinPacketDuration;
-  while (!packet_history_.empty()) {
-    if (packet_history_.size() >= kMaxCapacity) {
+  while (window_size_ > 0) {
+    if (window_size_ >= kMaxCapacity) {
       // We have reached the absolute max capacity, remove one packet
       // unconditionally.
       RemovePacket(0);
       continue;
     }
 
-    const StoredPacket& stored_packet = packet_history_.front();
+    const StoredPacket& stored_packet = PacketAt(0);
     if (stored_packet.pending_transmission_) {
       // Don't remove packets in the pacer queue, pending tranmission.
       return;
@@ -337,7 +353,7 @@ void RtpPacketHistory::CullOldPackets() {
       return;
     }
 
-    if (packet_history_.size() >= number_to_store_ ||
+    if (window_size_ >= number_to_store_ ||
         stored_packet.send_time() +
                 (packet_duration * kPacketCullingDelayFactor) <=
             now) {
@@ -355,11 +371,14 @@ std::unique_ptr<RtpPacketToSend> RtpPacketHistory::RemovePacket(
     int packet_index) {
   // Move the packet out from the StoredPacket container.
   std::unique_ptr<RtpPacketToSend> rtp_packet =
-      std::move(packet_history_[packet_index].packet_);
+      std::move(PacketAt(packet_index).packet_);
+  if (rtp_packet != nullptr) {
+    retained_bytes_ -= rtp_packet->size();
+  }
   if (packet_index == 0) {
-    while (!packet_history_.empty() &&
-           packet_history_.front().packet_ == nullptr) {
-      packet_history_.pop_front();
+    while (window_size_ > 0 && PacketAt(0).packet_ == nullptr) {
+      ++first_sequence_number_;
+      --window_size_;
     }
   }
 
@@ -367,12 +386,12 @@ std::unique_ptr<RtpPacketToSend> RtpPacketHistory::RemovePacket(
 }
 
 int RtpPacketHistory::GetPacketIndex(uint16_t sequence_number) const {
-  if (packet_history_.empty()) {
+  if (window_size_ == 0) {
     return 0;
   }
 
-  RTC_DCHECK(packet_history_.front().packet_ != nullptr);
-  int first_seq = packet_history_.front().packet_->SequenceNumber();
+  RTC_DCHECK(PacketAt(0).packet_ != nullptr);
+  int first_seq = first_sequence_number_;
   if (first_seq == sequence_number) {
     return 0;
   }
@@ -396,11 +415,42 @@ int RtpPacketHistory::GetPacketIndex(uint16_t sequence_number) const {
 RtpPacketHistory::StoredPacket* RtpPacketHistory::GetStoredPacket(
     uint16_t sequence_number) {
   int index = GetPacketIndex(sequence_number);
-  if (index < 0 || static_cast<size_t>(index) >= packet_history_.size() ||
-      packet_history_[index].packet_ == nullptr) {
+  if (index < 0 || static_cast<size_t>(index) >= window_size_ ||
+      PacketAt(index).packet_ == nullptr) {
     return nullptr;
   }
-  return &packet_history_[index];
+  return &PacketAt(index);
+}
+
+RtpPacketHistory::StoredPacket& RtpPacketHistory::PacketAt(int packet_index) {
+  return const_cast<StoredPacket&>(
+      static_cast<const RtpPacketHistory*>(this)->PacketAt(packet_index));
+}
+
+const RtpPacketHistory::StoredPacket& RtpPacketHistory::PacketAt(
+    int packet_index) const {
+  RTC_DCHECK_GE(packet_index, 0);
+  RTC_DCHECK_LT(packet_index, window_size_);
+  const uint16_t sequence_number = first_sequence_number_ + packet_index;
+  return packet_history_[sequence_number & (packet_history_.size() - 1)];
+}
+
+void RtpPacketHistory::Reserve(size_t window_size) {
+  RTC_DCHECK_LE(window_size, kMaxRingSize);
+  size_t ring_size = std::max(kMinRingSize, packet_history_.size());
+  while (ring_size < window_size) {
+    ring_size *= 2;
+  }
+  if (ring_size == packet_history_.size()) {
+    return;
+  }
+  std::vector<StoredPacket> ring(ring_size);
+  for (size_t i = 0; i < window_size_; ++i) {
+    const uint16_t sequence_number = first_sequence_number_ + i;
+    ring[sequence_number & (ring_size - 1)] = std::move(
+        packet_history_[sequence_number & (packet_history_.size() - 1)]);
+  }
+  packet_history_ = std::move(ring);
 }
 
 }  // namespace webrtc
@@ -11,7 +11,6 @@
 #ifndef MODULES_RTP_RTCP_SOURCE_RTP_PACKET_HISTORY_H_
 #define MODULES_RTP_RTCP_SOURCE_RTP_PACKET_HISTORY_H_
 
-#include <deque>
 #include <map>
 #include <memory>
 #include <set>
@@ -122,6 +121,10 @@ class RtpPacketHistory {
   // capacity.
   void Clear();
 
+  // Returns the total size of the packets in the history, excluding the packet
+  // kept for padding with PaddingMode::kRecentLargePacket.
+  size_t GetRetainedBytes() const;
+
  private:
   class StoredPacket {
    public:
@@ -171,6 +174,12 @@ class RtpPacketHistory {
       RTC_EXCLUSIVE_LOCKS_REQUIRED(lock_);
   StoredPacket* GetStoredPacket(uint16_t sequence_number)
       RTC_EXCLUSIVE_LOCKS_REQUIRED(lock_);
+  // Returns the entry at `packet_index`, which must be in [0, `window_size_`).
+  StoredPacket& PacketAt(int packet_index) RTC_EXCLUSIVE_LOCKS_REQUIRED(lock_);
+  const StoredPacket& PacketAt(int packet_index) const
+      RTC_EXCLUSIVE_LOCKS_REQUIRED(lock_);
+  // Grows `packet_history_` to hold at least `window_size` entries.
+  void Reserve(size_t window_size) RTC_EXCLUSIVE_LOCKS_REQUIRED(lock_);
 
   Clock* const clock_;
   const PaddingMode padding_mode_;
@@ -179,13 +188,21 @@ class RtpPacketHistory {
   StorageMode mode_ RTC_GUARDED_BY(lock_);
   TimeDelta rtt_ RTC_GUARDED_BY(lock_);
 
-  // Queue of stored packets, ordered by sequence number, with older packets in
-  // the front and new packets being added to the back. Note that there may be
-  // wrap-arounds so the back may have a lower sequence number.
-  // Packets may also be removed out-of-order, in which case there will be
-  // instances of StoredPacket with `packet_` set to nullptr. The first and last
-  // entry in the queue will however always be populated.
-  std::deque<StoredPacket> packet_history_ RTC_GUARDED_BY(lock_);
+  // Ring of stored packets, indexed by sequence number modulo its size. The
+  // size is a power of two, and thus divides the sequence number space, so
+  // that a packet is found without searching or unwrapping its sequence
+  // number. The ring holds the `window_size_` consecutive sequence numbers
+  // starting at `first_sequence_number_`, with older packets in the front and
+  // new packets being added to the back. Packets may be removed out-of-order,
+  // in which case there will be instances of StoredPacket with `packet_` set
+  // to nullptr. The first entry of the window is always populated, and entries
+  // outside of it are always empty.
+  std::vector<StoredPacket> packet_history_ RTC_GUARDED_BY(lock_);
+  uint16_t first_sequence_number_ RTC_GUARDED_BY(lock_);
+  size_t window_size_ RTC_GUARDED_BY(lock_);
+
+  // Sum of the sizes of the packets in `packet_history_`.
+  size_t retained_bytes_ RTC_GUARDED_BY(lock_);
 
   // Total number of packets with inserted.
   uint64_t packets_inserted_ RTC_GUARDED_BY(lock_);
@@ -575,6 +575,44 @@ TEST_P(RtpPacketHistoryTest, OutOfOrderInsertRemoval) {
   }
 }
 
+TEST_P(RtpPacketHistoryTest, KeepsPacketsAcrossLargeSequenceNumberGaps) {
+  hist_.SetStorePacketsStatus(StorageMode::kStoreAndCull, 10);
+
+  // Gaps larger than the initial capacity of the history, in both directions.
+  const int seq_offsets[] = {0, 3000, -3000, 6000};
+  for (int offset : seq_offsets) {
+    hist_.PutRtpPacket(CreateRtpPacket(To16u(kStartSeqNum + offset)),
+                       fake_clock_.CurrentTime());
+  }
+
+  for (int offset : seq_offsets) {
+    EXPECT_TRUE(hist_.GetPacketState(To16u(kStartSeqNum + offset)));
+  }
+  EXPECT_FALSE(hist_.GetPacketState(To16u(kStartSeqNum + 1)));
+  EXPECT_FALSE(hist_.GetPacketState(To16u(kStartSeqNum - 1)));
+}
+
+TEST_P(RtpPacketHistoryTest, TracksRetainedBytes) {
+  hist_.SetStorePacketsStatus(StorageMode::kStoreAndCull, 10);
+  EXPECT_EQ(hist_.GetRetainedBytes(), 0u);
+
+  std::unique_ptr<RtpPacketToSend> packet = CreateRtpPacket(kStartSeqNum);
+  packet->SetPayloadSize(100);
+  const size_t packet_size = packet->size();
+  hist_.PutRtpPacket(std::move(packet), fake_clock_.CurrentTime());
+  packet = CreateRtpPacket(To16u(kStartSeqNum + 1));
+  packet->SetPayloadSize(200);
+  const size_t next_packet_size = packet->size();
+  hist_.PutRtpPacket(std::move(packet), fake_clock_.CurrentTime());
+  EXPECT_EQ(hist_.GetRetainedBytes(), packet_size + next_packet_size);
+
+  hist_.CullAcknowledgedPackets(std::vector<uint16_t>{kStartSeqNum});
+  EXPECT_EQ(hist_.GetRetainedBytes(), next_packet_size);
+
+  hist_.Clear();
+  EXPECT_EQ(hist_.GetRetainedBytes(), 0u);
+}
+
 TEST_P(RtpPacketHistoryTest, UsesLastPacketAsPaddingWithDefaultMode) {
   if (GetParam() != RtpPacketHistory::PaddingMode::kDefault) {
     GTEST_SKIP() << "Default padding prioritization required for this test";
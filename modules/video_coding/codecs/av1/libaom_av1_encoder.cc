@@ -35,6 +35,7 @@
 #include "modules/video_coding/svc/create_scalability_structure.h"
 #include "modules/video_coding/svc/scalable_video_controller.h"
 #include "modules/video_coding/svc/scalable_video_controller_no_layering.h"
+#include "modules/video_coding/utility/encoder_input_mapper.h"
 #include "rtc_base/checks.h"
 #include "rtc_base/experiments/encoder_info_settings.h"
 #include "rtc_base/logging.h"
@@ -125,6 +126,7 @@ class LibaomAv1Encoder final : public VideoEncoder {
   absl::optional<aom_svc_params_t> svc_params_;
   VideoCodec encoder_settings_;
   LibaomAv1EncoderSettings settings_;
+  EncoderInputMapper input_mapper_;
   aom_image_t* frame_for_encode_;
   aom_codec_ctx_t ctx_;
   aom_codec_enc_cfg_t cfg_;
@@ -584,36 +586,10 @@ int32_t LibaomAv1Encoder::Encode(
     return WEBRTC_VIDEO_CODEC_ERROR;
   }
 
-  rtc::scoped_refptr<VideoFrameBuffer> buffer = frame.video_frame_buffer();
-  absl::InlinedVector<VideoFrameBuffer::Type, kMaxPreferredPixelFormats>
-      supported_formats = {VideoFrameBuffer::Type::kI420,
-                           VideoFrameBuffer::Type::kNV12};
-  rtc::scoped_refptr<VideoFrameBuffer> mapped_buffer;
-  if (buffer->type() != VideoFrameBuffer::Type::kNative) {
-    // `buffer` is already mapped.
-    mapped_buffer = buffer;
-  } else {
-    // Attempt to map to one of the supported formats.
-    mapped_buffer = buffer->GetMappedFrameBuffer(supported_formats);
-  }
-
-  // Convert input frame to I420, if needed.
-  if (!mapped_buffer ||
-      (absl::c_find(supported_formats, mapped_buffer->type()) ==
-           supported_formats.end() &&
-       mapped_buffer->type() != VideoFrameBuffer::Type::kI420A)) {
-    rtc::scoped_refptr<I420BufferInterface> converted_buffer(buffer->ToI420());
-    if (!converted_buffer) {
-      RTC_LOG(LS_ERROR) << "Failed to convert "
-                        << VideoFrameBufferTypeToString(
-                               frame.video_frame_buffer()->type())
-                        << " image to I420. Can't encode frame.";
-      return WEBRTC_VIDEO_CODEC_ENCODER_FAILURE;
-    }
-    RTC_CHECK(converted_buffer->type() == VideoFrameBuffer::Type::kI420 ||
-              converted_buffer->type() == VideoFrameBuffer::Type::kI420A);
-
-    mapped_buffer = converted_buffer;
+  rtc::scoped_refptr<VideoFrameBuffer> mapped_buffer =
+      input_mapper_.Map(frame.video_frame_buffer()).buffer;
+  if (!mapped_buffer) {
+    return WEBRTC_VIDEO_CODEC_ENCODER_FAILURE;
   }
 
   switch (mapped_buffer->type()) {
@@ -853,6 +829,7 @@ VideoEncoder::EncoderInfo LibaomAv1Encoder::GetEncoderInfo() const {
           : VideoEncoder::ScalingSettings(kMinQindex, kMaxQindex);
   info.preferred_pixel_formats = {VideoFrameBuffer::Type::kI420,
                                   VideoFrameBuffer::Type::kNV12};
+  info.num_input_conversions = input_mapper_.num_conversions();
   if (SvcEnabled()) {
     for (int sid = 0; sid < svc_params_->number_spatial_layers; ++sid) {
       info.fps_allocation[sid].resize(svc_params_->number_temporal_layers);
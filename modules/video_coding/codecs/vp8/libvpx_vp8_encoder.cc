@@ -1321,6 +1321,7 @@ VideoEncoder::EncoderInfo LibvpxVp8Encoder::GetEncoderInfo() const {
   }
   info.preferred_pixel_formats = {VideoFrameBuffer::Type::kI420,
                                   VideoFrameBuffer::Type::kNV12};
+  info.num_input_conversions = input_mapper_.num_conversions();
 
   if (inited_) {
     // `encoder_idx` is libvpx index where 0 is highest resolution.
@@ -1388,36 +1389,15 @@ std::vector<rtc::scoped_refptr<VideoFrameBuffer>>
 LibvpxVp8Encoder::PrepareBuffers(rtc::scoped_refptr<VideoFrameBuffer> buffer) {
   RTC_DCHECK_EQ(buffer->width(), raw_images_[0].d_w);
   RTC_DCHECK_EQ(buffer->height(), raw_images_[0].d_h);
-  absl::InlinedVector<VideoFrameBuffer::Type, kMaxPreferredPixelFormats>
-      supported_formats = {VideoFrameBuffer::Type::kI420,
-                           VideoFrameBuffer::Type::kNV12};
-
-  rtc::scoped_refptr<VideoFrameBuffer> mapped_buffer;
-  if (buffer->type() != VideoFrameBuffer::Type::kNative) {
-    // `buffer` is already mapped.
-    mapped_buffer = buffer;
-  } else {
-    // Attempt to map to one of the supported formats.
-    mapped_buffer = buffer->GetMappedFrameBuffer(supported_formats);
-  }
-  if (!mapped_buffer ||
-      (absl::c_find(supported_formats, mapped_buffer->type()) ==
-           supported_formats.end() &&
-       mapped_buffer->type() != VideoFrameBuffer::Type::kI420A)) {
-    // Unknown pixel format or unable to map, convert to I420 and prepare that
-    // buffer instead to ensure Scale() is safe to use.
-    auto converted_buffer = buffer->ToI420();
-    if (!converted_buffer) {
-      RTC_LOG(LS_ERROR) << "Failed to convert "
-                        << VideoFrameBufferTypeToString(buffer->type())
-                        << " image to I420. Can't encode frame.";
-      return {};
-    }
-    RTC_CHECK(converted_buffer->type() == VideoFrameBuffer::Type::kI420 ||
-              converted_buffer->type() == VideoFrameBuffer::Type::kI420A);
-
-    // Because `buffer` had to be converted, use `converted_buffer` instead...
-    buffer = mapped_buffer = converted_buffer;
+  EncoderInputMapper::MappedBuffer mapped = input_mapper_.Map(buffer);
+  if (!mapped.buffer) {
+    return {};
+  }
+  rtc::scoped_refptr<VideoFrameBuffer> mapped_buffer = mapped.buffer;
+  if (mapped.converted) {
+    // Because `buffer` had to be converted, use `mapped_buffer` instead to
+    // ensure Scale() is safe to use.
+    buffer = mapped_buffer;
   }
 
   // Maybe update pixel format.
@@ -243,6 +243,32 @@ TEST_F(TestVp8Impl, EncodeI420FrameAfterNv12Frame) {
             encoder_->Encode(NextInputFrame(), nullptr));
 }
 
+TEST_F(TestVp8Impl, ReportsInputConversions) {
+  EXPECT_EQ(WEBRTC_VIDEO_CODEC_OK, encoder_->Release());
+  EXPECT_EQ(WEBRTC_VIDEO_CODEC_OK,
+            encoder_->InitEncode(&codec_settings_, kSettings));
+  EXPECT_EQ(encoder_->GetEncoderInfo().num_input_conversions, 0);
+
+  // I420 and NV12 frames are encoded in place.
+  EncodedImage encoded_frame;
+  CodecSpecificInfo codec_specific_info;
+  EncodeAndWaitForFrame(NextInputFrame(), &encoded_frame, &codec_specific_info);
+  input_frame_generator_ = test::CreateSquareFrameGenerator(
+      kWidth, kHeight, test::FrameGeneratorInterface::OutputType::kNV12,
+      absl::nullopt);
+  EncodeAndWaitForFrame(NextInputFrame(), &encoded_frame, &codec_specific_info);
+  EXPECT_EQ(encoder_->GetEncoderInfo().num_input_conversions, 0);
+
+  // I010 frames are converted to I420.
+  input_frame_generator_ = test::CreateSquareFrameGenerator(
+      kWidth, kHeight, test::FrameGeneratorInterface::OutputType::kI010,
+      absl::nullopt);
+  EncodeAndWaitForFrame(NextInputFrame(), &encoded_frame, &codec_specific_info);
+  EXPECT_EQ(encoder_->GetEncoderInfo().num_input_conversions, 1);
+
+  EXPECT_EQ(WEBRTC_VIDEO_CODEC_OK, encoder_->Release());
+}
+
 TEST_F(TestVp8Impl, Configure) {
   EXPECT_EQ(WEBRTC_VIDEO_CODEC_OK, decoder_->Release());
   EXPECT_TRUE(decoder_->Configure({}));
@@ -1043,6 +1069,7 @@ TEST_P(TestVp8ImplForPixelFormat, EncodeNativeFrameSimulcast) {
   EXPECT_EQ(mapped_buffers[2]->width(), kWidth / 4);
   EXPECT_EQ(mapped_buffers[2]->height(), kHeight / 4);
   EXPECT_FALSE(mappable_buffer->DidConvertToI420());
+  EXPECT_EQ(encoder_->GetEncoderInfo().num_input_conversions, 0);
 
   EXPECT_EQ(WEBRTC_VIDEO_CODEC_OK, encoder_->Release());
 }
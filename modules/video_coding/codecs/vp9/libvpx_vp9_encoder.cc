@@ -1144,6 +1144,7 @@ int LibvpxVp9Encoder::Encode(const VideoFrame& input_image,
           }
           i010_copy = I010Buffer::Copy(*i420_buffer);
           i010_buffer = i010_copy.get();
+          ++num_i010_conversions_;
         }
       }
       raw_->planes[VPX_PLANE_Y] = const_cast<uint8_t*>(
@@ -1771,6 +1772,8 @@ VideoEncoder::EncoderInfo LibvpxVp9Encoder::GetEncoderInfo() const {
   }
   info.has_trusted_rate_controller = trusted_rate_controller_;
   info.is_hardware_accelerated = false;
+  info.num_input_conversions =
+      input_mapper_.num_conversions() + num_i010_conversions_;
   if (inited_) {
     // Find the max configured fps of any active spatial layer.
     float max_fps = 0.0;
@@ -2009,36 +2012,10 @@ void LibvpxVp9Encoder::MaybeRewrapRawWithFormat(const vpx_img_fmt fmt) {
 
 rtc::scoped_refptr<VideoFrameBuffer> LibvpxVp9Encoder::PrepareBufferForProfile0(
     rtc::scoped_refptr<VideoFrameBuffer> buffer) {
-  absl::InlinedVector<VideoFrameBuffer::Type, kMaxPreferredPixelFormats>
-      supported_formats = {VideoFrameBuffer::Type::kI420,
-                           VideoFrameBuffer::Type::kNV12};
-
-  rtc::scoped_refptr<VideoFrameBuffer> mapped_buffer;
-  if (buffer->type() != VideoFrameBuffer::Type::kNative) {
-    // `buffer` is already mapped.
-    mapped_buffer = buffer;
-  } else {
-    // Attempt to map to one of the supported formats.
-    mapped_buffer = buffer->GetMappedFrameBuffer(supported_formats);
-  }
-  if (!mapped_buffer ||
-      (absl::c_find(supported_formats, mapped_buffer->type()) ==
-           supported_formats.end() &&
-       mapped_buffer->type() != VideoFrameBuffer::Type::kI420A)) {
-    // Unknown pixel format or unable to map, convert to I420 and prepare that
-    // buffer instead to ensure Scale() is safe to use.
-    auto converted_buffer = buffer->ToI420();
-    if (!converted_buffer) {
-      RTC_LOG(LS_ERROR) << "Failed to convert "
-                        << VideoFrameBufferTypeToString(buffer->type())
-                        << " image to I420. Can't encode frame.";
-      return {};
-    }
-    RTC_CHECK(converted_buffer->type() == VideoFrameBuffer::Type::kI420 ||
-              converted_buffer->type() == VideoFrameBuffer::Type::kI420A);
-
-    // Because `buffer` had to be converted, use `converted_buffer` instead.
-    buffer = mapped_buffer = converted_buffer;
+  rtc::scoped_refptr<VideoFrameBuffer> mapped_buffer =
+      input_mapper_.Map(std::move(buffer)).buffer;
+  if (!mapped_buffer) {
+    return {};
   }
 
   // Prepare `raw_` from `mapped_buffer`.
@@ -0,0 +1,144 @@
+/*
+ *  Copyright 2024 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <stdint.h>
+
+#include <memory>
+#include <queue>
+#include <utility>
+#include <vector>
+
+#include "api/units/time_delta.h"
+#include "api/units/timestamp.h"
+#include "benchmark/benchmark.h"
+#include "modules/include/module_common_types.h"
+#include "modules/video_coding/nack_requester.h"
+#include "modules/video_coding/packet_buffer.h"
+#include "rtc_base/random.h"
+#include "rtc_base/system/unused.h"
+#include "system_wrappers/include/clock.h"
+#include "test/run_loop.h"
+#include "test/scoped_key_value_config.h"
+
+namespace webrtc {
+namespace {
+
+// Packets of a stream in the order they are received, where each packet is
+// lost with the given probability and its retransmission is received
+// `kRetransmissionDelay` packets later.
+class LossyStream {
+ public:
+  static constexpr int kRetransmissionDelay = 20;
+
+  explicit LossyStream(double loss) : loss_(loss) {}
+
+  uint16_t NextReceived() {
+    if (!retransmissions_.empty() &&
+        retransmissions_.front().first <= num_sent_) {
+      const uint16_t seq_num = retransmissions_.front().second;
+      retransmissions_.pop();
+      return seq_num;
+    }
+    while (random_.Rand<double>() < loss_) {
+      retransmissions_.emplace(num_sent_ + kRetransmissionDelay, next_seq_num_);
+      ++next_seq_num_;
+      ++num_sent_;
+    }
+    ++num_sent_;
+    return next_seq_num_++;
+  }
+
+ private:
+  const double loss_;
+  Random random_{1234};
+  uint16_t next_seq_num_ = 0;
+  int64_t num_sent_ = 0;
+  // Sequence numbers to retransmit, with the number of packets sent when their
+  // retransmission is received.
+  std::queue<std::pair<int64_t, uint16_t>> retransmissions_;
+};
+
+class CountingNackSender : public NackSender, public KeyFrameRequestSender {
+ public:
+  void SendNack(const std::vector<uint16_t>& sequence_numbers,
+                bool buffering_allowed) override {
+    nacks_sent += sequence_numbers.size();
+  }
+  void RequestKeyFrame() override { ++key_frames_requested; }
+
+  int64_t nacks_sent = 0;
+  int64_t key_frames_requested = 0;
+};
+
+// Receives packets at 1000 packets per second with `state.range(0)` percent
+// loss, and runs the periodic NACK processing every 20 ms.
+void BM_NackRequesterOnReceivedPacket(benchmark::State& state) {
+  test::RunLoop loop;
+  test::ScopedKeyValueConfig field_trials;
+  SimulatedClock clock(Timestamp::Seconds(1));
+  NackPeriodicProcessor processor;
+  CountingNackSender sender;
+  NackRequester nack_requester(TaskQueueBase::Current(), &processor, &clock,
+                               &sender, &sender, field_trials);
+  nack_requester.UpdateRtt(/*rtt_ms=*/50);
+  LossyStream stream(state.range(0) / 100.0);
+
+  int64_t packets = 0;
+  for (auto s : state) {
+    RTC_UNUSED(s);
+    nack_requester.OnReceivedPacket(stream.NextReceived(),
+                                    /*is_recovered=*/false);
+    clock.AdvanceTime(TimeDelta::Millis(1));
+    if (++packets % 20 == 0) {
+      nack_requester.ProcessNacks();
+    }
+  }
+  state.SetItemsProcessed(packets);
+  state.counters["nacks_per_packet"] =
+      benchmark::Counter(sender.nacks_sent, benchmark::Counter::kAvgIterations);
+}
+
+BENCHMARK(BM_NackRequesterOnReceivedPacket)->Arg(5)->Arg(30);
+
+// Inserts the packets of frames of 8 packets each with `state.range(0)`
+// percent loss.
+void BM_PacketBufferInsertPacket(benchmark::State& state) {
+  constexpr int kPacketsPerFrame = 8;
+  video_coding::PacketBuffer packet_buffer(/*start_buffer_size=*/512,
+                                           /*max_buffer_size=*/2048);
+  LossyStream stream(state.range(0) / 100.0);
+
+  int64_t packets = 0;
+  int64_t frames = 0;
+  for (auto s : state) {
+    RTC_UNUSED(s);
+    auto packet = std::make_unique<video_coding::PacketBuffer::Packet>();
+    packet->seq_num = stream.NextReceived();
+    packet->timestamp = packet->seq_num / kPacketsPerFrame * 3000;
+    packet->video_header.is_first_packet_in_frame =
+        packet->seq_num % kPacketsPerFrame == 0;
+    packet->video_header.is_last_packet_in_frame =
+        packet->seq_num % kPacketsPerFrame == kPacketsPerFrame - 1;
+    video_coding::PacketBuffer::InsertResult result =
+        packet_buffer.InsertPacket(std::move(packet));
+    for (const auto& inserted : result.packets) {
+      frames += inserted->is_last_packet_in_frame();
+    }
+    ++packets;
+  }
+  state.SetItemsProcessed(packets);
+  state.counters["frames_per_packet"] =
+      benchmark::Counter(frames, benchmark::Counter::kAvgIterations);
+}
+
+BENCHMARK(BM_PacketBufferInsertPacket)->Arg(5)->Arg(30);
+
+}  // namespace
+}  // namespace webrtc
@@ -29,6 +29,9 @@ constexpr int kMaxNackRetries = 10;
 constexpr int kMaxReorderedPackets = 128;
 constexpr int kNumReorderingBuckets = 10;
 constexpr TimeDelta kDefaultSendNackDelay = TimeDelta::Zero();
+// Covers the packets up to `kMaxPacketAge` older than the newest one.
+constexpr int kSeqNumBitmapSize = 1 << 14;
+static_assert(kSeqNumBitmapSize > kMaxPacketAge);
 
 TimeDelta GetSendNackDelay(const FieldTrialsView& field_trials) {
   int64_t delay_ms = strtol(
@@ -114,6 +117,8 @@ NackRequester::NackRequester(TaskQueueBase* current_queue,
       clock_(clock),
       nack_sender_(nack_sender),
       keyframe_request_sender_(keyframe_request_sender),
+      unsent_nacks_(kSeqNumBitmapSize),
+      recovered_list_(kSeqNumBitmapSize),
       reordering_histogram_(kNumReorderingBuckets, kMaxReorderedPackets),
       initialized_(false),
       rtt_(kDefaultRtt),
@@ -168,10 +173,11 @@ int NackRequester::OnReceivedPacket(uint16_t seq_num,
 
   if (AheadOf(newest_seq_num_, seq_num)) {
     // An out of order packet has been received.
-    auto nack_list_it = nack_list_.find(seq_num);
+    auto nack_list_it = LowerBound(nack_list_.begin(), seq_num);
     int nacks_sent_for_packet = 0;
-    if (nack_list_it != nack_list_.end()) {
-      nacks_sent_for_packet = nack_list_it->second.retries;
+    if (nack_list_it != nack_list_.end() && nack_list_it->seq_num == seq_num) {
+      nacks_sent_for_packet = nack_list_it->retries;
+      unsent_nacks_.Erase(seq_num);
       nack_list_.erase(nack_list_it);
     }
     if (!is_retransmitted)
@@ -180,12 +186,10 @@ int NackRequester::OnReceivedPacket(uint16_t seq_num,
   }
 
   if (is_recovered) {
-    recovered_list_.insert(seq_num);
+    recovered_list_.Insert(seq_num);
 
     // Remove old ones so we don't accumulate recovered packets.
-    auto it = recovered_list_.lower_bound(seq_num - kMaxPacketAge);
-    if (it != recovered_list_.begin())
-      recovered_list_.erase(recovered_list_.begin(), it);
+    recovered_list_.EraseOlderThan(seq_num - kMaxPacketAge);
 
     // Do not send nack for packets recovered by FEC or RTX.
     return 0;
@@ -212,9 +216,9 @@ void NackRequester::ClearUpTo(uint16_t seq_num) {
   // needs to be posted to the worker thread if callers migrate to the network
   // thread.
   RTC_DCHECK_RUN_ON(worker_thread_);
-  nack_list_.erase(nack_list_.begin(), nack_list_.lower_bound(seq_num));
-  recovered_list_.erase(recovered_list_.begin(),
-                        recovered_list_.lower_bound(seq_num));
+  nack_list_.erase(nack_list_.begin(),
+                   LowerBound(nack_list_.begin(), seq_num));
+  recovered_list_.EraseOlderThan(seq_num);
 }
 
 void NackRequester::UpdateRtt(int64_t rtt_ms) {
@@ -226,12 +230,13 @@ void NackRequester::AddPacketsToNack(uint16_t seq_num_start,
                                      uint16_t seq_num_end) {
   // Called on worker_thread_.
   // Remove old packets.
-  auto it = nack_list_.lower_bound(seq_num_end - kMaxPacketAge);
+  auto it = LowerBound(nack_list_.begin(), seq_num_end - kMaxPacketAge);
   nack_list_.erase(nack_list_.begin(), it);
 
   uint16_t num_new_nacks = ForwardDiff(seq_num_start, seq_num_end);
   if (nack_list_.size() + num_new_nacks > kMaxNackPackets) {
     nack_list_.clear();
+    unsent_nacks_.Clear();
     RTC_LOG(LS_WARNING) << "NACK list full, clearing NACK"
                            " list and requesting keyframe.";
     keyframe_request_sender_->RequestKeyFrame();
@@ -240,15 +245,29 @@ void NackRequester::AddPacketsToNack(uint16_t seq_num_start,
 
   for (uint16_t seq_num = seq_num_start; seq_num != seq_num_end; ++seq_num) {
     // Do not send nack for packets that are already recovered by FEC or RTX
-    if (recovered_list_.find(seq_num) != recovered_list_.end())
+    if (recovered_list_.Contains(seq_num))
       continue;
-    NackInfo nack_info(seq_num, seq_num + WaitNumberOfPackets(0.5),
-                       clock_->CurrentTime());
-    RTC_DCHECK(nack_list_.find(seq_num) == nack_list_.end());
-    nack_list_[seq_num] = nack_info;
+    RTC_DCHECK(nack_list_.empty() ||
+               AheadOf(seq_num, nack_list_.back().seq_num));
+    nack_list_.emplace_back(seq_num, seq_num + WaitNumberOfPackets(0.5),
+                            clock_->CurrentTime());
+    unsent_nacks_.Insert(seq_num);
   }
 }
 
+std::deque<NackRequester::NackInfo>::iterator NackRequester::LowerBound(
+    std::deque<NackInfo>::iterator begin,
+    uint16_t seq_num) {
+  // Most lookups are for the first entry, which is cheaper to check directly.
+  if (begin == nack_list_.end() || !AheadOf(seq_num, begin->seq_num)) {
+    return begin;
+  }
+  return std::lower_bound(std::next(begin), nack_list_.end(), seq_num,
+                          [](const NackInfo& nack_info, uint16_t seq_num) {
+                            return AheadOf(seq_num, nack_info.seq_num);
+                          });
+}
+
 std::vector<uint16_t> NackRequester::GetNackBatch(NackFilterOptions options) {
   // Called on worker_thread_.
 
@@ -258,18 +277,31 @@ std::vector<uint16_t> NackRequester::GetNackBatch(NackFilterOptions options) {
   std::vector<uint16_t> nack_batch;
   auto it = nack_list_.begin();
   while (it != nack_list_.end()) {
-    bool delay_timed_out = now - it->second.created_at_time >= send_nack_delay_;
-    bool nack_on_rtt_passed = now - it->second.sent_at_time >= rtt_;
+    if (!consider_timestamp) {
+      // Skip to the next packet that has not been NACKed yet, as the others
+      // cannot be NACKed by sequence number.
+      const uint16_t first = it->seq_num;
+      absl::optional<uint16_t> next_unsent = unsent_nacks_.FindFirst(
+          first, ForwardDiff(first, nack_list_.back().seq_num) + 1);
+      if (!next_unsent) {
+        break;
+      }
+      it = LowerBound(it, *next_unsent);
+      RTC_DCHECK(it != nack_list_.end());
+    }
+    bool delay_timed_out = now - it->created_at_time >= send_nack_delay_;
+    bool nack_on_rtt_passed = now - it->sent_at_time >= rtt_;
     bool nack_on_seq_num_passed =
-        it->second.sent_at_time.IsInfinite() &&
-        AheadOrAt(newest_seq_num_, it->second.send_at_seq_num);
+        it->sent_at_time.IsInfinite() &&
+        AheadOrAt(newest_seq_num_, it->send_at_seq_num);
     if (delay_timed_out && ((consider_seq_num && nack_on_seq_num_passed) ||
                             (consider_timestamp && nack_on_rtt_passed))) {
-      nack_batch.emplace_back(it->second.seq_num);
-      ++it->second.retries;
-      it->second.sent_at_time = now;
-      if (it->second.retries >= kMaxNackRetries) {
-        RTC_LOG(LS_WARNING) << "Sequence number " << it->second.seq_num
+      nack_batch.emplace_back(it->seq_num);
+      ++it->retries;
+      it->sent_at_time = now;
+      unsent_nacks_.Erase(it->seq_num);
+      if (it->retries >= kMaxNackRetries) {
+        RTC_LOG(LS_WARNING) << "Sequence number " << it->seq_num
                             << " removed from NACK list due to max retries.";
         it = nack_list_.erase(it);
       } else {
@@ -13,8 +13,7 @@
 
 #include <stdint.h>
 
-#include <map>
-#include <set>
+#include <deque>
 #include <vector>
 
 #include "api/field_trials_view.h"
@@ -25,6 +24,7 @@
 #include "api/units/timestamp.h"
 #include "modules/include/module_common_types.h"
 #include "modules/video_coding/histogram.h"
+#include "modules/video_coding/sequence_number_bitmap.h"
 #include "rtc_base/numerics/sequence_number_util.h"
 #include "rtc_base/task_utils/repeating_task.h"
 #include "rtc_base/thread_annotations.h"
@@ -108,6 +108,12 @@ class NackRequester final : public NackRequesterBase {
   void AddPacketsToNack(uint16_t seq_num_start, uint16_t seq_num_end)
       RTC_EXCLUSIVE_LOCKS_REQUIRED(worker_thread_);
 
+  // Returns the first entry of `nack_list_` from `begin` on that is not older
+  // than `seq_num`.
+  std::deque<NackInfo>::iterator LowerBound(
+      std::deque<NackInfo>::iterator begin,
+      uint16_t seq_num) RTC_EXCLUSIVE_LOCKS_REQUIRED(worker_thread_);
+
   std::vector<uint16_t> GetNackBatch(NackFilterOptions options)
       RTC_EXCLUSIVE_LOCKS_REQUIRED(worker_thread_);
 
@@ -128,9 +134,17 @@ class NackRequester final : public NackRequesterBase {
   // TODO(philipel): Some of the variables below are consistently used on a
   // known thread (e.g. see `initialized_`). Those probably do not need
   // synchronized access.
-  std::map<uint16_t, NackInfo, DescendingSeqNumComp<uint16_t>> nack_list_
+  // Packets to NACK, ordered by sequence number. Packets are always added to
+  // the back, as they are newer than all packets received so far.
+  std::deque<NackInfo> nack_list_ RTC_GUARDED_BY(worker_thread_);
+  // Sequence numbers of the packets in `nack_list_` that have not been NACKed
+  // yet, which are the only ones that can be NACKed by sequence number. Only
+  // read from the first packet in `nack_list_` on, so packets dropped from the
+  // front of the list need not be erased.
+  video_coding::SequenceNumberBitmap unsent_nacks_
       RTC_GUARDED_BY(worker_thread_);
-  std::set<uint16_t, DescendingSeqNumComp<uint16_t>> recovered_list_
+  // Packets recovered by FEC or RTX, which are not to be NACKed.
+  video_coding::SequenceNumberBitmap recovered_list_
       RTC_GUARDED_BY(worker_thread_);
   video_coding::Histogram reordering_histogram_ RTC_GUARDED_BY(worker_thread_);
   bool initialized_ RTC_GUARDED_BY(worker_thread_);
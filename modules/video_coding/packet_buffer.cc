@@ -33,6 +33,14 @@
 
 namespace webrtc {
 namespace video_coding {
+namespace {
+
+// Packets missing for longer are forgotten.
+constexpr int kMaxPaddingAge = 1000;
+constexpr int kMissingPacketsWindowSize = 1024;
+static_assert(kMissingPacketsWindowSize > kMaxPaddingAge);
+
+}  // namespace
 
 PacketBuffer::Packet::Packet(const RtpPacketReceived& rtp_packet,
                              const RTPVideoHeader& video_header)
@@ -49,6 +57,8 @@ PacketBuffer::PacketBuffer(size_t start_buffer_size, size_t max_buffer_size)
       first_packet_received_(false),
       is_cleared_to_first_seq_num_(false),
       buffer_(start_buffer_size),
+      missing_packets_(kMissingPacketsWindowSize),
+      received_padding_(SequenceNumberBitmap::kMaxWindowSize),
       sps_pps_idr_is_h264_keyframe_(false) {
   RTC_DCHECK_LE(start_buffer_size, max_buffer_size);
   // Buffer size must always be a power of 2.
@@ -114,9 +124,7 @@ PacketBuffer::InsertResult PacketBuffer::InsertPacket(
 
   UpdateMissingPackets(seq_num);
 
-  received_padding_.erase(
-      received_padding_.begin(),
-      received_padding_.lower_bound(seq_num - (buffer_.size() / 4)));
+  received_padding_.EraseOlderThan(seq_num - (buffer_.size() / 4));
 
   result.packets = FindFrames(seq_num);
   return result;
@@ -151,11 +159,9 @@ void PacketBuffer::ClearTo(uint16_t seq_num) {
   first_seq_num_ = seq_num;
 
   is_cleared_to_first_seq_num_ = true;
-  missing_packets_.erase(missing_packets_.begin(),
-                         missing_packets_.lower_bound(seq_num));
+  missing_packets_.EraseOlderThan(seq_num);
 
-  received_padding_.erase(received_padding_.begin(),
-                          received_padding_.lower_bound(seq_num));
+  received_padding_.EraseOlderThan(seq_num);
 }
 
 void PacketBuffer::Clear() {
@@ -165,7 +171,7 @@ void PacketBuffer::Clear() {
 PacketBuffer::InsertResult PacketBuffer::InsertPadding(uint16_t seq_num) {
   PacketBuffer::InsertResult result;
   UpdateMissingPackets(seq_num);
-  received_padding_.insert(seq_num);
+  received_padding_.Insert(seq_num);
   result.packets = FindFrames(static_cast<uint16_t>(seq_num + 1));
   return result;
 }
@@ -186,8 +192,8 @@ void PacketBuffer::ClearInternal() {
   first_packet_received_ = false;
   is_cleared_to_first_seq_num_ = false;
   newest_inserted_seq_num_.reset();
-  missing_packets_.clear();
-  received_padding_.clear();
+  missing_packets_.Clear();
+  received_padding_.Clear();
 }
 
 bool PacketBuffer::ExpandBufferSize() {
@@ -239,7 +245,7 @@ std::vector<std::unique_ptr<PacketBuffer::Packet>> PacketBuffer::FindFrames(
   auto start = seq_num;
 
   for (size_t i = 0; i < buffer_.size(); ++i) {
-    if (received_padding_.find(seq_num) != received_padding_.end()) {
+    if (received_padding_.Contains(seq_num)) {
       seq_num += 1;
       continue;
     }
@@ -367,9 +373,11 @@ std::vector<std::unique_ptr<PacketBuffer::Packet>> PacketBuffer::FindFrames(
 
         // If this is not a keyframe, make sure there are no gaps in the packet
         // sequence numbers up until this point.
-        if (!is_h264_keyframe && missing_packets_.upper_bound(start_seq_num) !=
-                                     missing_packets_.begin()) {
-          return found_frames;
+        if (!is_h264_keyframe) {
+          absl::optional<uint16_t> oldest_missing = missing_packets_.Oldest();
+          if (oldest_missing && !AheadOf(*oldest_missing, start_seq_num)) {
+            return found_frames;
+          }
         }
       }
 
@@ -388,10 +396,8 @@ std::vector<std::unique_ptr<PacketBuffer::Packet>> PacketBuffer::FindFrames(
           found_frames.push_back(std::move(packet));
         }
 
-        missing_packets_.erase(missing_packets_.begin(),
-                               missing_packets_.upper_bound(seq_num));
-        received_padding_.erase(received_padding_.lower_bound(start),
-                                received_padding_.upper_bound(seq_num));
+        missing_packets_.EraseOlderThan(seq_num + 1);
+        received_padding_.EraseRange(start, ForwardDiff(start, seq_num) + 1);
       }
     }
     ++seq_num;
@@ -403,11 +409,9 @@ void PacketBuffer::UpdateMissingPackets(uint16_t seq_num) {
   if (!newest_inserted_seq_num_)
     newest_inserted_seq_num_ = seq_num;
 
-  const int kMaxPaddingAge = 1000;
   if (AheadOf(seq_num, *newest_inserted_seq_num_)) {
     uint16_t old_seq_num = seq_num - kMaxPaddingAge;
-    auto erase_to = missing_packets_.lower_bound(old_seq_num);
-    missing_packets_.erase(missing_packets_.begin(), erase_to);
+    missing_packets_.EraseOlderThan(old_seq_num);
 
     // Guard against inserting a large amount of missing packets if there is a
     // jump in the sequence number.
@@ -415,12 +419,12 @@ void PacketBuffer::UpdateMissingPackets(uint16_t seq_num) {
       *newest_inserted_seq_num_ = old_seq_num;
 
     ++*newest_inserted_seq_num_;
-    while (AheadOf(seq_num, *newest_inserted_seq_num_)) {
-      missing_packets_.insert(*newest_inserted_seq_num_);
-      ++*newest_inserted_seq_num_;
-    }
+    missing_packets_.InsertRange(
+        *newest_inserted_seq_num_,
+        ForwardDiff(*newest_inserted_seq_num_, seq_num));
+    *newest_inserted_seq_num_ = seq_num;
   } else {
-    missing_packets_.erase(seq_num);
+    missing_packets_.Erase(seq_num);
   }
 }
 
@@ -13,7 +13,6 @@
 
 #include <memory>
 #include <queue>
-#include <set>
 #include <vector>
 
 #include "absl/base/attributes.h"
@@ -22,6 +21,7 @@
 #include "api/video/encoded_image.h"
 #include "modules/rtp_rtcp/source/rtp_packet_received.h"
 #include "modules/rtp_rtcp/source/rtp_video_header.h"
+#include "modules/video_coding/sequence_number_bitmap.h"
 #include "rtc_base/copy_on_write_buffer.h"
 #include "rtc_base/numerics/sequence_number_util.h"
 #include "rtc_base/thread_annotations.h"
@@ -116,9 +116,9 @@ class PacketBuffer {
   std::vector<std::unique_ptr<Packet>> buffer_;
 
   absl::optional<uint16_t> newest_inserted_seq_num_;
-  std::set<uint16_t, DescendingSeqNumComp<uint16_t>> missing_packets_;
+  SequenceNumberBitmap missing_packets_;
 
-  std::set<uint16_t, DescendingSeqNumComp<uint16_t>> received_padding_;
+  SequenceNumberBitmap received_padding_;
 
   // Indicates if we should require SPS, PPS, and IDR for a particular
   // RTP timestamp to treat the corresponding frame as a keyframe.
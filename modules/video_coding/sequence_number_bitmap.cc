@@ -0,0 +1,192 @@
+/*
+ *  Copyright 2024 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/video_coding/sequence_number_bitmap.h"
+
+#include <algorithm>
+
+#include "absl/numeric/bits.h"
+#include "rtc_base/checks.h"
+#include "rtc_base/numerics/sequence_number_util.h"
+
+namespace webrtc {
+namespace video_coding {
+namespace {
+
+constexpr int kBitsPerWord = 64;
+
+}  // namespace
+
+template <typename Fn>
+void SequenceNumberBitmap::ForEachWord(int offset, int count, Fn fn) const {
+  int bit = (WindowStart() + offset) & (window_size_ - 1);
+  while (count > 0) {
+    const int bit_in_word = bit % kBitsPerWord;
+    const int num_bits = std::min(count, kBitsPerWord - bit_in_word);
+    const uint64_t mask = (num_bits == kBitsPerWord
+                               ? ~uint64_t{0}
+                               : (uint64_t{1} << num_bits) - 1)
+                          << bit_in_word;
+    if (fn(bit / kBitsPerWord, mask)) {
+      return;
+    }
+    count -= num_bits;
+    bit = (bit + num_bits) & (window_size_ - 1);
+  }
+}
+
+SequenceNumberBitmap::SequenceNumberBitmap(int window_size)
+    : window_size_(window_size), words_(window_size / kBitsPerWord) {
+  RTC_DCHECK_GE(window_size, kBitsPerWord);
+  RTC_DCHECK_LE(window_size, kMaxWindowSize);
+  RTC_DCHECK(absl::has_single_bit(static_cast<unsigned>(window_size)));
+}
+
+SequenceNumberBitmap::~SequenceNumberBitmap() = default;
+
+bool SequenceNumberBitmap::Contains(uint16_t seq_num) const {
+  int count = 1;
+  int offset;
+  if (!ClipToWindow(seq_num, count, offset)) {
+    return false;
+  }
+  const int bit = seq_num & (window_size_ - 1);
+  return (words_[bit / kBitsPerWord] >> (bit % kBitsPerWord)) & 1;
+}
+
+void SequenceNumberBitmap::InsertRange(uint16_t first, int count) {
+  RTC_DCHECK_GE(count, 0);
+  RTC_DCHECK_LE(count, window_size_);
+  if (count == 0) {
+    return;
+  }
+  const uint16_t last = first + count - 1;
+  if (!end_ || AheadOrAt(last, *end_)) {
+    AdvanceTo(last + 1);
+  }
+  int offset;
+  if (!ClipToWindow(first, count, offset)) {
+    return;
+  }
+  const uint16_t clipped_first = WindowStart() + offset;
+  if (AheadOf(begin_, clipped_first)) {
+    begin_ = clipped_first;
+  }
+  ForEachWord(offset, count, [this](int index, uint64_t mask) {
+    words_[index] |= mask;
+    return false;
+  });
+}
+
+void SequenceNumberBitmap::EraseRange(uint16_t first, int count) {
+  RTC_DCHECK_GE(count, 0);
+  int offset;
+  if (!ClipToWindow(first, count, offset)) {
+    return;
+  }
+  ForEachWord(offset, count, [this](int index, uint64_t mask) {
+    words_[index] &= ~mask;
+    return false;
+  });
+}
+
+void SequenceNumberBitmap::EraseOlderThan(uint16_t seq_num) {
+  if (!end_) {
+    return;
+  }
+  if (AheadOrAt(seq_num, *end_)) {
+    seq_num = *end_;
+  } else if (!AheadOf(seq_num, begin_)) {
+    return;
+  }
+  // Only the sequence numbers from `begin_` on can be in the set, so each one
+  // is erased at most once however often this is called.
+  EraseRange(begin_, ForwardDiff(begin_, seq_num));
+  begin_ = seq_num;
+}
+
+void SequenceNumberBitmap::Clear() {
+  std::fill(words_.begin(), words_.end(), 0);
+  end_ = absl::nullopt;
+}
+
+absl::optional<uint16_t> SequenceNumberBitmap::FindFirst(uint16_t first,
+                                                         int count) const {
+  RTC_DCHECK_GE(count, 0);
+  int offset;
+  if (!ClipToWindow(first, count, offset)) {
+    return absl::nullopt;
+  }
+  absl::optional<uint16_t> found;
+  ForEachWord(offset, count, [&](int index, uint64_t mask) {
+    const uint64_t bits = words_[index] & mask;
+    if (bits == 0) {
+      return false;
+    }
+    const int bit = index * kBitsPerWord + absl::countr_zero(bits);
+    found = WindowStart() + ((bit - WindowStart()) & (window_size_ - 1));
+    return true;
+  });
+  return found;
+}
+
+absl::optional<uint16_t> SequenceNumberBitmap::Oldest() const {
+  if (!end_) {
+    return absl::nullopt;
+  }
+  return FindFirst(begin_, ForwardDiff(begin_, *end_));
+}
+
+bool SequenceNumberBitmap::ClipToWindow(uint16_t first,
+                                        int& count,
+                                        int& offset) const {
+  if (!end_ || count <= 0 || AheadOrAt(first, *end_)) {
+    return false;
+  }
+  // `first` is older than `end_`, by less than half the sequence number space,
+  // and `window_size_` is at most a quarter of it, so the offset fits.
+  offset = static_cast<int16_t>(first - WindowStart());
+  if (offset < 0) {
+    count += offset;
+    offset = 0;
+  }
+  count = std::min(count, window_size_ - offset);
+  return count > 0;
+}
+
+void SequenceNumberBitmap::AdvanceTo(uint16_t end) {
+  if (end_) {
+    const int distance = ForwardDiff(*end_, end);
+    if (distance >= window_size_) {
+      std::fill(words_.begin(), words_.end(), 0);
+      begin_ = end;
+    } else {
+      // The sequence numbers entering the window share their bits with those
+      // leaving it.
+      ForEachWord(0, distance, [this](int index, uint64_t mask) {
+        words_[index] &= ~mask;
+        return false;
+      });
+    }
+  } else {
+    begin_ = end;
+  }
+  end_ = end;
+  if (AheadOf(WindowStart(), begin_)) {
+    begin_ = WindowStart();
+  }
+}
+
+uint16_t SequenceNumberBitmap::WindowStart() const {
+  return *end_ - window_size_;
+}
+
+}  // namespace video_coding
+}  // namespace webrtc
@@ -0,0 +1,95 @@
+/*
+ *  Copyright 2024 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef MODULES_VIDEO_CODING_SEQUENCE_NUMBER_BITMAP_H_
+#define MODULES_VIDEO_CODING_SEQUENCE_NUMBER_BITMAP_H_
+
+#include <stdint.h>
+
+#include <vector>
+
+#include "absl/types/optional.h"
+
+namespace webrtc {
+namespace video_coding {
+
+// A set of RTP sequence numbers within a sliding window of the `window_size`
+// most recent sequence numbers, stored as one bit per sequence number. The
+// window ends at the newest sequence number ever inserted, and sequence numbers
+// that fall out of it are dropped from the set. Searches scan 64 sequence
+// numbers at a time, so that sparse sets are searched quickly.
+class SequenceNumberBitmap {
+ public:
+  static constexpr int kMaxWindowSize = 1 << 14;
+
+  // `window_size` must be a power of two between 64 and `kMaxWindowSize`.
+  explicit SequenceNumberBitmap(int window_size);
+  SequenceNumberBitmap(const SequenceNumberBitmap&) = delete;
+  SequenceNumberBitmap& operator=(const SequenceNumberBitmap&) = delete;
+  ~SequenceNumberBitmap();
+
+  bool Contains(uint16_t seq_num) const;
+
+  // Inserts the `count` sequence numbers starting at `first`, where `count`
+  // is at most the window size. Moves the window forward if they are newer
+  // than the newest sequence number inserted so far. Sequence numbers older
+  // than the window are ignored.
+  void InsertRange(uint16_t first, int count);
+  void Insert(uint16_t seq_num) { InsertRange(seq_num, 1); }
+
+  void EraseRange(uint16_t first, int count);
+  void Erase(uint16_t seq_num) { EraseRange(seq_num, 1); }
+
+  // Erases the sequence numbers older than `seq_num`.
+  void EraseOlderThan(uint16_t seq_num);
+
+  // Erases all sequence numbers and resets the window.
+  void Clear();
+
+  // Returns the oldest sequence number in the set among the `count` sequence
+  // numbers starting at `first`.
+  absl::optional<uint16_t> FindFirst(uint16_t first, int count) const;
+
+  // Returns the oldest sequence number in the set.
+  absl::optional<uint16_t> Oldest() const;
+
+ private:
+  // Calls `fn(index, mask)` for the words of `words_` that hold the bits of
+  // the `count` sequence numbers starting `offset` into the window, in order,
+  // until it returns true. `mask` selects the bits of the range in the word.
+  template <typename Fn>
+  void ForEachWord(int offset, int count, Fn fn) const;
+
+  // Clips the range of `count` sequence numbers starting at `first` to the
+  // window. Returns false if no part of the range is in the window, and
+  // otherwise sets `offset` to the offset of the clipped range from the start
+  // of the window.
+  bool ClipToWindow(uint16_t first, int& count, int& offset) const;
+
+  // Moves the window forward to end just before `end`.
+  void AdvanceTo(uint16_t end);
+
+  uint16_t WindowStart() const;
+
+  const int window_size_;
+  // One bit per sequence number, indexed by sequence number modulo
+  // `window_size_`.
+  std::vector<uint64_t> words_;
+  // One past the newest sequence number in the window, if any.
+  absl::optional<uint16_t> end_;
+  // The sequence numbers in the window older than `begin_` are not in the set.
+  // Valid only when `end_` is set.
+  uint16_t begin_ = 0;
+};
+
+}  // namespace video_coding
+}  // namespace webrtc
+
+#endif  // MODULES_VIDEO_CODING_SEQUENCE_NUMBER_BITMAP_H_
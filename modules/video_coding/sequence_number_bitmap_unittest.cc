@@ -0,0 +1,150 @@
+/*
+ *  Copyright 2024 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/video_coding/sequence_number_bitmap.h"
+
+#include <set>
+
+#include "rtc_base/numerics/sequence_number_util.h"
+#include "rtc_base/random.h"
+#include "test/gtest.h"
+
+namespace webrtc {
+namespace video_coding {
+namespace {
+
+TEST(SequenceNumberBitmapTest, ContainsInsertedSequenceNumbers) {
+  SequenceNumberBitmap bitmap(128);
+  EXPECT_FALSE(bitmap.Contains(10));
+
+  bitmap.Insert(10);
+  bitmap.InsertRange(20, 5);
+  EXPECT_TRUE(bitmap.Contains(10));
+  EXPECT_FALSE(bitmap.Contains(11));
+  EXPECT_FALSE(bitmap.Contains(19));
+  EXPECT_TRUE(bitmap.Contains(20));
+  EXPECT_TRUE(bitmap.Contains(24));
+  EXPECT_FALSE(bitmap.Contains(25));
+}
+
+TEST(SequenceNumberBitmapTest, InsertsAcrossWrapAround) {
+  SequenceNumberBitmap bitmap(128);
+  bitmap.InsertRange(65530, 10);
+  for (uint16_t seq_num = 65530; seq_num != 4; ++seq_num) {
+    EXPECT_TRUE(bitmap.Contains(seq_num));
+  }
+  EXPECT_FALSE(bitmap.Contains(4));
+  EXPECT_EQ(bitmap.Oldest(), 65530);
+}
+
+TEST(SequenceNumberBitmapTest, DropsSequenceNumbersOutsideWindow) {
+  SequenceNumberBitmap bitmap(128);
+  bitmap.Insert(100);
+  bitmap.Insert(227);
+  EXPECT_TRUE(bitmap.Contains(100));
+
+  bitmap.Insert(228);
+  EXPECT_FALSE(bitmap.Contains(100));
+  EXPECT_TRUE(bitmap.Contains(227));
+
+  // Too old to be inserted.
+  bitmap.Insert(100);
+  EXPECT_FALSE(bitmap.Contains(100));
+
+  bitmap.Insert(10000);
+  EXPECT_FALSE(bitmap.Contains(227));
+  EXPECT_FALSE(bitmap.Contains(228));
+  EXPECT_EQ(bitmap.Oldest(), 10000);
+}
+
+TEST(SequenceNumberBitmapTest, Erases) {
+  SequenceNumberBitmap bitmap(128);
+  bitmap.InsertRange(0, 100);
+  bitmap.Erase(50);
+  bitmap.EraseRange(60, 10);
+  bitmap.EraseOlderThan(20);
+
+  EXPECT_EQ(bitmap.Oldest(), 20);
+  EXPECT_FALSE(bitmap.Contains(50));
+  EXPECT_FALSE(bitmap.Contains(65));
+  EXPECT_TRUE(bitmap.Contains(70));
+
+  bitmap.EraseOlderThan(1000);
+  EXPECT_EQ(bitmap.Oldest(), absl::nullopt);
+}
+
+TEST(SequenceNumberBitmapTest, FindsFirstInRange) {
+  SequenceNumberBitmap bitmap(256);
+  bitmap.Insert(65500);
+  bitmap.Insert(65535);
+  bitmap.Insert(200);
+
+  EXPECT_EQ(bitmap.FindFirst(65500, 200), 65500);
+  EXPECT_EQ(bitmap.FindFirst(65501, 200), 65535);
+  EXPECT_EQ(bitmap.FindFirst(0, 200), absl::nullopt);
+  EXPECT_EQ(bitmap.FindFirst(0, 201), 200);
+  // Ranges are clipped to the window.
+  EXPECT_EQ(bitmap.FindFirst(60000, 10000), 65500);
+}
+
+TEST(SequenceNumberBitmapTest, ClearResetsWindow) {
+  SequenceNumberBitmap bitmap(64);
+  bitmap.Insert(1000);
+  bitmap.Clear();
+  EXPECT_FALSE(bitmap.Contains(1000));
+
+  bitmap.Insert(5);
+  EXPECT_TRUE(bitmap.Contains(5));
+}
+
+TEST(SequenceNumberBitmapTest, MatchesSetOfSequenceNumbersInWindow) {
+  constexpr int kWindowSize = 256;
+  SequenceNumberBitmap bitmap(kWindowSize);
+  std::set<uint16_t, DescendingSeqNumComp<uint16_t>> reference;
+  absl::optional<uint16_t> newest;
+  Random random(4711);
+  uint16_t seq_num = 65000;
+
+  for (int i = 0; i < 10'000; ++i) {
+    seq_num += random.Rand(-100, 110);
+    const int count = random.Rand(0, 80);
+    if (random.Rand<bool>()) {
+      bitmap.InsertRange(seq_num, count);
+      for (int j = 0; j < count; ++j) {
+        const uint16_t inserted = seq_num + j;
+        if (!newest || AheadOf(inserted, *newest)) {
+          newest = inserted;
+        }
+      }
+      for (int j = 0; j < count; ++j) {
+        reference.insert(seq_num + j);
+      }
+    } else {
+      bitmap.EraseRange(seq_num, count);
+      for (int j = 0; j < count; ++j) {
+        reference.erase(seq_num + j);
+      }
+    }
+    if (newest) {
+      reference.erase(reference.begin(),
+                      reference.upper_bound(*newest - kWindowSize));
+    }
+
+    ASSERT_EQ(bitmap.Oldest(), reference.empty()
+                                   ? absl::nullopt
+                                   : absl::make_optional(*reference.begin()));
+    const uint16_t probe = seq_num + random.Rand(-300, 300);
+    ASSERT_EQ(bitmap.Contains(probe), reference.count(probe) > 0);
+  }
+}
+
+}  // namespace
+}  // namespace video_coding
+}  // namespace webrtc
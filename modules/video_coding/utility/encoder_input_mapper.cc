@@ -0,0 +1,66 @@
+/*
+ *  Copyright (c) 2024 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/video_coding/utility/encoder_input_mapper.h"
+
+#include <utility>
+
+#include "rtc_base/checks.h"
+#include "rtc_base/logging.h"
+
+namespace webrtc {
+namespace {
+
+bool IsSupportedFormat(VideoFrameBuffer::Type type) {
+  return type == VideoFrameBuffer::Type::kI420 ||
+         type == VideoFrameBuffer::Type::kI420A ||
+         type == VideoFrameBuffer::Type::kNV12;
+}
+
+}  // namespace
+
+EncoderInputMapper::MappedBuffer EncoderInputMapper::Map(
+    rtc::scoped_refptr<VideoFrameBuffer> buffer) {
+  RTC_DCHECK(buffer);
+  rtc::scoped_refptr<VideoFrameBuffer> mapped_buffer;
+  if (buffer->type() != VideoFrameBuffer::Type::kNative) {
+    // `buffer` is already mapped.
+    mapped_buffer = buffer;
+  } else {
+    // Attempt to map to one of the supported formats.
+    VideoFrameBuffer::Type supported_formats[] = {
+        VideoFrameBuffer::Type::kI420, VideoFrameBuffer::Type::kNV12};
+    mapped_buffer = buffer->GetMappedFrameBuffer(supported_formats);
+  }
+  if (mapped_buffer && IsSupportedFormat(mapped_buffer->type())) {
+    return {std::move(mapped_buffer), /*converted=*/false};
+  }
+
+  // Unknown pixel format or unable to map, convert to I420.
+  if (last_converted_type_ != buffer->type()) {
+    RTC_LOG(LS_INFO) << "Converting "
+                     << VideoFrameBufferTypeToString(buffer->type())
+                     << " input to I420 for encoding.";
+    last_converted_type_ = buffer->type();
+  }
+  rtc::scoped_refptr<I420BufferInterface> converted_buffer = buffer->ToI420();
+  if (!converted_buffer) {
+    RTC_LOG(LS_ERROR) << "Failed to convert "
+                      << VideoFrameBufferTypeToString(buffer->type())
+                      << " image to I420. Can't encode frame.";
+    return {};
+  }
+  RTC_CHECK(converted_buffer->type() == VideoFrameBuffer::Type::kI420 ||
+            converted_buffer->type() == VideoFrameBuffer::Type::kI420A);
+  ++num_conversions_;
+  return {std::move(converted_buffer), /*converted=*/true};
+}
+
+}  // namespace webrtc
@@ -0,0 +1,56 @@
+/*
+ *  Copyright (c) 2024 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef MODULES_VIDEO_CODING_UTILITY_ENCODER_INPUT_MAPPER_H_
+#define MODULES_VIDEO_CODING_UTILITY_ENCODER_INPUT_MAPPER_H_
+
+#include <stdint.h>
+
+#include "absl/types/optional.h"
+#include "api/scoped_refptr.h"
+#include "api/video/video_frame_buffer.h"
+
+namespace webrtc {
+
+// Prepares input frames for encoders that read I420 or NV12 planes in place,
+// such as the libvpx and libaom encoders. I420, I420A and NV12 buffers, and
+// native buffers that can be mapped to one of those, are passed through so
+// that the encoder can wrap their planes without copying them. Only buffers of
+// other formats are converted to I420. The conversions are counted.
+class EncoderInputMapper {
+ public:
+  struct MappedBuffer {
+    // An I420, I420A or NV12 buffer, or null if the input could neither be
+    // mapped nor converted.
+    rtc::scoped_refptr<VideoFrameBuffer> buffer;
+    // True if `buffer` is a conversion of the input rather than the input
+    // itself or a mapping of it.
+    bool converted = false;
+  };
+
+  EncoderInputMapper() = default;
+  EncoderInputMapper(const EncoderInputMapper&) = delete;
+  EncoderInputMapper& operator=(const EncoderInputMapper&) = delete;
+
+  MappedBuffer Map(rtc::scoped_refptr<VideoFrameBuffer> buffer);
+
+  // Number of input buffers that have been converted to I420. Encoders report
+  // it in `VideoEncoder::EncoderInfo::num_input_conversions`.
+  int64_t num_conversions() const { return num_conversions_; }
+
+ private:
+  int64_t num_conversions_ = 0;
+  // Type of the last converted buffer, to log only when it changes.
+  absl::optional<VideoFrameBuffer::Type> last_converted_type_;
+};
+
+}  // namespace webrtc
+
+#endif  // MODULES_VIDEO_CODING_UTILITY_ENCODER_INPUT_MAPPER_H_
@@ -0,0 +1,100 @@
+/*
+ *  Copyright (c) 2024 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/video_coding/utility/encoder_input_mapper.h"
+
+#include "api/make_ref_counted.h"
+#include "api/video/i420_buffer.h"
+#include "api/video/i444_buffer.h"
+#include "api/video/nv12_buffer.h"
+#include "api/video/video_frame.h"
+#include "test/gtest.h"
+#include "test/mappable_native_buffer.h"
+
+namespace webrtc {
+namespace {
+
+constexpr int kWidth = 64;
+constexpr int kHeight = 48;
+
+// A native buffer that can neither be mapped nor converted.
+class UnmappableNativeBuffer : public VideoFrameBuffer {
+ public:
+  Type type() const override { return Type::kNative; }
+  int width() const override { return kWidth; }
+  int height() const override { return kHeight; }
+  rtc::scoped_refptr<I420BufferInterface> ToI420() override { return nullptr; }
+};
+
+TEST(EncoderInputMapperTest, PassesThroughI420Buffer) {
+  EncoderInputMapper mapper;
+  rtc::scoped_refptr<I420Buffer> buffer = I420Buffer::Create(kWidth, kHeight);
+
+  EncoderInputMapper::MappedBuffer mapped = mapper.Map(buffer);
+  EXPECT_EQ(mapped.buffer.get(), buffer.get());
+  EXPECT_FALSE(mapped.converted);
+  EXPECT_EQ(mapper.num_conversions(), 0);
+}
+
+TEST(EncoderInputMapperTest, PassesThroughNV12Buffer) {
+  EncoderInputMapper mapper;
+  rtc::scoped_refptr<NV12Buffer> buffer = NV12Buffer::Create(kWidth, kHeight);
+
+  EncoderInputMapper::MappedBuffer mapped = mapper.Map(buffer);
+  EXPECT_EQ(mapped.buffer.get(), buffer.get());
+  EXPECT_FALSE(mapped.converted);
+  EXPECT_EQ(mapper.num_conversions(), 0);
+}
+
+TEST(EncoderInputMapperTest, MapsNativeBufferWithoutConversion) {
+  EncoderInputMapper mapper;
+  VideoFrame frame = test::CreateMappableNativeFrame(
+      1, VideoFrameBuffer::Type::kNV12, kWidth, kHeight);
+
+  EncoderInputMapper::MappedBuffer mapped =
+      mapper.Map(frame.video_frame_buffer());
+  ASSERT_TRUE(mapped.buffer);
+  EXPECT_EQ(mapped.buffer->type(), VideoFrameBuffer::Type::kNV12);
+  EXPECT_FALSE(mapped.converted);
+  EXPECT_EQ(mapper.num_conversions(), 0);
+  EXPECT_FALSE(
+      test::GetMappableNativeBufferFromVideoFrame(frame)->DidConvertToI420());
+}
+
+TEST(EncoderInputMapperTest, ConvertsUnsupportedFormatToI420) {
+  EncoderInputMapper mapper;
+  rtc::scoped_refptr<I444Buffer> buffer = I444Buffer::Create(kWidth, kHeight);
+  buffer->InitializeData();
+
+  EncoderInputMapper::MappedBuffer mapped = mapper.Map(buffer);
+  ASSERT_TRUE(mapped.buffer);
+  EXPECT_EQ(mapped.buffer->type(), VideoFrameBuffer::Type::kI420);
+  EXPECT_EQ(mapped.buffer->width(), kWidth);
+  EXPECT_EQ(mapped.buffer->height(), kHeight);
+  EXPECT_TRUE(mapped.converted);
+  EXPECT_EQ(mapper.num_conversions(), 1);
+
+  // The input is converted again for every frame.
+  EXPECT_TRUE(mapper.Map(buffer).converted);
+  EXPECT_EQ(mapper.num_conversions(), 2);
+}
+
+TEST(EncoderInputMapperTest, ReturnsNullIfBufferCanNotBeConverted) {
+  EncoderInputMapper mapper;
+
+  EncoderInputMapper::MappedBuffer mapped =
+      mapper.Map(rtc::make_ref_counted<UnmappableNativeBuffer>());
+  EXPECT_FALSE(mapped.buffer);
+  EXPECT_FALSE(mapped.converted);
+  EXPECT_EQ(mapper.num_conversions(), 0);
+}
+
+}  // namespace
+}  // namespace webrtc
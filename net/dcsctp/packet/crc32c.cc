@@ -16,8 +16,15 @@
 namespace dcsctp {
 
 uint32_t GenerateCrc32C(rtc::ArrayView<const uint8_t> data) {
-  uint32_t crc32c = crc32c_value(data.data(), data.size());
+  return FinalizeCrc32C(ExtendCrc32C(0, data));
+}
+
+uint32_t ExtendCrc32C(uint32_t crc, rtc::ArrayView<const uint8_t> data) {
+  // Uses SSE4.2 or ARMv8 CRC32 instructions when supported by the CPU.
+  return crc32c_extend(crc, data.data(), data.size());
+}
 
+uint32_t FinalizeCrc32C(uint32_t crc32c) {
   // Byte swapping for little endian byte order:
   uint8_t byte0 = crc32c;
   uint8_t byte1 = crc32c >> 8;
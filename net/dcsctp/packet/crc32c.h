@@ -19,6 +19,16 @@ namespace dcsctp {
 // Generates the CRC32C checksum of `data`.
 uint32_t GenerateCrc32C(rtc::ArrayView<const uint8_t> data);
 
+// Extends `crc`, the intermediate CRC32C value of all preceding data (zero if
+// there is none), with `data`. This allows the checksum to be computed while a
+// packet is being serialized. The returned value must be passed through
+// FinalizeCrc32C to get the value returned by GenerateCrc32C.
+uint32_t ExtendCrc32C(uint32_t crc, rtc::ArrayView<const uint8_t> data);
+
+// Converts an intermediate CRC32C value, as returned by ExtendCrc32C, to the
+// checksum written in the SCTP common header.
+uint32_t FinalizeCrc32C(uint32_t crc);
+
 }  // namespace dcsctp
 
 #endif  // NET_DCSCTP_PACKET_CRC32C_H_
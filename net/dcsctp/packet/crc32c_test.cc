@@ -54,5 +54,14 @@ TEST(Crc32Test, TestVectors) {
   EXPECT_EQ(GenerateCrc32C(kISCSICommandPDU), 0x563a96d9U);
 }
 
+TEST(Crc32Test, ExtendingInPiecesMatchesSinglePass) {
+  for (size_t split = 0; split <= kISCSICommandPDU.size(); ++split) {
+    rtc::ArrayView<const uint8_t> data(kISCSICommandPDU);
+    uint32_t crc = ExtendCrc32C(0, data.subview(0, split));
+    crc = ExtendCrc32C(crc, data.subview(split));
+    EXPECT_EQ(FinalizeCrc32C(crc), 0x563a96d9U);
+  }
+}
+
 }  // namespace
 }  // namespace dcsctp
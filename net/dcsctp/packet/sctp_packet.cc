@@ -52,9 +52,33 @@ SctpPacket::Builder::Builder(VerificationTag verification_tag,
     : verification_tag_(verification_tag),
       source_port_(options.local_port),
       dest_port_(options.remote_port),
-      max_packet_size_(RoundDownTo4(options.mtu)) {}
+      max_packet_size_(RoundDownTo4(options.mtu)),
+      // When zero checksum may be negotiated, the checksum is likely not
+      // needed and is only calculated if requested in Build().
+      calculate_checksum_on_add_(
+          options.zero_checksum_alternate_error_detection_method ==
+          ZeroChecksumAlternateErrorDetectionMethod::None()) {}
+
+SctpPacket::Builder::Builder(VerificationTag verification_tag,
+                             const DcSctpOptions& options,
+                             std::vector<uint8_t>* spare_buffer)
+    : Builder(verification_tag, options) {
+  spare_buffer_ = spare_buffer;
+  out_.swap(*spare_buffer_);
+  out_.clear();
+}
+
+SctpPacket::Builder::~Builder() {
+  // A moved-from builder has no allocation left to hand back.
+  if (spare_buffer_ != nullptr &&
+      out_.capacity() > spare_buffer_->capacity()) {
+    out_.clear();
+    out_.swap(*spare_buffer_);
+  }
+}
 
 SctpPacket::Builder& SctpPacket::Builder::Add(const Chunk& chunk) {
+  const size_t start = out_.size();
   if (out_.empty()) {
     out_.reserve(max_packet_size_);
     out_.resize(SctpPacket::kHeaderSize);
@@ -70,6 +94,12 @@ SctpPacket::Builder& SctpPacket::Builder::Add(const Chunk& chunk) {
   if (out_.size() % 4 != 0) {
     out_.resize(RoundUpTo4(out_.size()));
   }
+  if (calculate_checksum_on_add_) {
+    // The checksum field in the common header is zero at this point, which is
+    // what the checksum must be calculated over.
+    crc_ = ExtendCrc32C(crc_, rtc::ArrayView<const uint8_t>(
+                                  out_.data() + start, out_.size() - start));
+  }
 
   RTC_DCHECK(out_.size() <= max_packet_size_)
       << "Exceeded max size, data=" << out_.size()
@@ -91,18 +121,26 @@ size_t SctpPacket::Builder::bytes_remaining() const {
 
 std::vector<uint8_t> SctpPacket::Builder::Build(bool write_checksum) {
   std::vector<uint8_t> out;
-  out_.swap(out);
+  BuildInto(out, write_checksum);
+  return out;
+}
 
-  if (!out.empty() && write_checksum) {
-    uint32_t crc = GenerateCrc32C(out);
-    BoundedByteWriter<kHeaderSize>(out).Store32<8>(crc);
+void SctpPacket::Builder::BuildInto(std::vector<uint8_t>& buffer,
+                                    bool write_checksum) {
+  if (!out_.empty() && write_checksum) {
+    uint32_t crc = FinalizeCrc32C(calculate_checksum_on_add_
+                                      ? crc_
+                                      : ExtendCrc32C(0, out_));
+    BoundedByteWriter<kHeaderSize>(out_).Store32<8>(crc);
   }
 
-  RTC_DCHECK(out.size() <= max_packet_size_)
-      << "Exceeded max size, data=" << out.size()
+  RTC_DCHECK(out_.size() <= max_packet_size_)
+      << "Exceeded max size, data=" << out_.size()
       << ", max_size=" << max_packet_size_;
 
-  return out;
+  buffer.clear();
+  out_.swap(buffer);
+  crc_ = 0;
 }
 
 absl::optional<SctpPacket> SctpPacket::Parse(rtc::ArrayView<const uint8_t> data,
@@ -58,6 +58,14 @@ class SctpPacket {
   class Builder {
    public:
     Builder(VerificationTag verification_tag, const DcSctpOptions& options);
+    // As above, but the packet is serialized into the allocation held by
+    // `spare_buffer`, and the builder's allocation is handed back to
+    // `spare_buffer` when the builder is destroyed. This lets short-lived
+    // builders share one allocation. `spare_buffer` must outlive the builder.
+    Builder(VerificationTag verification_tag,
+            const DcSctpOptions& options,
+            std::vector<uint8_t>* spare_buffer);
+    ~Builder();
 
     Builder(Builder&& other) = default;
     Builder& operator=(Builder&& other) = default;
@@ -78,6 +86,12 @@ class SctpPacket {
     // as the packet's checksum, instead of the crc32c value.
     std::vector<uint8_t> Build(bool write_checksum = true);
 
+    // Like Build(), but the built packet is swapped into `buffer`, and the
+    // previous allocation of `buffer` is kept by the Builder to serialize the
+    // next packet into. Callers that keep `buffer` between calls can build any
+    // number of packets without allocating.
+    void BuildInto(std::vector<uint8_t>& buffer, bool write_checksum = true);
+
    private:
     VerificationTag verification_tag_;
     uint16_t source_port_;
@@ -85,6 +99,11 @@ class SctpPacket {
     // The maximum packet size is always even divisible by four, as chunks are
     // always padded to a size even divisible by four.
     size_t max_packet_size_;
+    // If the checksum is expected to be written, it is calculated as chunks
+    // are added, while the serialized chunk is still in the cache.
+    bool calculate_checksum_on_add_;
+    uint32_t crc_ = 0;
+    std::vector<uint8_t>* spare_buffer_ = nullptr;
     std::vector<uint8_t> out_;
   };
 
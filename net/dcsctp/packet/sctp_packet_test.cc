@@ -285,6 +285,51 @@ TEST(SctpPacketTest, SerializeAndDeserializeThreeChunks) {
   EXPECT_EQ(data2.tsn(), TSN(124));
 }
 
+TEST(SctpPacketTest, BuildIntoReusesBufferAllocation) {
+  SctpPacket::Builder b(kVerificationTag, {});
+  std::vector<uint8_t> buffer;
+
+  b.Add(DataChunk(TSN(123), StreamID(456), SSN(789), PPID(9090),
+                  /*payload=*/std::vector<uint8_t>(500), /*options=*/{}));
+  b.BuildInto(buffer);
+  ASSERT_HAS_VALUE_AND_ASSIGN(
+      SctpPacket packet1, SctpPacket::Parse(buffer, kVerifyChecksumOptions));
+  ASSERT_THAT(packet1.descriptors(), SizeIs(1));
+  const uint8_t* first_allocation = buffer.data();
+
+  b.Add(DataChunk(TSN(124), StreamID(456), SSN(790), PPID(9090),
+                  /*payload=*/{1, 2, 3}, /*options=*/{}));
+  b.BuildInto(buffer);
+  ASSERT_HAS_VALUE_AND_ASSIGN(
+      SctpPacket packet2, SctpPacket::Parse(buffer, kVerifyChecksumOptions));
+  ASSERT_THAT(packet2.descriptors(), SizeIs(1));
+
+  // The third packet is serialized into the allocation of the first one.
+  b.Add(DataChunk(TSN(125), StreamID(456), SSN(791), PPID(9090),
+                  /*payload=*/{4, 5, 6}, /*options=*/{}));
+  b.BuildInto(buffer);
+  EXPECT_EQ(buffer.data(), first_allocation);
+  ASSERT_HAS_VALUE_AND_ASSIGN(
+      SctpPacket packet3, SctpPacket::Parse(buffer, kVerifyChecksumOptions));
+  ASSERT_HAS_VALUE_AND_ASSIGN(DataChunk data,
+                              DataChunk::Parse(packet3.descriptors()[0].data));
+  EXPECT_EQ(data.tsn(), TSN(125));
+}
+
+TEST(SctpPacketTest, WritesChecksumWhenZeroChecksumIsNegotiable) {
+  SctpPacket::Builder b(
+      kVerificationTag,
+      {.zero_checksum_alternate_error_detection_method =
+           ZeroChecksumAlternateErrorDetectionMethod::LowerLayerDtls()});
+  b.Add(DataChunk(TSN(123), StreamID(456), SSN(789), PPID(9090),
+                  /*payload=*/{1, 2, 3, 4, 5}, /*options=*/{}));
+  std::vector<uint8_t> serialized = b.Build(/*write_checksum=*/true);
+
+  ASSERT_HAS_VALUE_AND_ASSIGN(
+      SctpPacket packet, SctpPacket::Parse(serialized, kVerifyChecksumOptions));
+  EXPECT_NE(packet.common_header().checksum, 0u);
+}
+
 TEST(SctpPacketTest, ParseAbortWithEmptyCause) {
   SctpPacket::Builder b(kVerificationTag, {});
   b.Add(AbortChunk(
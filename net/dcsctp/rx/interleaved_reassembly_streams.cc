@@ -11,7 +11,9 @@
 
 #include <stddef.h>
 
+#include <algorithm>
 #include <cstdint>
+#include <deque>
 #include <functional>
 #include <iterator>
 #include <map>
@@ -37,69 +39,75 @@ InterleavedReassemblyStreams::InterleavedReassemblyStreams(
 
 size_t InterleavedReassemblyStreams::Stream::TryToAssembleMessage(
     UnwrappedMID mid) {
-  std::map<UnwrappedMID, ChunkMap>::const_iterator it =
-      chunks_by_mid_.find(mid);
-  if (it == chunks_by_mid_.end()) {
+  ChunkIterator start = absl::c_lower_bound(
+      chunks_, mid,
+      [](const Chunk& chunk, UnwrappedMID mid) { return chunk.mid < mid; });
+  ChunkIterator end = std::upper_bound(
+      start, chunks_.end(), mid,
+      [](UnwrappedMID mid, const Chunk& chunk) { return mid < chunk.mid; });
+  if (start == end) {
     RTC_DLOG(LS_VERBOSE) << parent_.log_prefix_ << "TryToAssembleMessage "
                          << *mid.Wrap() << " - no chunks";
     return 0;
   }
-  const ChunkMap& chunks = it->second;
-  if (!chunks.begin()->second.second.is_beginning ||
-      !chunks.rbegin()->second.second.is_end) {
+  const Chunk& last = *std::prev(end);
+  if (!start->data.is_beginning || !last.data.is_end) {
     RTC_DLOG(LS_VERBOSE) << parent_.log_prefix_ << "TryToAssembleMessage "
                          << *mid.Wrap() << "- missing beginning or end";
     return 0;
   }
-  int64_t fsn_diff = *chunks.rbegin()->first - *chunks.begin()->first;
-  if (fsn_diff != (static_cast<int64_t>(chunks.size()) - 1)) {
+  int64_t count = std::distance(start, end);
+  int64_t fsn_diff = *last.data.fsn - *start->data.fsn;
+  if (fsn_diff != count - 1) {
     RTC_DLOG(LS_VERBOSE) << parent_.log_prefix_ << "TryToAssembleMessage "
                          << *mid.Wrap() << "- not all chunks exist (have "
-                         << chunks.size() << ", expect " << (fsn_diff + 1)
-                         << ")";
+                         << count << ", expect " << (fsn_diff + 1) << ")";
     return 0;
   }
 
-  size_t removed_bytes = AssembleMessage(chunks);
+  size_t removed_bytes = AssembleMessage(start, end);
   RTC_DLOG(LS_VERBOSE) << parent_.log_prefix_ << "TryToAssembleMessage "
                        << *mid.Wrap() << " - succeeded and removed "
                        << removed_bytes;
 
-  chunks_by_mid_.erase(mid);
+  chunks_.erase(start, end);
   return removed_bytes;
 }
 
 size_t InterleavedReassemblyStreams::Stream::AssembleMessage(
-    const ChunkMap& tsn_chunks) {
-  size_t count = tsn_chunks.size();
+    ChunkIterator start,
+    ChunkIterator end) {
+  size_t count = std::distance(start, end);
   if (count == 1) {
     // Fast path - zero-copy
-    const Data& data = tsn_chunks.begin()->second.second;
+    Data& data = start->data;
     size_t payload_size = data.size();
-    UnwrappedTSN tsns[1] = {tsn_chunks.begin()->second.first};
+    UnwrappedTSN tsns[1] = {start->tsn};
     DcSctpMessage message(data.stream_id, data.ppid, std::move(data.payload));
     parent_.on_assembled_message_(tsns, std::move(message));
     return payload_size;
   }
 
-  // Slow path - will need to concatenate the payload.
-  std::vector<UnwrappedTSN> tsns;
+  // Slow path - will need to concatenate the payload, which is the only
+  // allocation made.
+  std::vector<UnwrappedTSN>& tsns = parent_.assembled_tsns_;
+  tsns.clear();
   tsns.reserve(count);
 
   std::vector<uint8_t> payload;
-  size_t payload_size = absl::c_accumulate(
-      tsn_chunks, 0,
-      [](size_t v, const auto& p) { return v + p.second.second.size(); });
+  size_t payload_size =
+      std::accumulate(start, end, size_t{0}, [](size_t v, const Chunk& chunk) {
+        return v + chunk.data.size();
+      });
   payload.reserve(payload_size);
 
-  for (auto& item : tsn_chunks) {
-    const UnwrappedTSN tsn = item.second.first;
-    const Data& data = item.second.second;
-    tsns.push_back(tsn);
+  for (auto it = start; it != end; ++it) {
+    const Data& data = it->data;
+    tsns.push_back(it->tsn);
     payload.insert(payload.end(), data.payload.begin(), data.payload.end());
   }
 
-  const Data& data = tsn_chunks.begin()->second.second;
+  const Data& data = start->data;
 
   DcSctpMessage message(data.stream_id, data.ppid, std::move(payload));
   parent_.on_assembled_message_(tsns, std::move(message));
@@ -109,14 +117,13 @@ size_t InterleavedReassemblyStreams::Stream::AssembleMessage(
 size_t InterleavedReassemblyStreams::Stream::EraseTo(MID mid) {
   UnwrappedMID unwrapped_mid = mid_unwrapper_.Unwrap(mid);
 
-  size_t removed_bytes = 0;
-  auto it = chunks_by_mid_.begin();
-  while (it != chunks_by_mid_.end() && it->first <= unwrapped_mid) {
-    removed_bytes += absl::c_accumulate(
-        it->second, 0,
-        [](size_t r2, const auto& q) { return r2 + q.second.second.size(); });
-    it = chunks_by_mid_.erase(it);
-  }
+  ChunkIterator end = absl::c_upper_bound(
+      chunks_, unwrapped_mid,
+      [](UnwrappedMID mid, const Chunk& chunk) { return mid < chunk.mid; });
+  size_t removed_bytes = std::accumulate(
+      chunks_.begin(), end, size_t{0},
+      [](size_t r, const Chunk& chunk) { return r + chunk.data.size(); });
+  chunks_.erase(chunks_.begin(), end);
 
   if (!stream_id_.unordered) {
     // For ordered streams, erasing a message might suddenly unblock that queue
@@ -137,11 +144,16 @@ int InterleavedReassemblyStreams::Stream::Add(UnwrappedTSN tsn, Data data) {
   int queued_bytes = data.size();
   UnwrappedMID mid = mid_unwrapper_.Unwrap(data.mid);
   FSN fsn = data.fsn;
-  auto [unused, inserted] =
-      chunks_by_mid_[mid].emplace(fsn, std::make_pair(tsn, std::move(data)));
-  if (!inserted) {
+  ChunkIterator it = absl::c_lower_bound(
+      chunks_, std::make_pair(mid, fsn),
+      [](const Chunk& chunk, const std::pair<UnwrappedMID, FSN>& key) {
+        return chunk.mid < key.first ||
+               (chunk.mid == key.first && *chunk.data.fsn < *key.second);
+      });
+  if (it != chunks_.end() && it->mid == mid && it->data.fsn == fsn) {
     return 0;
   }
+  chunks_.emplace(it, mid, tsn, std::move(data));
 
   if (stream_id_.unordered) {
     queued_bytes -= TryToAssembleMessage(mid);
@@ -11,9 +11,11 @@
 #define NET_DCSCTP_RX_INTERLEAVED_REASSEMBLY_STREAMS_H_
 
 #include <cstdint>
+#include <deque>
 #include <map>
 #include <string>
 #include <utility>
+#include <vector>
 
 #include "absl/strings/string_view.h"
 #include "api/array_view.h"
@@ -72,16 +74,26 @@ class InterleavedReassemblyStreams : public ReassemblyStreams {
       mid_unwrapper_.Reset();
       next_mid_ = mid_unwrapper_.Unwrap(MID(0));
     }
-    bool has_unassembled_chunks() const { return !chunks_by_mid_.empty(); }
+    bool has_unassembled_chunks() const { return !chunks_.empty(); }
     void AddHandoverState(DcSctpSocketHandoverState& state) const;
 
    private:
-    using ChunkMap = std::map<FSN, std::pair<UnwrappedTSN, Data>>;
+    // A received chunk that has not been assembled into a message yet.
+    struct Chunk {
+      Chunk(UnwrappedMID mid, UnwrappedTSN tsn, Data data)
+          : mid(mid), tsn(tsn), data(std::move(data)) {}
+      UnwrappedMID mid;
+      UnwrappedTSN tsn;
+      Data data;
+    };
+    using ChunkIterator = std::deque<Chunk>::iterator;
 
     // Try to assemble one message identified by `mid`.
     // Returns the number of bytes assembled if a message was assembled.
     size_t TryToAssembleMessage(UnwrappedMID mid);
-    size_t AssembleMessage(const ChunkMap& tsn_chunks);
+    // Assembles a message from the chunks in [start, end), which are all the
+    // chunks of the message in FSN order.
+    size_t AssembleMessage(ChunkIterator start, ChunkIterator end);
     // Try to assemble one or several messages in order from the stream.
     // Returns the number of bytes assembled if one or more messages were
     // assembled.
@@ -89,7 +101,11 @@ class InterleavedReassemblyStreams : public ReassemblyStreams {
 
     const FullStreamId stream_id_;
     InterleavedReassemblyStreams& parent_;
-    std::map<UnwrappedMID, ChunkMap> chunks_by_mid_;
+    // Sorted by MID, and by FSN within each message. Chunks mostly arrive in
+    // order and are appended, while retransmissions fill holes near the
+    // front, from where messages are assembled and erased. A deque makes both
+    // ends cheap.
+    std::deque<Chunk> chunks_;
     UnwrappedMID::Unwrapper mid_unwrapper_;
     UnwrappedMID next_mid_;
   };
@@ -103,6 +119,9 @@ class InterleavedReassemblyStreams : public ReassemblyStreams {
 
   // All unordered and ordered streams, managing not-yet-assembled data.
   std::map<FullStreamId, Stream> streams_;
+
+  // The TSNs of the message being assembled, kept to reuse its capacity.
+  std::vector<UnwrappedTSN> assembled_tsns_;
 };
 
 }  // namespace dcsctp
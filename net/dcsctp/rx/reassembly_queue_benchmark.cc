@@ -0,0 +1,75 @@
+/*
+ *  Copyright (c) 2024 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+#include <stddef.h>
+#include <stdint.h>
+
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+#include "net/dcsctp/common/internal_types.h"
+#include "net/dcsctp/packet/data.h"
+#include "net/dcsctp/public/types.h"
+#include "net/dcsctp/rx/reassembly_queue.h"
+#include "rtc_base/system/unused.h"
+
+namespace dcsctp {
+namespace {
+
+constexpr size_t kMessageSize = 64 * 1024;
+constexpr size_t kChunkSize = 1200;
+constexpr StreamID kStreamId(1);
+constexpr PPID kPpid(53);
+
+// Sends one ordered 64 KiB message split into 1200-byte chunks per iteration.
+// With `state.range(0)` set, message interleaving (I-DATA) is used, and with
+// `state.range(1)` set, every pair of chunks arrives swapped.
+void BM_ReassemblyQueueBulkTransfer(benchmark::State& state) {
+  const bool use_message_interleaving = state.range(0) != 0;
+  const bool reordered = state.range(1) != 0;
+  ReassemblyQueue queue("", /*max_size_bytes=*/4 * kMessageSize,
+                        use_message_interleaving);
+  std::vector<std::pair<TSN, Data>> chunks;
+  uint32_t tsn = 0;
+  uint32_t message_id = 0;
+
+  for (auto s : state) {
+    RTC_UNUSED(s);
+    chunks.clear();
+    uint32_t fsn = 0;
+    for (size_t offset = 0; offset < kMessageSize; offset += kChunkSize) {
+      const size_t size = std::min(kChunkSize, kMessageSize - offset);
+      chunks.emplace_back(
+          TSN(tsn++),
+          Data(kStreamId, SSN(message_id), MID(message_id), FSN(fsn++), kPpid,
+               std::vector<uint8_t>(size), Data::IsBeginning(offset == 0),
+               Data::IsEnd(offset + size == kMessageSize), IsUnordered(false)));
+    }
+    if (reordered) {
+      for (size_t i = 0; i + 1 < chunks.size(); i += 2) {
+        std::swap(chunks[i], chunks[i + 1]);
+      }
+    }
+    for (auto& [chunk_tsn, data] : chunks) {
+      queue.Add(chunk_tsn, std::move(data));
+    }
+    ++message_id;
+    benchmark::DoNotOptimize(queue.FlushMessages());
+  }
+  state.SetBytesProcessed(state.iterations() * kMessageSize);
+}
+
+BENCHMARK(BM_ReassemblyQueueBulkTransfer)
+    ->ArgsProduct({{0, 1}, {0, 1}})
+    ->ArgNames({"interleaving", "reordered"});
+
+}  // namespace
+}  // namespace dcsctp
@@ -12,10 +12,12 @@
 #include <stddef.h>
 
 #include <cstdint>
+#include <deque>
 #include <functional>
 #include <iterator>
 #include <map>
 #include <numeric>
+#include <tuple>
 #include <utility>
 #include <vector>
 
@@ -31,49 +33,51 @@
 namespace dcsctp {
 namespace {
 
-// Given a map (`chunks`) and an iterator to within that map (`iter`), this
-// function will return an iterator to the first chunk in that message, which
-// has the `is_beginning` flag set. If there are any gaps, or if the beginning
-// can't be found, `absl::nullopt` is returned.
-absl::optional<std::map<UnwrappedTSN, Data>::iterator> FindBeginning(
-    const std::map<UnwrappedTSN, Data>& chunks,
-    std::map<UnwrappedTSN, Data>::iterator iter) {
-  UnwrappedTSN prev_tsn = iter->first;
+// Given chunks sorted by TSN (`chunks`) and an iterator to within them
+// (`iter`), this function will return an iterator to the first chunk in that
+// message, which has the `is_beginning` flag set. If there are any gaps, or if
+// the beginning can't be found, `absl::nullopt` is returned.
+template <typename Container>
+absl::optional<typename Container::iterator> FindBeginning(
+    const Container& chunks,
+    typename Container::iterator iter) {
+  UnwrappedTSN prev_tsn = iter->tsn;
   for (;;) {
-    if (iter->second.is_beginning) {
+    if (iter->data.is_beginning) {
       return iter;
     }
     if (iter == chunks.begin()) {
       return absl::nullopt;
     }
     --iter;
-    if (iter->first.next_value() != prev_tsn) {
+    if (iter->tsn.next_value() != prev_tsn) {
       return absl::nullopt;
     }
-    prev_tsn = iter->first;
+    prev_tsn = iter->tsn;
   }
 }
 
-// Given a map (`chunks`) and an iterator to within that map (`iter`), this
-// function will return an iterator to the chunk after the last chunk in that
-// message, which has the `is_end` flag set. If there are any gaps, or if the
-// end can't be found, `absl::nullopt` is returned.
-absl::optional<std::map<UnwrappedTSN, Data>::iterator> FindEnd(
-    std::map<UnwrappedTSN, Data>& chunks,
-    std::map<UnwrappedTSN, Data>::iterator iter) {
-  UnwrappedTSN prev_tsn = iter->first;
+// Given chunks sorted by TSN (`chunks`) and an iterator to within them
+// (`iter`), this function will return an iterator to the chunk after the last
+// chunk in that message, which has the `is_end` flag set. If there are any
+// gaps, or if the end can't be found, `absl::nullopt` is returned.
+template <typename Container>
+absl::optional<typename Container::iterator> FindEnd(
+    Container& chunks,
+    typename Container::iterator iter) {
+  UnwrappedTSN prev_tsn = iter->tsn;
   for (;;) {
-    if (iter->second.is_end) {
+    if (iter->data.is_end) {
       return ++iter;
     }
     ++iter;
     if (iter == chunks.end()) {
       return absl::nullopt;
     }
-    if (iter->first != prev_tsn.next_value()) {
+    if (iter->tsn != prev_tsn.next_value()) {
       return absl::nullopt;
     }
-    prev_tsn = iter->first;
+    prev_tsn = iter->tsn;
   }
 }
 }  // namespace
@@ -84,71 +88,37 @@ TraditionalReassemblyStreams::TraditionalReassemblyStreams(
     : log_prefix_(log_prefix),
       on_assembled_message_(std::move(on_assembled_message)) {}
 
-int TraditionalReassemblyStreams::UnorderedStream::Add(UnwrappedTSN tsn,
-                                                       Data data) {
-  if (data.is_beginning && data.is_end) {
-    // Fastpath for already assembled chunks.
-    AssembleMessage(tsn, std::move(data));
-    return 0;
-  }
-  int queued_bytes = data.size();
-  auto [it, inserted] = chunks_.emplace(tsn, std::move(data));
-  if (!inserted) {
-    return 0;
-  }
-
-  queued_bytes -= TryToAssembleMessage(it);
-
-  return queued_bytes;
-}
-
-size_t TraditionalReassemblyStreams::UnorderedStream::TryToAssembleMessage(
-    ChunkMap::iterator iter) {
-  // TODO(boivie): This method is O(N) with the number of fragments in a
-  // message, which can be inefficient for very large values of N. This could be
-  // optimized by e.g. only trying to assemble a message once _any_ beginning
-  // and _any_ end has been found.
-  absl::optional<ChunkMap::iterator> start = FindBeginning(chunks_, iter);
-  if (!start.has_value()) {
-    return 0;
-  }
-  absl::optional<ChunkMap::iterator> end = FindEnd(chunks_, iter);
-  if (!end.has_value()) {
-    return 0;
-  }
-
-  size_t bytes_assembled = AssembleMessage(*start, *end);
-  chunks_.erase(*start, *end);
-  return bytes_assembled;
-}
-
+template <typename Iterator>
 size_t TraditionalReassemblyStreams::StreamBase::AssembleMessage(
-    const ChunkMap::iterator start,
-    const ChunkMap::iterator end) {
+    Iterator start,
+    Iterator end) {
   size_t count = std::distance(start, end);
 
   if (count == 1) {
     // Fast path - zero-copy
-    return AssembleMessage(start->first, std::move(start->second));
+    return AssembleMessage(start->tsn, std::move(start->data));
   }
 
-  // Slow path - will need to concatenate the payload.
-  std::vector<UnwrappedTSN> tsns;
+  // Slow path - will need to concatenate the payload, which is the only
+  // allocation made.
+  std::vector<UnwrappedTSN>& tsns = parent_.assembled_tsns_;
   std::vector<uint8_t> payload;
 
-  size_t payload_size = std::accumulate(
-      start, end, 0,
-      [](size_t v, const auto& p) { return v + p.second.size(); });
+  size_t payload_size =
+      std::accumulate(start, end, size_t{0}, [](size_t v, const auto& chunk) {
+        return v + chunk.data.size();
+      });
 
+  tsns.clear();
   tsns.reserve(count);
   payload.reserve(payload_size);
   for (auto it = start; it != end; ++it) {
-    const Data& data = it->second;
-    tsns.push_back(it->first);
+    const Data& data = it->data;
+    tsns.push_back(it->tsn);
     payload.insert(payload.end(), data.payload.begin(), data.payload.end());
   }
 
-  DcSctpMessage message(start->second.stream_id, start->second.ppid,
+  DcSctpMessage message(start->data.stream_id, start->data.ppid,
                         std::move(payload));
   parent_.on_assembled_message_(tsns, std::move(message));
 
@@ -166,36 +136,86 @@ size_t TraditionalReassemblyStreams::StreamBase::AssembleMessage(
   return payload_size;
 }
 
+int TraditionalReassemblyStreams::UnorderedStream::Add(UnwrappedTSN tsn,
+                                                       Data data) {
+  if (data.is_beginning && data.is_end) {
+    // Fastpath for already assembled chunks.
+    AssembleMessage(tsn, std::move(data));
+    return 0;
+  }
+  int queued_bytes = data.size();
+  auto it = absl::c_lower_bound(
+      chunks_, tsn, [](const Chunk& chunk, UnwrappedTSN tsn) {
+        return chunk.tsn < tsn;
+      });
+  if (it != chunks_.end() && it->tsn == tsn) {
+    return 0;
+  }
+  it = chunks_.emplace(it, tsn, std::move(data));
+
+  queued_bytes -= TryToAssembleMessage(it);
+
+  return queued_bytes;
+}
+
+size_t TraditionalReassemblyStreams::UnorderedStream::TryToAssembleMessage(
+    std::deque<Chunk>::iterator iter) {
+  // TODO(boivie): This method is O(N) with the number of fragments in a
+  // message, which can be inefficient for very large values of N. This could be
+  // optimized by e.g. only trying to assemble a message once _any_ beginning
+  // and _any_ end has been found.
+  absl::optional<std::deque<Chunk>::iterator> start =
+      FindBeginning(chunks_, iter);
+  if (!start.has_value()) {
+    return 0;
+  }
+  absl::optional<std::deque<Chunk>::iterator> end = FindEnd(chunks_, iter);
+  if (!end.has_value()) {
+    return 0;
+  }
+
+  size_t bytes_assembled = AssembleMessage(*start, *end);
+  chunks_.erase(*start, *end);
+  return bytes_assembled;
+}
+
 size_t TraditionalReassemblyStreams::UnorderedStream::EraseTo(
     UnwrappedTSN tsn) {
-  auto end_iter = chunks_.upper_bound(tsn);
+  auto end_iter = absl::c_upper_bound(
+      chunks_, tsn, [](UnwrappedTSN tsn, const Chunk& chunk) {
+        return tsn < chunk.tsn;
+      });
   size_t removed_bytes = std::accumulate(
-      chunks_.begin(), end_iter, 0,
-      [](size_t r, const auto& p) { return r + p.second.size(); });
+      chunks_.begin(), end_iter, size_t{0},
+      [](size_t r, const Chunk& chunk) { return r + chunk.data.size(); });
 
   chunks_.erase(chunks_.begin(), end_iter);
   return removed_bytes;
 }
 
 size_t TraditionalReassemblyStreams::OrderedStream::TryToAssembleMessage() {
-  if (chunks_by_ssn_.empty() || chunks_by_ssn_.begin()->first != next_ssn_) {
+  if (chunks_.empty() || chunks_.front().ssn != next_ssn_ ||
+      !chunks_.front().data.is_beginning) {
     return 0;
   }
 
-  ChunkMap& chunks = chunks_by_ssn_.begin()->second;
-
-  if (!chunks.begin()->second.is_beginning || !chunks.rbegin()->second.is_end) {
+  // The chunks of the message are the ones at the front with its SSN.
+  auto end = std::partition_point(
+      chunks_.begin(), chunks_.end(),
+      [&](const OrderedChunk& chunk) { return chunk.ssn == next_ssn_; });
+  const OrderedChunk& last = *std::prev(end);
+  if (!last.data.is_end) {
     return 0;
   }
 
-  uint32_t tsn_diff =
-      UnwrappedTSN::Difference(chunks.rbegin()->first, chunks.begin()->first);
-  if (tsn_diff != chunks.size() - 1) {
+  size_t count = std::distance(chunks_.begin(), end);
+  uint32_t tsn_diff = UnwrappedTSN::Difference(last.tsn, chunks_.front().tsn);
+  if (tsn_diff != count - 1) {
     return 0;
   }
 
-  size_t assembled_bytes = AssembleMessage(chunks.begin(), chunks.end());
-  chunks_by_ssn_.erase(chunks_by_ssn_.begin());
+  size_t assembled_bytes = AssembleMessage(chunks_.begin(), end);
+  chunks_.erase(chunks_.begin(), end);
   next_ssn_.Increment();
   return assembled_bytes;
 }
@@ -225,8 +245,7 @@ TraditionalReassemblyStreams::OrderedStream::TryToAssembleMessagesFastpath(
     next_ssn_.Increment();
   } else {
     size_t queued_bytes = data.size();
-    auto [iter, inserted] = chunks_by_ssn_[ssn].emplace(tsn, std::move(data));
-    if (!inserted) {
+    if (!Insert(ssn, tsn, std::move(data))) {
       // Not actually assembled, but deduplicated meaning queued size doesn't
       // include this message.
       return queued_bytes;
@@ -235,6 +254,22 @@ TraditionalReassemblyStreams::OrderedStream::TryToAssembleMessagesFastpath(
   return assembled_bytes + TryToAssembleMessages();
 }
 
+bool TraditionalReassemblyStreams::OrderedStream::Insert(UnwrappedSSN ssn,
+                                                         UnwrappedTSN tsn,
+                                                         Data data) {
+  auto it = absl::c_lower_bound(
+      chunks_, std::make_pair(ssn, tsn),
+      [](const OrderedChunk& chunk,
+         const std::pair<UnwrappedSSN, UnwrappedTSN>& key) {
+        return std::tie(chunk.ssn, chunk.tsn) < std::tie(key.first, key.second);
+      });
+  if (it != chunks_.end() && it->ssn == ssn && it->tsn == tsn) {
+    return false;
+  }
+  chunks_.emplace(it, ssn, tsn, std::move(data));
+  return true;
+}
+
 int TraditionalReassemblyStreams::OrderedStream::Add(UnwrappedTSN tsn,
                                                      Data data) {
   int queued_bytes = data.size();
@@ -243,8 +278,7 @@ int TraditionalReassemblyStreams::OrderedStream::Add(UnwrappedTSN tsn,
     return queued_bytes -
            TryToAssembleMessagesFastpath(ssn, tsn, std::move(data));
   }
-  auto [iter, inserted] = chunks_by_ssn_[ssn].emplace(tsn, std::move(data));
-  if (!inserted) {
+  if (!Insert(ssn, tsn, std::move(data))) {
     return 0;
   }
   return queued_bytes;
@@ -253,15 +287,16 @@ int TraditionalReassemblyStreams::OrderedStream::Add(UnwrappedTSN tsn,
 size_t TraditionalReassemblyStreams::OrderedStream::EraseTo(SSN ssn) {
   UnwrappedSSN unwrapped_ssn = ssn_unwrapper_.Unwrap(ssn);
 
-  auto end_iter = chunks_by_ssn_.upper_bound(unwrapped_ssn);
+  auto end_iter = absl::c_upper_bound(
+      chunks_, unwrapped_ssn, [](UnwrappedSSN ssn, const OrderedChunk& chunk) {
+        return ssn < chunk.ssn;
+      });
   size_t removed_bytes = std::accumulate(
-      chunks_by_ssn_.begin(), end_iter, 0, [](size_t r1, const auto& p) {
-        return r1 +
-               absl::c_accumulate(p.second, 0, [](size_t r2, const auto& q) {
-                 return r2 + q.second.size();
-               });
+      chunks_.begin(), end_iter, size_t{0},
+      [](size_t r, const OrderedChunk& chunk) {
+        return r + chunk.data.size();
       });
-  chunks_by_ssn_.erase(chunks_by_ssn_.begin(), end_iter);
+  chunks_.erase(chunks_.begin(), end_iter);
 
   if (unwrapped_ssn >= next_ssn_) {
     unwrapped_ssn.Increment();
@@ -12,8 +12,11 @@
 #include <stddef.h>
 #include <stdint.h>
 
+#include <deque>
 #include <map>
 #include <string>
+#include <utility>
+#include <vector>
 
 #include "absl/strings/string_view.h"
 #include "api/array_view.h"
@@ -46,7 +49,22 @@ class TraditionalReassemblyStreams : public ReassemblyStreams {
   void RestoreFromState(const DcSctpSocketHandoverState& state) override;
 
  private:
-  using ChunkMap = std::map<UnwrappedTSN, Data>;
+  // A received chunk that has not been assembled into a message yet.
+  struct Chunk {
+    Chunk(UnwrappedTSN tsn, Data data) : tsn(tsn), data(std::move(data)) {}
+    UnwrappedTSN tsn;
+    Data data;
+  };
+
+  // A received chunk of an ordered stream that has not been assembled into a
+  // message yet.
+  struct OrderedChunk {
+    OrderedChunk(UnwrappedSSN ssn, UnwrappedTSN tsn, Data data)
+        : ssn(ssn), tsn(tsn), data(std::move(data)) {}
+    UnwrappedSSN ssn;
+    UnwrappedTSN tsn;
+    Data data;
+  };
 
   // Base class for `UnorderedStream` and `OrderedStream`.
   class StreamBase {
@@ -54,7 +72,10 @@ class TraditionalReassemblyStreams : public ReassemblyStreams {
     explicit StreamBase(TraditionalReassemblyStreams* parent)
         : parent_(*parent) {}
 
-    size_t AssembleMessage(ChunkMap::iterator start, ChunkMap::iterator end);
+    // Assembles a message from the chunks in [start, end), which are all the
+    // chunks of the message in TSN order.
+    template <typename Iterator>
+    size_t AssembleMessage(Iterator start, Iterator end);
     size_t AssembleMessage(UnwrappedTSN tsn, Data data);
     TraditionalReassemblyStreams& parent_;
   };
@@ -71,14 +92,17 @@ class TraditionalReassemblyStreams : public ReassemblyStreams {
     bool has_unassembled_chunks() const { return !chunks_.empty(); }
 
    private:
-    // Given an iterator to any chunk within the map, try to assemble a message
-    // into `reassembled_messages` containing it and - if successful - erase
-    // those chunks from the stream chunks map.
+    // Given an iterator to any chunk within `chunks_`, try to assemble a
+    // message containing it and - if successful - erase those chunks from
+    // `chunks_`.
     //
     // Returns the number of bytes that were assembled.
-    size_t TryToAssembleMessage(ChunkMap::iterator iter);
+    size_t TryToAssembleMessage(std::deque<Chunk>::iterator iter);
 
-    ChunkMap chunks_;
+    // Sorted by TSN. Chunks mostly arrive in order and are appended, while
+    // retransmissions fill holes near the front, from where messages are
+    // assembled and erased. A deque makes both ends cheap.
+    std::deque<Chunk> chunks_;
   };
 
   // Manages all received data for a specific ordered stream, and assembles
@@ -95,7 +119,7 @@ class TraditionalReassemblyStreams : public ReassemblyStreams {
       next_ssn_ = ssn_unwrapper_.Unwrap(SSN(0));
     }
     SSN next_ssn() const { return next_ssn_.Wrap(); }
-    bool has_unassembled_chunks() const { return !chunks_by_ssn_.empty(); }
+    bool has_unassembled_chunks() const { return !chunks_.empty(); }
 
    private:
     // Try to assemble one or several messages in order from the stream.
@@ -103,12 +127,16 @@ class TraditionalReassemblyStreams : public ReassemblyStreams {
     size_t TryToAssembleMessage();
     size_t TryToAssembleMessages();
     // Same as above but when inserting the first complete message avoid
-    // insertion into the map.
+    // insertion into `chunks_`.
     size_t TryToAssembleMessagesFastpath(UnwrappedSSN ssn,
                                          UnwrappedTSN tsn,
                                          Data data);
-    // This must be an ordered container to be able to iterate in SSN order.
-    std::map<UnwrappedSSN, ChunkMap> chunks_by_ssn_;
+    // Inserts the chunk into `chunks_`. Returns false if it was a duplicate.
+    bool Insert(UnwrappedSSN ssn, UnwrappedTSN tsn, Data data);
+
+    // Sorted by SSN, and by TSN within each message, so that messages can be
+    // assembled in SSN order from the front.
+    std::deque<OrderedChunk> chunks_;
     UnwrappedSSN::Unwrapper ssn_unwrapper_;
     UnwrappedSSN next_ssn_;
   };
@@ -121,6 +149,9 @@ class TraditionalReassemblyStreams : public ReassemblyStreams {
   // All unordered and ordered streams, managing not-yet-assembled data.
   std::map<StreamID, UnorderedStream> unordered_streams_;
   std::map<StreamID, OrderedStream> ordered_streams_;
+
+  // The TSNs of the message being assembled, kept to reuse its capacity.
+  std::vector<UnwrappedTSN> assembled_tsns_;
 };
 
 }  // namespace dcsctp
@@ -12,12 +12,15 @@
 #include <cstdint>
 #include <memory>
 #include <utility>
+#include <vector>
 
+#include "api/array_view.h"
 #include "net/dcsctp/common/handover_testing.h"
 #include "net/dcsctp/common/sequence_numbers.h"
 #include "net/dcsctp/packet/chunk/forward_tsn_chunk.h"
 #include "net/dcsctp/packet/chunk/forward_tsn_common.h"
 #include "net/dcsctp/packet/data.h"
+#include "net/dcsctp/public/dcsctp_message.h"
 #include "net/dcsctp/rx/reassembly_streams.h"
 #include "net/dcsctp/testing/data_generator.h"
 #include "rtc_base/gunit.h"
@@ -26,9 +29,11 @@
 namespace dcsctp {
 namespace {
 using ::testing::ElementsAre;
+using ::testing::IsEmpty;
 using ::testing::MockFunction;
 using ::testing::NiceMock;
 using ::testing::Property;
+using ::testing::SizeIs;
 
 class TraditionalReassemblyStreamsTest : public testing::Test {
  protected:
@@ -253,5 +258,51 @@ TEST_F(TraditionalReassemblyStreamsTest, CanDeleteFirstOrderedMessage) {
   EXPECT_EQ(streams.Add(tsn(2), gen_.Ordered({2, 3, 4}, "BE")), 0);
 }
 
+TEST_F(TraditionalReassemblyStreamsTest, DeliversOrderedMessagesQueuedBehindHole) {
+  constexpr int kNumMessages = 100;
+  std::vector<UnwrappedTSN> assembled;
+  TraditionalReassemblyStreams streams(
+      "", [&](rtc::ArrayView<const UnwrappedTSN> tsns, DcSctpMessage message) {
+        assembled.push_back(tsns[0]);
+      });
+
+  std::vector<Data> messages;
+  for (int i = 0; i < kNumMessages; ++i) {
+    messages.push_back(gen_.Ordered({static_cast<uint8_t>(i)}, "BE"));
+  }
+  // All but the first message arrive, in reverse order.
+  for (int i = kNumMessages - 1; i > 0; --i) {
+    EXPECT_EQ(streams.Add(tsn(i + 1), std::move(messages[i])), 1);
+  }
+  EXPECT_THAT(assembled, IsEmpty());
+
+  EXPECT_EQ(streams.Add(tsn(1), std::move(messages[0])), 1 - kNumMessages);
+  ASSERT_THAT(assembled, SizeIs(kNumMessages));
+  for (int i = 0; i < kNumMessages; ++i) {
+    EXPECT_EQ(assembled[i], tsn(i + 1));
+  }
+}
+
+TEST_F(TraditionalReassemblyStreamsTest, AssemblesFragmentsReceivedOutOfOrder) {
+  NiceMock<MockFunction<ReassemblyStreams::OnAssembledMessage>> on_assembled;
+  EXPECT_CALL(on_assembled,
+              Call(ElementsAre(tsn(1), tsn(2), tsn(3), tsn(4), tsn(5)),
+                   Property(&DcSctpMessage::payload,
+                            ElementsAre(1, 2, 3, 4, 5, 6))));
+
+  TraditionalReassemblyStreams streams("", on_assembled.AsStdFunction());
+
+  Data b = gen_.Unordered({1}, "B");
+  Data m1 = gen_.Unordered({2, 3});
+  Data m2 = gen_.Unordered({4});
+  Data m3 = gen_.Unordered({5});
+  Data e = gen_.Unordered({6}, "E");
+  EXPECT_EQ(streams.Add(tsn(5), std::move(e)), 1);
+  EXPECT_EQ(streams.Add(tsn(3), std::move(m2)), 1);
+  EXPECT_EQ(streams.Add(tsn(1), std::move(b)), 1);
+  EXPECT_EQ(streams.Add(tsn(4), std::move(m3)), 1);
+  EXPECT_EQ(streams.Add(tsn(2), std::move(m1)), -4);
+}
+
 }  // namespace
 }  // namespace dcsctp
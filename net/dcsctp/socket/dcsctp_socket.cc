@@ -298,7 +298,8 @@ void DcSctpSocket::SendInit() {
                  options_.announced_maximum_outgoing_streams,
                  options_.announced_maximum_incoming_streams,
                  connect_params_.initial_tsn, params_builder.Build());
-  SctpPacket::Builder b(VerificationTag(0), options_);
+  SctpPacket::Builder b =
+      packet_sender_.PacketBuilder(VerificationTag(0), options_);
   b.Add(init);
   // https://www.ietf.org/archive/id/draft-tuexen-tsvwg-sctp-zero-checksum-01.html#section-4.2
   // "When an end point sends a packet containing an INIT chunk, it MUST include
@@ -1226,7 +1227,8 @@ void DcSctpSocket::HandleInit(const CommonHeader& header,
       ComputeCapabilities(options_, chunk->nbr_outbound_streams(),
                           chunk->nbr_inbound_streams(), chunk->parameters());
 
-  SctpPacket::Builder b(chunk->initiate_tag(), options_);
+  SctpPacket::Builder b =
+      packet_sender_.PacketBuilder(chunk->initiate_tag(), options_);
   Parameters::Builder params_builder =
       Parameters::Builder().Add(StateCookieParameter(
           StateCookie(chunk->initiate_tag(), my_verification_tag,
@@ -1393,7 +1395,8 @@ bool DcSctpSocket::HandleCookieEchoWithTCB(const CommonHeader& header,
       // that the peer has restarted ...  it MUST NOT set up a new association
       // but instead resend the SHUTDOWN ACK and send an ERROR chunk with a
       // "Cookie Received While Shutting Down" error cause to its peer."
-      SctpPacket::Builder b(cookie.peer_tag(), options_);
+      SctpPacket::Builder b =
+          packet_sender_.PacketBuilder(cookie.peer_tag(), options_);
       b.Add(ShutdownAckChunk());
       b.Add(ErrorChunk(Parameters::Builder()
                            .Add(CookieReceivedWhileShuttingDownCause())
@@ -1666,7 +1669,8 @@ void DcSctpSocket::HandleShutdownAck(
     // bit in the Chunk Flags to indicate that the Verification Tag is
     // reflected."
 
-    SctpPacket::Builder b(header.verification_tag, options_);
+    SctpPacket::Builder b =
+        packet_sender_.PacketBuilder(header.verification_tag, options_);
     b.Add(ShutdownCompleteChunk(/*tag_reflected=*/true));
     packet_sender_.Send(b);
   }
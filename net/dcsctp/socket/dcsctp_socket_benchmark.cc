@@ -0,0 +1,262 @@
+/*
+ *  Copyright (c) 2024 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+#include <algorithm>
+#include <atomic>
+#include <deque>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <utility>
+#include <vector>
+
+#include "absl/strings/string_view.h"
+#include "absl/types/optional.h"
+#include "api/array_view.h"
+#include "api/task_queue/task_queue_base.h"
+#include "api/units/time_delta.h"
+#include "api/units/timestamp.h"
+#include "benchmark/benchmark.h"
+#include "net/dcsctp/public/dcsctp_message.h"
+#include "net/dcsctp/public/dcsctp_options.h"
+#include "net/dcsctp/public/dcsctp_socket.h"
+#include "net/dcsctp/public/timeout.h"
+#include "net/dcsctp/public/types.h"
+#include "net/dcsctp/socket/dcsctp_socket.h"
+#include "net/dcsctp/timer/fake_timeout.h"
+#include "rtc_base/checks.h"
+#include "rtc_base/random.h"
+#include "rtc_base/system/unused.h"
+
+#if defined(DCSCTP_COUNT_ALLOCATIONS)
+// The number of heap allocations made by the process. The global allocation
+// functions are replaced to count them, which is only done in the
+// dcsctp_socket_allocation_benchmark binary, so that the benchmarks linked
+// into the shared benchmarks binary keep using the default allocator.
+static std::atomic<int64_t> g_allocations{0};
+
+void* operator new(size_t size) {
+  g_allocations.fetch_add(1, std::memory_order_relaxed);
+  void* p = malloc(size == 0 ? 1 : size);
+  if (p == nullptr) {
+    abort();
+  }
+  return p;
+}
+void* operator new[](size_t size) {
+  return operator new(size);
+}
+void* operator new(size_t size, const std::nothrow_t&) noexcept {
+  g_allocations.fetch_add(1, std::memory_order_relaxed);
+  return malloc(size == 0 ? 1 : size);
+}
+void* operator new[](size_t size, const std::nothrow_t& tag) noexcept {
+  return operator new(size, tag);
+}
+void operator delete(void* p) noexcept {
+  free(p);
+}
+void operator delete[](void* p) noexcept {
+  free(p);
+}
+void operator delete(void* p, size_t) noexcept {
+  free(p);
+}
+void operator delete[](void* p, size_t) noexcept {
+  free(p);
+}
+#endif
+
+namespace dcsctp {
+namespace {
+
+#if defined(DCSCTP_COUNT_ALLOCATIONS)
+constexpr bool kCountAllocations = true;
+int64_t Allocations() {
+  return g_allocations.load(std::memory_order_relaxed);
+}
+#else
+constexpr bool kCountAllocations = false;
+int64_t Allocations() {
+  return 0;
+}
+#endif
+
+constexpr PPID kPpid(53);
+// Message sizes, picked in turn, so that both single-chunk and fragmented
+// messages are sent.
+constexpr size_t kMessageSizes[] = {40, 500, 1200, 3000, 8000};
+
+// One endpoint of an in-memory association. Sent packets are queued, until
+// the benchmark delivers them to the other endpoint.
+class Peer : public DcSctpSocketCallbacks {
+ public:
+  Peer(absl::string_view name,
+       const DcSctpOptions& options,
+       const webrtc::Timestamp& now)
+      : now_(now),
+        timeout_manager_([this]() { return now_; }),
+        socket_(name, *this, /*packet_observer=*/nullptr, options) {}
+
+  void SendPacket(rtc::ArrayView<const uint8_t> data) override {
+    std::vector<uint8_t> packet;
+    if (!free_packets_.empty()) {
+      packet = std::move(free_packets_.back());
+      free_packets_.pop_back();
+    }
+    packet.assign(data.begin(), data.end());
+    sent_packets_.push_back(std::move(packet));
+  }
+  std::unique_ptr<Timeout> CreateTimeout(
+      webrtc::TaskQueueBase::DelayPrecision precision) override {
+    return timeout_manager_.CreateTimeout(precision);
+  }
+  webrtc::Timestamp Now() override { return now_; }
+  uint32_t GetRandomInt(uint32_t low, uint32_t high) override {
+    return random_.Rand(low, high - 1);
+  }
+  void OnMessageReceived(DcSctpMessage message) override {
+    ++received_messages_;
+    received_bytes_ += message.payload().size();
+  }
+  void OnError(ErrorKind error, absl::string_view message) override {}
+  void OnAborted(ErrorKind error, absl::string_view message) override {
+    RTC_CHECK_NOTREACHED();
+  }
+  void OnConnected() override { connected_ = true; }
+  void OnClosed() override {}
+  void OnConnectionRestarted() override {}
+  void OnStreamsResetFailed(rtc::ArrayView<const StreamID> outgoing_streams,
+                            absl::string_view reason) override {}
+  void OnStreamsResetPerformed(
+      rtc::ArrayView<const StreamID> outgoing_streams) override {}
+  void OnIncomingStreamsReset(
+      rtc::ArrayView<const StreamID> incoming_streams) override {}
+
+  DcSctpSocket& socket() { return socket_; }
+  bool connected() const { return connected_; }
+  int64_t received_messages() const { return received_messages_; }
+  int64_t received_bytes() const { return received_bytes_; }
+
+  // Delivers all packets sent by this endpoint to `other`. Returns false if
+  // there were none.
+  bool DeliverPacketsTo(Peer& other) {
+    if (sent_packets_.empty()) {
+      return false;
+    }
+    // Receiving a packet may make the other endpoint send packets, but never
+    // this one.
+    while (!sent_packets_.empty()) {
+      other.socket_.ReceivePacket(sent_packets_.front());
+      free_packets_.push_back(std::move(sent_packets_.front()));
+      sent_packets_.pop_front();
+    }
+    return true;
+  }
+
+  webrtc::TimeDelta GetTimeToNextTimeout() const {
+    return timeout_manager_.GetTimeToNextTimeout();
+  }
+
+  void HandleExpiredTimeouts() {
+    while (absl::optional<TimeoutID> timeout_id =
+               timeout_manager_.GetNextExpiredTimeout()) {
+      socket_.HandleTimeout(*timeout_id);
+    }
+  }
+
+ private:
+  const webrtc::Timestamp& now_;
+  FakeTimeoutManager timeout_manager_;
+  webrtc::Random random_{42};
+  std::deque<std::vector<uint8_t>> sent_packets_;
+  std::vector<std::vector<uint8_t>> free_packets_;
+  bool connected_ = false;
+  int64_t received_messages_ = 0;
+  int64_t received_bytes_ = 0;
+  DcSctpSocket socket_;
+};
+
+// Exchanges packets between `a` and `z` until `done` returns true, advancing
+// the time to the next timeout whenever no packets are in flight.
+template <typename Done>
+void RunUntil(webrtc::Timestamp& now, Peer& a, Peer& z, Done done) {
+  while (!done()) {
+    bool delivered = a.DeliverPacketsTo(z);
+    delivered |= z.DeliverPacketsTo(a);
+    if (!delivered) {
+      webrtc::TimeDelta delay =
+          std::min(a.GetTimeToNextTimeout(), z.GetTimeToNextTimeout());
+      RTC_CHECK(delay.IsFinite());
+      now += delay;
+      a.HandleExpiredTimeouts();
+      z.HandleExpiredTimeouts();
+    }
+  }
+}
+
+// Sends one message on each of `state.range(0)` streams per iteration, from
+// one socket to another, and runs until all of them have been received. With
+// `state.range(1)` set, message interleaving (I-DATA) is used. In the
+// dcsctp_socket_allocation_benchmark binary, the number of heap allocations
+// per sent message is reported as well.
+void BM_DcSctpSocketMultiStreamSend(benchmark::State& state) {
+  const int num_streams = state.range(0);
+  DcSctpOptions options;
+  options.enable_message_interleaving = state.range(1) != 0;
+  options.max_send_buffer_size = 100'000'000;
+  options.per_stream_send_queue_limit = 100'000'000;
+  // With interleaving, fragments of all messages may be received before any
+  // of them is complete.
+  options.max_receiver_window_buffer_size = 100'000'000;
+  webrtc::Timestamp now = webrtc::Timestamp::Seconds(1);
+  Peer a("A", options, now);
+  Peer z("Z", options, now);
+  a.socket().Connect();
+  RunUntil(now, a, z, [&]() { return a.connected() && z.connected(); });
+
+  int64_t sent_messages = 0;
+  int64_t sent_bytes = 0;
+  size_t next_size = 0;
+  int64_t allocations = 0;
+  for (auto s : state) {
+    RTC_UNUSED(s);
+    const int64_t allocations_before = Allocations();
+    for (int stream = 0; stream < num_streams; ++stream) {
+      const size_t size = kMessageSizes[next_size];
+      next_size = (next_size + 1) % std::size(kMessageSizes);
+      a.socket().Send(DcSctpMessage(StreamID(stream), kPpid,
+                                    std::vector<uint8_t>(size)),
+                      SendOptions());
+      sent_bytes += size;
+    }
+    sent_messages += num_streams;
+    RunUntil(now, a, z,
+             [&]() { return z.received_messages() == sent_messages; });
+    allocations += Allocations() - allocations_before;
+  }
+  RTC_CHECK_EQ(z.received_bytes(), sent_bytes);
+  state.SetBytesProcessed(sent_bytes);
+  state.SetItemsProcessed(sent_messages);
+  if (kCountAllocations) {
+    state.counters["allocations_per_message"] =
+        benchmark::Counter(static_cast<double>(allocations) / sent_messages);
+  }
+}
+
+BENCHMARK(BM_DcSctpSocketMultiStreamSend)
+    ->ArgsProduct({{1, 100, 1000, 10000}, {0, 1}})
+    ->ArgNames({"streams", "interleaving"});
+
+}  // namespace
+}  // namespace dcsctp
@@ -21,15 +21,21 @@ PacketSender::PacketSender(DcSctpSocketCallbacks& callbacks,
                                               SendPacketStatus)> on_sent_packet)
     : callbacks_(callbacks), on_sent_packet_(std::move(on_sent_packet)) {}
 
+SctpPacket::Builder PacketSender::PacketBuilder(
+    VerificationTag verification_tag,
+    const DcSctpOptions& options) {
+  return SctpPacket::Builder(verification_tag, options, &spare_buffer_);
+}
+
 bool PacketSender::Send(SctpPacket::Builder& builder, bool write_checksum) {
   if (builder.empty()) {
     return false;
   }
 
-  std::vector<uint8_t> payload = builder.Build(write_checksum);
+  builder.BuildInto(payload_, write_checksum);
 
-  SendPacketStatus status = callbacks_.SendPacketWithStatus(payload);
-  on_sent_packet_(payload, status);
+  SendPacketStatus status = callbacks_.SendPacketWithStatus(payload_);
+  on_sent_packet_(payload_, status);
   switch (status) {
     case SendPacketStatus::kSuccess: {
       return true;
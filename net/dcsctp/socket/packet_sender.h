@@ -10,6 +10,11 @@
 #ifndef NET_DCSCTP_SOCKET_PACKET_SENDER_H_
 #define NET_DCSCTP_SOCKET_PACKET_SENDER_H_
 
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+#include "api/array_view.h"
 #include "net/dcsctp/packet/sctp_packet.h"
 #include "net/dcsctp/public/dcsctp_socket.h"
 
@@ -24,12 +29,25 @@ class PacketSender {
                std::function<void(rtc::ArrayView<const uint8_t>,
                                   SendPacketStatus)> on_sent_packet);
 
+  // Returns a builder for a packet to be sent by this sender. It serializes
+  // into the allocation of a previously sent packet instead of allocating its
+  // own, and must not outlive this sender.
+  SctpPacket::Builder PacketBuilder(VerificationTag verification_tag,
+                                    const DcSctpOptions& options);
+
   // Sends the packet, and returns true if it was sent successfully.
   bool Send(SctpPacket::Builder& builder, bool write_checksum = true);
 
  private:
   DcSctpSocketCallbacks& callbacks_;
 
+  // Holds the most recently sent packet. Its allocation is handed back to the
+  // builder of the next packet, to avoid allocating a buffer per packet.
+  std::vector<uint8_t> payload_;
+  // Allocation handed back by the builders returned by PacketBuilder() when
+  // they are destroyed, and handed out to the next one.
+  std::vector<uint8_t> spare_buffer_;
+
   // Callback that will be triggered for every send attempt, indicating the
   // status of the operation.
   std::function<void(rtc::ArrayView<const uint8_t>, SendPacketStatus)>
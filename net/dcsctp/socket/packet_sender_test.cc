@@ -9,6 +9,8 @@
  */
 #include "net/dcsctp/socket/packet_sender.h"
 
+#include <vector>
+
 #include "net/dcsctp/common/internal_types.h"
 #include "net/dcsctp/packet/chunk/cookie_ack_chunk.h"
 #include "net/dcsctp/socket/mock_dcsctp_socket_callbacks.h"
@@ -46,5 +48,26 @@ TEST_F(PacketSenderTest, SendPacketCallsCallback) {
   EXPECT_FALSE(sender_.Send(PacketBuilder().Add(CookieAckChunk())));
 }
 
+TEST_F(PacketSenderTest, ShortLivedBuildersReuseAllocations) {
+  std::vector<const uint8_t*> sent_data;
+  EXPECT_CALL(on_send_fn_, Call)
+      .WillRepeatedly([&](rtc::ArrayView<const uint8_t> data,
+                          SendPacketStatus) {
+        sent_data.push_back(data.data());
+      });
+  for (int i = 0; i < 4; ++i) {
+    SctpPacket::Builder builder =
+        sender_.PacketBuilder(kVerificationTag, options_);
+    EXPECT_TRUE(sender_.Send(builder.Add(CookieAckChunk())));
+  }
+
+  // Once two allocations exist, they alternate between the packet being
+  // built and the packet most recently sent.
+  ASSERT_EQ(sent_data.size(), 4u);
+  EXPECT_NE(sent_data[0], sent_data[1]);
+  EXPECT_EQ(sent_data[2], sent_data[0]);
+  EXPECT_EQ(sent_data[3], sent_data[1]);
+}
+
 }  // namespace
 }  // namespace dcsctp
@@ -195,7 +195,7 @@ void TransmissionControlBlock::MaybeSendFastRetransmit() {
   // ignore the value of cwnd and SHOULD NOT delay retransmission for this
   // single packet."
 
-  SctpPacket::Builder builder(peer_verification_tag_, options_);
+  SctpPacket::Builder builder = PacketBuilder();
   auto chunks = retransmission_queue_.GetChunksForFastRetransmit(
       builder.bytes_remaining());
   for (auto& [tsn, data] : chunks) {
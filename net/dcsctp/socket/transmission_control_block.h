@@ -74,7 +74,7 @@ class TransmissionControlBlock : public Context {
   }
   void ClearTxErrorCounter() override { tx_error_counter_.Clear(); }
   SctpPacket::Builder PacketBuilder() const override {
-    return SctpPacket::Builder(peer_verification_tag_, options_);
+    return packet_sender_.PacketBuilder(peer_verification_tag_, options_);
   }
   bool HasTooManyTxErrors() const override {
     return tx_error_counter_.IsExhausted();
@@ -135,7 +135,7 @@ class TransmissionControlBlock : public Context {
   // present, then only one packet will be sent, with this chunk as the first
   // chunk.
   void SendBufferedPackets(webrtc::Timestamp now) {
-    SctpPacket::Builder builder(peer_verification_tag_, options_);
+    SctpPacket::Builder builder = PacketBuilder();
     SendBufferedPackets(builder, now);
   }
 
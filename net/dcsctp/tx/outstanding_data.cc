@@ -10,7 +10,6 @@
 #include "net/dcsctp/tx/outstanding_data.h"
 
 #include <algorithm>
-#include <set>
 #include <utility>
 #include <vector>
 
@@ -79,14 +78,10 @@ bool OutstandingData::Item::has_expired(Timestamp now) const {
 bool OutstandingData::IsConsistent() const {
   size_t actual_unacked_bytes = 0;
   size_t actual_unacked_items = 0;
+  size_t actual_acked_items = 0;
+  size_t actual_combined_to_be_retransmitted = 0;
+  bool members_match = true;
 
-  std::set<UnwrappedTSN> combined_to_be_retransmitted;
-  combined_to_be_retransmitted.insert(to_be_retransmitted_.begin(),
-                                      to_be_retransmitted_.end());
-  combined_to_be_retransmitted.insert(to_be_fast_retransmitted_.begin(),
-                                      to_be_fast_retransmitted_.end());
-
-  std::set<UnwrappedTSN> actual_combined_to_be_retransmitted;
   UnwrappedTSN tsn = last_cumulative_tsn_ack_;
   for (const Item& item : outstanding_data_) {
     tsn.Increment();
@@ -95,14 +90,23 @@ bool OutstandingData::IsConsistent() const {
       ++actual_unacked_items;
     }
 
+    if (item.is_acked()) {
+      ++actual_acked_items;
+      members_match &= acked_.contains(tsn);
+    }
+
     if (item.should_be_retransmitted()) {
-      actual_combined_to_be_retransmitted.insert(tsn);
+      ++actual_combined_to_be_retransmitted;
+      members_match &= to_be_retransmitted_.contains(tsn) ||
+                       to_be_fast_retransmitted_.contains(tsn);
     }
   }
 
   return actual_unacked_bytes == unacked_bytes_ &&
-         actual_unacked_items == unacked_items_ &&
-         actual_combined_to_be_retransmitted == combined_to_be_retransmitted;
+         actual_unacked_items == unacked_items_ && members_match &&
+         actual_acked_items == acked_.size() &&
+         actual_combined_to_be_retransmitted ==
+             to_be_retransmitted_.size() + to_be_fast_retransmitted_.size();
 }
 
 void OutstandingData::AckChunk(AckInfo& ack_info,
@@ -116,11 +120,11 @@ void OutstandingData::AckChunk(AckInfo& ack_info,
       --unacked_items_;
     }
     if (item.should_be_retransmitted()) {
-      RTC_DCHECK(to_be_fast_retransmitted_.find(tsn) ==
-                 to_be_fast_retransmitted_.end());
+      RTC_DCHECK(!to_be_fast_retransmitted_.contains(tsn));
       to_be_retransmitted_.erase(tsn);
     }
     item.Ack();
+    acked_.insert(tsn);
     ack_info.highest_tsn_acked = std::max(ack_info.highest_tsn_acked, tsn);
   }
 }
@@ -180,6 +184,9 @@ void OutstandingData::RemoveAcked(UnwrappedTSN cumulative_tsn_ack,
     outstanding_data_.pop_front();
     last_cumulative_tsn_ack_.Increment();
   }
+  acked_.AdvanceTo(last_cumulative_tsn_ack_.next_value());
+  to_be_fast_retransmitted_.AdvanceTo(last_cumulative_tsn_ack_.next_value());
+  to_be_retransmitted_.AdvanceTo(last_cumulative_tsn_ack_.next_value());
 
   stream_reset_breakpoint_tsns_.erase(stream_reset_breakpoint_tsns_.begin(),
                                       stream_reset_breakpoint_tsns_.upper_bound(
@@ -195,14 +202,19 @@ void OutstandingData::AckGapBlocks(
   // SACK chunk as advisory.". Note that when NR-SACK is supported, this can be
   // handled differently.
 
+  // Blocks that were reported in previous SACKs are mostly acked already, so
+  // only the TSNs in the blocks that aren't acked yet are visited.
   for (auto& block : gap_ack_blocks) {
-    UnwrappedTSN start = UnwrappedTSN::AddTo(cumulative_tsn_ack, block.start);
-    UnwrappedTSN end = UnwrappedTSN::AddTo(cumulative_tsn_ack, block.end);
-    for (UnwrappedTSN tsn = start; tsn <= end; tsn = tsn.next_value()) {
-      if (tsn > last_cumulative_tsn_ack_ && tsn < next_tsn()) {
-        Item& item = GetItem(tsn);
-        AckChunk(ack_info, tsn, item);
-      }
+    UnwrappedTSN start =
+        std::max(UnwrappedTSN::AddTo(cumulative_tsn_ack, block.start),
+                 last_cumulative_tsn_ack_.next_value());
+    UnwrappedTSN end = std::min(
+        UnwrappedTSN::AddTo(cumulative_tsn_ack, block.end).next_value(),
+        next_tsn());
+    for (UnwrappedTSN tsn = acked_.Find(start, end, /*member=*/false);
+         tsn < end;
+         tsn = acked_.Find(tsn.next_value(), end, /*member=*/false)) {
+      AckChunk(ack_info, tsn, GetItem(tsn));
     }
   }
 }
@@ -260,6 +272,10 @@ bool OutstandingData::NackItem(UnwrappedTSN tsn,
   if (item.is_outstanding()) {
     unacked_bytes_ -= GetSerializedChunkSize(item.data());
     --unacked_items_;
+  } else if (item.is_acked()) {
+    // Gap ack blocks are advisory, and a chunk that was acked by one may be
+    // reported as missing by a later SACK.
+    acked_.erase(tsn);
   }
 
   switch (item.Nack(retransmit_now)) {
@@ -304,6 +320,7 @@ void OutstandingData::AbandonAllFor(const Item& item) {
     // The added chunk shouldn't be included in `unacked_bytes`, so set it
     // as acked.
     added_item.Ack();
+    acked_.insert(tsn);
     RTC_DLOG(LS_VERBOSE) << "Adding unsent end placeholder for message at tsn="
                          << *tsn.Wrap();
   }
@@ -326,12 +343,14 @@ void OutstandingData::AbandonAllFor(const Item& item) {
 }
 
 std::vector<std::pair<TSN, Data>> OutstandingData::ExtractChunksThatCanFit(
-    std::set<UnwrappedTSN>& chunks,
+    TsnBitmap& chunks,
     size_t max_size) {
   std::vector<std::pair<TSN, Data>> result;
 
-  for (auto it = chunks.begin(); it != chunks.end();) {
-    UnwrappedTSN tsn = *it;
+  const UnwrappedTSN end = next_tsn();
+  for (UnwrappedTSN tsn = chunks.Find(last_cumulative_tsn_ack_.next_value(),
+                                      end, /*member=*/true);
+       tsn < end; tsn = chunks.Find(tsn.next_value(), end, /*member=*/true)) {
     Item& item = GetItem(tsn);
     RTC_DCHECK(item.should_be_retransmitted());
     RTC_DCHECK(!item.is_outstanding());
@@ -345,9 +364,7 @@ std::vector<std::pair<TSN, Data>> OutstandingData::ExtractChunksThatCanFit(
       max_size -= serialized_size;
       unacked_bytes_ += serialized_size;
       ++unacked_items_;
-      it = chunks.erase(it);
-    } else {
-      ++it;
+      chunks.erase(tsn);
     }
     // No point in continuing if the packet is full.
     if (max_size <= data_chunk_header_size_) {
@@ -369,9 +386,7 @@ OutstandingData::GetChunksToBeFastRetransmitted(size_t max_size) {
   // marked for retransmission they will be retransmitted later on as soon as
   // cwnd allows."
   if (!to_be_fast_retransmitted_.empty()) {
-    to_be_retransmitted_.insert(to_be_fast_retransmitted_.begin(),
-                                to_be_fast_retransmitted_.end());
-    to_be_fast_retransmitted_.clear();
+    to_be_retransmitted_.merge(to_be_fast_retransmitted_);
   }
 
   RTC_DCHECK(IsConsistent());
@@ -569,6 +584,9 @@ IForwardTsnChunk OutstandingData::CreateIForwardTsn() const {
 void OutstandingData::ResetSequenceNumbers(UnwrappedTSN last_cumulative_tsn) {
   RTC_DCHECK(outstanding_data_.empty());
   last_cumulative_tsn_ack_ = last_cumulative_tsn;
+  acked_.Reset(last_cumulative_tsn.next_value());
+  to_be_fast_retransmitted_.Reset(last_cumulative_tsn.next_value());
+  to_be_retransmitted_.Reset(last_cumulative_tsn.next_value());
 }
 
 void OutstandingData::BeginResetStreams() {
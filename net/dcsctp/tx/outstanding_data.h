@@ -10,9 +10,10 @@
 #ifndef NET_DCSCTP_TX_OUTSTANDING_DATA_H_
 #define NET_DCSCTP_TX_OUTSTANDING_DATA_H_
 
+#include <stdint.h>
+
 #include <deque>
 #include <map>
-#include <set>
 #include <utility>
 #include <vector>
 
@@ -25,6 +26,7 @@
 #include "net/dcsctp/packet/chunk/sack_chunk.h"
 #include "net/dcsctp/packet/data.h"
 #include "net/dcsctp/public/types.h"
+#include "net/dcsctp/tx/tsn_bitmap.h"
 #include "rtc_base/containers/flat_set.h"
 
 namespace dcsctp {
@@ -83,7 +85,10 @@ class OutstandingData {
       std::function<bool(StreamID, OutgoingMessageId)> discard_from_send_queue)
       : data_chunk_header_size_(data_chunk_header_size),
         last_cumulative_tsn_ack_(last_cumulative_tsn_ack),
-        discard_from_send_queue_(std::move(discard_from_send_queue)) {}
+        discard_from_send_queue_(std::move(discard_from_send_queue)),
+        acked_(last_cumulative_tsn_ack.next_value()),
+        to_be_fast_retransmitted_(last_cumulative_tsn_ack.next_value()),
+        to_be_retransmitted_(last_cumulative_tsn_ack.next_value()) {}
 
   AckInfo HandleSack(
       UnwrappedTSN cumulative_tsn_ack,
@@ -342,7 +347,7 @@ class OutstandingData {
   void AbandonAllFor(const OutstandingData::Item& item);
 
   std::vector<std::pair<TSN, Data>> ExtractChunksThatCanFit(
-      std::set<UnwrappedTSN>& chunks,
+      TsnBitmap& chunks,
       size_t max_size);
 
   bool IsConsistent() const;
@@ -363,10 +368,13 @@ class OutstandingData {
   // The number of DATA chunks that are in-flight (sent but not yet acked or
   // nacked).
   size_t unacked_items_ = 0;
+  // Data chunks that have been acked, by the cumulative TSN ack or by gap ack
+  // blocks.
+  TsnBitmap acked_;
   // Data chunks that are eligible for fast retransmission.
-  std::set<UnwrappedTSN> to_be_fast_retransmitted_;
+  TsnBitmap to_be_fast_retransmitted_;
   // Data chunks that are to be retransmitted.
-  std::set<UnwrappedTSN> to_be_retransmitted_;
+  TsnBitmap to_be_retransmitted_;
   // Wben a stream reset has begun, the "next TSN to assign" is added to this
   // set, and removed when the cum-ack TSN reaches it. This is used to limit a
   // FORWARD-TSN to reset streams past a "stream reset last assigned TSN".
@@ -0,0 +1,177 @@
+/*
+ *  Copyright (c) 2024 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+#include <stddef.h>
+#include <stdint.h>
+
+#include <deque>
+#include <iterator>
+#include <utility>
+#include <vector>
+
+#include "api/units/timestamp.h"
+#include "benchmark/benchmark.h"
+#include "net/dcsctp/common/internal_types.h"
+#include "net/dcsctp/common/sequence_numbers.h"
+#include "net/dcsctp/packet/chunk/data_chunk.h"
+#include "net/dcsctp/packet/chunk/sack_chunk.h"
+#include "net/dcsctp/packet/data.h"
+#include "net/dcsctp/public/types.h"
+#include "net/dcsctp/tx/outstanding_data.h"
+#include "rtc_base/random.h"
+#include "rtc_base/system/unused.h"
+
+namespace dcsctp {
+namespace {
+
+constexpr size_t kPacketSize = 1200;
+constexpr size_t kPayloadSize = 1100;
+// The number of new chunks sent, and the number of chunks arriving at the
+// receiver, per SACK.
+constexpr int kChunksPerSack = 2;
+constexpr double kLossRate = 0.01;
+
+// The TSNs received by the peer, as the cumulative TSN ack and the gap ack
+// blocks above it.
+class Receiver {
+ public:
+  explicit Receiver(UnwrappedTSN cumulative_tsn_ack)
+      : cumulative_tsn_ack_(cumulative_tsn_ack) {}
+
+  void Receive(UnwrappedTSN tsn) {
+    if (tsn <= cumulative_tsn_ack_) {
+      return;
+    }
+    if (tsn == cumulative_tsn_ack_.next_value()) {
+      cumulative_tsn_ack_ = tsn;
+      if (!blocks_.empty() &&
+          blocks_.front().first == cumulative_tsn_ack_.next_value()) {
+        cumulative_tsn_ack_ = blocks_.front().second;
+        blocks_.erase(blocks_.begin());
+      }
+      return;
+    }
+    auto it = blocks_.begin();
+    while (it != blocks_.end() && it->second.next_value() < tsn) {
+      ++it;
+    }
+    if (it == blocks_.end() || tsn.next_value() < it->first) {
+      blocks_.emplace(it, tsn, tsn);
+      return;
+    }
+    if (tsn.next_value() == it->first) {
+      it->first = tsn;
+    } else if (it->second.next_value() == tsn) {
+      it->second = tsn;
+      auto next = std::next(it);
+      if (next != blocks_.end() && next->first == tsn.next_value()) {
+        it->second = next->second;
+        blocks_.erase(next);
+      }
+    }
+  }
+
+  UnwrappedTSN cumulative_tsn_ack() const { return cumulative_tsn_ack_; }
+
+  std::vector<SackChunk::GapAckBlock> gap_ack_blocks() const {
+    std::vector<SackChunk::GapAckBlock> blocks;
+    blocks.reserve(blocks_.size());
+    for (const auto& [first, last] : blocks_) {
+      blocks.emplace_back(
+          static_cast<uint16_t>(
+              UnwrappedTSN::Difference(first, cumulative_tsn_ack_)),
+          static_cast<uint16_t>(
+              UnwrappedTSN::Difference(last, cumulative_tsn_ack_)));
+    }
+    return blocks;
+  }
+
+ private:
+  UnwrappedTSN cumulative_tsn_ack_;
+  std::vector<std::pair<UnwrappedTSN, UnwrappedTSN>> blocks_;
+};
+
+// Sends a stream of chunks over a path with a bandwidth-delay product of
+// `state.range(0)` chunks and 1% random loss, and handles one SACK per
+// iteration. New chunks are sent while fewer than the bandwidth-delay product
+// are in flight and the outstanding chunks fit in the receiver window, and
+// chunks marked for retransmission are sent one packet per iteration.
+void BM_OutstandingDataHighBdp(benchmark::State& state) {
+  const size_t bandwidth_delay_product = state.range(0);
+  const int64_t delay = bandwidth_delay_product / kChunksPerSack;
+  const int64_t receive_window = 4 * bandwidth_delay_product;
+  UnwrappedTSN::Unwrapper unwrapper;
+  const UnwrappedTSN initial_tsn = unwrapper.Unwrap(TSN(10));
+  OutstandingData outstanding_data(
+      DataChunk::kHeaderSize, initial_tsn,
+      [](StreamID, OutgoingMessageId) { return false; });
+  Receiver receiver(initial_tsn);
+  webrtc::Random random(1234);
+  const Data data(StreamID(1), SSN(0), MID(0), FSN(0), PPID(53),
+                  std::vector<uint8_t>(kPayloadSize), Data::IsBeginning(true),
+                  Data::IsEnd(true), IsUnordered(true));
+  const webrtc::Timestamp now = webrtc::Timestamp::Seconds(1);
+  // The chunks on the path, with the iteration they arrive in.
+  std::deque<std::pair<int64_t, UnwrappedTSN>> in_flight;
+  int64_t iteration = 0;
+  uint32_t message_id = 0;
+
+  auto send = [&](UnwrappedTSN tsn) {
+    in_flight.emplace_back(iteration + delay, tsn);
+  };
+  auto resend = [&](const std::vector<std::pair<TSN, Data>>& chunks) {
+    for (const auto& [tsn, unused] : chunks) {
+      send(unwrapper.Unwrap(tsn));
+    }
+  };
+
+  for (auto s : state) {
+    RTC_UNUSED(s);
+    if (outstanding_data.has_data_to_be_fast_retransmitted()) {
+      resend(outstanding_data.GetChunksToBeFastRetransmitted(kPacketSize));
+    } else if (outstanding_data.has_data_to_be_retransmitted()) {
+      resend(outstanding_data.GetChunksToBeRetransmitted(kPacketSize));
+    }
+    for (int i = 0;
+         i < kChunksPerSack &&
+         outstanding_data.unacked_items() < bandwidth_delay_product &&
+         UnwrappedTSN::Difference(outstanding_data.next_tsn(),
+                                  outstanding_data.last_cumulative_tsn_ack()) <=
+             receive_window;
+         ++i) {
+      send(*outstanding_data.Insert(OutgoingMessageId(message_id++), data,
+                                    now));
+    }
+
+    while (!in_flight.empty() && in_flight.front().first <= iteration) {
+      if (random.Rand<double>() >= kLossRate) {
+        receiver.Receive(in_flight.front().second);
+      }
+      in_flight.pop_front();
+    }
+
+    benchmark::DoNotOptimize(outstanding_data.HandleSack(
+        receiver.cumulative_tsn_ack(), receiver.gap_ack_blocks(),
+        /*is_in_fast_recovery=*/false));
+    if (in_flight.empty()) {
+      // The retransmission timer expires.
+      outstanding_data.NackAll();
+    }
+    ++iteration;
+  }
+  state.counters["outstanding_chunks"] = benchmark::Counter(
+      UnwrappedTSN::Difference(outstanding_data.next_tsn(),
+                               outstanding_data.last_cumulative_tsn_ack()) -
+      1);
+}
+
+BENCHMARK(BM_OutstandingDataHighBdp)->Arg(1000)->Arg(10000);
+
+}  // namespace
+}  // namespace dcsctp
@@ -205,7 +205,7 @@ absl::optional<SendQueue::DataToSend> RRSendQueue::OutgoingStream::Produce(
       if (pause_state_ == PauseState::kPending) {
         RTC_DLOG(LS_VERBOSE) << "Pause state on " << *stream_id
                              << " is moving from pending to paused";
-        pause_state_ = PauseState::kPaused;
+        SetPauseState(PauseState::kPaused);
       }
     } else {
       item.remaining_offset += chunk_payload.size();
@@ -248,7 +248,7 @@ bool RRSendQueue::OutgoingStream::Discard(OutgoingMessageId message_id) {
       scheduler_stream_->ForceReschedule();
 
       if (pause_state_ == PauseState::kPending) {
-        pause_state_ = PauseState::kPaused;
+        SetPauseState(PauseState::kPaused);
         scheduler_stream_->MakeInactive();
       } else if (bytes_to_send_in_next_message() == 0) {
         scheduler_stream_->MakeInactive();
@@ -292,9 +292,9 @@ void RRSendQueue::OutgoingStream::Pause() {
     }
   }
 
-  pause_state_ = (items_.empty() || items_.front().remaining_offset == 0)
-                     ? PauseState::kPaused
-                     : PauseState::kPending;
+  SetPauseState((items_.empty() || items_.front().remaining_offset == 0)
+                    ? PauseState::kPaused
+                    : PauseState::kPending);
 
   if (had_pending_items && pause_state_ == PauseState::kPaused) {
     RTC_DLOG(LS_VERBOSE) << "Stream " << *stream_id()
@@ -307,7 +307,7 @@ void RRSendQueue::OutgoingStream::Pause() {
 
 void RRSendQueue::OutgoingStream::Resume() {
   RTC_DCHECK(pause_state_ == PauseState::kResetting);
-  pause_state_ = PauseState::kNotPaused;
+  SetPauseState(PauseState::kNotPaused);
   scheduler_stream_->MaybeMakeActive();
   RTC_DCHECK(IsConsistent());
 }
@@ -317,7 +317,7 @@ void RRSendQueue::OutgoingStream::Reset() {
   // to, or when the entire SendQueue is reset due to detecting the peer having
   // restarted. The stream may be in any state at this time.
   PauseState old_pause_state = pause_state_;
-  pause_state_ = PauseState::kNotPaused;
+  SetPauseState(PauseState::kNotPaused);
   next_ordered_mid_ = MID(0);
   next_unordered_mid_ = MID(0);
   next_ssn_ = SSN(0);
@@ -342,6 +342,16 @@ void RRSendQueue::OutgoingStream::Reset() {
   RTC_DCHECK(IsConsistent());
 }
 
+void RRSendQueue::OutgoingStream::SetPauseState(PauseState state) {
+  if (pause_state_ == PauseState::kPaused) {
+    --parent_.num_streams_ready_to_be_reset_;
+  }
+  if (state == PauseState::kPaused) {
+    ++parent_.num_streams_ready_to_be_reset_;
+  }
+  pause_state_ = state;
+}
+
 bool RRSendQueue::OutgoingStream::has_partially_sent_message() const {
   if (items_.empty()) {
     return false;
@@ -399,12 +409,12 @@ void RRSendQueue::PrepareResetStream(StreamID stream_id) {
 }
 
 bool RRSendQueue::HasStreamsReadyToBeReset() const {
-  for (auto& [unused, stream] : streams_) {
-    if (stream.IsReadyToBeReset()) {
-      return true;
-    }
-  }
-  return false;
+  RTC_DCHECK_EQ(absl::c_count_if(streams_,
+                                 [](const auto& p) {
+                                   return p.second.IsReadyToBeReset();
+                                 }),
+                num_streams_ready_to_be_reset_);
+  return num_streams_ready_to_be_reset_ > 0;
 }
 std::vector<StreamID> RRSendQueue::GetStreamsReadyToBeReset() {
   RTC_DCHECK(absl::c_count_if(streams_, [](const auto& p) {
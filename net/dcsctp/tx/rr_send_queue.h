@@ -178,7 +178,7 @@ class RRSendQueue : public SendQueue {
 
     void SetAsResetting() {
       RTC_DCHECK(pause_state_ == PauseState::kPaused);
-      pause_state_ = PauseState::kResetting;
+      SetPauseState(PauseState::kResetting);
     }
 
     // Resets this stream, meaning MIDs and SSNs are set to zero.
@@ -243,6 +243,9 @@ class RRSendQueue : public SendQueue {
 
     bool IsConsistent() const;
     void HandleMessageExpired(OutgoingStream::Item& item);
+    // Sets `pause_state_`, and updates the parent's count of streams that are
+    // ready to be reset.
+    void SetPauseState(PauseState state);
 
     RRSendQueue& parent_;
 
@@ -279,6 +282,10 @@ class RRSendQueue : public SendQueue {
 
   // All streams, and messages added to those.
   std::map<StreamID, OutgoingStream> streams_;
+
+  // The number of streams in `streams_` that are ready to be reset, so that it
+  // can be checked without iterating over all streams.
+  int num_streams_ready_to_be_reset_ = 0;
 };
 }  // namespace dcsctp
 
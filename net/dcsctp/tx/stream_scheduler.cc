@@ -11,7 +11,6 @@
 
 #include <algorithm>
 
-#include "absl/algorithm/container.h"
 #include "absl/types/optional.h"
 #include "api/array_view.h"
 #include "net/dcsctp/packet/data.h"
@@ -21,9 +20,13 @@
 #include "net/dcsctp/tx/send_queue.h"
 #include "rtc_base/checks.h"
 #include "rtc_base/logging.h"
-#include "rtc_base/strings/str_join.h"
 
 namespace dcsctp {
+namespace {
+// The number of stale entries in the heap of active streams that are
+// tolerated, in addition to one per active stream, before they're removed.
+constexpr size_t kMaxStaleActiveStreams = 64;
+}  // namespace
 
 void StreamScheduler::Stream::SetPriority(StreamPriority priority) {
   priority_ = priority;
@@ -41,31 +44,22 @@ absl::optional<SendQueue::DataToSend> StreamScheduler::Produce(
 
   RTC_DLOG(LS_VERBOSE) << log_prefix_
                        << "Producing data, rescheduling=" << rescheduling
-                       << ", active="
-                       << StrJoin(active_streams_, ", ",
-                                  [&](rtc::StringBuilder& sb, const auto& p) {
-                                    sb << *p->stream_id() << "@"
-                                       << *p->next_finish_time();
-                                  });
+                       << ", active=" << num_active_streams_;
 
   RTC_DCHECK(rescheduling || current_stream_ != nullptr);
 
   absl::optional<SendQueue::DataToSend> data;
-  while (!data.has_value() && !active_streams_.empty()) {
+  while (!data.has_value() && num_active_streams_ > 0) {
     if (rescheduling) {
-      auto it = active_streams_.begin();
-      current_stream_ = *it;
+      current_stream_ = PopNextActiveStream();
       RTC_DLOG(LS_VERBOSE) << log_prefix_ << "Rescheduling to stream "
                            << *current_stream_->stream_id();
 
-      active_streams_.erase(it);
       current_stream_->ForceMarkInactive();
     } else {
       RTC_DLOG(LS_VERBOSE) << log_prefix_ << "Producing from previous stream: "
                            << *current_stream_->stream_id();
-      RTC_DCHECK(absl::c_any_of(active_streams_, [this](const auto* p) {
-        return p == current_stream_;
-      }));
+      RTC_DCHECK(current_stream_->is_active());
     }
 
     data = current_stream_->Produce(now, max_size);
@@ -142,17 +136,92 @@ absl::optional<SendQueue::DataToSend> StreamScheduler::Stream::Produce(
   return data;
 }
 
+StreamScheduler::Stream* StreamScheduler::PopNextActiveStream() {
+  for (;;) {
+    RTC_DCHECK(!active_streams_.empty());
+    std::pop_heap(active_streams_.begin(), active_streams_.end(),
+                  ActiveStreamComparator());
+    ActiveStream entry = active_streams_.back();
+    active_streams_.pop_back();
+    --entry.stream->active_stream_entries_;
+    if (!entry.is_stale()) {
+      return entry.stream;
+    }
+  }
+}
+
+void StreamScheduler::AddActiveStream(Stream* stream) {
+  ++num_active_streams_;
+  ++stream->active_stream_entries_;
+  active_streams_.push_back({.next_finish_time = stream->next_finish_time_,
+                             .stream_id = stream->stream_id_,
+                             .activation = stream->activation_,
+                             .stream = stream});
+  std::push_heap(active_streams_.begin(), active_streams_.end(),
+                 ActiveStreamComparator());
+
+  // Stale entries are normally dropped when they reach the top of the heap,
+  // but streams that are repeatedly made inactive and active again could make
+  // them pile up.
+  if (active_streams_.size() >
+      2 * static_cast<size_t>(num_active_streams_) + kMaxStaleActiveStreams) {
+    RemoveActiveStreamsIf([](const ActiveStream& e) { return e.is_stale(); });
+  }
+}
+
+template <typename Predicate>
+void StreamScheduler::RemoveActiveStreamsIf(Predicate pred) {
+  active_streams_.erase(
+      std::remove_if(active_streams_.begin(), active_streams_.end(),
+                     [&](const ActiveStream& e) {
+                       if (!pred(e)) {
+                         return false;
+                       }
+                       --e.stream->active_stream_entries_;
+                       return true;
+                     }),
+      active_streams_.end());
+  std::make_heap(active_streams_.begin(), active_streams_.end(),
+                 ActiveStreamComparator());
+}
+
 bool StreamScheduler::IsConsistent() const {
-  for (Stream* stream : active_streams_) {
-    if (stream->next_finish_time_ == VirtualTime::Zero()) {
-      RTC_DLOG(LS_VERBOSE) << log_prefix_ << "Stream " << *stream->stream_id()
-                           << " is active, but has no next-finish-time";
+  int num_active_streams = 0;
+  for (const ActiveStream& entry : active_streams_) {
+    if (entry.is_stale()) {
+      continue;
+    }
+    ++num_active_streams;
+    if (entry.next_finish_time != entry.stream->next_finish_time_) {
+      RTC_DLOG(LS_VERBOSE) << log_prefix_ << "Stream "
+                           << *entry.stream->stream_id()
+                           << " is active, but has a different finish time";
       return false;
     }
   }
+  if (num_active_streams != num_active_streams_) {
+    RTC_DLOG(LS_VERBOSE) << log_prefix_ << "Found " << num_active_streams
+                         << " active streams, but expected "
+                         << num_active_streams_;
+    return false;
+  }
   return true;
 }
 
+StreamScheduler::Stream::~Stream() {
+  if (is_active()) {
+    --parent_.num_active_streams_;
+  }
+  if (parent_.current_stream_ == this) {
+    parent_.current_stream_ = nullptr;
+    parent_.currently_sending_a_message_ = false;
+  }
+  if (active_stream_entries_ > 0) {
+    parent_.RemoveActiveStreamsIf(
+        [this](const ActiveStream& e) { return e.stream == this; });
+  }
+}
+
 void StreamScheduler::Stream::MaybeMakeActive() {
   RTC_DLOG(LS_VERBOSE) << parent_.log_prefix_ << "MaybeMakeActive("
                        << *stream_id() << ")";
@@ -176,28 +245,32 @@ void StreamScheduler::Stream::MakeActive(size_t bytes_to_send_next) {
                        << *next_finish_time;
   RTC_DCHECK(next_finish_time_ == VirtualTime::Zero());
   next_finish_time_ = next_finish_time;
-  RTC_DCHECK(!absl::c_any_of(parent_.active_streams_,
-                             [this](const auto* p) { return p == this; }));
-  parent_.active_streams_.emplace(this);
+  ++activation_;
+  parent_.AddActiveStream(this);
 }
 
 void StreamScheduler::Stream::ForceMarkInactive() {
   RTC_DLOG(LS_VERBOSE) << parent_.log_prefix_ << "Making stream "
                        << *stream_id() << " inactive";
   RTC_DCHECK(next_finish_time_ != VirtualTime::Zero());
+  if (is_active()) {
+    --parent_.num_active_streams_;
+  }
   next_finish_time_ = VirtualTime::Zero();
 }
 
 void StreamScheduler::Stream::MakeInactive() {
+  // The stream's entry in `active_streams_` is now stale, and will be dropped
+  // when it reaches the top of the heap.
   ForceMarkInactive();
-  webrtc::EraseIf(parent_.active_streams_,
-                  [&](const auto* s) { return s == this; });
 }
 
 std::set<StreamID> StreamScheduler::ActiveStreamsForTesting() const {
   std::set<StreamID> stream_ids;
-  for (const auto& stream : active_streams_) {
-    stream_ids.insert(stream->stream_id());
+  for (const ActiveStream& entry : active_streams_) {
+    if (!entry.is_stale()) {
+      stream_ids.insert(entry.stream_id);
+    }
   }
   return stream_ids;
 }
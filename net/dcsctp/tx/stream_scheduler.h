@@ -19,6 +19,7 @@
 #include <set>
 #include <string>
 #include <utility>
+#include <vector>
 
 #include "absl/algorithm/container.h"
 #include "absl/memory/memory.h"
@@ -31,7 +32,6 @@
 #include "net/dcsctp/public/dcsctp_socket.h"
 #include "net/dcsctp/public/types.h"
 #include "net/dcsctp/tx/send_queue.h"
-#include "rtc_base/containers/flat_set.h"
 #include "rtc_base/strong_alias.h"
 
 namespace dcsctp {
@@ -98,6 +98,8 @@ class StreamScheduler {
 
   class Stream {
    public:
+    ~Stream();
+
     StreamID stream_id() const { return stream_id_; }
 
     StreamPriority priority() const { return priority_; }
@@ -140,6 +142,7 @@ class StreamScheduler {
 
     VirtualTime current_time() const { return current_virtual_time_; }
     VirtualTime next_finish_time() const { return next_finish_time_; }
+    bool is_active() const { return next_finish_time_ != VirtualTime::Zero(); }
     size_t bytes_to_send_in_next_message() const {
       return producer_.bytes_to_send_in_next_message();
     }
@@ -154,6 +157,12 @@ class StreamScheduler {
     // This outgoing stream's "current" virtual_time.
     VirtualTime current_virtual_time_ = VirtualTime::Zero();
     VirtualTime next_finish_time_ = VirtualTime::Zero();
+    // Incremented every time the stream is made active, to tell its entry in
+    // `StreamScheduler::active_streams_` apart from stale ones.
+    uint64_t activation_ = 0;
+    // The number of entries, stale or not, in `active_streams_` that refer to
+    // this stream.
+    int active_stream_entries_ = 0;
   };
 
   // The `mtu` parameter represents the maximum SCTP packet size, which should
@@ -187,18 +196,41 @@ class StreamScheduler {
   std::set<StreamID> ActiveStreamsForTesting() const;
 
  private:
+  // An entry in `active_streams_`. Streams aren't removed from the heap when
+  // they are made inactive, but their entries become stale, as the stream's
+  // `activation_` no longer matches.
+  struct ActiveStream {
+    VirtualTime next_finish_time;
+    StreamID stream_id;
+    uint64_t activation;
+    Stream* stream;
+
+    bool is_stale() const {
+      return !stream->is_active() || stream->activation_ != activation;
+    }
+  };
+
   struct ActiveStreamComparator {
-    // Ordered by virtual finish time (primary), stream-id (secondary).
-    bool operator()(Stream* a, Stream* b) const {
-      VirtualTime a_vft = a->next_finish_time();
-      VirtualTime b_vft = b->next_finish_time();
-      if (a_vft == b_vft) {
-        return a->stream_id() < b->stream_id();
+    // Ordered by virtual finish time (primary), stream-id (secondary), with the
+    // greatest first, so that the heap's top is the next stream to send from.
+    bool operator()(const ActiveStream& a, const ActiveStream& b) const {
+      if (a.next_finish_time == b.next_finish_time) {
+        return a.stream_id > b.stream_id;
       }
-      return a_vft < b_vft;
+      return a.next_finish_time > b.next_finish_time;
     }
   };
 
+  // Removes and returns the active stream with the earliest virtual finish
+  // time. Must only be called when there are active streams.
+  Stream* PopNextActiveStream();
+
+  void AddActiveStream(Stream* stream);
+
+  // Removes all entries in `active_streams_` for which `pred` returns true.
+  template <typename Predicate>
+  void RemoveActiveStreamsIf(Predicate pred);
+
   bool IsConsistent() const;
 
   const absl::string_view log_prefix_;
@@ -217,8 +249,11 @@ class StreamScheduler {
   // stream until that message has been sent in full.
   bool currently_sending_a_message_ = false;
 
-  // The currently active streams, ordered by virtual finish time.
-  webrtc::flat_set<Stream*, ActiveStreamComparator> active_streams_;
+  // The currently active streams, as a binary heap ordered by virtual finish
+  // time, so that streams can be scheduled in O(log n) even when there are
+  // thousands of them. It may also contain stale entries, which are skipped.
+  std::vector<ActiveStream> active_streams_;
+  int num_active_streams_ = 0;
 };
 
 }  // namespace dcsctp
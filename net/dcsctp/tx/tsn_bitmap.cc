@@ -0,0 +1,124 @@
+/*
+ *  Copyright (c) 2026 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+#include "net/dcsctp/tx/tsn_bitmap.h"
+
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+#include "absl/numeric/bits.h"
+#include "net/dcsctp/common/sequence_numbers.h"
+#include "rtc_base/checks.h"
+
+namespace dcsctp {
+
+bool TsnBitmap::contains(UnwrappedTSN tsn) const {
+  if (tsn < begin_ || *tsn - *begin_ >= capacity()) {
+    return false;
+  }
+  return (word(*tsn) >> (*tsn % 64)) & 1;
+}
+
+void TsnBitmap::insert(UnwrappedTSN tsn) {
+  RTC_DCHECK(tsn >= begin_);
+  if (*tsn - *begin_ >= capacity()) {
+    // Grow the ring to cover `tsn`, and move the members to their new place.
+    size_t num_words = std::max<size_t>(words_.size(), 1);
+    while (*tsn - *begin_ >= static_cast<int64_t>(num_words) * 64) {
+      num_words *= 2;
+    }
+    TsnBitmap grown(begin_);
+    grown.words_.resize(num_words);
+    const UnwrappedTSN end = UnwrappedTSN::AddTo(begin_, capacity());
+    for (UnwrappedTSN member = Find(begin_, end, true); member < end;
+         member = Find(member.next_value(), end, true)) {
+      grown.word(*member) |= uint64_t{1} << (*member % 64);
+    }
+    words_ = std::move(grown.words_);
+  }
+  uint64_t& bits = word(*tsn);
+  const uint64_t mask = uint64_t{1} << (*tsn % 64);
+  if ((bits & mask) == 0) {
+    bits |= mask;
+    ++size_;
+  }
+}
+
+void TsnBitmap::erase(UnwrappedTSN tsn) {
+  if (!contains(tsn)) {
+    return;
+  }
+  word(*tsn) &= ~(uint64_t{1} << (*tsn % 64));
+  --size_;
+}
+
+void TsnBitmap::merge(TsnBitmap& other) {
+  const UnwrappedTSN end = UnwrappedTSN::AddTo(other.begin_, other.capacity());
+  for (UnwrappedTSN tsn = other.Find(other.begin_, end, true); tsn < end;
+       tsn = other.Find(tsn.next_value(), end, true)) {
+    insert(tsn);
+  }
+  other.Reset(other.begin_);
+}
+
+void TsnBitmap::Reset(UnwrappedTSN begin) {
+  std::fill(words_.begin(), words_.end(), 0);
+  size_ = 0;
+  begin_ = begin;
+}
+
+void TsnBitmap::AdvanceTo(UnwrappedTSN begin) {
+  if (begin <= begin_) {
+    return;
+  }
+  if (*begin - *begin_ >= capacity()) {
+    Reset(begin);
+    return;
+  }
+  for (int64_t tsn = *begin_; tsn < *begin;) {
+    const int offset = tsn % 64;
+    const int count = std::min<int64_t>(64 - offset, *begin - tsn);
+    const uint64_t mask = (count == 64 ? ~uint64_t{0}
+                                       : ((uint64_t{1} << count) - 1))
+                          << offset;
+    uint64_t& bits = word(tsn);
+    size_ -= absl::popcount(bits & mask);
+    bits &= ~mask;
+    tsn += count;
+  }
+  begin_ = begin;
+}
+
+UnwrappedTSN TsnBitmap::Find(UnwrappedTSN from,
+                             UnwrappedTSN end,
+                             bool member) const {
+  RTC_DCHECK(from >= begin_);
+  if (from >= end) {
+    return end;
+  }
+  // TSNs at or above `limit` are outside the ring, and are not members.
+  const int64_t limit = std::min(*end, *begin_ + capacity());
+  int64_t found = std::max(*from, limit);
+  for (int64_t tsn = *from; tsn < limit;) {
+    const int offset = tsn % 64;
+    const uint64_t bits = (member ? word(tsn) : ~word(tsn)) >> offset;
+    if (bits != 0) {
+      found = std::min(tsn + absl::countr_zero(bits), limit);
+      break;
+    }
+    tsn += 64 - offset;
+  }
+  if (found < limit || (!member && found < *end)) {
+    return UnwrappedTSN::AddTo(from, found - *from);
+  }
+  return end;
+}
+
+}  // namespace dcsctp
@@ -0,0 +1,70 @@
+/*
+ *  Copyright (c) 2026 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+#ifndef NET_DCSCTP_TX_TSN_BITMAP_H_
+#define NET_DCSCTP_TX_TSN_BITMAP_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <vector>
+
+#include "net/dcsctp/common/sequence_numbers.h"
+
+namespace dcsctp {
+
+// A set of TSNs, stored as one bit per TSN in a ring buffer that is indexed by
+// the TSN, so that it can follow a sliding window of TSNs, such as the
+// outstanding data. Finding the members in a range of TSNs is done by scanning
+// 64 TSNs at a time.
+class TsnBitmap {
+ public:
+  // Creates an empty set where `begin` is the lowest TSN that can be added.
+  explicit TsnBitmap(UnwrappedTSN begin) : begin_(begin) {}
+
+  bool empty() const { return size_ == 0; }
+  size_t size() const { return size_; }
+
+  bool contains(UnwrappedTSN tsn) const;
+  void insert(UnwrappedTSN tsn);
+  void erase(UnwrappedTSN tsn);
+
+  // Moves all TSNs from `other` to this set.
+  void merge(TsnBitmap& other);
+
+  // Removes all TSNs and sets the lowest TSN that can be added to `begin`.
+  void Reset(UnwrappedTSN begin);
+
+  // Removes all TSNs below `begin`, which becomes the lowest TSN that can be
+  // added.
+  void AdvanceTo(UnwrappedTSN begin);
+
+  // Returns the lowest TSN in [`from`, `end`) that is a member of the set if
+  // `member` is true, or that isn't if `member` is false. Returns `end` if
+  // there is no such TSN.
+  UnwrappedTSN Find(UnwrappedTSN from, UnwrappedTSN end, bool member) const;
+
+ private:
+  int64_t capacity() const { return static_cast<int64_t>(words_.size()) * 64; }
+  uint64_t& word(int64_t tsn) {
+    return words_[(tsn & (capacity() - 1)) / 64];
+  }
+  uint64_t word(int64_t tsn) const {
+    return words_[(tsn & (capacity() - 1)) / 64];
+  }
+
+  UnwrappedTSN begin_;
+  size_t size_ = 0;
+  // The ring buffer, with a power-of-two number of words. It covers the TSNs
+  // [`begin_`, `begin_` + `capacity()`).
+  std::vector<uint64_t> words_;
+};
+
+}  // namespace dcsctp
+#endif  // NET_DCSCTP_TX_TSN_BITMAP_H_
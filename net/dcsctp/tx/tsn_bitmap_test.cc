@@ -0,0 +1,270 @@
+/*
+ *  Copyright (c) 2026 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+#include "net/dcsctp/tx/tsn_bitmap.h"
+
+#include <algorithm>
+#include <vector>
+
+#include "net/dcsctp/common/internal_types.h"
+#include "net/dcsctp/common/sequence_numbers.h"
+#include "rtc_base/gunit.h"
+#include "test/gmock.h"
+
+namespace dcsctp {
+namespace {
+using ::testing::ElementsAre;
+using ::testing::IsEmpty;
+
+// Not a multiple of 64, so that the ring doesn't start at a word boundary.
+constexpr int kBase = 1000;
+
+UnwrappedTSN Tsn(int value) {
+  UnwrappedTSN::Unwrapper unwrapper;
+  return UnwrappedTSN::AddTo(unwrapper.Unwrap(TSN(kBase)), value - kBase);
+}
+
+std::vector<int> Members(const TsnBitmap& bitmap, int from, int end) {
+  std::vector<int> members;
+  for (UnwrappedTSN tsn = bitmap.Find(Tsn(from), Tsn(end), true);
+       tsn < Tsn(end); tsn = bitmap.Find(tsn.next_value(), Tsn(end), true)) {
+    members.push_back(kBase + (*tsn - *Tsn(kBase)));
+  }
+  return members;
+}
+
+TEST(TsnBitmapTest, IsEmptyWhenCreated) {
+  TsnBitmap bitmap(Tsn(kBase));
+  EXPECT_TRUE(bitmap.empty());
+  EXPECT_EQ(bitmap.size(), 0u);
+  EXPECT_FALSE(bitmap.contains(Tsn(kBase)));
+  EXPECT_THAT(Members(bitmap, kBase, kBase + 1000), IsEmpty());
+}
+
+TEST(TsnBitmapTest, InsertsAndErases) {
+  TsnBitmap bitmap(Tsn(kBase));
+  bitmap.insert(Tsn(kBase + 3));
+  bitmap.insert(Tsn(kBase + 3));
+  bitmap.insert(Tsn(kBase + 10));
+  EXPECT_EQ(bitmap.size(), 2u);
+  EXPECT_TRUE(bitmap.contains(Tsn(kBase + 3)));
+  EXPECT_TRUE(bitmap.contains(Tsn(kBase + 10)));
+  EXPECT_FALSE(bitmap.contains(Tsn(kBase + 4)));
+
+  bitmap.erase(Tsn(kBase + 3));
+  bitmap.erase(Tsn(kBase + 3));
+  bitmap.erase(Tsn(kBase + 5000));
+  EXPECT_EQ(bitmap.size(), 1u);
+  EXPECT_FALSE(bitmap.contains(Tsn(kBase + 3)));
+  EXPECT_TRUE(bitmap.contains(Tsn(kBase + 10)));
+}
+
+TEST(TsnBitmapTest, DoesNotContainTsnsOutsideOfTheRing) {
+  TsnBitmap bitmap(Tsn(kBase));
+  bitmap.insert(Tsn(kBase));
+  EXPECT_FALSE(bitmap.contains(Tsn(kBase - 1)));
+  EXPECT_FALSE(bitmap.contains(Tsn(kBase + 64)));
+  EXPECT_FALSE(bitmap.contains(Tsn(kBase + 100000)));
+}
+
+TEST(TsnBitmapTest, FindsMembersAcrossWords) {
+  TsnBitmap bitmap(Tsn(kBase));
+  bitmap.insert(Tsn(kBase + 3));
+  bitmap.insert(Tsn(kBase + 70));
+  bitmap.insert(Tsn(kBase + 200));
+
+  EXPECT_EQ(bitmap.Find(Tsn(kBase), Tsn(kBase + 300), true), Tsn(kBase + 3));
+  EXPECT_EQ(bitmap.Find(Tsn(kBase + 3), Tsn(kBase + 300), true),
+            Tsn(kBase + 3));
+  EXPECT_EQ(bitmap.Find(Tsn(kBase + 4), Tsn(kBase + 300), true),
+            Tsn(kBase + 70));
+  EXPECT_EQ(bitmap.Find(Tsn(kBase + 71), Tsn(kBase + 300), true),
+            Tsn(kBase + 200));
+  EXPECT_EQ(bitmap.Find(Tsn(kBase + 201), Tsn(kBase + 300), true),
+            Tsn(kBase + 300));
+  EXPECT_THAT(Members(bitmap, kBase, kBase + 300),
+              ElementsAre(kBase + 3, kBase + 70, kBase + 200));
+}
+
+TEST(TsnBitmapTest, FindStopsAtEnd) {
+  TsnBitmap bitmap(Tsn(kBase));
+  bitmap.insert(Tsn(kBase + 70));
+
+  EXPECT_EQ(bitmap.Find(Tsn(kBase), Tsn(kBase + 70), true), Tsn(kBase + 70));
+  EXPECT_EQ(bitmap.Find(Tsn(kBase), Tsn(kBase + 20), true), Tsn(kBase + 20));
+  EXPECT_EQ(bitmap.Find(Tsn(kBase + 20), Tsn(kBase + 20), true),
+            Tsn(kBase + 20));
+  EXPECT_EQ(bitmap.Find(Tsn(kBase + 70), Tsn(kBase + 71), true),
+            Tsn(kBase + 70));
+}
+
+TEST(TsnBitmapTest, FindsNonMembers) {
+  TsnBitmap bitmap(Tsn(kBase));
+  for (int tsn = kBase; tsn <= kBase + 130; ++tsn) {
+    bitmap.insert(Tsn(tsn));
+  }
+  bitmap.erase(Tsn(kBase + 64));
+
+  EXPECT_EQ(bitmap.Find(Tsn(kBase), Tsn(kBase + 300), false),
+            Tsn(kBase + 64));
+  EXPECT_EQ(bitmap.Find(Tsn(kBase + 65), Tsn(kBase + 300), false),
+            Tsn(kBase + 131));
+  EXPECT_EQ(bitmap.Find(Tsn(kBase + 65), Tsn(kBase + 100), false),
+            Tsn(kBase + 100));
+}
+
+TEST(TsnBitmapTest, FindsNonMembersBeyondTheRing) {
+  TsnBitmap empty(Tsn(kBase));
+  EXPECT_EQ(empty.Find(Tsn(kBase + 5), Tsn(kBase + 10), false),
+            Tsn(kBase + 5));
+  EXPECT_EQ(empty.Find(Tsn(kBase + 5), Tsn(kBase + 10), true),
+            Tsn(kBase + 10));
+
+  TsnBitmap full(Tsn(kBase));
+  for (int tsn = kBase; tsn < kBase + 64; ++tsn) {
+    full.insert(Tsn(tsn));
+  }
+  EXPECT_EQ(full.Find(Tsn(kBase), Tsn(kBase + 1000), false), Tsn(kBase + 64));
+  EXPECT_EQ(full.Find(Tsn(kBase + 500), Tsn(kBase + 1000), false),
+            Tsn(kBase + 500));
+}
+
+TEST(TsnBitmapTest, AdvanceToRemovesLowerMembers) {
+  TsnBitmap bitmap(Tsn(kBase));
+  bitmap.insert(Tsn(kBase + 1));
+  bitmap.insert(Tsn(kBase + 63));
+  bitmap.insert(Tsn(kBase + 64));
+  bitmap.insert(Tsn(kBase + 65));
+  bitmap.insert(Tsn(kBase + 120));
+
+  bitmap.AdvanceTo(Tsn(kBase + 65));
+  EXPECT_EQ(bitmap.size(), 2u);
+  EXPECT_FALSE(bitmap.contains(Tsn(kBase + 1)));
+  EXPECT_FALSE(bitmap.contains(Tsn(kBase + 63)));
+  EXPECT_FALSE(bitmap.contains(Tsn(kBase + 64)));
+  EXPECT_THAT(Members(bitmap, kBase + 65, kBase + 1000),
+              ElementsAre(kBase + 65, kBase + 120));
+
+  // Advancing backwards does nothing.
+  bitmap.AdvanceTo(Tsn(kBase));
+  EXPECT_EQ(bitmap.size(), 2u);
+  EXPECT_TRUE(bitmap.contains(Tsn(kBase + 65)));
+}
+
+TEST(TsnBitmapTest, AdvanceToPastTheRingRemovesAllMembers) {
+  TsnBitmap bitmap(Tsn(kBase));
+  bitmap.insert(Tsn(kBase + 1));
+  bitmap.insert(Tsn(kBase + 60));
+
+  bitmap.AdvanceTo(Tsn(kBase + 1000));
+  EXPECT_TRUE(bitmap.empty());
+  EXPECT_FALSE(bitmap.contains(Tsn(kBase + 60)));
+  EXPECT_THAT(Members(bitmap, kBase + 1000, kBase + 2000), IsEmpty());
+
+  bitmap.insert(Tsn(kBase + 1001));
+  EXPECT_THAT(Members(bitmap, kBase + 1000, kBase + 2000),
+              ElementsAre(kBase + 1001));
+}
+
+TEST(TsnBitmapTest, WrapsAroundInTheRing) {
+  // Slides a window of 100 TSNs over many times the ring's capacity, so that
+  // members and searches keep wrapping around the end of the ring.
+  constexpr int kWindow = 100;
+  TsnBitmap bitmap(Tsn(kBase));
+  for (int tsn = kBase; tsn < kBase + 2000; ++tsn) {
+    bitmap.AdvanceTo(Tsn(std::max(kBase, tsn - kWindow + 1)));
+    if (tsn % 3 != 0) {
+      bitmap.insert(Tsn(tsn));
+    }
+
+    const int begin = std::max(kBase, tsn - kWindow + 1);
+    std::vector<int> expected;
+    for (int i = begin; i <= tsn; ++i) {
+      if (i % 3 != 0) {
+        expected.push_back(i);
+      }
+    }
+    ASSERT_EQ(bitmap.size(), expected.size()) << tsn;
+    ASSERT_EQ(Members(bitmap, begin, tsn + 1), expected) << tsn;
+    ASSERT_EQ(bitmap.Find(Tsn(begin), Tsn(tsn + 1), false),
+              Tsn(std::min(begin + (3 - begin % 3) % 3, tsn + 1)))
+        << tsn;
+  }
+}
+
+TEST(TsnBitmapTest, GrowsPastInitialCapacity) {
+  TsnBitmap bitmap(Tsn(kBase));
+  bitmap.insert(Tsn(kBase));
+  bitmap.insert(Tsn(kBase + 63));
+  bitmap.insert(Tsn(kBase + 1000));
+  bitmap.insert(Tsn(kBase + 5000));
+
+  EXPECT_EQ(bitmap.size(), 4u);
+  EXPECT_THAT(Members(bitmap, kBase, kBase + 10000),
+              ElementsAre(kBase, kBase + 63, kBase + 1000, kBase + 5000));
+  EXPECT_EQ(bitmap.Find(Tsn(kBase + 1), Tsn(kBase + 10000), false),
+            Tsn(kBase + 1));
+}
+
+TEST(TsnBitmapTest, GrowsWhileWrappedAround) {
+  TsnBitmap bitmap(Tsn(kBase));
+  for (int tsn = kBase; tsn < kBase + 100; ++tsn) {
+    bitmap.insert(Tsn(tsn));
+  }
+  // The ring now covers 128 TSNs, and its start is in the middle of it.
+  bitmap.AdvanceTo(Tsn(kBase + 90));
+  bitmap.insert(Tsn(kBase + 200));
+  // Grows the ring, which has to move the members that have wrapped around.
+  bitmap.insert(Tsn(kBase + 600));
+
+  EXPECT_EQ(bitmap.size(), 12u);
+  EXPECT_THAT(
+      Members(bitmap, kBase + 90, kBase + 1000),
+      ElementsAre(kBase + 90, kBase + 91, kBase + 92, kBase + 93, kBase + 94,
+                  kBase + 95, kBase + 96, kBase + 97, kBase + 98, kBase + 99,
+                  kBase + 200, kBase + 600));
+}
+
+TEST(TsnBitmapTest, MergeMovesAllMembers) {
+  TsnBitmap bitmap(Tsn(kBase));
+  bitmap.insert(Tsn(kBase + 1));
+  bitmap.insert(Tsn(kBase + 5));
+
+  TsnBitmap other(Tsn(kBase));
+  other.insert(Tsn(kBase + 5));
+  other.insert(Tsn(kBase + 70));
+  other.insert(Tsn(kBase + 700));
+
+  bitmap.merge(other);
+  EXPECT_EQ(bitmap.size(), 4u);
+  EXPECT_THAT(Members(bitmap, kBase, kBase + 1000),
+              ElementsAre(kBase + 1, kBase + 5, kBase + 70, kBase + 700));
+  EXPECT_TRUE(other.empty());
+  EXPECT_THAT(Members(other, kBase, kBase + 1000), IsEmpty());
+}
+
+TEST(TsnBitmapTest, MergeFromWrappedAroundBitmap) {
+  TsnBitmap bitmap(Tsn(kBase + 50));
+
+  TsnBitmap other(Tsn(kBase));
+  for (int tsn = kBase; tsn < kBase + 64; ++tsn) {
+    other.insert(Tsn(tsn));
+  }
+  other.AdvanceTo(Tsn(kBase + 60));
+  other.insert(Tsn(kBase + 110));
+
+  bitmap.merge(other);
+  EXPECT_THAT(Members(bitmap, kBase + 50, kBase + 1000),
+              ElementsAre(kBase + 60, kBase + 61, kBase + 62, kBase + 63,
+                          kBase + 110));
+  EXPECT_TRUE(other.empty());
+}
+
+}  // namespace
+}  // namespace dcsctp
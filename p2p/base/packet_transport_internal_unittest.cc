@@ -10,7 +10,11 @@
 
 #include "p2p/base/packet_transport_internal.h"
 
+#include <string>
+#include <vector>
+
 #include "p2p/base/fake_packet_transport.h"
+#include "rtc_base/copy_on_write_buffer.h"
 #include "rtc_base/gunit.h"
 #include "rtc_base/network/received_packet.h"
 #include "rtc_base/third_party/sigslot/sigslot.h"
@@ -41,6 +45,40 @@ TEST(PacketTransportInternal,
   packet_transport.DeregisterReceivedPacketCallback(&receiver);
 }
 
+TEST(PacketTransportInternal, ReceiversReadPayloadTakenByAnotherReceiver) {
+  rtc::FakePacketTransport packet_transport("test");
+  // Takes the payload and modifies it in place, as SrtpTransport does.
+  rtc::CopyOnWriteBuffer taken;
+  packet_transport.RegisterReceivedPacketCallback(
+      &taken,
+      [&](rtc::PacketTransportInternal*, const rtc::ReceivedPacket& packet) {
+        taken = rtc::ReceivedPacket(packet).TakePayload();
+        taken.MutableData()[0] = 'x';
+      });
+  std::vector<std::string> read;
+  auto read_payload = [&](rtc::PacketTransportInternal*,
+                          const rtc::ReceivedPacket& packet) {
+    read.emplace_back(reinterpret_cast<const char*>(packet.payload().data()),
+                      packet.payload().size());
+  };
+  int receiver1;
+  int receiver2;
+  packet_transport.RegisterReceivedPacketCallback(&receiver1, read_payload);
+  packet_transport.RegisterReceivedPacketCallback(&receiver2, read_payload);
+
+  rtc::SocketAddress address;
+  packet_transport.NotifyPacketReceived(
+      rtc::ReceivedPacket::CreateFromBuffer(rtc::CopyOnWriteBuffer("abc", 3),
+                                            address));
+
+  EXPECT_THAT(read, ::testing::ElementsAre("abc", "abc"));
+  EXPECT_EQ(taken, rtc::CopyOnWriteBuffer("xbc", 3));
+
+  packet_transport.DeregisterReceivedPacketCallback(&taken);
+  packet_transport.DeregisterReceivedPacketCallback(&receiver1);
+  packet_transport.DeregisterReceivedPacketCallback(&receiver2);
+}
+
 TEST(PacketTransportInternal, NotifiesOnceOnClose) {
   rtc::FakePacketTransport packet_transport("test");
   int call_count = 0;
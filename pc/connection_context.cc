@@ -109,6 +109,7 @@ ConnectionContext::ConnectionContext(
       default_network_manager_(std::move(dependencies->network_manager)),
       call_factory_(std::move(dependencies->media_factory)),
       default_socket_factory_(std::move(dependencies->packet_socket_factory)),
+      uses_default_sctp_factory_(dependencies->sctp_factory == nullptr),
       sctp_factory_(
           MaybeCreateSctpFactory(std::move(dependencies->sctp_factory),
                                  network_thread())),
@@ -61,6 +61,11 @@ class ConnectionContext final : public RefCountedNonVirtual<ConnectionContext> {
   SctpTransportFactoryInterface* sctp_transport_factory() const {
     return sctp_factory_.get();
   }
+  // True when `sctp_transport_factory()` was created here rather than
+  // injected through the PeerConnectionFactoryDependencies.
+  bool uses_default_sctp_transport_factory() const {
+    return uses_default_sctp_factory_;
+  }
 
   cricket::MediaEngineInterface* media_engine() const {
     return media_engine_.get();
@@ -139,6 +144,7 @@ class ConnectionContext final : public RefCountedNonVirtual<ConnectionContext> {
 
   std::unique_ptr<rtc::PacketSocketFactory> default_socket_factory_
       RTC_GUARDED_BY(signaling_thread_);
+  const bool uses_default_sctp_factory_;
   std::unique_ptr<SctpTransportFactoryInterface> const sctp_factory_;
 
   // Controls whether to announce support for the the rfc4588 payload format
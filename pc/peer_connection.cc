@@ -37,6 +37,7 @@
 #include "media/base/media_engine.h"
 #include "media/base/rid_description.h"
 #include "media/base/stream_params.h"
+#include "media/sctp/sctp_transport_factory.h"
 #include "modules/rtp_rtcp/include/rtp_rtcp_defines.h"
 #include "p2p/base/basic_async_resolver_factory.h"
 #include "p2p/base/connection.h"
@@ -583,6 +584,9 @@ PeerConnection::PeerConnection(
     bool dtls_enabled)
     : env_(env),
       context_(context),
+      network_thread_(dependencies.network_thread
+                          ? dependencies.network_thread
+                          : context_->network_thread()),
       options_(options),
       observer_(dependencies.observer),
       is_unified_plan_(is_unified_plan),
@@ -763,6 +767,16 @@ JsepTransportController* PeerConnection::InitializeTransportController_n(
   // DTLS has to be enabled to use SCTP.
   if (dtls_enabled_) {
     config.sctp_factory = context_->sctp_transport_factory();
+    if (network_thread() != context_->network_thread() &&
+        context_->uses_default_sctp_transport_factory()) {
+      // The default SCTP factory is bound to the factory's network thread.
+      // An injected one is used as is.
+#ifdef WEBRTC_HAVE_SCTP
+      sctp_factory_ =
+          std::make_unique<cricket::SctpTransportFactory>(network_thread());
+#endif
+      config.sctp_factory = sctp_factory_.get();
+    }
   }
 
   config.ice_transport_factory = ice_transport_factory_.get();
@@ -45,6 +45,7 @@
 #include "api/sequence_checker.h"
 #include "api/set_local_description_observer_interface.h"
 #include "api/set_remote_description_observer_interface.h"
+#include "api/transport/sctp_transport_factory_interface.h"
 #include "api/stats/rtc_stats_collector_callback.h"
 #include "api/task_queue/pending_task_safety_flag.h"
 #include "api/transport/bitrate_settings.h"
@@ -262,9 +263,7 @@ class PeerConnection : public PeerConnectionInternal,
     return context_->signaling_thread();
   }
 
-  rtc::Thread* network_thread() const final {
-    return context_->network_thread();
-  }
+  rtc::Thread* network_thread() const final { return network_thread_; }
   rtc::Thread* worker_thread() const final { return context_->worker_thread(); }
 
   std::string session_id() const override { return session_id_; }
@@ -609,6 +608,9 @@ class PeerConnection : public PeerConnectionInternal,
 
   const Environment env_;
   const rtc::scoped_refptr<ConnectionContext> context_;
+  // Either the network thread of `context_` or the one set in
+  // PeerConnectionDependencies.
+  rtc::Thread* const network_thread_;
   const PeerConnectionFactoryInterface::Options options_;
   PeerConnectionObserver* observer_ RTC_GUARDED_BY(signaling_thread()) =
       nullptr;
@@ -629,6 +631,9 @@ class PeerConnection : public PeerConnectionInternal,
 
   const std::unique_ptr<AsyncDnsResolverFactoryInterface>
       async_dns_resolver_factory_;
+  // Only set when the PeerConnection doesn't use the network thread of
+  // `context_`, in which case the SCTP transports of `context_` can't be used.
+  std::unique_ptr<SctpTransportFactoryInterface> sctp_factory_;
   std::unique_ptr<cricket::PortAllocator>
       port_allocator_;  // TODO(bugs.webrtc.org/9987): Accessed on both
                         // signaling and network thread.
@@ -99,6 +99,17 @@ class PeerConnectionEndToEndBaseTest : public sigslot::has_slots<>,
 #endif
   }
 
+  // Makes the caller's PeerConnection run on a network thread of its own,
+  // separate from the one of its factory. Must be called before CreatePcs.
+  void UseOwnNetworkThreadForCaller() {
+    caller_network_thread_ =
+        std::make_unique<rtc::Thread>(&caller_network_pss_);
+    RTC_CHECK(caller_network_thread_->Start());
+    caller_ = rtc::make_ref_counted<PeerConnectionTestWrapper>(
+        "caller", &caller_network_pss_, network_thread_.get(),
+        worker_thread_.get(), caller_network_thread_.get());
+  }
+
   void CreatePcs(
       rtc::scoped_refptr<webrtc::AudioEncoderFactory> audio_encoder_factory1,
       rtc::scoped_refptr<webrtc::AudioDecoderFactory> audio_decoder_factory1,
@@ -223,6 +234,8 @@ class PeerConnectionEndToEndBaseTest : public sigslot::has_slots<>,
   rtc::PhysicalSocketServer pss_;
   std::unique_ptr<rtc::Thread> network_thread_;
   std::unique_ptr<rtc::Thread> worker_thread_;
+  rtc::PhysicalSocketServer caller_network_pss_;
+  std::unique_ptr<rtc::Thread> caller_network_thread_;
   rtc::scoped_refptr<PeerConnectionTestWrapper> caller_;
   rtc::scoped_refptr<PeerConnectionTestWrapper> callee_;
   DataChannelList caller_signaled_data_channels_;
@@ -519,6 +532,26 @@ TEST_P(PeerConnectionEndToEndTest, CreateDataChannelBeforeNegotiate) {
   CloseDataChannels(callee_dc.get(), caller_signaled_data_channels_, 0);
 }
 
+// Verifies that a PeerConnection running on a network thread other than the
+// one of its factory can connect and transfer data.
+TEST_P(PeerConnectionEndToEndTest, DataChannelOnOwnNetworkThread) {
+  UseOwnNetworkThreadForCaller();
+  CreatePcs(webrtc::MockAudioEncoderFactory::CreateEmptyFactory(),
+            webrtc::MockAudioDecoderFactory::CreateEmptyFactory());
+
+  webrtc::DataChannelInit init;
+  rtc::scoped_refptr<DataChannelInterface> caller_dc(
+      caller_->CreateDataChannel("data", init));
+
+  Negotiate();
+  WaitForConnection();
+
+  WaitForDataChannelsToOpen(caller_dc.get(), callee_signaled_data_channels_, 0);
+  TestDataChannelSendAndReceive(caller_dc.get(),
+                                callee_signaled_data_channels_[0].get());
+  CloseDataChannels(caller_dc.get(), callee_signaled_data_channels_, 0);
+}
+
 // Verifies that a DataChannel created after the negotiation can transition to
 // "OPEN" and transfer data.
 TEST_P(PeerConnectionEndToEndTest, CreateDataChannelAfterNegotiate) {
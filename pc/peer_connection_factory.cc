@@ -53,6 +53,20 @@
 
 namespace webrtc {
 
+namespace {
+
+// Lets `thread` make blocking calls to `target`. Must be called on `thread`.
+// Every PeerConnection on a custom network thread passes through here, so
+// the thread is only added to the allow list the first time it is seen.
+void AllowInvokesToThreadOnce(rtc::Thread* thread, rtc::Thread* target) {
+  RTC_DCHECK_RUN_ON(thread);
+  if (!thread->IsInvokeToThreadAllowed(target)) {
+    thread->AllowInvokesToThread(target);
+  }
+}
+
+}  // namespace
+
 rtc::scoped_refptr<PeerConnectionFactoryInterface>
 CreateModularPeerConnectionFactory(
     PeerConnectionFactoryDependencies dependencies) {
@@ -230,11 +244,24 @@ PeerConnectionFactory::CreatePeerConnectionOrError(
 
   const Environment env = env_factory.Create();
 
+  rtc::Thread* pc_network_thread = network_thread();
+  if (dependencies.network_thread &&
+      dependencies.network_thread != network_thread()) {
+    // The default port allocator uses the network manager and socket factory
+    // of the factory's network thread, which can't be used from another one.
+    if (!dependencies.allocator) {
+      return RTCError(RTCErrorType::INVALID_PARAMETER,
+                      "A custom network thread requires a port allocator.");
+    }
+    pc_network_thread = dependencies.network_thread;
+    AllowInvokesToThreadOnce(signaling_thread(), pc_network_thread);
+  }
+
   // Set internal defaults if optional dependencies are not set.
   if (!dependencies.cert_generator) {
     dependencies.cert_generator =
         std::make_unique<rtc::RTCCertificateGenerator>(signaling_thread(),
-                                                       network_thread());
+                                                       pc_network_thread);
   }
   if (!dependencies.allocator) {
     dependencies.allocator = std::make_unique<cricket::BasicPortAllocator>(
@@ -257,9 +284,11 @@ PeerConnectionFactory::CreatePeerConnectionOrError(
   dependencies.allocator->SetVpnList(configuration.vpn_list);
 
   std::unique_ptr<Call> call =
-      worker_thread()->BlockingCall([this, &env, &configuration] {
-        return CreateCall_w(env, configuration);
-      });
+      worker_thread()->BlockingCall(
+          [this, &env, &configuration, pc_network_thread] {
+            AllowInvokesToThreadOnce(worker_thread(), pc_network_thread);
+            return CreateCall_w(env, configuration, pc_network_thread);
+          });
 
   auto result = PeerConnection::Create(env, context_, options_, std::move(call),
                                        configuration, std::move(dependencies));
@@ -273,7 +302,7 @@ PeerConnectionFactory::CreatePeerConnectionOrError(
   // worker_thread()).  All such methods have thread checks though, so the code
   // should still be clear (outside of macro expansion).
   rtc::scoped_refptr<PeerConnectionInterface> result_proxy =
-      PeerConnectionProxy::Create(signaling_thread(), network_thread(),
+      PeerConnectionProxy::Create(signaling_thread(), pc_network_thread,
                                   result.MoveValue());
   return result_proxy;
 }
@@ -305,10 +334,11 @@ rtc::scoped_refptr<AudioTrackInterface> PeerConnectionFactory::CreateAudioTrack(
 
 std::unique_ptr<Call> PeerConnectionFactory::CreateCall_w(
     const Environment& env,
-    const PeerConnectionInterface::RTCConfiguration& configuration) {
+    const PeerConnectionInterface::RTCConfiguration& configuration,
+    rtc::Thread* network_thread) {
   RTC_DCHECK_RUN_ON(worker_thread());
 
-  CallConfig call_config(env, network_thread());
+  CallConfig call_config(env, network_thread);
   if (!media_engine() || !context_->call_factory()) {
     return nullptr;
   }
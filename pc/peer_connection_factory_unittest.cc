@@ -50,6 +50,7 @@
 #include "rtc_base/internal/default_socket_server.h"
 #include "rtc_base/rtc_certificate_generator.h"
 #include "rtc_base/socket_address.h"
+#include "rtc_base/thread.h"
 #include "rtc_base/time_utils.h"
 #include "test/gmock.h"
 #include "test/gtest.h"
@@ -629,6 +630,24 @@ TEST_F(PeerConnectionFactoryTest, CreatePCUsingIPLiteralAddress) {
   VerifyTurnServers(turn_servers);
 }
 
+// A PeerConnection on its own network thread can't use the default port
+// allocator, which belongs to the factory's network thread.
+TEST_F(PeerConnectionFactoryTest, CreatePCOnNetworkThreadRequiresAllocator) {
+  std::unique_ptr<rtc::Thread> network_thread =
+      rtc::Thread::CreateWithSocketServer();
+  network_thread->Start();
+  PeerConnectionInterface::RTCConfiguration config;
+  config.sdp_semantics = SdpSemantics::kUnifiedPlan;
+  PeerConnectionDependencies pc_dependencies(&observer_);
+  pc_dependencies.cert_generator =
+      std::make_unique<FakeRTCCertificateGenerator>();
+  pc_dependencies.network_thread = network_thread.get();
+  auto result =
+      factory_->CreatePeerConnectionOrError(config, std::move(pc_dependencies));
+  ASSERT_FALSE(result.ok());
+  EXPECT_EQ(RTCErrorType::INVALID_PARAMETER, result.error().type());
+}
+
 // This test verifies the captured stream is rendered locally using a
 // local video track.
 TEST_F(PeerConnectionFactoryTest, LocalRendering) {
@@ -220,6 +220,7 @@ RtpTransceiver::~RtpTransceiver() {
 
 RTCError RtpTransceiver::CreateChannel(
     absl::string_view mid,
+    rtc::Thread* network_thread,
     Call* call_ptr,
     const cricket::MediaConfig& media_config,
     bool srtp_required,
@@ -273,7 +274,7 @@ RTCError RtpTransceiver::CreateChannel(
           });
 
       new_channel = std::make_unique<cricket::VoiceChannel>(
-          context()->worker_thread(), context()->network_thread(),
+          context()->worker_thread(), network_thread,
           context()->signaling_thread(), std::move(media_send_channel),
           std::move(media_receive_channel), mid, srtp_required, crypto_options,
           context()->ssrc_generator());
@@ -310,7 +311,7 @@ RTCError RtpTransceiver::CreateChannel(
           });
 
       new_channel = std::make_unique<cricket::VideoChannel>(
-          context()->worker_thread(), context()->network_thread(),
+          context()->worker_thread(), network_thread,
           context()->signaling_thread(), std::move(media_send_channel),
           std::move(media_receive_channel), mid, srtp_required, crypto_options,
           context()->ssrc_generator());
@@ -321,6 +322,7 @@ RTCError RtpTransceiver::CreateChannel(
     return RTCError(RTCErrorType::INTERNAL_ERROR,
                     "Failed to create channel for mid=" + std::string(mid));
   }
+  network_thread_ = network_thread;
   SetChannel(std::move(new_channel), transport_lookup);
   return RTCError::OK();
 }
@@ -353,7 +355,7 @@ void RtpTransceiver::SetChannel(
   // Similarly, if the channel() accessor is limited to the network thread, that
   // helps with keeping the channel implementation requirements being met and
   // avoids synchronization for accessing the pointer or network related state.
-  context()->network_thread()->BlockingCall([&]() {
+  network_thread()->BlockingCall([&]() {
     if (channel_) {
       channel_->SetFirstPacketReceivedCallback(nullptr);
       channel_->SetRtpTransport(nullptr);
@@ -389,7 +391,7 @@ void RtpTransceiver::ClearChannel() {
   }
   std::unique_ptr<cricket::ChannelInterface> channel_to_delete;
 
-  context()->network_thread()->BlockingCall([&]() {
+  network_thread()->BlockingCall([&]() {
     if (channel_) {
       channel_->SetFirstPacketReceivedCallback(nullptr);
       channel_->SetRtpTransport(nullptr);
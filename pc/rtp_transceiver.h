@@ -116,9 +116,12 @@ class RtpTransceiver : public RtpTransceiverInterface {
   // the transceiver is not in the currently set local/remote description.
   cricket::ChannelInterface* channel() const { return channel_.get(); }
 
-  // Creates the Voice/VideoChannel and sets it.
+  // Creates the Voice/VideoChannel and sets it. The channel runs its network
+  // side on `network_thread`, which is the network thread of the owning
+  // PeerConnection.
   RTCError CreateChannel(
       absl::string_view mid,
+      rtc::Thread* network_thread,
       Call* call_ptr,
       const cricket::MediaConfig& media_config,
       bool srtp_required,
@@ -301,6 +304,11 @@ class RtpTransceiver : public RtpTransceiverInterface {
     return context_->media_engine();
   }
   ConnectionContext* context() const { return context_; }
+  // The thread that `channel_` runs its network side on. Falls back to the
+  // network thread of `context_` if the channel was set with SetChannel().
+  rtc::Thread* network_thread() const {
+    return network_thread_ ? network_thread_ : context_->network_thread();
+  }
   void OnFirstPacketReceived();
   void StopSendingAndReceiving();
   // Delete a channel, and ensure that references to its media channel
@@ -336,6 +344,7 @@ class RtpTransceiver : public RtpTransceiverInterface {
   // from thread_.
   std::unique_ptr<cricket::ChannelInterface> channel_ = nullptr;
   ConnectionContext* const context_;
+  rtc::Thread* network_thread_ = nullptr;
   std::vector<RtpCodecCapability> codec_preferences_;
   std::vector<RtpHeaderExtensionCapability> header_extensions_to_negotiate_;
 
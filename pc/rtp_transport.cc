@@ -247,23 +247,21 @@ void RtpTransport::OnSentPacket(rtc::PacketTransportInternal* packet_transport,
   processing_sent_packet_ = false;
 }
 
-void RtpTransport::OnRtpPacketReceived(
-    const rtc::ReceivedPacket& received_packet) {
-  rtc::CopyOnWriteBuffer payload(received_packet.payload());
-  DemuxPacket(
-      payload,
-      received_packet.arrival_time().value_or(Timestamp::MinusInfinity()),
-      received_packet.ecn());
+void RtpTransport::OnRtpPacketReceived(rtc::ReceivedPacket received_packet) {
+  const Timestamp arrival_time =
+      received_packet.arrival_time().value_or(Timestamp::MinusInfinity());
+  const rtc::EcnMarking ecn = received_packet.ecn();
+  DemuxPacket(std::move(received_packet).TakePayload(), arrival_time, ecn);
 }
 
-void RtpTransport::OnRtcpPacketReceived(
-    const rtc::ReceivedPacket& received_packet) {
-  rtc::CopyOnWriteBuffer payload(received_packet.payload());
+void RtpTransport::OnRtcpPacketReceived(rtc::ReceivedPacket received_packet) {
   // TODO(bugs.webrtc.org/15368): Propagate timestamp and maybe received packet
   // further.
-  SendRtcpPacketReceived(&payload, received_packet.arrival_time()
-                                       ? received_packet.arrival_time()->us()
-                                       : -1);
+  const int64_t packet_time_us = received_packet.arrival_time()
+                                     ? received_packet.arrival_time()->us()
+                                     : -1;
+  rtc::CopyOnWriteBuffer payload = std::move(received_packet).TakePayload();
+  SendRtcpPacketReceived(&payload, packet_time_us);
 }
 
 void RtpTransport::OnReadPacket(rtc::PacketTransportInternal* transport,
@@ -289,6 +287,8 @@ void RtpTransport::OnReadPacket(rtc::PacketTransportInternal* transport,
     return;
   }
 
+  // The handlers get a copy of the packet, which shares its payload buffer
+  // with the packet seen by the other receivers.
   if (packet_type == cricket::RtpPacketType::kRtcp) {
     OnRtcpPacketReceived(received_packet);
   } else {
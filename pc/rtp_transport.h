@@ -105,8 +105,10 @@ class RtpTransport : public RtpTransportInternal {
   // Overridden by SrtpTransport.
   virtual void OnNetworkRouteChanged(
       absl::optional<rtc::NetworkRoute> network_route);
-  virtual void OnRtpPacketReceived(const rtc::ReceivedPacket& packet);
-  virtual void OnRtcpPacketReceived(const rtc::ReceivedPacket& packet);
+  // RtpTransport is the final receiver of RTP and RTCP packets, so these get
+  // a packet of their own and may take over its payload.
+  virtual void OnRtpPacketReceived(rtc::ReceivedPacket packet);
+  virtual void OnRtcpPacketReceived(rtc::ReceivedPacket packet);
   // Overridden by SrtpTransport and DtlsSrtpTransport.
   virtual void OnWritableState(rtc::PacketTransportInternal* packet_transport);
 
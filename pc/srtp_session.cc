@@ -178,24 +178,71 @@ bool SrtpSession::ProtectRtp(void* p, int in_len, int max_len, int* out_len) {
                         << max_len << " is less than the needed " << need_len;
     return false;
   }
-  if (dump_plain_rtp_) {
-    DumpPacket(p, in_len, /*outbound=*/true);
-  }
 
-  *out_len = in_len;
-  int err = srtp_protect(session_, p, out_len);
-  int seq_num = ParseRtpSequenceNumber(
-      rtc::MakeArrayView(reinterpret_cast<const uint8_t*>(p), in_len));
+  int err = DoProtectRtp(p, in_len, out_len);
   if (err != srtp_err_status_ok) {
-    RTC_LOG(LS_WARNING) << "Failed to protect SRTP packet, seqnum=" << seq_num
+    RTC_LOG(LS_WARNING) << "Failed to protect SRTP packet, seqnum="
+                        << ParseRtpSequenceNumber(rtc::MakeArrayView(
+                               reinterpret_cast<const uint8_t*>(p), in_len))
                         << ", err=" << err
                         << ", last seqnum=" << last_send_seq_num_;
     return false;
   }
-  last_send_seq_num_ = seq_num;
   return true;
 }
 
+int SrtpSession::ProtectRtpBatch(rtc::ArrayView<BatchPacket> packets) {
+  RTC_DCHECK(thread_checker_.IsCurrent());
+  if (!session_) {
+    RTC_LOG(LS_WARNING) << "Failed to protect " << packets.size()
+                        << " SRTP packets: no SRTP Session";
+    for (BatchPacket& packet : packets) {
+      packet.ok = false;
+    }
+    return 0;
+  }
+
+  int protected_count = 0;
+  int last_err = srtp_err_status_ok;
+  for (BatchPacket& packet : packets) {
+    if (packet.max_len < packet.len + rtp_auth_tag_len_) {
+      packet.ok = false;
+      last_err = srtp_err_status_bad_param;
+      continue;
+    }
+    int out_len = 0;
+    int err = DoProtectRtp(packet.data, packet.len, &out_len);
+    packet.ok = err == srtp_err_status_ok;
+    if (!packet.ok) {
+      last_err = err;
+      continue;
+    }
+    packet.len = out_len;
+    ++protected_count;
+  }
+  if (protected_count != static_cast<int>(packets.size())) {
+    RTC_LOG(LS_WARNING) << "Failed to protect "
+                        << packets.size() - protected_count << " of "
+                        << packets.size() << " SRTP packets, last err="
+                        << last_err << ", last seqnum=" << last_send_seq_num_;
+  }
+  return protected_count;
+}
+
+int SrtpSession::DoProtectRtp(void* p, int in_len, int* out_len) {
+  if (dump_plain_rtp_) {
+    DumpPacket(p, in_len, /*outbound=*/true);
+  }
+
+  *out_len = in_len;
+  int err = srtp_protect(session_, p, out_len);
+  if (err == srtp_err_status_ok) {
+    last_send_seq_num_ = ParseRtpSequenceNumber(
+        rtc::MakeArrayView(reinterpret_cast<const uint8_t*>(p), in_len));
+  }
+  return err;
+}
+
 bool SrtpSession::ProtectRtp(void* p,
                              int in_len,
                              int max_len,
@@ -16,6 +16,7 @@
 
 #include <vector>
 
+#include "api/array_view.h"
 #include "api/field_trials_view.h"
 #include "api/scoped_refptr.h"
 #include "api/sequence_checker.h"
@@ -42,6 +43,17 @@ class SrtpSession {
   SrtpSession(const SrtpSession&) = delete;
   SrtpSession& operator=(const SrtpSession&) = delete;
 
+  // An RTP packet in a batch passed to ProtectRtpBatch.
+  struct BatchPacket {
+    void* data = nullptr;
+    // Length of the packet on input, of the processed packet on output.
+    int len = 0;
+    // Size of the buffer pointed to by `data`.
+    int max_len = 0;
+    // Set to true if the packet was processed successfully.
+    bool ok = false;
+  };
+
   // Configures the session for sending data using the specified
   // crypto suite and key. Receiving must be done by a separate session.
   bool SetSend(int crypto_suite,
@@ -79,6 +91,12 @@ class SrtpSession {
   bool UnprotectRtp(void* data, int in_len, int* out_len);
   bool UnprotectRtcp(void* data, int in_len, int* out_len);
 
+  // Encrypts a burst of RTP packets, in-place. Equivalent to calling
+  // ProtectRtp() for each packet, but the session is checked once and
+  // failures are logged once per batch. Packets are processed back to back in
+  // order. Returns the number of packets protected successfully.
+  int ProtectRtpBatch(rtc::ArrayView<BatchPacket> packets);
+
   // Helper method to get authentication params.
   bool GetRtpAuthParams(uint8_t** key, int* key_len, int* tag_len);
 
@@ -121,6 +139,10 @@ class SrtpSession {
                  const uint8_t* key,
                  size_t len,
                  const std::vector<int>& extension_ids);
+  // Protects a single RTP packet without checking the session or the buffer
+  // size. Returns the libsrtp error code.
+  int DoProtectRtp(void* data, int in_len, int* out_len);
+
   // Returns send stream current packet index from srtp db.
   bool GetSendStreamPacketIndex(void* data, int in_len, int64_t* index);
 
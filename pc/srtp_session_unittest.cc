@@ -13,6 +13,7 @@
 #include <string.h>
 
 #include <string>
+#include <vector>
 
 #include "media/base/fake_rtp.h"
 #include "pc/test/srtp_test_util.h"
@@ -194,6 +195,44 @@ TEST_F(SrtpSessionTest, TestBuffersTooSmall) {
                                sizeof(rtcp_packet_) - 14, &out_len));
 }
 
+// Test that a batch of packets can be encrypted and that a failure for one
+// packet does not affect the others.
+TEST_F(SrtpSessionTest, TestProtectRtpBatch) {
+  EXPECT_TRUE(s1_.SetSend(kSrtpAes128CmSha1_80, kTestKey1, kTestKeyLen,
+                          kEncryptedHeaderExtensionIds));
+  EXPECT_TRUE(s2_.SetRecv(kSrtpAes128CmSha1_80, kTestKey1, kTestKeyLen,
+                          kEncryptedHeaderExtensionIds));
+  constexpr int kNumPackets = 3;
+  char packets[kNumPackets][sizeof(rtp_packet_)];
+  std::vector<cricket::SrtpSession::BatchPacket> batch(kNumPackets);
+  for (int i = 0; i < kNumPackets; ++i) {
+    memcpy(packets[i], kPcmuFrame, rtp_len_);
+    SetBE16(reinterpret_cast<uint8_t*>(packets[i]) + 2, 100 + i);
+    batch[i].data = packets[i];
+    batch[i].len = rtp_len_;
+    batch[i].max_len = sizeof(packets[i]);
+  }
+  // No room for the auth tag.
+  batch[1].max_len = rtp_len_;
+
+  EXPECT_EQ(2, s1_.ProtectRtpBatch(batch));
+  EXPECT_TRUE(batch[0].ok);
+  EXPECT_FALSE(batch[1].ok);
+  EXPECT_TRUE(batch[2].ok);
+  EXPECT_EQ(batch[0].len, rtp_len_ + rtp_auth_tag_len(kCsAesCm128HmacSha1_80));
+  EXPECT_EQ(batch[1].len, rtp_len_);
+
+  // The packet that failed to be protected is rejected on the receive side.
+  for (int i = 0; i < kNumPackets; ++i) {
+    int out_len = 0;
+    EXPECT_EQ(batch[i].ok, s2_.UnprotectRtp(packets[i], batch[i].len, &out_len));
+    if (batch[i].ok) {
+      EXPECT_EQ(out_len, rtp_len_);
+      EXPECT_EQ(0, memcmp(packets[i] + 4, kPcmuFrame + 4, rtp_len_ - 4));
+    }
+  }
+}
+
 TEST_F(SrtpSessionTest, TestReplay) {
   static const uint16_t kMaxSeqnum = static_cast<uint16_t>(-1);
   static const uint16_t seqnum_big = 62275;
@@ -17,6 +17,7 @@
 #include <vector>
 
 #include "absl/strings/match.h"
+#include "api/task_queue/task_queue_base.h"
 #include "media/base/rtp_utils.h"
 #include "modules/rtp_rtcp/source/rtp_util.h"
 #include "pc/rtp_transport.h"
@@ -32,6 +33,12 @@
 #include "rtc_base/zero_memory.h"
 
 namespace webrtc {
+namespace {
+
+// Maximum number of batchable RTP packets held back to be protected together.
+constexpr size_t kMaxRtpBatchSize = 32;
+
+}  // namespace
 
 SrtpTransport::SrtpTransport(bool rtcp_mux_enabled,
                              const FieldTrialsView& field_trials)
@@ -45,6 +52,11 @@ bool SrtpTransport::SendRtpPacket(rtc::CopyOnWriteBuffer* packet,
         << "Failed to send the packet because SRTP transport is inactive.";
     return false;
   }
+  if (options.batchable && !IsExternalAuthActive()) {
+    return QueueRtpPacket(packet, options, flags);
+  }
+  // Keep the packets in order.
+  SendPendingRtpPackets();
   rtc::PacketOptions updated_options = options;
   TRACE_EVENT0("webrtc", "SRTP Encode");
   bool res;
@@ -93,6 +105,93 @@ bool SrtpTransport::SendRtpPacket(rtc::CopyOnWriteBuffer* packet,
   return SendPacket(/*rtcp=*/false, packet, updated_options, flags);
 }
 
+bool SrtpTransport::QueueRtpPacket(rtc::CopyOnWriteBuffer* packet,
+                                   const rtc::PacketOptions& options,
+                                   int flags) {
+  // A packet without room for the auth tag would only fail once it is no
+  // longer possible to tell the caller, so reject it right away.
+  if (packet->capacity() <
+      packet->size() + send_session_->GetSrtpOverhead()) {
+    RTC_LOG(LS_ERROR) << "Failed to protect RTP packet: size="
+                      << packet->size() << ", capacity=" << packet->capacity()
+                      << ", seqnum=" << ParseRtpSequenceNumber(*packet)
+                      << ", SSRC=" << ParseRtpSsrc(*packet);
+    return false;
+  }
+  pending_rtp_packets_.push_back(
+      {.packet = std::move(*packet), .options = options, .flags = flags});
+  if (options.last_packet_in_batch ||
+      pending_rtp_packets_.size() >= kMaxRtpBatchSize) {
+    return SendPendingRtpPackets();
+  }
+  if (pending_rtp_packets_.size() == 1) {
+    // Don't hold packets back past the current task in case the last packet
+    // of the batch never comes.
+    TaskQueueBase* current = TaskQueueBase::Current();
+    if (current == nullptr) {
+      return SendPendingRtpPackets();
+    }
+    current->PostTask(
+        SafeTask(batch_safety_.flag(), [this] { SendPendingRtpPackets(); }));
+  }
+  return true;
+}
+
+bool SrtpTransport::SendPendingRtpPackets() {
+  if (pending_rtp_packets_.empty()) {
+    return true;
+  }
+  if (!IsSrtpActive()) {
+    RTC_LOG(LS_ERROR) << "Failed to send " << pending_rtp_packets_.size()
+                      << " packets because SRTP transport is inactive.";
+    failed_batched_rtp_packets_ +=
+        rtc::checked_cast<int>(pending_rtp_packets_.size());
+    pending_rtp_packets_.clear();
+    return false;
+  }
+  TRACE_EVENT0("webrtc", "SRTP Encode");
+  // Swap the queues rather than moving out of `pending_rtp_packets_`, so that
+  // both keep their capacity for the next batch.
+  RTC_DCHECK(sending_rtp_packets_.empty());
+  sending_rtp_packets_.swap(pending_rtp_packets_);
+  protect_batch_.resize(sending_rtp_packets_.size());
+  for (size_t i = 0; i < sending_rtp_packets_.size(); ++i) {
+    rtc::CopyOnWriteBuffer& packet = sending_rtp_packets_[i].packet;
+    protect_batch_[i] = {
+        .data = packet.MutableData(),
+        .len = rtc::checked_cast<int>(packet.size()),
+        .max_len = rtc::checked_cast<int>(packet.capacity())};
+  }
+  send_session_->ProtectRtpBatch(protect_batch_);
+
+  int failed = 0;
+  for (size_t i = 0; i < sending_rtp_packets_.size(); ++i) {
+    PendingRtpPacket& pending = sending_rtp_packets_[i];
+    if (!protect_batch_[i].ok) {
+      RTC_LOG(LS_ERROR) << "Failed to protect RTP packet: size="
+                        << pending.packet.size()
+                        << ", seqnum=" << ParseRtpSequenceNumber(pending.packet)
+                        << ", SSRC=" << ParseRtpSsrc(pending.packet);
+      ++failed;
+      continue;
+    }
+    // Update the length of the packet now that we've added the auth tag.
+    pending.packet.SetSize(protect_batch_[i].len);
+    if (!SendPacket(/*rtcp=*/false, &pending.packet, pending.options,
+                    pending.flags)) {
+      ++failed;
+    }
+  }
+  if (failed > 0) {
+    RTC_LOG(LS_WARNING) << "Failed to send " << failed << " of "
+                        << sending_rtp_packets_.size()
+                        << " batched RTP packets.";
+    failed_batched_rtp_packets_ += failed;
+  }
+  sending_rtp_packets_.clear();
+  return failed == 0;
+}
+
 bool SrtpTransport::SendRtcpPacket(rtc::CopyOnWriteBuffer* packet,
                                    const rtc::PacketOptions& options,
                                    int flags) {
@@ -101,6 +200,7 @@ bool SrtpTransport::SendRtcpPacket(rtc::CopyOnWriteBuffer* packet,
         << "Failed to send the packet because SRTP transport is inactive.";
     return false;
   }
+  SendPendingRtpPackets();
 
   TRACE_EVENT0("webrtc", "SRTP Encode");
   uint8_t* data = packet->MutableData();
@@ -118,7 +218,7 @@ bool SrtpTransport::SendRtcpPacket(rtc::CopyOnWriteBuffer* packet,
   return SendPacket(/*rtcp=*/true, packet, options, flags);
 }
 
-void SrtpTransport::OnRtpPacketReceived(const rtc::ReceivedPacket& packet) {
+void SrtpTransport::OnRtpPacketReceived(rtc::ReceivedPacket packet) {
   TRACE_EVENT0("webrtc", "SrtpTransport::OnRtpPacketReceived");
   if (!IsSrtpActive()) {
     RTC_LOG(LS_WARNING)
@@ -126,7 +226,12 @@ void SrtpTransport::OnRtpPacketReceived(const rtc::ReceivedPacket& packet) {
     return;
   }
 
-  rtc::CopyOnWriteBuffer payload(packet.payload());
+  const Timestamp arrival_time =
+      packet.arrival_time().value_or(Timestamp::MinusInfinity());
+  const rtc::EcnMarking ecn = packet.ecn();
+  // Unprotects in place. This copies the payload first if it is still shared
+  // with other receivers of the packet.
+  rtc::CopyOnWriteBuffer payload = std::move(packet).TakePayload();
   char* data = payload.MutableData<char>();
   int len = rtc::checked_cast<int>(payload.size());
   if (!UnprotectRtp(data, len, &len)) {
@@ -144,19 +249,19 @@ void SrtpTransport::OnRtpPacketReceived(const rtc::ReceivedPacket& packet) {
     return;
   }
   payload.SetSize(len);
-  DemuxPacket(std::move(payload),
-              packet.arrival_time().value_or(Timestamp::MinusInfinity()),
-              packet.ecn());
+  DemuxPacket(std::move(payload), arrival_time, ecn);
 }
 
-void SrtpTransport::OnRtcpPacketReceived(const rtc::ReceivedPacket& packet) {
+void SrtpTransport::OnRtcpPacketReceived(rtc::ReceivedPacket packet) {
   TRACE_EVENT0("webrtc", "SrtpTransport::OnRtcpPacketReceived");
   if (!IsSrtpActive()) {
     RTC_LOG(LS_WARNING)
         << "Inactive SRTP transport received an RTCP packet. Drop it.";
     return;
   }
-  rtc::CopyOnWriteBuffer payload(packet.payload());
+  const int64_t packet_time_us =
+      packet.arrival_time() ? packet.arrival_time()->us() : -1;
+  rtc::CopyOnWriteBuffer payload = std::move(packet).TakePayload();
   char* data = payload.MutableData<char>();
   int len = rtc::checked_cast<int>(payload.size());
   if (!UnprotectRtcp(data, len, &len)) {
@@ -167,8 +272,7 @@ void SrtpTransport::OnRtcpPacketReceived(const rtc::ReceivedPacket& packet) {
     return;
   }
   payload.SetSize(len);
-  SendRtcpPacketReceived(
-      &payload, packet.arrival_time() ? packet.arrival_time()->us() : -1);
+  SendRtcpPacketReceived(&payload, packet_time_us);
 }
 
 void SrtpTransport::OnNetworkRouteChanged(
@@ -279,6 +383,7 @@ bool SrtpTransport::IsWritable(bool rtcp) const {
 }
 
 void SrtpTransport::ResetParams() {
+  pending_rtp_packets_.clear();
   send_session_ = nullptr;
   recv_session_ = nullptr;
   send_rtcp_session_ = nullptr;
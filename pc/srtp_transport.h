@@ -21,6 +21,7 @@
 #include "absl/types/optional.h"
 #include "api/field_trials_view.h"
 #include "api/rtc_error.h"
+#include "api/task_queue/pending_task_safety_flag.h"
 #include "p2p/base/packet_transport_internal.h"
 #include "pc/rtp_transport.h"
 #include "pc/srtp_session.h"
@@ -109,6 +110,10 @@ class SrtpTransport : public RtpTransport {
   // disassociates all SSRCs of the sink from libSRTP.
   bool UnregisterRtpDemuxerSink(RtpPacketSinkInterface* sink) override;
 
+  // Number of packets sent with `options.batchable` set that were held back
+  // and later failed to be protected or sent.
+  int failed_batched_rtp_packets() const { return failed_batched_rtp_packets_; }
+
  protected:
   // If the writable state changed, fire the SignalWritableState.
   void MaybeUpdateWritableState();
@@ -117,14 +122,26 @@ class SrtpTransport : public RtpTransport {
   void ConnectToRtpTransport();
   void CreateSrtpSessions();
 
-  void OnRtpPacketReceived(const rtc::ReceivedPacket& packet) override;
-  void OnRtcpPacketReceived(const rtc::ReceivedPacket& packet) override;
+  void OnRtpPacketReceived(rtc::ReceivedPacket packet) override;
+  void OnRtcpPacketReceived(rtc::ReceivedPacket packet) override;
   void OnNetworkRouteChanged(
       absl::optional<rtc::NetworkRoute> network_route) override;
 
   // Override the RtpTransport::OnWritableState.
   void OnWritableState(rtc::PacketTransportInternal* packet_transport) override;
 
+  // Holds back a packet sent with `options.batchable` set, and protects and
+  // sends the held back packets together when the last packet of the batch is
+  // sent, or at the end of the current task. Returns false if the packet can't
+  // be protected; failures after it has been held back are only counted in
+  // `failed_batched_rtp_packets_`.
+  bool QueueRtpPacket(rtc::CopyOnWriteBuffer* packet,
+                      const rtc::PacketOptions& options,
+                      int flags);
+  // Returns false if any of the held back packets couldn't be protected or
+  // sent.
+  bool SendPendingRtpPackets();
+
   bool ProtectRtp(void* data, int in_len, int max_len, int* out_len);
 
   // Overloaded version, outputs packet index.
@@ -164,6 +181,18 @@ class SrtpTransport : public RtpTransport {
 
   int decryption_failure_count_ = 0;
 
+  struct PendingRtpPacket {
+    rtc::CopyOnWriteBuffer packet;
+    rtc::PacketOptions options;
+    int flags;
+  };
+  std::vector<PendingRtpPacket> pending_rtp_packets_;
+  // Scratch space for SendPendingRtpPackets(), kept to reuse the allocations.
+  std::vector<PendingRtpPacket> sending_rtp_packets_;
+  std::vector<cricket::SrtpSession::BatchPacket> protect_batch_;
+  int failed_batched_rtp_packets_ = 0;
+  ScopedTaskSafety batch_safety_;
+
   const FieldTrialsView& field_trials_;
 };
 
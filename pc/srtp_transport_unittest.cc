@@ -26,6 +26,7 @@
 #include "rtc_base/containers/flat_set.h"
 #include "rtc_base/ssl_stream_adapter.h"
 #include "rtc_base/third_party/sigslot/sigslot.h"
+#include "rtc_base/thread.h"
 #include "test/gtest.h"
 #include "test/scoped_key_value_config.h"
 
@@ -345,6 +346,100 @@ class SrtpTransportTest : public ::testing::Test, public sigslot::has_slots<> {
   test::ScopedKeyValueConfig field_trials_;
 };
 
+class SrtpTransportBatchTest : public SrtpTransportTest {
+ protected:
+  SrtpTransportBatchTest() {
+    std::vector<int> extension_ids;
+    EXPECT_TRUE(srtp_transport1_->SetRtpParams(
+        rtc::kSrtpAes128CmSha1_80, kTestKey1, kTestKeyLen, extension_ids,
+        rtc::kSrtpAes128CmSha1_80, kTestKey2, kTestKeyLen, extension_ids));
+    EXPECT_TRUE(srtp_transport2_->SetRtpParams(
+        rtc::kSrtpAes128CmSha1_80, kTestKey2, kTestKeyLen, extension_ids,
+        rtc::kSrtpAes128CmSha1_80, kTestKey1, kTestKeyLen, extension_ids));
+  }
+
+  bool SendBatchable(bool last_packet_in_batch) {
+    size_t rtp_len = sizeof(kPcmuFrame);
+    size_t packet_size =
+        rtp_len + rtc::rtp_auth_tag_len(rtc::kCsAesCm128HmacSha1_80);
+    rtc::CopyOnWriteBuffer packet(kPcmuFrame, rtp_len, packet_size);
+    rtc::SetBE16(packet.MutableData() + 2, ++sequence_number_);
+    rtc::PacketOptions options;
+    options.batchable = true;
+    options.last_packet_in_batch = last_packet_in_batch;
+    return srtp_transport1_->SendRtpPacket(&packet, options,
+                                           cricket::PF_SRTP_BYPASS);
+  }
+
+  rtc::AutoThread main_thread_;
+};
+
+TEST_F(SrtpTransportBatchTest, ProtectsBatchWithItsLastPacket) {
+  EXPECT_TRUE(SendBatchable(/*last_packet_in_batch=*/false));
+  EXPECT_TRUE(SendBatchable(/*last_packet_in_batch=*/false));
+  EXPECT_EQ(rtp_sink2_.rtp_count(), 0);
+
+  EXPECT_TRUE(SendBatchable(/*last_packet_in_batch=*/true));
+  EXPECT_EQ(rtp_sink2_.rtp_count(), 3);
+  EXPECT_EQ(rtp_sink2_.last_recv_rtp_packet().SequenceNumber(), 3);
+}
+
+TEST_F(SrtpTransportBatchTest, ProtectsIncompleteBatchAtEndOfTask) {
+  EXPECT_TRUE(SendBatchable(/*last_packet_in_batch=*/false));
+  EXPECT_TRUE(SendBatchable(/*last_packet_in_batch=*/false));
+  EXPECT_EQ(rtp_sink2_.rtp_count(), 0);
+
+  main_thread_.ProcessMessages(0);
+  EXPECT_EQ(rtp_sink2_.rtp_count(), 2);
+}
+
+TEST_F(SrtpTransportBatchTest, SendsHeldBackPacketsBeforeUnbatchedPacket) {
+  EXPECT_TRUE(SendBatchable(/*last_packet_in_batch=*/false));
+
+  rtc::CopyOnWriteBuffer packet(
+      kPcmuFrame, sizeof(kPcmuFrame),
+      sizeof(kPcmuFrame) + rtc::rtp_auth_tag_len(rtc::kCsAesCm128HmacSha1_80));
+  rtc::SetBE16(packet.MutableData() + 2, ++sequence_number_);
+  EXPECT_TRUE(srtp_transport1_->SendRtpPacket(&packet, rtc::PacketOptions(),
+                                              cricket::PF_SRTP_BYPASS));
+  EXPECT_EQ(rtp_sink2_.rtp_count(), 2);
+  EXPECT_EQ(rtp_sink2_.last_recv_rtp_packet().SequenceNumber(), 2);
+}
+
+TEST_F(SrtpTransportBatchTest, RejectsPacketWithoutRoomForAuthTag) {
+  rtc::CopyOnWriteBuffer packet(kPcmuFrame, sizeof(kPcmuFrame),
+                                sizeof(kPcmuFrame));
+  rtc::SetBE16(packet.MutableData() + 2, ++sequence_number_);
+  rtc::PacketOptions options;
+  options.batchable = true;
+  EXPECT_FALSE(srtp_transport1_->SendRtpPacket(&packet, options,
+                                               cricket::PF_SRTP_BYPASS));
+
+  main_thread_.ProcessMessages(0);
+  EXPECT_EQ(rtp_sink2_.rtp_count(), 0);
+  EXPECT_EQ(srtp_transport1_->failed_batched_rtp_packets(), 0);
+}
+
+TEST_F(SrtpTransportBatchTest, CountsHeldBackPacketsThatFailToSend) {
+  EXPECT_TRUE(SendBatchable(/*last_packet_in_batch=*/false));
+  EXPECT_TRUE(SendBatchable(/*last_packet_in_batch=*/false));
+  rtp_packet_transport1_->SetDestination(nullptr, /*asymmetric=*/false);
+
+  main_thread_.ProcessMessages(0);
+  EXPECT_EQ(rtp_sink2_.rtp_count(), 0);
+  EXPECT_EQ(srtp_transport1_->failed_batched_rtp_packets(), 2);
+}
+
+TEST_F(SrtpTransportBatchTest, ReusesQueuesAcrossBatches) {
+  for (int batch = 0; batch < 3; ++batch) {
+    EXPECT_TRUE(SendBatchable(/*last_packet_in_batch=*/false));
+    EXPECT_TRUE(SendBatchable(/*last_packet_in_batch=*/true));
+  }
+  EXPECT_EQ(rtp_sink2_.rtp_count(), 6);
+  EXPECT_EQ(rtp_sink2_.last_recv_rtp_packet().SequenceNumber(), 6);
+  EXPECT_EQ(srtp_transport1_->failed_batched_rtp_packets(), 0);
+}
+
 class SrtpTransportTestWithExternalAuth
     : public SrtpTransportTest,
       public ::testing::WithParamInterface<bool> {};
@@ -123,11 +123,13 @@ PeerConnectionTestWrapper::PeerConnectionTestWrapper(
     const std::string& name,
     rtc::SocketServer* socket_server,
     rtc::Thread* network_thread,
-    rtc::Thread* worker_thread)
+    rtc::Thread* worker_thread,
+    rtc::Thread* pc_network_thread)
     : name_(name),
       socket_server_(socket_server),
       network_thread_(network_thread),
       worker_thread_(worker_thread),
+      pc_network_thread_(pc_network_thread),
       pending_negotiation_(false) {
   pc_thread_checker_.Detach();
 }
@@ -152,7 +154,7 @@ bool PeerConnectionTestWrapper::CreatePc(
     rtc::scoped_refptr<webrtc::AudioDecoderFactory> audio_decoder_factory) {
   std::unique_ptr<cricket::PortAllocator> port_allocator(
       new cricket::FakePortAllocator(
-          network_thread_,
+          pc_network_thread_ ? pc_network_thread_ : network_thread_,
           std::make_unique<rtc::BasicPacketSocketFactory>(socket_server_),
           &field_trials_));
 
@@ -183,6 +185,7 @@ bool PeerConnectionTestWrapper::CreatePc(
   webrtc::PeerConnectionDependencies deps(this);
   deps.allocator = std::move(port_allocator);
   deps.cert_generator = std::move(cert_generator);
+  deps.network_thread = pc_network_thread_;
   auto result = peer_connection_factory_->CreatePeerConnectionOrError(
       config, std::move(deps));
   if (result.ok()) {
@@ -44,10 +44,14 @@ class PeerConnectionTestWrapper
   static void Connect(PeerConnectionTestWrapper* caller,
                       PeerConnectionTestWrapper* callee);
 
+  // If `pc_network_thread` is set, the PeerConnection runs on it instead of
+  // on the factory's `network_thread`, and `socket_server` must be the one
+  // of `pc_network_thread`.
   PeerConnectionTestWrapper(const std::string& name,
                             rtc::SocketServer* socket_server,
                             rtc::Thread* network_thread,
-                            rtc::Thread* worker_thread);
+                            rtc::Thread* worker_thread,
+                            rtc::Thread* pc_network_thread = nullptr);
   virtual ~PeerConnectionTestWrapper();
 
   bool CreatePc(
@@ -135,6 +139,7 @@ class PeerConnectionTestWrapper
   rtc::SocketServer* const socket_server_;
   rtc::Thread* const network_thread_;
   rtc::Thread* const worker_thread_;
+  rtc::Thread* const pc_network_thread_;
   webrtc::SequenceChecker pc_thread_checker_;
   rtc::scoped_refptr<webrtc::PeerConnectionInterface> peer_connection_;
   rtc::scoped_refptr<webrtc::PeerConnectionFactoryInterface>
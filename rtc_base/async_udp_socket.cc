@@ -10,9 +10,18 @@
 
 #include "rtc_base/async_udp_socket.h"
 
+#include <cstring>
+#include <utility>
+#include <vector>
+
 #include "absl/types/optional.h"
+#include "api/array_view.h"
+#include "api/scoped_refptr.h"
+#include "api/task_queue/pending_task_safety_flag.h"
+#include "api/task_queue/task_queue_base.h"
 #include "api/units/time_delta.h"
 #include "rtc_base/checks.h"
+#include "rtc_base/copy_on_write_buffer.h"
 #include "rtc_base/logging.h"
 #include "rtc_base/network/received_packet.h"
 #include "rtc_base/network/sent_packet.h"
@@ -21,6 +30,26 @@
 
 namespace rtc {
 
+namespace {
+
+// Maximum number of datagrams read per read event when batched receive is
+// enabled with the "WebRTC-UdpBatchReceive" field trial.
+constexpr size_t kReceiveBatchSize = 16;
+
+// Maximum number of packets held back by AsyncUDPSocket::SendTo when batched
+// send is enabled with the "WebRTC-UdpBatchSend" field trial. Held back
+// packets are sent when the last packet of their batch is sent, at the end of
+// the current task at the latest, or when the socket becomes writable if it
+// was blocked.
+constexpr size_t kMaxSendBatchSize = 32;
+
+// With the "WebRTC-UdpZeroCopyReceive" field trial, datagrams of up to this
+// size, which covers the MTU of most networks, are received into a buffer of
+// their own that is handed on to the receiver without copying.
+constexpr size_t kZeroCopyHeadSize = 1500;
+
+}  // namespace
+
 AsyncUDPSocket* AsyncUDPSocket::Create(Socket* socket,
                                        const SocketAddress& bind_address) {
   std::unique_ptr<Socket> owned_socket(socket);
@@ -39,8 +68,35 @@ AsyncUDPSocket* AsyncUDPSocket::Create(SocketFactory* factory,
   return Create(socket, bind_address);
 }
 
-AsyncUDPSocket::AsyncUDPSocket(Socket* socket) : socket_(socket) {
+AsyncUDPSocket::AsyncUDPSocket(Socket* socket)
+    : socket_(socket),
+      head_pool_(kZeroCopyHeadSize),
+      send_batching_enabled_(
+          webrtc::field_trial::IsEnabled("WebRTC-UdpBatchSend")),
+      zero_copy_receive_enabled_(
+          webrtc::field_trial::IsEnabled("WebRTC-UdpZeroCopyReceive")) {
   sequence_checker_.Detach();
+  if (send_batching_enabled_) {
+    pending_packets_.reserve(kMaxSendBatchSize);
+    send_buffers_.reserve(kMaxSendBatchSize);
+  }
+  if (webrtc::field_trial::IsEnabled("WebRTC-UdpBatchReceive")) {
+    batch_buffers_.resize(kReceiveBatchSize);
+  }
+  if (zero_copy_receive_enabled_) {
+    head_ = rtc::Buffer(0, head_pool_);
+    for (size_t i = 0; i < batch_buffers_.size(); ++i) {
+      batch_heads_.emplace_back(0, head_pool_);
+    }
+  }
+  batch_receive_buffers_.reserve(batch_buffers_.size());
+  for (size_t i = 0; i < batch_buffers_.size(); ++i) {
+    Socket::ReceiveBuffer& receive_buffer =
+        batch_receive_buffers_.emplace_back(batch_buffers_[i]);
+    if (zero_copy_receive_enabled_) {
+      receive_buffer.head = &batch_heads_[i];
+    }
+  }
   // The socket should start out readable but not writable.
   socket_->SignalReadEvent.connect(this, &AsyncUDPSocket::OnReadEvent);
   socket_->SignalWriteEvent.connect(this, &AsyncUDPSocket::OnWriteEvent);
@@ -57,6 +113,12 @@ SocketAddress AsyncUDPSocket::GetRemoteAddress() const {
 int AsyncUDPSocket::Send(const void* pv,
                          size_t cb,
                          const rtc::PacketOptions& options) {
+  if (send_batching_enabled_) {
+    RTC_DCHECK_RUN_ON(&sequence_checker_);
+    if (!pending_packets_.empty()) {
+      FlushPendingPackets();
+    }
+  }
   rtc::SentPacket sent_packet(options.packet_id, rtc::TimeMillis(),
                               options.info_signaled_after_sent);
   CopySocketInformationToPacketInfo(cb, *this, false, &sent_packet.info);
@@ -72,12 +134,122 @@ int AsyncUDPSocket::SendTo(const void* pv,
   rtc::SentPacket sent_packet(options.packet_id, rtc::TimeMillis(),
                               options.info_signaled_after_sent);
   CopySocketInformationToPacketInfo(cb, *this, true, &sent_packet.info);
+  if (send_batching_enabled_) {
+    RTC_DCHECK_RUN_ON(&sequence_checker_);
+    if (options.batchable) {
+      return SendToBatched(pv, cb, addr, sent_packet,
+                           options.last_packet_in_batch);
+    }
+    if (!pending_packets_.empty()) {
+      FlushPendingPackets();
+    }
+  }
   int ret = socket_->SendTo(pv, cb, addr);
   SignalSentPacket(this, sent_packet);
   return ret;
 }
 
+int AsyncUDPSocket::SendToBatched(const void* pv,
+                                  size_t cb,
+                                  const SocketAddress& addr,
+                                  const rtc::SentPacket& sent_packet,
+                                  bool last_packet_in_batch) {
+  RTC_DCHECK_RUN_ON(&sequence_checker_);
+  if (pending_packets_.size() >= kMaxSendBatchSize) {
+    // Only happens while the socket is blocked, in which case an unbatched
+    // send would fail too.
+    RTC_DCHECK(write_blocked_);
+    socket_->SetError(EWOULDBLOCK);
+    return -1;
+  }
+  pending_packets_.push_back({.payload_offset = pending_payloads_.size(),
+                              .payload_size = cb,
+                              .address = addr,
+                              .sent_packet = sent_packet});
+  pending_payloads_.AppendData(static_cast<const uint8_t*>(pv), cb);
+  if (write_blocked_) {
+    // Sent from OnWriteEvent().
+    return static_cast<int>(cb);
+  }
+  if (last_packet_in_batch || pending_packets_.size() >= kMaxSendBatchSize) {
+    int ret = FlushPendingPackets();
+    return ret < 0 ? ret : static_cast<int>(cb);
+  }
+  if (pending_packets_.size() == 1) {
+    // Don't hold packets back past the current task in case the last packet
+    // of the batch never comes.
+    webrtc::TaskQueueBase* current = webrtc::TaskQueueBase::Current();
+    if (current == nullptr) {
+      int ret = FlushPendingPackets();
+      return ret < 0 ? ret : static_cast<int>(cb);
+    }
+    current->PostTask(webrtc::SafeTask(task_safety_.flag(), [this] {
+      RTC_DCHECK_RUN_ON(&sequence_checker_);
+      if (!write_blocked_ && !pending_packets_.empty()) {
+        FlushPendingPackets();
+      }
+    }));
+  }
+  return static_cast<int>(cb);
+}
+
+int AsyncUDPSocket::FlushPendingPackets() {
+  RTC_DCHECK_RUN_ON(&sequence_checker_);
+  int ret = 0;
+  size_t flushed = 0;
+  while (flushed < pending_packets_.size()) {
+    send_buffers_.clear();
+    for (size_t i = flushed; i < pending_packets_.size(); ++i) {
+      const PendingPacket& packet = pending_packets_[i];
+      send_buffers_.push_back(
+          {.payload = rtc::ArrayView<const uint8_t>(
+               pending_payloads_.data() + packet.payload_offset,
+               packet.payload_size),
+           .destination = packet.address});
+    }
+    int sent = socket_->SendToBatch(send_buffers_);
+    if (sent > 0) {
+      for (int i = 0; i < sent; ++i) {
+        SignalSentPacket(this, pending_packets_[flushed + i].sent_packet);
+      }
+      flushed += sent;
+      continue;
+    }
+    ret = -1;
+    if (socket_->IsBlocking()) {
+      // Keep the rest for OnWriteEvent().
+      write_blocked_ = true;
+      break;
+    }
+    // The first packet can't be sent. Drop it without signaling it as sent,
+    // and go on with the rest.
+    RTC_LOG(LS_WARNING) << "AsyncUDPSocket dropped a batched packet, error "
+                        << socket_->GetError();
+    ++flushed;
+  }
+  pending_packets_.erase(pending_packets_.begin(),
+                         pending_packets_.begin() + flushed);
+  if (pending_packets_.empty()) {
+    pending_payloads_.Clear();
+  } else if (flushed > 0) {
+    // Move the payloads that are still queued to the front.
+    size_t start = pending_packets_.front().payload_offset;
+    std::memmove(pending_payloads_.data(), pending_payloads_.data() + start,
+                 pending_payloads_.size() - start);
+    pending_payloads_.SetSize(pending_payloads_.size() - start);
+    for (PendingPacket& packet : pending_packets_) {
+      packet.payload_offset -= start;
+    }
+  }
+  return ret;
+}
+
 int AsyncUDPSocket::Close() {
+  if (send_batching_enabled_) {
+    RTC_DCHECK_RUN_ON(&sequence_checker_);
+    pending_packets_.clear();
+    pending_payloads_.Clear();
+  }
   return socket_->Close();
 }
 
@@ -101,27 +273,66 @@ void AsyncUDPSocket::SetError(int error) {
   return socket_->SetError(error);
 }
 
+webrtc::BufferPool::Stats AsyncUDPSocket::GetReceiveBufferPoolStats() const {
+  RTC_DCHECK_RUN_ON(&sequence_checker_);
+  return head_pool_.GetStats();
+}
+
 void AsyncUDPSocket::OnReadEvent(Socket* socket) {
   RTC_DCHECK(socket_.get() == socket);
   RTC_DCHECK_RUN_ON(&sequence_checker_);
 
+  if (!batch_buffers_.empty()) {
+    ReadBatch();
+    return;
+  }
+
   Socket::ReceiveBuffer receive_buffer(buffer_);
+  if (zero_copy_receive_enabled_) {
+    receive_buffer.head = &head_;
+  }
   int len = socket_->RecvFrom(receive_buffer);
   if (len < 0) {
-    // An error here typically means we got an ICMP error in response to our
-    // send datagram, indicating the remote address was unreachable.
-    // When doing ICE, this kind of thing will often happen.
-    // TODO: Do something better like forwarding the error to the user.
-    SocketAddress local_addr = socket_->GetLocalAddress();
-    RTC_LOG(LS_INFO) << "AsyncUDPSocket[" << local_addr.ToSensitiveString()
-                     << "] receive failed with error " << socket_->GetError();
+    LogReceiveError();
     return;
   }
   if (len == 0) {
     // Spurios wakeup.
     return;
   }
+  DeliverPacket(receive_buffer);
+}
+
+void AsyncUDPSocket::ReadBatch() {
+  RTC_DCHECK_RUN_ON(&sequence_checker_);
+  for (Socket::ReceiveBuffer& receive_buffer : batch_receive_buffers_) {
+    // The socket only sets these if it has them for a datagram.
+    receive_buffer.arrival_time = absl::nullopt;
+    receive_buffer.ecn = EcnMarking::kNotEct;
+  }
+
+  int count = socket_->RecvFromBatch(batch_receive_buffers_);
+  if (count < 0) {
+    LogReceiveError();
+    return;
+  }
+  // A receiver may destroy the socket, in which case the rest of the batch is
+  // dropped.
+  rtc::scoped_refptr<webrtc::PendingTaskSafetyFlag> alive =
+      task_safety_.flag();
+  for (int i = 0; i < count && alive->alive(); ++i) {
+    Socket::ReceiveBuffer& receive_buffer = batch_receive_buffers_[i];
+    if (receive_buffer.payload.empty() &&
+        (receive_buffer.head == nullptr || receive_buffer.head->empty())) {
+      // Empty datagrams are dropped, like in OnReadEvent().
+      continue;
+    }
+    DeliverPacket(receive_buffer);
+  }
+}
 
+void AsyncUDPSocket::DeliverPacket(Socket::ReceiveBuffer& receive_buffer) {
+  RTC_DCHECK_RUN_ON(&sequence_checker_);
   if (!receive_buffer.arrival_time) {
     // Timestamp from socket is not available.
     receive_buffer.arrival_time = webrtc::Timestamp::Micros(rtc::TimeMicros());
@@ -133,12 +344,45 @@ void AsyncUDPSocket::OnReadEvent(Socket* socket) {
     }
     *receive_buffer.arrival_time += *socket_time_offset_;
   }
-  NotifyPacketReceived(
-      ReceivedPacket(receive_buffer.payload, receive_buffer.source_address,
-                     receive_buffer.arrival_time, receive_buffer.ecn));
+  rtc::Buffer* head = receive_buffer.head;
+  if (head == nullptr || head->empty()) {
+    // The whole datagram is in `payload`, which is reused for the next read.
+    NotifyPacketReceived(
+        ReceivedPacket(receive_buffer.payload, receive_buffer.source_address,
+                       receive_buffer.arrival_time, receive_buffer.ecn));
+    return;
+  }
+  if (!receive_buffer.payload.empty()) {
+    // The datagram didn't fit into `head`.
+    head->AppendData(receive_buffer.payload);
+  }
+  // Hand `head` over to the receivers and allocate a new one for the next
+  // read.
+  CopyOnWriteBuffer payload(std::move(*head));
+  *head = rtc::Buffer(0, head_pool_);
+  NotifyPacketReceived(ReceivedPacket::CreateFromBuffer(
+      std::move(payload), receive_buffer.source_address,
+      receive_buffer.arrival_time, receive_buffer.ecn));
+}
+
+void AsyncUDPSocket::LogReceiveError() {
+  // An error here typically means we got an ICMP error in response to our
+  // send datagram, indicating the remote address was unreachable.
+  // When doing ICE, this kind of thing will often happen.
+  // TODO: Do something better like forwarding the error to the user.
+  SocketAddress local_addr = socket_->GetLocalAddress();
+  RTC_LOG(LS_INFO) << "AsyncUDPSocket[" << local_addr.ToSensitiveString()
+                   << "] receive failed with error " << socket_->GetError();
 }
 
 void AsyncUDPSocket::OnWriteEvent(Socket* socket) {
+  if (send_batching_enabled_) {
+    RTC_DCHECK_RUN_ON(&sequence_checker_);
+    write_blocked_ = false;
+    if (!pending_packets_.empty()) {
+      FlushPendingPackets();
+    }
+  }
   SignalReadyToSend(this);
 }
 
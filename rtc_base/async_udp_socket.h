@@ -15,11 +15,16 @@
 
 #include <cstdint>
 #include <memory>
+#include <vector>
 
 #include "absl/types/optional.h"
 #include "api/sequence_checker.h"
+#include "api/task_queue/pending_task_safety_flag.h"
 #include "api/units/time_delta.h"
 #include "rtc_base/async_packet_socket.h"
+#include "rtc_base/buffer.h"
+#include "rtc_base/memory/buffer_pool.h"
+#include "rtc_base/network/sent_packet.h"
 #include "rtc_base/socket.h"
 #include "rtc_base/socket_address.h"
 #include "rtc_base/socket_factory.h"
@@ -61,17 +66,75 @@ class AsyncUDPSocket : public AsyncPacketSocket {
   int GetError() const override;
   void SetError(int error) override;
 
+  // Returns how often the buffers that received packets are handed over in
+  // were taken from released packets rather than allocated. Only counts when
+  // zero-copy receive is enabled.
+  webrtc::BufferPool::Stats GetReceiveBufferPoolStats() const;
+
  private:
   // Called when the underlying socket is ready to be read from.
   void OnReadEvent(Socket* socket);
+  // Reads up to `batch_buffers_.size()` datagrams with one call to
+  // Socket::RecvFromBatch and signals them one by one.
+  void ReadBatch();
+  void DeliverPacket(Socket::ReceiveBuffer& receive_buffer);
+  void LogReceiveError();
+  // Queues a packet sent with `options.batchable` set, and sends the queue if
+  // the batch is complete.
+  int SendToBatched(const void* pv,
+                    size_t cb,
+                    const SocketAddress& addr,
+                    const rtc::SentPacket& sent_packet,
+                    bool last_packet_in_batch);
+  // Sends the packets queued by SendToBatched() with as few calls to
+  // Socket::SendToBatch as possible, and signals those that were sent. If the
+  // socket blocks, the rest stays queued until OnWriteEvent(). Packets that
+  // fail with another error are dropped. Returns -1 if any packet wasn't
+  // sent, 0 otherwise.
+  int FlushPendingPackets();
+
+  struct PendingPacket {
+    // Location of the payload in `pending_payloads_`.
+    size_t payload_offset;
+    size_t payload_size;
+    SocketAddress address;
+    rtc::SentPacket sent_packet;
+  };
   // Called when the underlying socket is ready to send.
   void OnWriteEvent(Socket* socket);
 
   RTC_NO_UNIQUE_ADDRESS webrtc::SequenceChecker sequence_checker_;
   std::unique_ptr<Socket> socket_;
   rtc::Buffer buffer_ RTC_GUARDED_BY(sequence_checker_);
+  // Empty unless batched receive is enabled.
+  std::vector<rtc::Buffer> batch_buffers_ RTC_GUARDED_BY(sequence_checker_);
+  // Storage of `head_` and `batch_heads_`. The heads are released by the
+  // receivers of the packets, often on other threads.
+  webrtc::BufferPool head_pool_;
+  // Receive the start of datagrams when zero-copy receive is enabled, and are
+  // handed over to the receivers of the packets. One per read buffer.
+  rtc::Buffer head_ RTC_GUARDED_BY(sequence_checker_);
+  std::vector<rtc::Buffer> batch_heads_ RTC_GUARDED_BY(sequence_checker_);
+  // Refer to `batch_buffers_` and `batch_heads_`, and are reused for every
+  // batched read.
+  std::vector<Socket::ReceiveBuffer> batch_receive_buffers_
+      RTC_GUARDED_BY(sequence_checker_);
+  const bool send_batching_enabled_;
+  const bool zero_copy_receive_enabled_;
+  // Batchable packets waiting for the last packet of their batch, or for the
+  // socket to become writable.
+  std::vector<PendingPacket> pending_packets_
+      RTC_GUARDED_BY(sequence_checker_);
+  // The payloads of `pending_packets_`, back to back. Keeps its capacity, so
+  // that queuing a packet doesn't allocate once the socket is warmed up.
+  rtc::Buffer pending_payloads_ RTC_GUARDED_BY(sequence_checker_);
+  // Refer to `pending_payloads_`, and are reused for every flush.
+  std::vector<Socket::SendBuffer> send_buffers_
+      RTC_GUARDED_BY(sequence_checker_);
+  bool write_blocked_ RTC_GUARDED_BY(sequence_checker_) = false;
   absl::optional<webrtc::TimeDelta> socket_time_offset_
       RTC_GUARDED_BY(sequence_checker_);
+  webrtc::ScopedTaskSafetyDetached task_safety_;
 };
 
 }  // namespace rtc
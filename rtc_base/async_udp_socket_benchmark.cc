@@ -0,0 +1,89 @@
+/*
+ *  Copyright 2024 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <stdint.h>
+
+#include <memory>
+
+#include "api/units/time_delta.h"
+#include "benchmark/benchmark.h"
+#include "rtc_base/async_udp_socket.h"
+#include "rtc_base/copy_on_write_buffer.h"
+#include "rtc_base/network/received_packet.h"
+#include "rtc_base/physical_socket_server.h"
+#include "rtc_base/socket_address.h"
+#include "rtc_base/system/unused.h"
+#include "rtc_base/thread.h"
+#include "test/field_trial.h"
+
+namespace rtc {
+namespace {
+
+constexpr size_t kPacketSize = 1200;
+
+// Sends datagrams over loopback to an AsyncUDPSocket, whose receiver takes
+// the payload of each packet, as RtpTransport does. If `kModifyInPlace` is
+// set, the receiver then modifies the payload in place, as SrtpTransport does
+// when unprotecting RTP packets, which copies it while the packet delivered
+// by the socket still refers to it. Reports how many bytes are copied per
+// packet after the datagram has been read from the socket.
+template <bool kZeroCopy, bool kModifyInPlace>
+void BM_ReceivePayload(benchmark::State& state) {
+  webrtc::test::ScopedFieldTrials field_trials(
+      kZeroCopy ? "WebRTC-UdpZeroCopyReceive/Enabled/" : "");
+  PhysicalSocketServer socket_server;
+  AutoSocketServerThread thread(&socket_server);
+  std::unique_ptr<AsyncUDPSocket> receiver(
+      AsyncUDPSocket::Create(&socket_server, SocketAddress("127.0.0.1", 0)));
+  std::unique_ptr<Socket> sender(
+      socket_server.CreateSocket(AF_INET, SOCK_DGRAM));
+  sender->Bind(SocketAddress("127.0.0.1", 0));
+
+  int64_t packets = 0;
+  int64_t bytes_copied = 0;
+  receiver->RegisterReceivedPacketCallback(
+      [&](AsyncPacketSocket* socket, const ReceivedPacket& packet) {
+        const uint8_t* received = packet.payload().data();
+        CopyOnWriteBuffer payload = ReceivedPacket(packet).TakePayload();
+        const uint8_t* data = payload.cdata();
+        if (kModifyInPlace) {
+          uint8_t* mutable_data = payload.MutableData();
+          mutable_data[0] ^= 1;
+          data = mutable_data;
+        }
+        if (data != received) {
+          bytes_copied += payload.size();
+        }
+        ++packets;
+        // Ends the Wait() below.
+        socket_server.WakeUp();
+      });
+
+  const uint8_t packet[kPacketSize] = {};
+  for (auto s : state) {
+    RTC_UNUSED(s);
+    const int64_t sent = packets + 1;
+    sender->SendTo(packet, kPacketSize, receiver->GetLocalAddress());
+    while (packets < sent) {
+      socket_server.Wait(webrtc::TimeDelta::Millis(100), /*process_io=*/true);
+    }
+  }
+  state.SetItemsProcessed(packets);
+  state.counters["bytes_copied_per_packet"] =
+      packets > 0 ? static_cast<double>(bytes_copied) / packets : 0;
+}
+
+BENCHMARK_TEMPLATE(BM_ReceivePayload, false, false);
+BENCHMARK_TEMPLATE(BM_ReceivePayload, true, false);
+BENCHMARK_TEMPLATE(BM_ReceivePayload, false, true);
+BENCHMARK_TEMPLATE(BM_ReceivePayload, true, true);
+
+}  // namespace
+}  // namespace rtc
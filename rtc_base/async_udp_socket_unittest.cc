@@ -10,21 +10,32 @@
 
 #include "rtc_base/async_udp_socket.h"
 
+#include <algorithm>
+#include <cstdint>
+#include <limits>
 #include <memory>
 #include <string>
+#include <vector>
 
+#include "api/array_view.h"
+#include "rtc_base/async_socket.h"
 #include "rtc_base/gunit.h"
+#include "rtc_base/memory/buffer_pool.h"
+#include "rtc_base/network/received_packet.h"
+#include "rtc_base/network/sent_packet.h"
 #include "rtc_base/physical_socket_server.h"
+#include "rtc_base/thread.h"
 #include "rtc_base/virtual_socket_server.h"
+#include "test/field_trial.h"
+#include "test/gmock.h"
 
 namespace rtc {
 
 class AsyncUdpSocketTest : public ::testing::Test, public sigslot::has_slots<> {
  public:
   AsyncUdpSocketTest()
-      : pss_(new rtc::PhysicalSocketServer),
-        vss_(new rtc::VirtualSocketServer(pss_.get())),
-        socket_(vss_->CreateSocket(SOCK_DGRAM)),
+      : vss_(new rtc::VirtualSocketServer()),
+        socket_(vss_->CreateSocket(AF_INET, SOCK_DGRAM)),
         udp_socket_(new AsyncUDPSocket(socket_)),
         ready_to_send_(false) {
     udp_socket_->SignalReadyToSend.connect(this,
@@ -34,7 +45,6 @@ class AsyncUdpSocketTest : public ::testing::Test, public sigslot::has_slots<> {
   void OnReadyToSend(rtc::AsyncPacketSocket* socket) { ready_to_send_ = true; }
 
  protected:
-  std::unique_ptr<PhysicalSocketServer> pss_;
   std::unique_ptr<VirtualSocketServer> vss_;
   Socket* socket_;
   std::unique_ptr<AsyncUDPSocket> udp_socket_;
@@ -47,4 +57,214 @@ TEST_F(AsyncUdpSocketTest, OnWriteEvent) {
   EXPECT_TRUE(ready_to_send_);
 }
 
+// Records the datagrams passed to SendToBatch, and can be made to block or to
+// fail.
+class FakeBatchSocket : public AsyncSocketAdapter {
+ public:
+  using AsyncSocketAdapter::AsyncSocketAdapter;
+
+  int SendToBatch(ArrayView<const SendBuffer> buffers) override {
+    if (fail_next_) {
+      fail_next_ = false;
+      SetError(EHOSTUNREACH);
+      return -1;
+    }
+    if (writable_ == 0) {
+      SetError(EWOULDBLOCK);
+      return -1;
+    }
+    size_t count = std::min(buffers.size(), writable_);
+    for (size_t i = 0; i < count; ++i) {
+      sent_.emplace_back(reinterpret_cast<const char*>(buffers[i].payload.data()),
+                         buffers[i].payload.size());
+    }
+    writable_ -= count;
+    return static_cast<int>(count);
+  }
+
+  // Number of datagrams that can be sent before the socket blocks.
+  size_t writable_ = std::numeric_limits<size_t>::max();
+  bool fail_next_ = false;
+  std::vector<std::string> sent_;
+};
+
+class AsyncUdpSocketBatchSendTest : public ::testing::Test,
+                                    public sigslot::has_slots<> {
+ public:
+  AsyncUdpSocketBatchSendTest()
+      : field_trials_("WebRTC-UdpBatchSend/Enabled/"),
+        thread_(&vss_),
+        socket_(new FakeBatchSocket(vss_.CreateSocket(AF_INET, SOCK_DGRAM))),
+        udp_socket_(new AsyncUDPSocket(socket_)) {
+    udp_socket_->SignalSentPacket.connect(
+        this, &AsyncUdpSocketBatchSendTest::OnSentPacket);
+  }
+
+  void OnSentPacket(AsyncPacketSocket* socket, const SentPacket& packet) {
+    signaled_ids_.push_back(packet.packet_id);
+  }
+
+  int Send(const std::string& payload, bool last_packet_in_batch) {
+    PacketOptions options;
+    options.packet_id = next_packet_id_++;
+    options.batchable = true;
+    options.last_packet_in_batch = last_packet_in_batch;
+    return udp_socket_->SendTo(payload.data(), payload.size(), kDestination,
+                               options);
+  }
+
+ protected:
+  const SocketAddress kDestination = SocketAddress("1.2.3.4", 5678);
+  webrtc::test::ScopedFieldTrials field_trials_;
+  VirtualSocketServer vss_;
+  AutoSocketServerThread thread_;
+  FakeBatchSocket* socket_;
+  std::unique_ptr<AsyncUDPSocket> udp_socket_;
+  int64_t next_packet_id_ = 1;
+  std::vector<int64_t> signaled_ids_;
+};
+
+TEST_F(AsyncUdpSocketBatchSendTest, SendsBatchWithItsLastPacket) {
+  EXPECT_EQ(3, Send("foo", /*last_packet_in_batch=*/false));
+  EXPECT_EQ(3, Send("bar", /*last_packet_in_batch=*/false));
+  EXPECT_TRUE(socket_->sent_.empty());
+  EXPECT_TRUE(signaled_ids_.empty());
+
+  EXPECT_EQ(4, Send("bazz", /*last_packet_in_batch=*/true));
+  EXPECT_THAT(socket_->sent_, ::testing::ElementsAre("foo", "bar", "bazz"));
+  EXPECT_THAT(signaled_ids_, ::testing::ElementsAre(1, 2, 3));
+}
+
+TEST_F(AsyncUdpSocketBatchSendTest, SendsIncompleteBatchAtEndOfTask) {
+  Send("foo", /*last_packet_in_batch=*/false);
+  Send("bar", /*last_packet_in_batch=*/false);
+  EXPECT_TRUE(socket_->sent_.empty());
+
+  thread_.ProcessMessages(0);
+  EXPECT_THAT(socket_->sent_, ::testing::ElementsAre("foo", "bar"));
+  EXPECT_THAT(signaled_ids_, ::testing::ElementsAre(1, 2));
+}
+
+TEST_F(AsyncUdpSocketBatchSendTest, SendsRestOfBlockedBatchOnWriteEvent) {
+  socket_->writable_ = 1;
+  Send("foo", /*last_packet_in_batch=*/false);
+  Send("bar", /*last_packet_in_batch=*/false);
+  Send("bazz", /*last_packet_in_batch=*/true);
+  EXPECT_THAT(socket_->sent_, ::testing::ElementsAre("foo"));
+  EXPECT_THAT(signaled_ids_, ::testing::ElementsAre(1));
+
+  // Queued while the socket is blocked.
+  Send("qux", /*last_packet_in_batch=*/true);
+  thread_.ProcessMessages(0);
+  EXPECT_THAT(socket_->sent_, ::testing::ElementsAre("foo"));
+
+  socket_->writable_ = std::numeric_limits<size_t>::max();
+  socket_->SignalWriteEvent(socket_);
+  EXPECT_THAT(socket_->sent_,
+              ::testing::ElementsAre("foo", "bar", "bazz", "qux"));
+  EXPECT_THAT(signaled_ids_, ::testing::ElementsAre(1, 2, 3, 4));
+}
+
+TEST_F(AsyncUdpSocketBatchSendTest, DoesNotSignalPacketThatFailed) {
+  Send("foo", /*last_packet_in_batch=*/false);
+  socket_->fail_next_ = true;
+  EXPECT_EQ(-1, Send("bar", /*last_packet_in_batch=*/true));
+  // The failed packet is dropped and the rest of the batch is sent.
+  EXPECT_THAT(socket_->sent_, ::testing::ElementsAre("bar"));
+  EXPECT_THAT(signaled_ids_, ::testing::ElementsAre(2));
+}
+
+#if defined(WEBRTC_LINUX)
+class AsyncUdpSocketLoopbackTest : public ::testing::Test {
+ protected:
+  // Creates the sockets only after the field trials of the test are set.
+  void CreateSockets() {
+    receiver_socket_ = server_.CreateSocket(AF_INET, SOCK_DGRAM);
+    receiver_.reset(
+        AsyncUDPSocket::Create(receiver_socket_, SocketAddress("127.0.0.1", 0)));
+    ASSERT_TRUE(receiver_);
+    receiver_->RegisterReceivedPacketCallback(
+        [&](AsyncPacketSocket* socket, const ReceivedPacket& packet) {
+          received_.emplace_back(
+              reinterpret_cast<const char*>(packet.payload().data()),
+              packet.payload().size());
+        });
+    sender_.reset(server_.CreateSocket(AF_INET, SOCK_DGRAM));
+    ASSERT_EQ(0, sender_->Bind(SocketAddress("127.0.0.1", 0)));
+  }
+
+  void Send(const std::string& packet) {
+    ASSERT_EQ(static_cast<int>(packet.size()),
+              sender_->SendTo(packet.data(), packet.size(),
+                              receiver_->GetLocalAddress()));
+  }
+
+  PhysicalSocketServer server_;
+  Socket* receiver_socket_ = nullptr;
+  std::unique_ptr<AsyncUDPSocket> receiver_;
+  std::unique_ptr<Socket> sender_;
+  std::vector<std::string> received_;
+};
+
+TEST_F(AsyncUdpSocketLoopbackTest, BatchReceiveDeliversQueuedDatagrams) {
+  webrtc::test::ScopedFieldTrials field_trials(
+      "WebRTC-UdpBatchReceive/Enabled/");
+  CreateSockets();
+  Send("foo");
+  Send("");
+  Send("bazz");
+
+  receiver_socket_->SignalReadEvent(receiver_socket_);
+  // All datagrams are read by one read event, and the empty one is dropped
+  // like it is without batching.
+  EXPECT_THAT(received_, ::testing::ElementsAre("foo", "bazz"));
+
+  Send("bar");
+  receiver_socket_->SignalReadEvent(receiver_socket_);
+  EXPECT_THAT(received_, ::testing::ElementsAre("foo", "bazz", "bar"));
+}
+
+TEST_F(AsyncUdpSocketLoopbackTest, BatchReceiveWithZeroCopyReceive) {
+  webrtc::test::ScopedFieldTrials field_trials(
+      "WebRTC-UdpBatchReceive/Enabled/WebRTC-UdpZeroCopyReceive/Enabled/");
+  CreateSockets();
+  const std::string kLargePacket(3000, 'x');
+  Send("foo");
+  Send("");
+  Send(kLargePacket);
+
+  receiver_socket_->SignalReadEvent(receiver_socket_);
+  EXPECT_THAT(received_, ::testing::ElementsAre("foo", kLargePacket));
+}
+
+TEST_F(AsyncUdpSocketLoopbackTest, ZeroCopyReceiveReusesReleasedBuffers) {
+  if (!webrtc::BufferPool::kEnabled) {
+    GTEST_SKIP() << "Pooling is disabled in sanitizer builds.";
+  }
+  webrtc::test::ScopedFieldTrials field_trials(
+      "WebRTC-UdpZeroCopyReceive/Enabled/");
+  CreateSockets();
+  Send("foo");
+  receiver_socket_->SignalReadEvent(receiver_socket_);
+  Send("bar");
+  receiver_socket_->SignalReadEvent(receiver_socket_);
+  EXPECT_THAT(received_, ::testing::ElementsAre("foo", "bar"));
+
+  // One buffer is allocated up front and one after each read, which can
+  // reuse the buffer of the previous packet since it has been released.
+  webrtc::BufferPool::Stats stats = receiver_->GetReceiveBufferPoolStats();
+  EXPECT_EQ(stats.misses, 2u);
+  EXPECT_EQ(stats.hits, 1u);
+}
+
+TEST_F(AsyncUdpSocketLoopbackTest, SingleReceiveDropsEmptyDatagrams) {
+  CreateSockets();
+  Send("");
+  receiver_socket_->SignalReadEvent(receiver_socket_);
+  Send("foo");
+  receiver_socket_->SignalReadEvent(receiver_socket_);
+  EXPECT_THAT(received_, ::testing::ElementsAre("foo"));
+}
+#endif  // WEBRTC_LINUX
+
 }  // namespace rtc
@@ -22,6 +22,7 @@
 #include "absl/strings/string_view.h"
 #include "api/array_view.h"
 #include "rtc_base/checks.h"
+#include "rtc_base/memory/buffer_pool.h"
 #include "rtc_base/type_traits.h"
 #include "rtc_base/zero_memory.h"
 
@@ -44,6 +45,21 @@ struct BufferCompat {
            : (std::is_same<T, typename std::remove_const<U>::type>::value));
 };
 
+// (Internal; please don't use outside this file.) Releases the storage of a
+// BufferT, which may come from a webrtc::BufferPool.
+template <typename T>
+struct BufferDeleter {
+  void operator()(T* data) const {
+    if (pooled) {
+      webrtc::BufferPool::Free(data);
+    } else {
+      delete[] data;
+    }
+  }
+
+  bool pooled = false;
+};
+
 }  // namespace internal
 
 // Basic buffer class, can be grown and shrunk dynamically.
@@ -91,7 +107,20 @@ class BufferT {
   BufferT(size_t size, size_t capacity)
       : size_(size),
         capacity_(std::max(size, capacity)),
-        data_(capacity_ > 0 ? new T[capacity_] : nullptr) {
+        data_(AllocateData(capacity_)) {
+    RTC_DCHECK(IsConsistent());
+  }
+
+  // Construct a buffer with the specified number of uninitialized elements,
+  // whose storage is a block of `pool`. Growing the buffer beyond the block
+  // moves it to storage of its own.
+  BufferT(size_t size, webrtc::BufferPool& pool)
+      : size_(size),
+        capacity_(pool.block_size() / sizeof(T)),
+        data_(static_cast<T*>(pool.Allocate()),
+              internal::BufferDeleter<T>{.pooled = true}) {
+    static_assert(alignof(T) <= __STDCPP_DEFAULT_NEW_ALIGNMENT__,
+                  "T may not be over-aligned");
     RTC_DCHECK(IsConsistent());
   }
 
@@ -370,6 +399,12 @@ class BufferT {
   }
 
  private:
+  using Data = std::unique_ptr<T[], internal::BufferDeleter<T>>;
+
+  static Data AllocateData(size_t capacity) {
+    return Data(capacity > 0 ? new T[capacity] : nullptr);
+  }
+
   void EnsureCapacityWithHeadroom(size_t capacity, bool extra_headroom) {
     RTC_DCHECK(IsConsistent());
     if (capacity <= capacity_)
@@ -384,7 +419,7 @@ class BufferT {
         extra_headroom ? std::max(capacity, capacity_ + capacity_ / 2)
                        : capacity;
 
-    std::unique_ptr<T[]> new_data(new T[new_capacity]);
+    Data new_data = AllocateData(new_capacity);
     if (data_ != nullptr) {
       std::memcpy(new_data.get(), data_.get(), size_ * sizeof(T));
     }
@@ -437,7 +472,7 @@ class BufferT {
 
   size_t size_;
   size_t capacity_;
-  std::unique_ptr<T[]> data_;
+  Data data_;
 };
 
 // By far the most common sort of buffer.
@@ -12,6 +12,8 @@
 
 #include <stddef.h>
 
+#include <utility>
+
 #include "absl/strings/string_view.h"
 
 namespace rtc {
@@ -48,6 +50,14 @@ CopyOnWriteBuffer::CopyOnWriteBuffer(size_t size, size_t capacity)
   RTC_DCHECK(IsConsistent());
 }
 
+CopyOnWriteBuffer::CopyOnWriteBuffer(Buffer&& buffer)
+    : buffer_(buffer.capacity() > 0 ? new RefCountedBuffer(std::move(buffer))
+                                    : nullptr),
+      offset_(0),
+      size_(buffer_ ? buffer_->size() : 0) {
+  RTC_DCHECK(IsConsistent());
+}
+
 CopyOnWriteBuffer::~CopyOnWriteBuffer() = default;
 
 bool CopyOnWriteBuffer::operator==(const CopyOnWriteBuffer& buf) const {
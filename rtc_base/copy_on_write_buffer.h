@@ -45,6 +45,9 @@ class RTC_EXPORT CopyOnWriteBuffer {
   explicit CopyOnWriteBuffer(size_t size);
   CopyOnWriteBuffer(size_t size, size_t capacity);
 
+  // Take over the contents of `buffer` without copying them.
+  explicit CopyOnWriteBuffer(Buffer&& buffer);
+
   // Construct a buffer and copy the specified number of bytes into it. The
   // source array may be (const) uint8_t*, int8_t*, or char*.
   template <typename T,
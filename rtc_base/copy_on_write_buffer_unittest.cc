@@ -79,6 +79,18 @@ TEST(CopyOnWriteBufferTest, TestMoveConstruct) {
   EXPECT_EQ(buf2.data(), buf1_data);
 }
 
+TEST(CopyOnWriteBufferTest, TakesOverBufferWithoutCopying) {
+  Buffer buffer(kTestData, 3, 10);
+  const uint8_t* data = buffer.data();
+  CopyOnWriteBuffer buf(std::move(buffer));
+  EXPECT_EQ(buf.size(), 3u);
+  EXPECT_EQ(buf.capacity(), 10u);
+  EXPECT_EQ(buf.cdata(), data);
+  EXPECT_EQ(0, memcmp(buf.cdata(), kTestData, 3));
+  // The buffer is not shared, so it can be written to in place.
+  EXPECT_EQ(buf.MutableData(), data);
+}
+
 TEST(CopyOnWriteBufferTest, TestMoveAssign) {
   CopyOnWriteBuffer buf1(kTestData, 3, 10);
   size_t buf1_size = buf1.size();
@@ -0,0 +1,114 @@
+/*
+ *  Copyright 2024 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "rtc_base/memory/buffer_pool.h"
+
+#include <algorithm>
+#include <atomic>
+#include <new>
+
+#include "rtc_base/checks.h"
+
+namespace webrtc {
+namespace {
+
+// Precedes every block, padded so that blocks stay aligned as by operator new.
+struct alignas(__STDCPP_DEFAULT_NEW_ALIGNMENT__) BlockHeader {
+  void* shared;
+};
+
+BlockHeader* HeaderOf(void* block) {
+  return static_cast<BlockHeader*>(block) - 1;
+}
+
+}  // namespace
+
+// Released blocks form a singly linked list through their first bytes.
+struct BufferPool::FreeBlock {
+  FreeBlock* next;
+};
+
+// Outlives the pool for as long as any of its blocks is in use.
+struct BufferPool::SharedState {
+  // Marks `released` once the pool is destroyed. Never the address of a block.
+  static FreeBlock* Closed() {
+    return reinterpret_cast<FreeBlock*>(alignof(BlockHeader));
+  }
+
+  static void DeleteBlocks(FreeBlock* block) {
+    while (block != nullptr) {
+      FreeBlock* next = block->next;
+      ::operator delete(HeaderOf(block));
+      block = next;
+    }
+  }
+
+  void Release() {
+    if (ref_count.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+      delete this;
+    }
+  }
+
+  // One for the pool and one for each block in use.
+  std::atomic<size_t> ref_count{1};
+  // Blocks released since the owner last took them over, or Closed().
+  std::atomic<FreeBlock*> released{nullptr};
+};
+
+BufferPool::BufferPool(size_t block_size)
+    : block_size_(std::max(block_size, sizeof(FreeBlock))),
+      shared_(new SharedState) {}
+
+BufferPool::~BufferPool() {
+  SharedState::DeleteBlocks(free_blocks_);
+  SharedState::DeleteBlocks(shared_->released.exchange(
+      SharedState::Closed(), std::memory_order_acquire));
+  shared_->Release();
+}
+
+void* BufferPool::Allocate() {
+  shared_->ref_count.fetch_add(1, std::memory_order_relaxed);
+  if (free_blocks_ == nullptr) {
+    free_blocks_ =
+        shared_->released.exchange(nullptr, std::memory_order_acquire);
+  }
+  if (FreeBlock* block = free_blocks_) {
+    free_blocks_ = block->next;
+    ++stats_.hits;
+    return block;
+  }
+  ++stats_.misses;
+  BlockHeader* header = static_cast<BlockHeader*>(
+      ::operator new(sizeof(BlockHeader) + block_size_));
+  header->shared = shared_;
+  return header + 1;
+}
+
+void BufferPool::Free(void* block) {
+  RTC_DCHECK(block);
+  SharedState* shared = static_cast<SharedState*>(HeaderOf(block)->shared);
+  FreeBlock* head = shared->released.load(std::memory_order_relaxed);
+  bool returned = false;
+  while (kEnabled && head != SharedState::Closed()) {
+    FreeBlock* free_block = new (block) FreeBlock{.next = head};
+    if (shared->released.compare_exchange_weak(head, free_block,
+                                               std::memory_order_release,
+                                               std::memory_order_relaxed)) {
+      returned = true;
+      break;
+    }
+  }
+  if (!returned) {
+    ::operator delete(HeaderOf(block));
+  }
+  shared->Release();
+}
+
+}  // namespace webrtc
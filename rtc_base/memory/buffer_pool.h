@@ -0,0 +1,76 @@
+/*
+ *  Copyright 2024 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef RTC_BASE_MEMORY_BUFFER_POOL_H_
+#define RTC_BASE_MEMORY_BUFFER_POOL_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "rtc_base/sanitizer.h"
+#include "rtc_base/system/rtc_export.h"
+
+namespace webrtc {
+
+// Pool of memory blocks of a fixed size, for rtc::Buffers that are allocated
+// on one thread and released on others, as received packets are: they are
+// read on the network thread and released wherever they are last used, which
+// defeats the thread caches of the allocator.
+//
+// Blocks are allocated on the sequence that owns the pool. A block released on
+// any thread is returned to its pool through a lock-free list, from which the
+// owner takes it for later allocations. The pool thus keeps as many blocks as
+// were in use at once, until it is destroyed. Blocks that are still in use
+// when the pool is destroyed are deleted when they are released.
+//
+// Blocks are not reused in builds with AddressSanitizer or MemorySanitizer,
+// so that they keep detecting use of freed memory.
+class RTC_EXPORT BufferPool {
+ public:
+  static constexpr bool kEnabled = !RTC_HAS_ASAN && !RTC_HAS_MSAN;
+
+  struct Stats {
+    // Allocations that reused a released block.
+    uint64_t hits = 0;
+    // Allocations that had to call operator new.
+    uint64_t misses = 0;
+  };
+
+  explicit BufferPool(size_t block_size);
+  ~BufferPool();
+
+  BufferPool(const BufferPool&) = delete;
+  BufferPool& operator=(const BufferPool&) = delete;
+
+  size_t block_size() const { return block_size_; }
+
+  // Returns a block of block_size() bytes, aligned as by operator new.
+  void* Allocate();
+
+  // Releases `block`, which must have been returned by Allocate() of any pool.
+  // May be called on any thread.
+  static void Free(void* block);
+
+  Stats GetStats() const { return stats_; }
+
+ private:
+  struct FreeBlock;
+  struct SharedState;
+
+  const size_t block_size_;
+  SharedState* const shared_;
+  // Blocks taken over from `shared_`, used only by the owner.
+  FreeBlock* free_blocks_ = nullptr;
+  Stats stats_;
+};
+
+}  // namespace webrtc
+
+#endif  // RTC_BASE_MEMORY_BUFFER_POOL_H_
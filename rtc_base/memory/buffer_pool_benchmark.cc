@@ -0,0 +1,62 @@
+/*
+ *  Copyright 2024 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <stddef.h>
+
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+#include "rtc_base/buffer.h"
+#include "rtc_base/memory/buffer_pool.h"
+#include "rtc_base/system/unused.h"
+#include "rtc_base/thread.h"
+
+namespace webrtc {
+namespace {
+
+constexpr size_t kPacketSize = 1500;
+constexpr int kPacketsPerBatch = 32;
+
+// Allocates buffers for received packets on the benchmark thread and releases
+// them on another thread, as packets read on the network thread are released
+// after decoding.
+template <bool kPooled>
+void BM_AllocateHereReleaseElsewhere(benchmark::State& state) {
+  std::unique_ptr<rtc::Thread> releasing_thread = rtc::Thread::Create();
+  releasing_thread->Start();
+  BufferPool pool(kPacketSize);
+  for (auto s : state) {
+    RTC_UNUSED(s);
+    std::vector<rtc::Buffer> packets;
+    packets.reserve(kPacketsPerBatch);
+    for (int i = 0; i < kPacketsPerBatch; ++i) {
+      rtc::Buffer& packet = kPooled ? packets.emplace_back(0, pool)
+                                    : packets.emplace_back(0, kPacketSize);
+      packet.SetSize(kPacketSize);
+      packet[0] = static_cast<uint8_t>(i);
+    }
+    releasing_thread->PostTask([packets = std::move(packets)] {});
+  }
+  releasing_thread->BlockingCall([] {});
+  state.SetItemsProcessed(state.iterations() * kPacketsPerBatch);
+  if (kPooled) {
+    const BufferPool::Stats stats = pool.GetStats();
+    state.counters["hit_rate"] =
+        static_cast<double>(stats.hits) / (stats.hits + stats.misses);
+  }
+}
+
+BENCHMARK_TEMPLATE(BM_AllocateHereReleaseElsewhere, false);
+BENCHMARK_TEMPLATE(BM_AllocateHereReleaseElsewhere, true);
+
+}  // namespace
+}  // namespace webrtc
@@ -0,0 +1,99 @@
+/*
+ *  Copyright 2024 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "rtc_base/memory/buffer_pool.h"
+
+#include <memory>
+#include <utility>
+
+#include "rtc_base/buffer.h"
+#include "rtc_base/platform_thread.h"
+#include "test/gtest.h"
+
+namespace webrtc {
+namespace {
+
+constexpr size_t kBlockSize = 1500;
+
+TEST(BufferPoolTest, ReusesReleasedBlock) {
+  if (!BufferPool::kEnabled) {
+    GTEST_SKIP() << "Pooling is disabled in sanitizer builds.";
+  }
+  BufferPool pool(kBlockSize);
+  void* block = pool.Allocate();
+  BufferPool::Free(block);
+  EXPECT_EQ(pool.Allocate(), block);
+  BufferPool::Free(block);
+
+  EXPECT_EQ(pool.GetStats().misses, 1u);
+  EXPECT_EQ(pool.GetStats().hits, 1u);
+}
+
+TEST(BufferPoolTest, ReusesBlockReleasedOnOtherThread) {
+  if (!BufferPool::kEnabled) {
+    GTEST_SKIP() << "Pooling is disabled in sanitizer builds.";
+  }
+  BufferPool pool(kBlockSize);
+  void* block = pool.Allocate();
+  rtc::PlatformThread::SpawnJoinable([block] { BufferPool::Free(block); },
+                                     "Releasing thread");
+  EXPECT_EQ(pool.Allocate(), block);
+  BufferPool::Free(block);
+  EXPECT_EQ(pool.GetStats().hits, 1u);
+}
+
+TEST(BufferPoolTest, DoesNotShareBlocksBetweenPools) {
+  BufferPool pool1(kBlockSize);
+  BufferPool pool2(kBlockSize);
+  BufferPool::Free(pool1.Allocate());
+  BufferPool::Free(pool2.Allocate());
+  EXPECT_EQ(pool2.GetStats().hits, 0u);
+}
+
+TEST(BufferPoolTest, BlocksMayOutliveThePool) {
+  auto pool = std::make_unique<BufferPool>(kBlockSize);
+  void* block = pool->Allocate();
+  BufferPool::Free(pool->Allocate());
+  pool = nullptr;
+  // Deleted rather than returned to the destroyed pool.
+  BufferPool::Free(block);
+}
+
+TEST(BufferPoolTest, BufferUsesBlockOfPool) {
+  if (!BufferPool::kEnabled) {
+    GTEST_SKIP() << "Pooling is disabled in sanitizer builds.";
+  }
+  BufferPool pool(kBlockSize);
+  const uint8_t* data;
+  {
+    rtc::Buffer buffer(100, pool);
+    EXPECT_EQ(buffer.size(), 100u);
+    EXPECT_EQ(buffer.capacity(), kBlockSize);
+    data = buffer.data();
+  }
+  rtc::Buffer buffer(0, pool);
+  EXPECT_EQ(buffer.data(), data);
+  EXPECT_EQ(pool.GetStats().hits, 1u);
+}
+
+TEST(BufferPoolTest, GrownBufferReleasesBlock) {
+  BufferPool pool(kBlockSize);
+  rtc::Buffer buffer(kBlockSize, pool);
+  buffer[0] = 7;
+  buffer.AppendData(uint8_t{1});
+  EXPECT_EQ(buffer.size(), kBlockSize + 1);
+  EXPECT_EQ(buffer[0], 7);
+
+  rtc::Buffer other(0, pool);
+  EXPECT_EQ(pool.GetStats().hits, BufferPool::kEnabled ? 1u : 0u);
+}
+
+}  // namespace
+}  // namespace webrtc
@@ -13,6 +13,7 @@
 #include <utility>
 
 #include "absl/types/optional.h"
+#include "rtc_base/copy_on_write_buffer.h"
 #include "rtc_base/socket_address.h"
 
 namespace rtc {
@@ -30,8 +31,18 @@ ReceivedPacket::ReceivedPacket(rtc::ArrayView<const uint8_t> payload,
 
 ReceivedPacket ReceivedPacket::CopyAndSet(
     DecryptionInfo decryption_info) const {
-  return ReceivedPacket(payload_, source_address_, arrival_time_, ecn_,
+  ReceivedPacket packet(payload_, source_address_, arrival_time_, ecn_,
                         decryption_info);
+  packet.payload_buffer_ = payload_buffer_;
+  return packet;
+}
+
+rtc::CopyOnWriteBuffer ReceivedPacket::TakePayload() && {
+  if (payload_buffer_.size() == payload_.size() &&
+      payload_buffer_.cdata() == payload_.data()) {
+    return std::move(payload_buffer_);
+  }
+  return rtc::CopyOnWriteBuffer(payload_);
 }
 
 // static
@@ -48,4 +59,17 @@ ReceivedPacket ReceivedPacket::CreateFromLegacy(
                             : absl::nullopt);
 }
 
+// static
+ReceivedPacket ReceivedPacket::CreateFromBuffer(
+    rtc::CopyOnWriteBuffer payload_buffer,
+    const SocketAddress& source_address,
+    absl::optional<webrtc::Timestamp> arrival_time,
+    EcnMarking ecn) {
+  ReceivedPacket packet(
+      rtc::MakeArrayView(payload_buffer.cdata(), payload_buffer.size()),
+      source_address, std::move(arrival_time), ecn);
+  packet.payload_buffer_ = std::move(payload_buffer);
+  return packet;
+}
+
 }  // namespace rtc
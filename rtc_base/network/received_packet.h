@@ -15,6 +15,7 @@
 #include "absl/types/optional.h"
 #include "api/array_view.h"
 #include "api/units/timestamp.h"
+#include "rtc_base/copy_on_write_buffer.h"
 #include "rtc_base/network/ecn_marking.h"
 #include "rtc_base/socket_address.h"
 #include "rtc_base/system/rtc_export.h"
@@ -48,6 +49,13 @@ class RTC_EXPORT ReceivedPacket {
   const SocketAddress& source_address() const { return source_address_; }
   rtc::ArrayView<const uint8_t> payload() const { return payload_; }
 
+  // Returns the payload in a buffer. If the packet holds a buffer, the
+  // returned buffer refers to it without copying the payload. Since other
+  // copies of the packet may still refer to it too, modifying the returned
+  // buffer copies the payload unless this packet held the last reference:
+  //   rtc::CopyOnWriteBuffer payload = std::move(packet).TakePayload();
+  rtc::CopyOnWriteBuffer TakePayload() &&;
+
   // Timestamp when this packet was received. Not available on all socket
   // implementations.
   absl::optional<webrtc::Timestamp> arrival_time() const {
@@ -74,8 +82,19 @@ class RTC_EXPORT ReceivedPacket {
       int64_t packet_time_us,
       const rtc::SocketAddress& = rtc::SocketAddress());
 
+  // Creates a packet that holds a reference to `payload_buffer`. Copies of the
+  // packet share the buffer, which stays valid as long as any of them does.
+  // Caller must keep address valid for the lifetime of this ReceivedPacket.
+  static ReceivedPacket CreateFromBuffer(
+      rtc::CopyOnWriteBuffer payload_buffer,
+      const SocketAddress& source_address,
+      absl::optional<webrtc::Timestamp> arrival_time = absl::nullopt,
+      EcnMarking ecn = EcnMarking::kNotEct);
+
  private:
   rtc::ArrayView<const uint8_t> payload_;
+  // Holds `payload_` if the packet was created from a buffer, empty otherwise.
+  rtc::CopyOnWriteBuffer payload_buffer_;
   absl::optional<webrtc::Timestamp> arrival_time_;
   const SocketAddress& source_address_;
   EcnMarking ecn_;
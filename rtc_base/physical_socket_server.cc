@@ -9,6 +9,7 @@
  */
 #include "rtc_base/physical_socket_server.h"
 
+#include <algorithm>
 #include <cstdint>
 #include <utility>
 
@@ -134,6 +135,30 @@ rtc::EcnMarking EcnFromDs(uint8_t ds) {
   return rtc::EcnMarking::kNotEct;
 }
 
+// Extracts the receive timestamp and ECN marking from the ancillary data of a
+// message received with recvmsg() or recvmmsg().
+void ParseControlMessages(msghdr& msg,
+                          int64_t* timestamp,
+                          rtc::EcnMarking* ecn) {
+  struct cmsghdr* cmsg;
+  for (cmsg = CMSG_FIRSTHDR(&msg); cmsg; cmsg = CMSG_NXTHDR(&msg, cmsg)) {
+    if (ecn) {
+      if ((cmsg->cmsg_type == IPV6_TCLASS &&
+           cmsg->cmsg_level == IPPROTO_IPV6) ||
+          (cmsg->cmsg_type == IP_TOS && cmsg->cmsg_level == IPPROTO_IP)) {
+        *ecn = EcnFromDs(CMSG_DATA(cmsg)[0]);
+      }
+    }
+    if (cmsg->cmsg_level != SOL_SOCKET)
+      continue;
+    if (timestamp && cmsg->cmsg_type == SCM_TIMESTAMP) {
+      timeval* ts = reinterpret_cast<timeval*>(CMSG_DATA(cmsg));
+      *timestamp = rtc::kNumMicrosecsPerSec * static_cast<int64_t>(ts->tv_sec) +
+                   static_cast<int64_t>(ts->tv_usec);
+    }
+  }
+}
+
 #endif
 
 class ScopedSetTrue {
@@ -152,6 +177,16 @@ class ScopedSetTrue {
 
 namespace rtc {
 
+#if defined(WEBRTC_LINUX)
+struct PhysicalSocket::SendBatchScratch {
+  // Bounds the number of datagrams per sendmmsg() call.
+  static constexpr size_t kMaxBatchSize = 32;
+  mmsghdr msgs[kMaxBatchSize];
+  iovec iovs[kMaxBatchSize];
+  sockaddr_storage addrs[kMaxBatchSize];
+};
+#endif  // WEBRTC_LINUX
+
 PhysicalSocket::PhysicalSocket(PhysicalSocketServer* ss, SOCKET s)
     : ss_(ss),
       s_(s),
@@ -436,6 +471,62 @@ int PhysicalSocket::SendTo(const void* buffer,
   return sent;
 }
 
+#if defined(WEBRTC_LINUX)
+int PhysicalSocket::SendToBatch(ArrayView<const SendBuffer> buffers) {
+  if (!udp_ || buffers.size() == 1) {
+    return Socket::SendToBatch(buffers);
+  }
+  if (!send_batch_scratch_) {
+    send_batch_scratch_ = std::make_unique<SendBatchScratch>();
+  }
+  static constexpr size_t kMaxBatchSize = SendBatchScratch::kMaxBatchSize;
+  mmsghdr* msgs = send_batch_scratch_->msgs;
+  iovec* iovs = send_batch_scratch_->iovs;
+  sockaddr_storage* addrs = send_batch_scratch_->addrs;
+  size_t total_sent = 0;
+  while (total_sent < buffers.size()) {
+    const size_t batch_size =
+        std::min(buffers.size() - total_sent, kMaxBatchSize);
+    for (size_t i = 0; i < batch_size; ++i) {
+      msgs[i] = {};
+      const SendBuffer& buffer = buffers[total_sent + i];
+      iovs[i] = {.iov_base = const_cast<uint8_t*>(buffer.payload.data()),
+                 .iov_len = buffer.payload.size()};
+      msghdr& msg = msgs[i].msg_hdr;
+      msg.msg_iov = &iovs[i];
+      msg.msg_iovlen = 1;
+      msg.msg_name = &addrs[i];
+      msg.msg_namelen = static_cast<socklen_t>(
+          buffer.destination.ToSockAddrStorage(&addrs[i]));
+    }
+    int sent = ::sendmmsg(s_, msgs, batch_size,
+#if !defined(WEBRTC_ANDROID)
+                          // Suppress SIGPIPE. See Send() for explanation.
+                          MSG_NOSIGNAL
+#else
+                          0
+#endif
+    );
+    if (sent < 0) {
+      UpdateLastError();
+      MaybeRemapSendError();
+      if (IsBlockingError(GetError())) {
+        EnableEvents(DE_WRITE);
+      }
+      return total_sent > 0 ? static_cast<int>(total_sent) : sent;
+    }
+    total_sent += sent;
+    if (static_cast<size_t>(sent) < batch_size) {
+      // The kernel stopped early, typically because the send buffer is full.
+      // The error for the first unsent datagram is reported on the next call.
+      EnableEvents(DE_WRITE);
+      break;
+    }
+  }
+  return static_cast<int>(total_sent);
+}
+#endif  // WEBRTC_LINUX
+
 int PhysicalSocket::Recv(void* buffer, size_t length, int64_t* timestamp) {
   int received = DoReadFromSocket(buffer, length, /*out_addr*/ nullptr,
                                   timestamp, /*ecn=*/nullptr);
@@ -485,11 +576,18 @@ int PhysicalSocket::RecvFrom(ReceiveBuffer& buffer) {
   int64_t timestamp = -1;
   static constexpr int BUF_SIZE = 64 * 1024;
   buffer.payload.EnsureCapacity(BUF_SIZE);
+#if defined(WEBRTC_POSIX)
+  Buffer* head = buffer.head;
+#else
+  // Scattered reads need recvmsg().
+  Buffer* head = nullptr;
+#endif
 
   int received = DoReadFromSocket(
       buffer.payload.data(), buffer.payload.capacity(), &buffer.source_address,
-      &timestamp, ecn_ ? &buffer.ecn : nullptr);
-  buffer.payload.SetSize(received > 0 ? received : 0);
+      &timestamp, ecn_ ? &buffer.ecn : nullptr, head);
+  const size_t head_size = head ? head->size() : 0;
+  buffer.payload.SetSize(received > 0 ? received - head_size : 0);
   if (received > 0 && timestamp != -1) {
     buffer.arrival_time = webrtc::Timestamp::Micros(timestamp);
   }
@@ -505,19 +603,94 @@ int PhysicalSocket::RecvFrom(ReceiveBuffer& buffer) {
   return received;
 }
 
+#if defined(WEBRTC_LINUX)
+int PhysicalSocket::RecvFromBatch(ArrayView<ReceiveBuffer> buffers) {
+  if (!udp_ || buffers.size() == 1) {
+    return Socket::RecvFromBatch(buffers);
+  }
+  static constexpr int BUF_SIZE = 64 * 1024;
+  // Bounds the amount of stack used for message headers and ancillary data.
+  static constexpr size_t kMaxBatchSize = 32;
+  static constexpr size_t kControlSize =
+      CMSG_SPACE(sizeof(struct timeval) + 5 * sizeof(int));
+  const size_t batch_size = std::min(buffers.size(), kMaxBatchSize);
+
+  mmsghdr msgs[kMaxBatchSize] = {};
+  // The optional head buffer, followed by the payload buffer.
+  iovec iovs[kMaxBatchSize][2];
+  sockaddr_storage addrs[kMaxBatchSize];
+  char control[kMaxBatchSize][kControlSize];
+  for (size_t i = 0; i < batch_size; ++i) {
+    ReceiveBuffer& buffer = buffers[i];
+    buffer.payload.EnsureCapacity(BUF_SIZE);
+    size_t num_iovs = 0;
+    if (buffer.head) {
+      iovs[i][num_iovs++] = {.iov_base = buffer.head->data(),
+                             .iov_len = buffer.head->capacity()};
+    }
+    iovs[i][num_iovs++] = {.iov_base = buffer.payload.data(),
+                           .iov_len = buffer.payload.capacity()};
+    msghdr& msg = msgs[i].msg_hdr;
+    msg.msg_iov = iovs[i];
+    msg.msg_iovlen = num_iovs;
+    msg.msg_name = &addrs[i];
+    msg.msg_namelen = sizeof(addrs[i]);
+    msg.msg_control = control[i];
+    msg.msg_controllen = kControlSize;
+  }
+
+  int received = ::recvmmsg(s_, msgs, batch_size, 0, nullptr);
+  for (int i = 0; i < std::max(received, 0); ++i) {
+    ReceiveBuffer& buffer = buffers[i];
+    int64_t timestamp = -1;
+    ParseControlMessages(msgs[i].msg_hdr, &timestamp,
+                         ecn_ ? &buffer.ecn : nullptr);
+    size_t payload_size = msgs[i].msg_len;
+    if (buffer.head) {
+      buffer.head->SetSize(std::min(payload_size, buffer.head->capacity()));
+      payload_size -= buffer.head->size();
+    }
+    buffer.payload.SetSize(payload_size);
+    if (timestamp != -1) {
+      buffer.arrival_time = webrtc::Timestamp::Micros(timestamp);
+    }
+    SocketAddressFromSockAddrStorage(addrs[i], &buffer.source_address);
+  }
+
+  UpdateLastError();
+  int error = GetError();
+  bool success = (received >= 0) || IsBlockingError(error);
+  // Always re-enable reads for UDP, even if an error occurred.
+  EnableEvents(DE_READ);
+  if (!success) {
+    RTC_LOG_F(LS_VERBOSE) << "Error = " << error;
+  }
+  return received;
+}
+#endif  // WEBRTC_LINUX
+
 int PhysicalSocket::DoReadFromSocket(void* buffer,
                                      size_t length,
                                      SocketAddress* out_addr,
                                      int64_t* timestamp,
-                                     EcnMarking* ecn) {
+                                     EcnMarking* ecn,
+                                     Buffer* head) {
   sockaddr_storage addr_storage;
   socklen_t addr_len = sizeof(addr_storage);
   sockaddr* addr = reinterpret_cast<sockaddr*>(&addr_storage);
 
 #if defined(WEBRTC_POSIX)
   int received = 0;
-  iovec iov = {.iov_base = buffer, .iov_len = length};
-  msghdr msg = {.msg_iov = &iov, .msg_iovlen = 1};
+  // The optional head buffer, followed by `buffer`.
+  iovec iovs[2];
+  size_t num_iovs = 0;
+  if (head) {
+    head->SetSize(0);
+    iovs[num_iovs++] = {.iov_base = head->data(),
+                        .iov_len = head->capacity()};
+  }
+  iovs[num_iovs++] = {.iov_base = buffer, .iov_len = length};
+  msghdr msg = {.msg_iov = iovs, .msg_iovlen = num_iovs};
   if (out_addr) {
     out_addr->Clear();
     msg.msg_name = addr;
@@ -536,25 +709,11 @@ int PhysicalSocket::DoReadFromSocket(void* buffer,
       // An error occured or shut down.
       return received;
     }
+    if (head) {
+      head->SetSize(std::min(static_cast<size_t>(received), head->capacity()));
+    }
     if (timestamp || ecn) {
-      struct cmsghdr* cmsg;
-      for (cmsg = CMSG_FIRSTHDR(&msg); cmsg; cmsg = CMSG_NXTHDR(&msg, cmsg)) {
-        if (ecn) {
-          if ((cmsg->cmsg_type == IPV6_TCLASS &&
-               cmsg->cmsg_level == IPPROTO_IPV6) ||
-              (cmsg->cmsg_type == IP_TOS && cmsg->cmsg_level == IPPROTO_IP)) {
-            *ecn = EcnFromDs(CMSG_DATA(cmsg)[0]);
-          }
-        }
-        if (cmsg->cmsg_level != SOL_SOCKET)
-          continue;
-        if (timestamp && cmsg->cmsg_type == SCM_TIMESTAMP) {
-          timeval* ts = reinterpret_cast<timeval*>(CMSG_DATA(cmsg));
-          *timestamp =
-              rtc::kNumMicrosecsPerSec * static_cast<int64_t>(ts->tv_sec) +
-              static_cast<int64_t>(ts->tv_usec);
-        }
-      }
+      ParseControlMessages(msg, timestamp, ecn);
     }
     if (out_addr) {
       SocketAddressFromSockAddrStorage(addr_storage, out_addr);
@@ -11,6 +11,7 @@
 #ifndef RTC_BASE_PHYSICAL_SOCKET_SERVER_H_
 #define RTC_BASE_PHYSICAL_SOCKET_SERVER_H_
 
+#include "api/array_view.h"
 #include "api/async_dns_resolver.h"
 #include "api/units/time_delta.h"
 #include "rtc_base/socket.h"
@@ -183,6 +184,10 @@ class PhysicalSocket : public Socket, public sigslot::has_slots<> {
   int SendTo(const void* buffer,
              size_t length,
              const SocketAddress& addr) override;
+#if defined(WEBRTC_LINUX)
+  // Uses sendmmsg() to send up to 32 datagrams per system call.
+  int SendToBatch(ArrayView<const SendBuffer> buffers) override;
+#endif
 
   int Recv(void* buffer, size_t length, int64_t* timestamp) override;
   // TODO(webrtc:15368): Deprecate and remove.
@@ -191,6 +196,11 @@ class PhysicalSocket : public Socket, public sigslot::has_slots<> {
                SocketAddress* out_addr,
                int64_t* timestamp) override;
   int RecvFrom(ReceiveBuffer& buffer) override;
+#if defined(WEBRTC_LINUX)
+  // Uses recvmmsg() to drain up to `buffers.size()` datagrams from a UDP
+  // socket with a single system call.
+  int RecvFromBatch(ArrayView<ReceiveBuffer> buffers) override;
+#endif
 
   int Listen(int backlog) override;
   Socket* Accept(SocketAddress* out_addr) override;
@@ -218,11 +228,15 @@ class PhysicalSocket : public Socket, public sigslot::has_slots<> {
                        const struct sockaddr* dest_addr,
                        socklen_t addrlen);
 
+  // If `head` is set, the first bytes received are written to `head`, up to
+  // its capacity, and the rest to `buffer`. The return value counts both.
+  // Only supported on POSIX.
   int DoReadFromSocket(void* buffer,
                        size_t length,
                        SocketAddress* out_addr,
                        int64_t* timestamp,
-                       EcnMarking* ecn);
+                       EcnMarking* ecn,
+                       Buffer* head = nullptr);
 
   void OnResolveResult(const webrtc::AsyncDnsResolverResult& resolver);
 
@@ -252,6 +266,13 @@ class PhysicalSocket : public Socket, public sigslot::has_slots<> {
 #endif
 
  private:
+#if defined(WEBRTC_LINUX)
+  // Message headers for sendmmsg(), allocated on the first SendToBatch() and
+  // reused by the later ones.
+  struct SendBatchScratch;
+  std::unique_ptr<SendBatchScratch> send_batch_scratch_;
+#endif
+
   uint8_t enabled_events_ = 0;
 };
 
@@ -14,6 +14,8 @@
 
 #include <algorithm>
 #include <memory>
+#include <string>
+#include <vector>
 
 #include "rtc_base/gunit.h"
 #include "rtc_base/ip_address.h"
@@ -523,6 +525,106 @@ TEST_F(PhysicalSocketTest,
 
 #endif
 
+#if defined(WEBRTC_POSIX)
+// Verify that a datagram is split between the head and payload buffers.
+TEST_F(PhysicalSocketTest, UdpRecvFromFillsHeadFirst) {
+  MAYBE_SKIP_IPV4;
+  std::unique_ptr<Socket> receiver(server_.CreateSocket(AF_INET, SOCK_DGRAM));
+  ASSERT_EQ(0, receiver->Bind(SocketAddress(kIPv4Loopback, 0)));
+  std::unique_ptr<Socket> sender(server_.CreateSocket(AF_INET, SOCK_DGRAM));
+  ASSERT_EQ(0, sender->Bind(SocketAddress(kIPv4Loopback, 0)));
+
+  const std::string kPackets[] = {"foo", "foobar"};
+  for (const std::string& packet : kPackets) {
+    ASSERT_EQ(static_cast<int>(packet.size()),
+              sender->SendTo(packet.data(), packet.size(),
+                             receiver->GetLocalAddress()));
+  }
+
+  Buffer payload;
+  Buffer head(0, 4);
+  Socket::ReceiveBuffer buffer(payload);
+  buffer.head = &head;
+  ASSERT_EQ(3, receiver->RecvFrom(buffer));
+  EXPECT_EQ("foo", std::string(head.data<char>(), head.size()));
+  EXPECT_TRUE(payload.empty());
+
+  ASSERT_EQ(6, receiver->RecvFrom(buffer));
+  EXPECT_EQ("foob", std::string(head.data<char>(), head.size()));
+  EXPECT_EQ("ar", std::string(payload.data<char>(), payload.size()));
+}
+#endif
+
+#if defined(WEBRTC_LINUX)
+// Verify that datagrams queued on a UDP socket are drained by a single
+// RecvFromBatch call, in order and with their source address.
+TEST_F(PhysicalSocketTest, UdpRecvFromBatchReadsQueuedDatagrams) {
+  MAYBE_SKIP_IPV4;
+  std::unique_ptr<Socket> receiver(server_.CreateSocket(AF_INET, SOCK_DGRAM));
+  ASSERT_EQ(0, receiver->Bind(SocketAddress(kIPv4Loopback, 0)));
+  std::unique_ptr<Socket> sender(server_.CreateSocket(AF_INET, SOCK_DGRAM));
+  ASSERT_EQ(0, sender->Bind(SocketAddress(kIPv4Loopback, 0)));
+
+  const std::string kPackets[] = {"foo", "bar", "bazz"};
+  for (const std::string& packet : kPackets) {
+    ASSERT_EQ(static_cast<int>(packet.size()),
+              sender->SendTo(packet.data(), packet.size(),
+                             receiver->GetLocalAddress()));
+  }
+
+  std::vector<Buffer> payloads(5);
+  std::vector<Socket::ReceiveBuffer> buffers;
+  for (Buffer& payload : payloads) {
+    buffers.emplace_back(payload);
+  }
+  ASSERT_EQ(3, receiver->RecvFromBatch(buffers));
+  for (int i = 0; i < 3; ++i) {
+    EXPECT_EQ(kPackets[i],
+              std::string(reinterpret_cast<const char*>(payloads[i].data()),
+                          payloads[i].size()));
+    EXPECT_EQ(sender->GetLocalAddress(), buffers[i].source_address);
+    EXPECT_TRUE(buffers[i].arrival_time.has_value());
+  }
+
+  // Nothing left to read.
+  EXPECT_EQ(-1, receiver->RecvFromBatch(buffers));
+  EXPECT_TRUE(receiver->IsBlocking());
+}
+
+// Verify that datagrams passed to SendToBatch arrive in order.
+TEST_F(PhysicalSocketTest, UdpSendToBatchSendsAllDatagrams) {
+  MAYBE_SKIP_IPV4;
+  std::unique_ptr<Socket> receiver(server_.CreateSocket(AF_INET, SOCK_DGRAM));
+  ASSERT_EQ(0, receiver->Bind(SocketAddress(kIPv4Loopback, 0)));
+  std::unique_ptr<Socket> sender(server_.CreateSocket(AF_INET, SOCK_DGRAM));
+  ASSERT_EQ(0, sender->Bind(SocketAddress(kIPv4Loopback, 0)));
+
+  const std::string kPackets[] = {"foo", "bar", "bazz"};
+  std::vector<Socket::SendBuffer> buffers;
+  for (const std::string& packet : kPackets) {
+    buffers.push_back(
+        {.payload = rtc::MakeArrayView(
+             reinterpret_cast<const uint8_t*>(packet.data()), packet.size()),
+         .destination = receiver->GetLocalAddress()});
+  }
+  ASSERT_EQ(3, sender->SendToBatch(buffers));
+  // A shorter batch reuses the message headers of the first one.
+  rtc::ArrayView<const Socket::SendBuffer> shorter_batch(buffers);
+  ASSERT_EQ(2, sender->SendToBatch(shorter_batch.subview(1)));
+
+  for (const std::string& packet :
+       {kPackets[0], kPackets[1], kPackets[2], kPackets[1], kPackets[2]}) {
+    Buffer payload;
+    Socket::ReceiveBuffer receive_buffer(payload);
+    ASSERT_EQ(static_cast<int>(packet.size()),
+              receiver->RecvFrom(receive_buffer));
+    EXPECT_EQ(packet, std::string(reinterpret_cast<const char*>(payload.data()),
+                                  payload.size()));
+    EXPECT_EQ(sender->GetLocalAddress(), receive_buffer.source_address);
+  }
+}
+#endif  // WEBRTC_LINUX
+
 TEST_F(PhysicalSocketTest, UdpSocketRecvTimestampUseRtcEpochIPv4) {
   MAYBE_SKIP_IPV4;
   SocketTest::TestUdpSocketRecvTimestampUseRtcEpochIPv4();
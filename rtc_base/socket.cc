@@ -12,10 +12,24 @@
 
 #include <cstdint>
 
+#include "api/array_view.h"
 #include "rtc_base/buffer.h"
+#include "rtc_base/checks.h"
 
 namespace rtc {
 
+int Socket::SendToBatch(ArrayView<const SendBuffer> buffers) {
+  int sent = 0;
+  for (const SendBuffer& buffer : buffers) {
+    if (SendTo(buffer.payload.data(), buffer.payload.size(),
+               buffer.destination) < 0) {
+      return sent > 0 ? sent : -1;
+    }
+    ++sent;
+  }
+  return sent;
+}
+
 int Socket::RecvFrom(ReceiveBuffer& buffer) {
   static constexpr int BUF_SIZE = 64 * 1024;
   int64_t timestamp = -1;
@@ -30,4 +44,10 @@ int Socket::RecvFrom(ReceiveBuffer& buffer) {
   return len;
 }
 
+int Socket::RecvFromBatch(ArrayView<ReceiveBuffer> buffers) {
+  RTC_DCHECK(!buffers.empty());
+  int len = RecvFrom(buffers[0]);
+  return len > 0 ? 1 : len;
+}
+
 }  // namespace rtc
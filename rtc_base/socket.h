@@ -28,6 +28,7 @@
 #include "rtc_base/win32.h"
 #endif
 
+#include "api/array_view.h"
 #include "api/units/timestamp.h"
 #include "rtc_base/buffer.h"
 #include "rtc_base/network/ecn_marking.h"
@@ -94,6 +95,14 @@ class RTC_EXPORT Socket {
     SocketAddress source_address;
     EcnMarking ecn = EcnMarking::kNotEct;
     Buffer& payload;
+    // If set, sockets that support scattered reads receive the first bytes of
+    // a datagram, up to the capacity of `head`, into `head` and only the rest
+    // into `payload`. Other sockets leave `head` untouched.
+    Buffer* head = nullptr;
+  };
+  struct SendBuffer {
+    ArrayView<const uint8_t> payload;
+    SocketAddress destination;
   };
   virtual ~Socket() {}
 
@@ -112,6 +121,11 @@ class RTC_EXPORT Socket {
   virtual int Connect(const SocketAddress& addr) = 0;
   virtual int Send(const void* pv, size_t cb) = 0;
   virtual int SendTo(const void* pv, size_t cb, const SocketAddress& addr) = 0;
+  // Sends each of `buffers` to its destination, in order. Returns the number
+  // of datagrams sent, which may be less than `buffers.size()` if the socket
+  // would block, or a negative value if none could be sent.
+  // Default implementation calls SendTo() once per datagram.
+  virtual int SendToBatch(ArrayView<const SendBuffer> buffers);
   // `timestamp` is in units of microseconds.
   virtual int Recv(void* pv, size_t cb, int64_t* timestamp) = 0;
   // TODO(webrtc:15368): Deprecate and remove.
@@ -126,6 +140,12 @@ class RTC_EXPORT Socket {
   // Default implementation calls RecvFrom(void* ...) with 64Kbyte buffer.
   // Returns number of bytes received or a negative value on error.
   virtual int RecvFrom(ReceiveBuffer& buffer);
+  // Receives up to `buffers.size()` datagrams in one call, filling `buffers`
+  // from the front. Returns the number of datagrams received, 0 if nothing
+  // was read or a negative value on error.
+  // Default implementation receives a single datagram using
+  // RecvFrom(ReceiveBuffer& buffer).
+  virtual int RecvFromBatch(ArrayView<ReceiveBuffer> buffers);
   virtual int Listen(int backlog) = 0;
   virtual Socket* Accept(SocketAddress* paddr) = 0;
   virtual int Close() = 0;
@@ -0,0 +1,123 @@
+/*
+ *  Copyright 2024 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <atomic>
+#include <memory>
+#include <vector>
+
+#include "api/task_queue/task_queue_factory.h"
+#include "api/units/time_delta.h"
+#include "benchmark/benchmark.h"
+#include "rtc_base/event.h"
+#include "rtc_base/platform_thread.h"
+#include "rtc_base/system/unused.h"
+#include "rtc_base/task_queue_lock_free.h"
+#include "rtc_base/task_queue_stdlib.h"
+
+#if defined(WEBRTC_ENABLE_LIBEVENT)
+#include "rtc_base/task_queue_libevent.h"
+#endif
+
+namespace webrtc {
+namespace {
+
+constexpr int kTasksPerProducer = 10'000;
+
+// Tasks run on other threads than the benchmark, so all benchmarks use wall
+// clock time.
+
+// Posts `kTasksPerProducer` tasks from each of `state.range(0)` threads to a
+// single queue and waits for all of them to run.
+template <std::unique_ptr<TaskQueueFactory> (*CreateFactory)()>
+void BM_PostTask(benchmark::State& state) {
+  const int num_producers = state.range(0);
+  std::unique_ptr<TaskQueueFactory> factory = CreateFactory();
+  auto queue =
+      factory->CreateTaskQueue("Consumer", TaskQueueFactory::Priority::NORMAL);
+  for (auto s : state) {
+    RTC_UNUSED(s);
+    rtc::Event done;
+    std::atomic<int> remaining(num_producers * kTasksPerProducer);
+    std::vector<rtc::PlatformThread> producers;
+    for (int i = 0; i < num_producers; ++i) {
+      producers.push_back(rtc::PlatformThread::SpawnJoinable(
+          [&] {
+            for (int j = 0; j < kTasksPerProducer; ++j) {
+              queue->PostTask([&] {
+                if (remaining.fetch_sub(1, std::memory_order_relaxed) == 1) {
+                  done.Set();
+                }
+              });
+            }
+          },
+          "Producer"));
+    }
+    // Joins the producers.
+    producers.clear();
+    done.Wait(rtc::Event::kForever);
+  }
+  state.SetItemsProcessed(state.iterations() * num_producers *
+                          kTasksPerProducer);
+}
+
+// Posts `kTasksPerProducer` delayed tasks, which are all due immediately, from
+// the queue itself and waits for all of them to run.
+template <std::unique_ptr<TaskQueueFactory> (*CreateFactory)()>
+void BM_PostDelayedTask(benchmark::State& state) {
+  std::unique_ptr<TaskQueueFactory> factory = CreateFactory();
+  auto queue =
+      factory->CreateTaskQueue("Consumer", TaskQueueFactory::Priority::NORMAL);
+  for (auto s : state) {
+    RTC_UNUSED(s);
+    rtc::Event done;
+    int remaining = kTasksPerProducer;
+    queue->PostTask([&] {
+      for (int j = 0; j < kTasksPerProducer; ++j) {
+        queue->PostDelayedTask(
+            [&] {
+              if (--remaining == 0) {
+                done.Set();
+              }
+            },
+            TimeDelta::Zero());
+      }
+    });
+    done.Wait(rtc::Event::kForever);
+  }
+  state.SetItemsProcessed(state.iterations() * kTasksPerProducer);
+}
+
+BENCHMARK_TEMPLATE(BM_PostTask, CreateTaskQueueStdlibFactory)
+    ->Arg(1)
+    ->Arg(4)
+    ->Arg(16)
+    ->UseRealTime();
+BENCHMARK_TEMPLATE(BM_PostTask, CreateTaskQueueLockFreeFactory)
+    ->Arg(1)
+    ->Arg(4)
+    ->Arg(16)
+    ->UseRealTime();
+BENCHMARK_TEMPLATE(BM_PostDelayedTask, CreateTaskQueueStdlibFactory)
+    ->UseRealTime();
+BENCHMARK_TEMPLATE(BM_PostDelayedTask, CreateTaskQueueLockFreeFactory)
+    ->UseRealTime();
+
+#if defined(WEBRTC_ENABLE_LIBEVENT)
+BENCHMARK_TEMPLATE(BM_PostTask, CreateTaskQueueLibeventFactory)
+    ->Arg(1)
+    ->Arg(4)
+    ->Arg(16)
+    ->UseRealTime();
+BENCHMARK_TEMPLATE(BM_PostDelayedTask, CreateTaskQueueLibeventFactory)
+    ->UseRealTime();
+#endif
+
+}  // namespace
+}  // namespace webrtc
@@ -0,0 +1,285 @@
+/*
+ *  Copyright 2024 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "rtc_base/task_queue_lock_free.h"
+
+#include <atomic>
+#include <memory>
+#include <utility>
+
+#include "absl/functional/any_invocable.h"
+#include "absl/strings/string_view.h"
+#include "api/task_queue/task_queue_base.h"
+#include "api/units/time_delta.h"
+#include "rtc_base/checks.h"
+#include "rtc_base/event.h"
+#include "rtc_base/numerics/divide_round.h"
+#include "rtc_base/platform_thread.h"
+#include "rtc_base/time_utils.h"
+#include "rtc_base/timer_wheel.h"
+
+namespace webrtc {
+namespace {
+
+rtc::ThreadPriority TaskQueuePriorityToThreadPriority(
+    TaskQueueFactory::Priority priority) {
+  switch (priority) {
+    case TaskQueueFactory::Priority::HIGH:
+      return rtc::ThreadPriority::kRealtime;
+    case TaskQueueFactory::Priority::LOW:
+      return rtc::ThreadPriority::kLow;
+    case TaskQueueFactory::Priority::NORMAL:
+      return rtc::ThreadPriority::kNormal;
+  }
+}
+
+class TaskQueueLockFree final : public TaskQueueBase {
+ public:
+  TaskQueueLockFree(absl::string_view queue_name,
+                    rtc::ThreadPriority priority);
+  ~TaskQueueLockFree() override = default;
+
+  void Delete() override;
+
+ protected:
+  void PostTaskImpl(absl::AnyInvocable<void() &&> task,
+                    const PostTaskTraits& traits,
+                    const Location& location) override;
+  void PostDelayedTaskImpl(absl::AnyInvocable<void() &&> task,
+                           TimeDelta delay,
+                           const PostDelayedTaskTraits& traits,
+                           const Location& location) override;
+
+ private:
+  static constexpr int64_t kImmediate = -1;
+
+  // Node of the intrusive MPSC queue described at
+  // https://www.1024cores.net/home/lock-free-algorithms/queues/intrusive-mpsc-node-based-queue
+  struct Node {
+    std::atomic<Node*> next{nullptr};
+    absl::AnyInvocable<void() &&> task;
+    // Time at which a delayed task is to run, or kImmediate.
+    int64_t fire_at_us = kImmediate;
+  };
+
+  static rtc::PlatformThread InitializeThread(TaskQueueLockFree* me,
+                                              absl::string_view queue_name,
+                                              rtc::ThreadPriority priority);
+
+  // Called on any thread.
+  void Push(Node* node);
+  // Called on the queue's thread only. Returns nullptr if the queue is empty,
+  // or if a concurrent Push() hasn't finished linking its node yet.
+  Node* Pop();
+  bool HasPendingNodes() const;
+
+  void ProcessTasks();
+  void WaitForWork(int64_t now_us);
+  void NotifyWake();
+
+  // Signaled when a task is posted while the queue's thread is asleep.
+  rtc::Event flag_notify_;
+  std::atomic<bool> sleeping_{false};
+  std::atomic<bool> thread_should_quit_{false};
+
+  // Producers swap themselves in at `head_`, the queue's thread consumes from
+  // `tail_`. `stub_` keeps the list non-empty.
+  Node stub_;
+  alignas(64) std::atomic<Node*> head_{&stub_};
+  alignas(64) Node* tail_ = &stub_;
+
+  // Delayed tasks, only accessed on the queue's thread.
+  TimerWheel<absl::AnyInvocable<void() &&>> delayed_tasks_{rtc::TimeMicros()};
+
+  // Contains the active worker thread assigned to processing
+  // tasks (including delayed tasks).
+  // Placing this last ensures the thread doesn't touch uninitialized attributes
+  // throughout it's lifetime.
+  rtc::PlatformThread thread_;
+};
+
+TaskQueueLockFree::TaskQueueLockFree(absl::string_view queue_name,
+                                     rtc::ThreadPriority priority)
+    : flag_notify_(/*manual_reset=*/false, /*initially_signaled=*/false),
+      thread_(InitializeThread(this, queue_name, priority)) {}
+
+// static
+rtc::PlatformThread TaskQueueLockFree::InitializeThread(
+    TaskQueueLockFree* me,
+    absl::string_view queue_name,
+    rtc::ThreadPriority priority) {
+  rtc::Event started;
+  auto thread = rtc::PlatformThread::SpawnJoinable(
+      [&started, me] {
+        CurrentTaskQueueSetter set_current(me);
+        started.Set();
+        me->ProcessTasks();
+      },
+      queue_name, rtc::ThreadAttributes().SetPriority(priority));
+  started.Wait(rtc::Event::kForever);
+  return thread;
+}
+
+void TaskQueueLockFree::Delete() {
+  RTC_DCHECK(!IsCurrent());
+
+  thread_should_quit_.store(true, std::memory_order_release);
+  // The thread may be between checking `sleeping_` and waiting, so it must be
+  // signaled unconditionally.
+  flag_notify_.Set();
+
+  delete this;
+}
+
+void TaskQueueLockFree::PostTaskImpl(absl::AnyInvocable<void() &&> task,
+                                     const PostTaskTraits& traits,
+                                     const Location& location) {
+  Node* node = new Node;
+  node->task = std::move(task);
+  Push(node);
+  NotifyWake();
+}
+
+void TaskQueueLockFree::PostDelayedTaskImpl(
+    absl::AnyInvocable<void() &&> task,
+    TimeDelta delay,
+    const PostDelayedTaskTraits& traits,
+    const Location& location) {
+  // Delayed tasks travel through the same queue and are moved to
+  // `delayed_tasks_` by the queue's thread, so that the timer wheel needs no
+  // synchronization.
+  Node* node = new Node;
+  node->task = std::move(task);
+  node->fire_at_us = rtc::TimeMicros() + delay.us();
+  Push(node);
+  NotifyWake();
+}
+
+void TaskQueueLockFree::Push(Node* node) {
+  node->next.store(nullptr, std::memory_order_relaxed);
+  Node* prev = head_.exchange(node, std::memory_order_seq_cst);
+  prev->next.store(node, std::memory_order_release);
+}
+
+TaskQueueLockFree::Node* TaskQueueLockFree::Pop() {
+  Node* tail = tail_;
+  Node* next = tail->next.load(std::memory_order_acquire);
+  if (tail == &stub_) {
+    if (next == nullptr) {
+      return nullptr;
+    }
+    tail_ = next;
+    tail = next;
+    next = next->next.load(std::memory_order_acquire);
+  }
+  if (next != nullptr) {
+    tail_ = next;
+    return tail;
+  }
+  if (tail != head_.load(std::memory_order_acquire)) {
+    // A producer has swapped in a new head but not linked it yet.
+    return nullptr;
+  }
+  // `tail` is the last node. Push the stub behind it so that `tail` can be
+  // handed out without racing with producers that link to it.
+  Push(&stub_);
+  next = tail->next.load(std::memory_order_acquire);
+  if (next != nullptr) {
+    tail_ = next;
+    return tail;
+  }
+  return nullptr;
+}
+
+bool TaskQueueLockFree::HasPendingNodes() const {
+  return tail_->next.load(std::memory_order_acquire) != nullptr ||
+         head_.load(std::memory_order_seq_cst) != tail_;
+}
+
+void TaskQueueLockFree::ProcessTasks() {
+  while (!thread_should_quit_.load(std::memory_order_acquire)) {
+    // Reading the clock is only needed while delayed tasks are pending.
+    const int64_t now_us = delayed_tasks_.empty() ? 0 : rtc::TimeMicros();
+    absl::AnyInvocable<void() &&> delayed_task;
+    if (!delayed_tasks_.empty() &&
+        delayed_tasks_.PopExpired(now_us, delayed_task)) {
+      std::move(delayed_task)();
+      continue;
+    }
+
+    if (Node* node = Pop()) {
+      std::unique_ptr<Node> owned_node(node);
+      if (node->fire_at_us == kImmediate) {
+        std::move(node->task)();
+      } else {
+        delayed_tasks_.Insert(node->fire_at_us, std::move(node->task));
+      }
+      continue;
+    }
+
+    WaitForWork(now_us);
+  }
+
+  // Ensure remaining deleted tasks are destroyed with Current() set up to this
+  // task queue. Destroying a task may post another one, so repeat until the
+  // queue is drained.
+  while (HasPendingNodes() || !delayed_tasks_.empty()) {
+    delayed_tasks_.Clear();
+    while (Node* node = Pop()) {
+      delete node;
+    }
+  }
+}
+
+void TaskQueueLockFree::WaitForWork(int64_t now_us) {
+  TimeDelta sleep_time = rtc::Event::kForever;
+  if (!delayed_tasks_.empty()) {
+    sleep_time = TimeDelta::Millis(
+        DivideRoundUp(delayed_tasks_.NextExpiryUs() - now_us, 1'000));
+  }
+
+  // Announce that the thread is about to sleep before checking the queue a
+  // last time. A producer either sees `sleeping_` and signals
+  // `flag_notify_`, or has pushed its task early enough for it to be seen
+  // here.
+  sleeping_.store(true, std::memory_order_seq_cst);
+  if (!HasPendingNodes()) {
+    flag_notify_.Wait(sleep_time);
+  }
+  sleeping_.store(false, std::memory_order_relaxed);
+}
+
+void TaskQueueLockFree::NotifyWake() {
+  // Only a sleeping thread needs to be woken, which keeps the futex off the
+  // posting path while the queue's thread is busy.
+  if (sleeping_.load(std::memory_order_seq_cst) &&
+      sleeping_.exchange(false, std::memory_order_acq_rel)) {
+    flag_notify_.Set();
+  }
+}
+
+class TaskQueueLockFreeFactory final : public TaskQueueFactory {
+ public:
+  std::unique_ptr<TaskQueueBase, TaskQueueDeleter> CreateTaskQueue(
+      absl::string_view name,
+      Priority priority) const override {
+    return std::unique_ptr<TaskQueueBase, TaskQueueDeleter>(
+        new TaskQueueLockFree(name,
+                              TaskQueuePriorityToThreadPriority(priority)));
+  }
+};
+
+}  // namespace
+
+std::unique_ptr<TaskQueueFactory> CreateTaskQueueLockFreeFactory() {
+  return std::make_unique<TaskQueueLockFreeFactory>();
+}
+
+}  // namespace webrtc
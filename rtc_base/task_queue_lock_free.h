@@ -0,0 +1,28 @@
+/*
+ *  Copyright 2024 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef RTC_BASE_TASK_QUEUE_LOCK_FREE_H_
+#define RTC_BASE_TASK_QUEUE_LOCK_FREE_H_
+
+#include <memory>
+
+#include "api/task_queue/task_queue_factory.h"
+
+namespace webrtc {
+
+// Creates task queues that post tasks through a lock-free multi-producer
+// single-consumer queue and keep delayed tasks in a timer wheel owned by the
+// queue's thread. Posting a task only takes a lock when the queue's thread is
+// asleep and needs to be woken up.
+std::unique_ptr<TaskQueueFactory> CreateTaskQueueLockFreeFactory();
+
+}  // namespace webrtc
+
+#endif  // RTC_BASE_TASK_QUEUE_LOCK_FREE_H_
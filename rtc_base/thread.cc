@@ -316,7 +316,7 @@ Thread::Thread(std::unique_ptr<SocketServer> ss)
     : Thread(std::move(ss), /*do_init=*/true) {}
 
 Thread::Thread(SocketServer* ss, bool do_init)
-    : delayed_next_num_(0),
+    : delayed_messages_(TimeMillis() * kNumMicrosecsPerMillisec),
       fInitialized_(false),
       fDestroyed_(false),
       stop_(0),
@@ -364,7 +364,7 @@ void Thread::DoDestroy() {
   // Clear.
   CurrentTaskQueueSetter set_current(this);
   messages_ = {};
-  delayed_messages_ = {};
+  delayed_messages_.Clear();
 }
 
 SocketServer* Thread::socketserver() {
@@ -404,14 +404,15 @@ absl::AnyInvocable<void() &&> Thread::Get(int cmsWait) {
       MutexLock lock(&mutex_);
       // Check for delayed messages that have been triggered and calculate the
       // next trigger time.
-      while (!delayed_messages_.empty()) {
-        if (msCurrent < delayed_messages_.top().run_time_ms) {
-          cmsDelayNext =
-              TimeDiff(delayed_messages_.top().run_time_ms, msCurrent);
-          break;
-        }
-        messages_.push(std::move(delayed_messages_.top().functor));
-        delayed_messages_.pop();
+      absl::AnyInvocable<void() &&> delayed_task;
+      while (delayed_messages_.PopExpired(msCurrent * kNumMicrosecsPerMillisec,
+                                          delayed_task)) {
+        messages_.push(std::move(delayed_task));
+      }
+      if (!delayed_messages_.empty()) {
+        cmsDelayNext = TimeDiff(
+            delayed_messages_.NextExpiryUs() / kNumMicrosecsPerMillisec,
+            msCurrent);
       }
       // Pull a message off the message queue, if available.
       if (!messages_.empty()) {
@@ -482,22 +483,15 @@ void Thread::PostDelayedTaskImpl(absl::AnyInvocable<void() &&> task,
   }
 
   // Keep thread safe
-  // Add to the priority queue. Gets sorted soonest first.
+  // Add to the timer wheel. Gets sorted soonest first.
   // Signal for the multiplexer to return.
 
   int64_t delay_ms = delay.RoundUpTo(webrtc::TimeDelta::Millis(1)).ms<int>();
   int64_t run_time_ms = TimeAfter(delay_ms);
   {
     MutexLock lock(&mutex_);
-    delayed_messages_.push({.delay_ms = delay_ms,
-                            .run_time_ms = run_time_ms,
-                            .message_number = delayed_next_num_,
-                            .functor = std::move(task)});
-    // If this message queue processes 1 message every millisecond for 50 days,
-    // we will wrap this number.  Even then, only messages with identical times
-    // will be misordered, and then only briefly.  This is probably ok.
-    ++delayed_next_num_;
-    RTC_DCHECK_NE(0, delayed_next_num_);
+    delayed_messages_.Insert(run_time_ms * kNumMicrosecsPerMillisec,
+                             std::move(task));
   }
   WakeUpSocketServer();
 }
@@ -509,7 +503,8 @@ int Thread::GetDelay() {
     return 0;
 
   if (!delayed_messages_.empty()) {
-    int delay = TimeUntil(delayed_messages_.top().run_time_ms);
+    int delay = TimeUntil(delayed_messages_.NextExpiryUs() /
+                          kNumMicrosecsPerMillisec);
     if (delay < 0)
       delay = 0;
     return delay;
@@ -0,0 +1,294 @@
+/*
+ *  Copyright 2024 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef RTC_BASE_TIMER_WHEEL_H_
+#define RTC_BASE_TIMER_WHEEL_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <algorithm>
+#include <array>
+#include <limits>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+namespace webrtc {
+
+// A hierarchical timer wheel holding values of type `T` that expire at a
+// given time in microseconds.
+//
+// Time is divided into ticks of `kTickUs`. The first level has one slot per
+// tick for the next `kSlotsPerLevel` ticks, and each following level has slots
+// that are `kSlotsPerLevel` times as wide as the ones of the level below. When
+// the wheel reaches the start of a slot in a higher level, the values of that
+// slot are cascaded into lower levels. Inserting a value is thus O(1). The
+// values of a first level slot are sorted once, when the wheel reaches its
+// tick. Values more than the span of the highest level ahead stay in the
+// highest level until they come within reach. The earliest expiry time is
+// cached, so that NextExpiryUs() only searches the wheel after the values of a
+// whole tick have been popped.
+//
+// Values are returned in order of expiry time, and in insertion order for
+// values that expire at the same time. The clock may go backwards, as fake
+// clocks in tests do: values that expire before the wheel's current time are
+// kept in a separate sorted list.
+//
+// This class is not thread safe.
+template <typename T>
+class TimerWheel {
+ public:
+  static constexpr int64_t kTickUs = 1'000;
+  static constexpr int kSlotBits = 6;
+  static constexpr size_t kSlotsPerLevel = size_t{1} << kSlotBits;
+  static constexpr int kNumLevels = 4;
+
+  explicit TimerWheel(int64_t now_us) : current_tick_(now_us / kTickUs) {}
+
+  TimerWheel(const TimerWheel&) = delete;
+  TimerWheel& operator=(const TimerWheel&) = delete;
+
+  bool empty() const { return size_ == 0; }
+  size_t size() const { return size_; }
+
+  // Adds `value`, to expire at `fire_at_us`. Values with an expiry time in the
+  // past expire at the next call to PopExpired().
+  void Insert(int64_t fire_at_us, T value) {
+    if (next_expiry_valid_) {
+      next_expiry_us_ = std::min(next_expiry_us_, fire_at_us);
+    }
+    Place(Entry{.fire_at_us = fire_at_us,
+                .order = next_order_++,
+                .value = std::move(value)});
+    ++size_;
+  }
+
+  // Moves the earliest value that has expired at `now_us` to `value` and
+  // returns true. Returns false if there is no expired value.
+  bool PopExpired(int64_t now_us, T& value) {
+    const int64_t now_tick = now_us / kTickUs;
+    if (size_ == 0) {
+      current_tick_ = now_tick;
+      return false;
+    }
+    if (!overdue_.empty()) {
+      // Overdue values expire before any value in the wheel.
+      return PopIfExpired(overdue_, now_us, value);
+    }
+    while (true) {
+      Slot& slot = levels_[0][SlotIndex(current_tick_, 0)];
+      if (!slot.empty()) {
+        if (sorted_tick_ != current_tick_) {
+          std::sort(slot.begin(), slot.end(), EarliestLast);
+          sorted_tick_ = current_tick_;
+        }
+        return PopIfExpired(slot, now_us, value);
+      }
+      if (current_tick_ >= now_tick) {
+        return false;
+      }
+      AdvanceTowards(now_tick);
+    }
+  }
+
+  // Returns the expiry time of the earliest value, or the maximum int64_t
+  // value if the wheel is empty.
+  int64_t NextExpiryUs() const {
+    if (!next_expiry_valid_) {
+      next_expiry_us_ = FindNextExpiryUs();
+      next_expiry_valid_ = true;
+    }
+    return next_expiry_us_;
+  }
+
+  // Removes all values. They are destroyed in unspecified order.
+  void Clear() {
+    for (auto& level : levels_) {
+      for (Slot& slot : level) {
+        slot.clear();
+      }
+    }
+    overdue_.clear();
+    level_sizes_ = {};
+    size_ = 0;
+    next_expiry_us_ = std::numeric_limits<int64_t>::max();
+    next_expiry_valid_ = true;
+  }
+
+ private:
+  struct Entry {
+    bool Before(const Entry& o) const {
+      return std::tie(fire_at_us, order) < std::tie(o.fire_at_us, o.order);
+    }
+
+    int64_t fire_at_us;
+    uint64_t order;
+    T value;
+  };
+
+  // The slot of the first level at `sorted_tick_` and `overdue_` are sorted in
+  // descending order so that the earliest value is at the back. Other slots
+  // are not sorted.
+  using Slot = std::vector<Entry>;
+
+  static bool EarliestLast(const Entry& a, const Entry& b) {
+    return b.Before(a);
+  }
+
+  static size_t SlotIndex(int64_t tick, int level) {
+    return static_cast<size_t>(tick >> (level * kSlotBits)) &
+           (kSlotsPerLevel - 1);
+  }
+
+  static void InsertSorted(Slot& slot, Entry entry) {
+    slot.insert(std::upper_bound(slot.begin(), slot.end(), entry, EarliestLast),
+                std::move(entry));
+  }
+
+  int64_t FindNextExpiryUs() const {
+    if (!overdue_.empty()) {
+      return overdue_.back().fire_at_us;
+    }
+    int64_t next_us = std::numeric_limits<int64_t>::max();
+    if (level_sizes_[0] > 0) {
+      // Slots of the first level hold one tick each.
+      for (size_t i = 0; i < kSlotsPerLevel; ++i) {
+        const int64_t tick = current_tick_ + static_cast<int64_t>(i);
+        const Slot& slot = levels_[0][SlotIndex(tick, 0)];
+        if (slot.empty()) {
+          continue;
+        }
+        if (tick == sorted_tick_) {
+          next_us = slot.back().fire_at_us;
+        } else {
+          for (const Entry& entry : slot) {
+            next_us = std::min(next_us, entry.fire_at_us);
+          }
+        }
+        break;
+      }
+    }
+    for (int level = 1; level < kNumLevels; ++level) {
+      if (level_sizes_[level] == 0) {
+        continue;
+      }
+      const int64_t block = current_tick_ >> (level * kSlotBits);
+      for (size_t i = 1; i <= kSlotsPerLevel; ++i) {
+        const Slot& slot = levels_[level][static_cast<size_t>(block + i) &
+                                          (kSlotsPerLevel - 1)];
+        for (const Entry& entry : slot) {
+          next_us = std::min(next_us, entry.fire_at_us);
+        }
+        // Slots below the highest level hold a single block of time, so the
+        // first non-empty one holds the earliest values of the level.
+        if (!slot.empty() && level < kNumLevels - 1) {
+          break;
+        }
+      }
+    }
+    return next_us;
+  }
+
+  bool PopIfExpired(Slot& slot, int64_t now_us, T& value) {
+    if (slot.back().fire_at_us > now_us) {
+      return false;
+    }
+    value = std::move(slot.back().value);
+    slot.pop_back();
+    --size_;
+    if (&slot != &overdue_) {
+      --level_sizes_[0];
+    }
+    // All other values expire after those of `overdue_` or of the current
+    // tick, so only an empty slot requires searching the wheel.
+    if (!slot.empty()) {
+      next_expiry_us_ = slot.back().fire_at_us;
+    } else if (size_ == 0) {
+      next_expiry_us_ = std::numeric_limits<int64_t>::max();
+    } else {
+      next_expiry_valid_ = false;
+    }
+    return true;
+  }
+
+  void Place(Entry entry) {
+    int64_t tick = entry.fire_at_us / kTickUs;
+    const int64_t delta = tick - current_tick_;
+    if (delta < 0) {
+      InsertSorted(overdue_, std::move(entry));
+      return;
+    }
+    for (int level = 0; level < kNumLevels; ++level) {
+      const int64_t span = int64_t{1} << ((level + 1) * kSlotBits);
+      if (delta >= span && level < kNumLevels - 1) {
+        continue;
+      }
+      if (delta >= span) {
+        // Beyond the highest level. Park the value in its last slot, to be
+        // placed again when that slot is cascaded.
+        tick = current_tick_ + span - 1;
+      }
+      Slot& slot = levels_[level][SlotIndex(tick, level)];
+      if (level == 0 && tick == sorted_tick_) {
+        InsertSorted(slot, std::move(entry));
+      } else {
+        slot.push_back(std::move(entry));
+      }
+      ++level_sizes_[level];
+      return;
+    }
+  }
+
+  // Moves `current_tick_` forward by at least one tick, but not past
+  // `now_tick`, and cascades the slots that start at the new tick. Skips ahead
+  // over ticks for which the lower levels hold no values.
+  void AdvanceTowards(int64_t now_tick) {
+    int64_t next_tick = current_tick_ + 1;
+    for (int level = 0; level < kNumLevels && level_sizes_[level] == 0;
+         ++level) {
+      const int bits = (level + 1) * kSlotBits;
+      const int64_t boundary = ((current_tick_ >> bits) + 1) << bits;
+      next_tick = std::max(next_tick, std::min(boundary, now_tick));
+    }
+    current_tick_ = next_tick;
+    // Cascade higher levels first, so that their values can be spread into
+    // the slots of lower levels that start at the same tick.
+    for (int level = kNumLevels - 1; level > 0; --level) {
+      const int64_t mask = (int64_t{1} << (level * kSlotBits)) - 1;
+      if ((current_tick_ & mask) != 0) {
+        continue;
+      }
+      Slot cascaded;
+      cascaded.swap(levels_[level][SlotIndex(current_tick_, level)]);
+      level_sizes_[level] -= cascaded.size();
+      for (Entry& entry : cascaded) {
+        Place(std::move(entry));
+      }
+    }
+  }
+
+  std::array<std::array<Slot, kSlotsPerLevel>, kNumLevels> levels_;
+  std::array<size_t, kNumLevels> level_sizes_ = {};
+  Slot overdue_;
+  // All values of earlier ticks are either returned by PopExpired() or in
+  // `overdue_`.
+  int64_t current_tick_;
+  // The tick whose first level slot was last sorted.
+  int64_t sorted_tick_ = std::numeric_limits<int64_t>::min();
+  uint64_t next_order_ = 0;
+  size_t size_ = 0;
+  mutable int64_t next_expiry_us_ = std::numeric_limits<int64_t>::max();
+  mutable bool next_expiry_valid_ = true;
+};
+
+}  // namespace webrtc
+
+#endif  // RTC_BASE_TIMER_WHEEL_H_
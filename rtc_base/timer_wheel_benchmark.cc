@@ -0,0 +1,111 @@
+/*
+ *  Copyright 2024 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <stdint.h>
+
+#include <algorithm>
+#include <queue>
+#include <tuple>
+#include <utility>
+
+#include "absl/functional/any_invocable.h"
+#include "benchmark/benchmark.h"
+#include "rtc_base/random.h"
+#include "rtc_base/system/unused.h"
+#include "rtc_base/timer_wheel.h"
+
+namespace webrtc {
+namespace {
+
+using Task = absl::AnyInvocable<void() &&>;
+
+// Timers are spread over 0-2 s, as for retransmission, STUN and RTCP timers.
+constexpr uint32_t kMaxDelayUs = 2'000'000;
+
+// The delayed task queue that rtc::Thread used before the timer wheel.
+class PriorityQueueTimers {
+ public:
+  void Insert(int64_t fire_at_us, Task task) {
+    queue_.push(Entry{fire_at_us, order_++, std::move(task)});
+  }
+  bool PopExpired(int64_t now_us, Task& task) {
+    if (queue_.empty() || queue_.top().fire_at_us > now_us) {
+      return false;
+    }
+    task = std::move(queue_.top().task);
+    queue_.pop();
+    return true;
+  }
+
+ private:
+  struct Entry {
+    bool operator<(const Entry& o) const {
+      return std::tie(o.fire_at_us, o.order) < std::tie(fire_at_us, order);
+    }
+    int64_t fire_at_us;
+    uint64_t order;
+    mutable Task task;
+  };
+
+  std::priority_queue<Entry> queue_;
+  uint64_t order_ = 0;
+};
+
+class WheelTimers {
+ public:
+  void Insert(int64_t fire_at_us, Task task) {
+    wheel_.Insert(fire_at_us, std::move(task));
+  }
+  bool PopExpired(int64_t now_us, Task& task) {
+    return wheel_.PopExpired(now_us, task);
+  }
+
+ private:
+  TimerWheel<Task> wheel_{0};
+};
+
+// Inserts one timer and runs the expired ones per iteration. Time advances so
+// that `state.range(0)` timers are pending on average.
+template <typename Timers>
+void BM_TimerChurn(benchmark::State& state) {
+  const int num_timers = state.range(0);
+  const int64_t step_us = std::max<int64_t>(1, kMaxDelayUs / 2 / num_timers);
+  Random random(1234);
+  Timers timers;
+  int64_t now_us = 0;
+  int fired = 0;
+  for (int i = 0; i < num_timers; ++i) {
+    timers.Insert(now_us + random.Rand(0u, kMaxDelayUs), [&] { ++fired; });
+  }
+  Task task;
+  for (auto s : state) {
+    RTC_UNUSED(s);
+    timers.Insert(now_us + random.Rand(0u, kMaxDelayUs), [&] { ++fired; });
+    now_us += step_us;
+    while (timers.PopExpired(now_us, task)) {
+      std::move(task)();
+    }
+  }
+  benchmark::DoNotOptimize(fired);
+}
+
+BENCHMARK_TEMPLATE(BM_TimerChurn, PriorityQueueTimers)
+    ->Arg(100)
+    ->Arg(1'000)
+    ->Arg(10'000)
+    ->Arg(100'000);
+BENCHMARK_TEMPLATE(BM_TimerChurn, WheelTimers)
+    ->Arg(100)
+    ->Arg(1'000)
+    ->Arg(10'000)
+    ->Arg(100'000);
+
+}  // namespace
+}  // namespace webrtc
@@ -0,0 +1,147 @@
+/*
+ *  Copyright 2024 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "rtc_base/timer_wheel.h"
+
+#include <limits>
+#include <memory>
+#include <vector>
+
+#include "test/gmock.h"
+#include "test/gtest.h"
+
+namespace webrtc {
+namespace {
+
+using ::testing::ElementsAre;
+
+constexpr int64_t kStartUs = 1'000'000;
+
+std::vector<int> PopAllExpired(TimerWheel<int>& wheel, int64_t now_us) {
+  std::vector<int> values;
+  int value;
+  while (wheel.PopExpired(now_us, value)) {
+    values.push_back(value);
+  }
+  return values;
+}
+
+TEST(TimerWheelTest, IsEmptyWhenCreated) {
+  TimerWheel<int> wheel(kStartUs);
+  EXPECT_TRUE(wheel.empty());
+  EXPECT_EQ(wheel.NextExpiryUs(), std::numeric_limits<int64_t>::max());
+  EXPECT_THAT(PopAllExpired(wheel, kStartUs + 1'000'000), ElementsAre());
+}
+
+TEST(TimerWheelTest, DoesNotReturnValuesBeforeTheyExpire) {
+  TimerWheel<int> wheel(kStartUs);
+  wheel.Insert(kStartUs + 1'500, 1);
+  EXPECT_EQ(wheel.NextExpiryUs(), kStartUs + 1'500);
+
+  EXPECT_THAT(PopAllExpired(wheel, kStartUs + 1'000), ElementsAre());
+  EXPECT_THAT(PopAllExpired(wheel, kStartUs + 1'499), ElementsAre());
+  EXPECT_THAT(PopAllExpired(wheel, kStartUs + 1'500), ElementsAre(1));
+  EXPECT_TRUE(wheel.empty());
+}
+
+TEST(TimerWheelTest, ReturnsValuesInExpiryOrder) {
+  TimerWheel<int> wheel(kStartUs);
+  wheel.Insert(kStartUs + 30'000, 3);
+  wheel.Insert(kStartUs + 10'000, 1);
+  wheel.Insert(kStartUs + 20'000, 2);
+  wheel.Insert(kStartUs + 10'100, 4);
+  EXPECT_EQ(wheel.size(), 4u);
+
+  EXPECT_THAT(PopAllExpired(wheel, kStartUs + 100'000),
+              ElementsAre(1, 4, 2, 3));
+}
+
+TEST(TimerWheelTest, ReturnsValuesWithSameExpiryInInsertionOrder) {
+  TimerWheel<int> wheel(kStartUs);
+  for (int i = 0; i < 10; ++i) {
+    wheel.Insert(kStartUs + 5'000, i);
+  }
+  EXPECT_THAT(PopAllExpired(wheel, kStartUs + 5'000),
+              ElementsAre(0, 1, 2, 3, 4, 5, 6, 7, 8, 9));
+}
+
+TEST(TimerWheelTest, TracksNextExpiryWithinATick) {
+  TimerWheel<int> wheel(kStartUs);
+  wheel.Insert(kStartUs + 5'700, 3);
+  wheel.Insert(kStartUs + 5'100, 1);
+  wheel.Insert(kStartUs + 6'000, 4);
+  EXPECT_EQ(wheel.NextExpiryUs(), kStartUs + 5'100);
+
+  EXPECT_THAT(PopAllExpired(wheel, kStartUs + 5'100), ElementsAre(1));
+  EXPECT_EQ(wheel.NextExpiryUs(), kStartUs + 5'700);
+  // Inserted into the tick that is being popped.
+  wheel.Insert(kStartUs + 5'400, 2);
+  EXPECT_EQ(wheel.NextExpiryUs(), kStartUs + 5'400);
+  EXPECT_THAT(PopAllExpired(wheel, kStartUs + 5'999), ElementsAre(2, 3));
+  EXPECT_EQ(wheel.NextExpiryUs(), kStartUs + 6'000);
+  EXPECT_THAT(PopAllExpired(wheel, kStartUs + 6'000), ElementsAre(4));
+  EXPECT_EQ(wheel.NextExpiryUs(), std::numeric_limits<int64_t>::max());
+}
+
+TEST(TimerWheelTest, CascadesValuesFromHigherLevels) {
+  TimerWheel<int> wheel(kStartUs);
+  // One value for each level, and one beyond the span of the wheel.
+  wheel.Insert(kStartUs + 20'000, 1);
+  wheel.Insert(kStartUs + 3'000'000, 2);
+  wheel.Insert(kStartUs + 200'000'000, 3);
+  wheel.Insert(kStartUs + 20'000'000'000, 4);
+  wheel.Insert(kStartUs + 3'000'001, 5);
+  EXPECT_EQ(wheel.NextExpiryUs(), kStartUs + 20'000);
+
+  EXPECT_THAT(PopAllExpired(wheel, kStartUs + 20'000), ElementsAre(1));
+  EXPECT_EQ(wheel.NextExpiryUs(), kStartUs + 3'000'000);
+  EXPECT_THAT(PopAllExpired(wheel, kStartUs + 2'999'999), ElementsAre());
+  EXPECT_THAT(PopAllExpired(wheel, kStartUs + 3'000'000), ElementsAre(2));
+  EXPECT_THAT(PopAllExpired(wheel, kStartUs + 3'000'001), ElementsAre(5));
+  EXPECT_EQ(wheel.NextExpiryUs(), kStartUs + 200'000'000);
+  EXPECT_THAT(PopAllExpired(wheel, kStartUs + 199'999'999), ElementsAre());
+  EXPECT_THAT(PopAllExpired(wheel, kStartUs + 200'000'000), ElementsAre(3));
+  EXPECT_EQ(wheel.NextExpiryUs(), kStartUs + 20'000'000'000);
+  EXPECT_THAT(PopAllExpired(wheel, kStartUs + 19'999'999'999), ElementsAre());
+  EXPECT_THAT(PopAllExpired(wheel, kStartUs + 20'000'000'000), ElementsAre(4));
+  EXPECT_TRUE(wheel.empty());
+}
+
+TEST(TimerWheelTest, HandlesClockGoingBackwards) {
+  TimerWheel<int> wheel(kStartUs);
+  wheel.Insert(kStartUs + 10'000, 2);
+  // Inserted by someone whose clock is behind the wheel.
+  wheel.Insert(kStartUs - 50'000, 1);
+  EXPECT_EQ(wheel.NextExpiryUs(), kStartUs - 50'000);
+
+  EXPECT_THAT(PopAllExpired(wheel, kStartUs - 60'000), ElementsAre());
+  EXPECT_THAT(PopAllExpired(wheel, kStartUs - 50'000), ElementsAre(1));
+  EXPECT_THAT(PopAllExpired(wheel, kStartUs + 10'000), ElementsAre(2));
+}
+
+TEST(TimerWheelTest, ValuesInThePastExpireImmediately) {
+  TimerWheel<int> wheel(kStartUs);
+  EXPECT_THAT(PopAllExpired(wheel, kStartUs + 50'000), ElementsAre());
+  wheel.Insert(kStartUs + 10'000, 1);
+  EXPECT_THAT(PopAllExpired(wheel, kStartUs + 50'000), ElementsAre(1));
+}
+
+TEST(TimerWheelTest, ClearDestroysValues) {
+  TimerWheel<std::unique_ptr<int>> wheel(kStartUs);
+  wheel.Insert(kStartUs + 1'000, std::make_unique<int>(1));
+  wheel.Insert(kStartUs + 1'000'000, std::make_unique<int>(2));
+  wheel.Clear();
+  EXPECT_TRUE(wheel.empty());
+  std::unique_ptr<int> value;
+  EXPECT_FALSE(wheel.PopExpired(kStartUs + 2'000'000, value));
+}
+
+}  // namespace
+}  // namespace webrtc
@@ -0,0 +1,245 @@
+/*
+ *  Copyright (c) 2024 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "video/decode_thread_pool.h"
+
+#include <deque>
+#include <string>
+#include <utility>
+
+#include "api/units/time_delta.h"
+#include "rtc_base/checks.h"
+#include "rtc_base/strings/string_builder.h"
+
+namespace webrtc {
+
+class DecodeThreadPool::PooledTaskQueue final : public TaskQueueBase {
+ public:
+  PooledTaskQueue(DecodeThreadPool* pool, int64_t id) : pool_(pool), id_(id) {}
+
+  void Delete() override {
+    RTC_DCHECK(!IsCurrent());
+    pool_->DeleteQueue(this);
+  }
+
+  int64_t id() const { return id_; }
+
+  struct Task {
+    Timestamp deadline;
+    absl::AnyInvocable<void() &&> run;
+  };
+
+  void RunTask(absl::AnyInvocable<void() &&> task) {
+    CurrentTaskQueueSetter set_current(this);
+    std::move(task)();
+    // Destroy the task while the queue is still current.
+    task = nullptr;
+  }
+
+ protected:
+  void PostTaskImpl(absl::AnyInvocable<void() &&> task,
+                    const PostTaskTraits& traits,
+                    const Location& location) override {
+    pool_->PostTask(this, Timestamp::MinusInfinity(), std::move(task));
+  }
+
+  void PostDelayedTaskImpl(absl::AnyInvocable<void() &&> task,
+                           TimeDelta delay,
+                           const PostDelayedTaskTraits& traits,
+                           const Location& location) override {
+    auto post = [pool = pool_, id = id_, task = std::move(task)]() mutable {
+      pool->PostTaskIfAlive(id, std::move(task));
+    };
+    if (traits.high_precision) {
+      pool_->timer_queue_->PostDelayedHighPrecisionTask(std::move(post), delay,
+                                                        location);
+    } else {
+      pool_->timer_queue_->PostDelayedTask(std::move(post), delay, location);
+    }
+  }
+
+ private:
+  friend class DecodeThreadPool;
+
+  DecodeThreadPool* const pool_;
+  const int64_t id_;
+
+  // Guarded by `pool_->mutex_`.
+  std::deque<Task> tasks_;
+  // True while the queue is in `ready_queues_` or running.
+  bool scheduled_ = false;
+  // Key of the queue in `ready_queues_`, if it is there.
+  ReadyKey ready_key_;
+  bool running_ = false;
+  bool deleted_ = false;
+  // Signaled when a running task returns after the queue has been deleted.
+  rtc::Event stopped_;
+};
+
+DecodeThreadPool::DecodeThreadPool(TaskQueueFactory* task_queue_factory,
+                                   int num_threads)
+    : timer_queue_(task_queue_factory->CreateTaskQueue(
+          "DecodeThreadPoolTimer",
+          TaskQueueFactory::Priority::HIGH)) {
+  RTC_DCHECK_GT(num_threads, 0);
+  threads_.reserve(num_threads);
+  for (int i = 0; i < num_threads; ++i) {
+    rtc::StringBuilder name;
+    name << "DecodeThreadPool" << i;
+    threads_.push_back(rtc::PlatformThread::SpawnJoinable(
+        [this] { RunWorker(); }, name.str(),
+        rtc::ThreadAttributes().SetPriority(rtc::ThreadPriority::kRealtime)));
+  }
+}
+
+DecodeThreadPool::~DecodeThreadPool() {
+  // Stop the timer first so that no delayed task is posted while the workers
+  // are stopping.
+  timer_queue_ = nullptr;
+  {
+    MutexLock lock(&mutex_);
+    RTC_DCHECK(queues_.empty()) << "Task queues must be deleted first.";
+    stopping_ = true;
+  }
+  work_available_.Set();
+  // Joins the threads.
+  threads_.clear();
+}
+
+std::unique_ptr<TaskQueueBase, TaskQueueDeleter>
+DecodeThreadPool::CreateTaskQueue() {
+  MutexLock lock(&mutex_);
+  int64_t id = next_queue_id_++;
+  auto* queue = new PooledTaskQueue(this, id);
+  queues_[id] = queue;
+  return std::unique_ptr<TaskQueueBase, TaskQueueDeleter>(queue);
+}
+
+void DecodeThreadPool::PostTaskWithDeadline(
+    TaskQueueBase* queue,
+    Timestamp deadline,
+    absl::AnyInvocable<void() &&> task) {
+  PostTask(static_cast<PooledTaskQueue*>(queue), deadline, std::move(task));
+}
+
+void DecodeThreadPool::PostTask(PooledTaskQueue* queue,
+                                Timestamp deadline,
+                                absl::AnyInvocable<void() &&> task) {
+  RTC_DCHECK_EQ(queue->pool_, this);
+  {
+    MutexLock lock(&mutex_);
+    if (queue->deleted_) {
+      return;
+    }
+    EnqueueTaskLocked(queue, deadline, std::move(task));
+  }
+  work_available_.Set();
+}
+
+void DecodeThreadPool::PostTaskIfAlive(int64_t queue_id,
+                                       absl::AnyInvocable<void() &&> task) {
+  {
+    MutexLock lock(&mutex_);
+    auto it = queues_.find(queue_id);
+    if (it == queues_.end()) {
+      return;
+    }
+    EnqueueTaskLocked(it->second, Timestamp::MinusInfinity(), std::move(task));
+  }
+  work_available_.Set();
+}
+
+void DecodeThreadPool::EnqueueTaskLocked(PooledTaskQueue* queue,
+                                         Timestamp deadline,
+                                         absl::AnyInvocable<void() &&> task) {
+  queue->tasks_.push_back({.deadline = deadline, .run = std::move(task)});
+  if (!queue->scheduled_) {
+    queue->scheduled_ = true;
+    AddReadyQueueLocked(queue);
+  }
+}
+
+void DecodeThreadPool::AddReadyQueueLocked(PooledTaskQueue* queue) {
+  RTC_DCHECK(!queue->tasks_.empty());
+  queue->ready_key_ = {.deadline = queue->tasks_.front().deadline,
+                       .order = next_ready_order_++};
+  ready_queues_.emplace(queue->ready_key_, queue);
+}
+
+void DecodeThreadPool::DeleteQueue(PooledTaskQueue* queue) {
+  std::deque<PooledTaskQueue::Task> dropped_tasks;
+  bool wait_for_running_task;
+  {
+    MutexLock lock(&mutex_);
+    queue->deleted_ = true;
+    queues_.erase(queue->id());
+    dropped_tasks.swap(queue->tasks_);
+    if (queue->scheduled_ && !queue->running_) {
+      ready_queues_.erase(queue->ready_key_);
+    }
+    wait_for_running_task = queue->running_;
+  }
+  if (wait_for_running_task) {
+    queue->stopped_.Wait(rtc::Event::kForever);
+  }
+  // Destroy the tasks that didn't run outside of the lock, since destroying
+  // them may post tasks.
+  dropped_tasks.clear();
+  delete queue;
+}
+
+void DecodeThreadPool::RunWorker() {
+  while (true) {
+    PooledTaskQueue* queue = nullptr;
+    absl::AnyInvocable<void() &&> task;
+    bool more_ready_queues = false;
+    {
+      MutexLock lock(&mutex_);
+      if (stopping_) {
+        break;
+      }
+      if (!ready_queues_.empty()) {
+        queue = ready_queues_.begin()->second;
+        ready_queues_.erase(ready_queues_.begin());
+        task = std::move(queue->tasks_.front().run);
+        queue->tasks_.pop_front();
+        queue->running_ = true;
+        more_ready_queues = !ready_queues_.empty();
+      }
+    }
+    if (!queue) {
+      work_available_.Wait(rtc::Event::kForever);
+      continue;
+    }
+    // Wake another worker for the remaining queues, since `work_available_`
+    // wakes a single waiter per signal.
+    if (more_ready_queues) {
+      work_available_.Set();
+    }
+
+    queue->RunTask(std::move(task));
+
+    MutexLock lock(&mutex_);
+    queue->running_ = false;
+    if (queue->deleted_) {
+      queue->stopped_.Set();
+    } else if (queue->tasks_.empty()) {
+      queue->scheduled_ = false;
+    } else {
+      // Give the other ready queues with the same deadline a turn before
+      // running the next task of this one.
+      AddReadyQueueLocked(queue);
+    }
+  }
+  // Let the next worker see that the pool is stopping.
+  work_available_.Set();
+}
+
+}  // namespace webrtc
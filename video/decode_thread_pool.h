@@ -0,0 +1,119 @@
+/*
+ *  Copyright (c) 2024 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef VIDEO_DECODE_THREAD_POOL_H_
+#define VIDEO_DECODE_THREAD_POOL_H_
+
+#include <stdint.h>
+
+#include <map>
+#include <memory>
+#include <tuple>
+#include <vector>
+
+#include "absl/functional/any_invocable.h"
+#include "api/task_queue/task_queue_base.h"
+#include "api/task_queue/task_queue_factory.h"
+#include "api/units/timestamp.h"
+#include "rtc_base/event.h"
+#include "rtc_base/platform_thread.h"
+#include "rtc_base/synchronization/mutex.h"
+#include "rtc_base/thread_annotations.h"
+
+namespace webrtc {
+
+// Runs the decode queues of many video receive streams on a bounded number of
+// threads, instead of one thread per stream.
+//
+// `CreateTaskQueue()` returns a task queue that is a drop-in replacement for a
+// dedicated decode queue: its tasks run one at a time, in the order they were
+// posted, and `TaskQueueBase::Current()` returns the queue while they run.
+// Different queues run in parallel on the worker threads of the pool. A worker
+// runs one task of a queue and then moves on to the next queue that has tasks,
+// so that a stream with a backlog can't hold up the others.
+//
+// Decode tasks can be posted with `PostTaskWithDeadline()`, giving the render
+// time of the frame they decode. Of the queues that are ready, the workers
+// first run the one whose next task has the earliest deadline, so that the
+// streams that are closest to missing their render time are decoded first.
+// Tasks posted without a deadline, which are few and short, go before all
+// decode tasks. Queues with the same deadline take turns.
+//
+// Delayed tasks are timed on a separate task queue and then posted to their
+// queue.
+//
+// The pool may be shared by several calls. It must outlive the task queues
+// created from it.
+class DecodeThreadPool {
+ public:
+  DecodeThreadPool(TaskQueueFactory* task_queue_factory, int num_threads);
+  ~DecodeThreadPool();
+
+  DecodeThreadPool(const DecodeThreadPool&) = delete;
+  DecodeThreadPool& operator=(const DecodeThreadPool&) = delete;
+
+  std::unique_ptr<TaskQueueBase, TaskQueueDeleter> CreateTaskQueue();
+
+  // Posts `task` to `queue`, which must have been created by this pool, to be
+  // run by `deadline`.
+  void PostTaskWithDeadline(TaskQueueBase* queue,
+                            Timestamp deadline,
+                            absl::AnyInvocable<void() &&> task);
+
+  int num_threads() const { return static_cast<int>(threads_.size()); }
+
+ private:
+  class PooledTaskQueue;
+
+  // Orders the ready queues by the deadline of their next task, and then by
+  // the order in which they became ready.
+  struct ReadyKey {
+    Timestamp deadline = Timestamp::MinusInfinity();
+    int64_t order = 0;
+
+    bool operator<(const ReadyKey& other) const {
+      return std::tie(deadline, order) < std::tie(other.deadline, other.order);
+    }
+  };
+
+  void PostTask(PooledTaskQueue* queue,
+                Timestamp deadline,
+                absl::AnyInvocable<void() &&> task);
+  // Posts `task` to the queue with `queue_id` unless the queue has been
+  // deleted.
+  void PostTaskIfAlive(int64_t queue_id, absl::AnyInvocable<void() &&> task);
+  void DeleteQueue(PooledTaskQueue* queue);
+  void EnqueueTaskLocked(PooledTaskQueue* queue,
+                         Timestamp deadline,
+                         absl::AnyInvocable<void() &&> task)
+      RTC_EXCLUSIVE_LOCKS_REQUIRED(mutex_);
+  // Adds `queue`, which must have tasks, to `ready_queues_`.
+  void AddReadyQueueLocked(PooledTaskQueue* queue)
+      RTC_EXCLUSIVE_LOCKS_REQUIRED(mutex_);
+  void RunWorker();
+
+  Mutex mutex_;
+  // Signaled when a queue becomes ready to run, or when the pool is stopping.
+  rtc::Event work_available_;
+  bool stopping_ RTC_GUARDED_BY(mutex_) = false;
+  int64_t next_queue_id_ RTC_GUARDED_BY(mutex_) = 0;
+  int64_t next_ready_order_ RTC_GUARDED_BY(mutex_) = 0;
+  // Queues that have tasks and aren't running.
+  std::map<ReadyKey, PooledTaskQueue*> ready_queues_ RTC_GUARDED_BY(mutex_);
+  // All queues that haven't been deleted, by id.
+  std::map<int64_t, PooledTaskQueue*> queues_ RTC_GUARDED_BY(mutex_);
+
+  std::vector<rtc::PlatformThread> threads_;
+  std::unique_ptr<TaskQueueBase, TaskQueueDeleter> timer_queue_;
+};
+
+}  // namespace webrtc
+
+#endif  // VIDEO_DECODE_THREAD_POOL_H_
@@ -0,0 +1,234 @@
+/*
+ *  Copyright (c) 2024 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "video/decode_thread_pool.h"
+
+#include <atomic>
+#include <memory>
+#include <vector>
+
+#include "api/task_queue/default_task_queue_factory.h"
+#include "api/units/time_delta.h"
+#include "api/units/timestamp.h"
+#include "rtc_base/event.h"
+#include "rtc_base/synchronization/mutex.h"
+#include "test/gmock.h"
+#include "test/gtest.h"
+
+namespace webrtc {
+namespace {
+
+using ::testing::ElementsAre;
+
+constexpr TimeDelta kTimeout = TimeDelta::Seconds(5);
+
+class DecodeThreadPoolTest : public ::testing::Test {
+ protected:
+  DecodeThreadPoolTest()
+      : task_queue_factory_(CreateDefaultTaskQueueFactory()) {}
+
+  std::unique_ptr<TaskQueueFactory> task_queue_factory_;
+};
+
+TEST_F(DecodeThreadPoolTest, RunsTasksOfAQueueInOrderOnTheQueue) {
+  DecodeThreadPool pool(task_queue_factory_.get(), /*num_threads=*/4);
+  auto queue = pool.CreateTaskQueue();
+  std::vector<int> order;
+  bool all_current = true;
+  rtc::Event done;
+  for (int i = 0; i < 100; ++i) {
+    queue->PostTask([&, i] {
+      all_current &= queue->IsCurrent();
+      order.push_back(i);
+      if (i == 99) {
+        done.Set();
+      }
+    });
+  }
+  ASSERT_TRUE(done.Wait(kTimeout));
+  ASSERT_EQ(order.size(), 100u);
+  for (int i = 0; i < 100; ++i) {
+    EXPECT_EQ(order[i], i);
+  }
+  EXPECT_TRUE(all_current);
+}
+
+TEST_F(DecodeThreadPoolTest, DoesNotRunTasksOfAQueueConcurrently) {
+  DecodeThreadPool pool(task_queue_factory_.get(), /*num_threads=*/4);
+  auto queue = pool.CreateTaskQueue();
+  std::atomic<int> running(0);
+  std::atomic<int> max_running(0);
+  rtc::Event done;
+  for (int i = 0; i < 200; ++i) {
+    queue->PostTask([&, i] {
+      int now_running = ++running;
+      int max = max_running.load();
+      while (now_running > max &&
+             !max_running.compare_exchange_weak(max, now_running)) {
+      }
+      --running;
+      if (i == 199) {
+        done.Set();
+      }
+    });
+  }
+  ASSERT_TRUE(done.Wait(kTimeout));
+  EXPECT_EQ(max_running.load(), 1);
+}
+
+TEST_F(DecodeThreadPoolTest, RunsQueuesInParallel) {
+  DecodeThreadPool pool(task_queue_factory_.get(), /*num_threads=*/2);
+  auto first = pool.CreateTaskQueue();
+  auto second = pool.CreateTaskQueue();
+  rtc::Event first_started;
+  rtc::Event second_ran;
+  rtc::Event done;
+  first->PostTask([&] {
+    first_started.Set();
+    // Only returns if `second` runs on another thread meanwhile.
+    if (second_ran.Wait(kTimeout)) {
+      done.Set();
+    }
+  });
+  ASSERT_TRUE(first_started.Wait(kTimeout));
+  second->PostTask([&] { second_ran.Set(); });
+  EXPECT_TRUE(done.Wait(kTimeout));
+}
+
+TEST_F(DecodeThreadPoolTest, QueueWithBacklogDoesNotHoldUpOtherQueues) {
+  DecodeThreadPool pool(task_queue_factory_.get(), /*num_threads=*/1);
+  auto busy = pool.CreateTaskQueue();
+  auto other = pool.CreateTaskQueue();
+  Mutex mutex;
+  std::vector<int> order;
+  auto record = [&](int value) {
+    MutexLock lock(&mutex);
+    order.push_back(value);
+  };
+  rtc::Event posted;
+  rtc::Event done;
+  busy->PostTask([&] {
+    posted.Wait(kTimeout);
+    record(1);
+  });
+  busy->PostTask([&] { record(2); });
+  busy->PostTask([&] {
+    record(3);
+    done.Set();
+  });
+  other->PostTask([&] { record(10); });
+  posted.Set();
+  ASSERT_TRUE(done.Wait(kTimeout));
+
+  MutexLock lock(&mutex);
+  EXPECT_THAT(order, ElementsAre(1, 10, 2, 3));
+}
+
+TEST_F(DecodeThreadPoolTest, RunsQueueWithEarliestDeadlineFirst) {
+  DecodeThreadPool pool(task_queue_factory_.get(), /*num_threads=*/1);
+  auto blocking = pool.CreateTaskQueue();
+  auto late = pool.CreateTaskQueue();
+  auto early = pool.CreateTaskQueue();
+  auto control = pool.CreateTaskQueue();
+  Mutex mutex;
+  std::vector<int> order;
+  auto record = [&](int value) {
+    MutexLock lock(&mutex);
+    order.push_back(value);
+  };
+  rtc::Event posted;
+  rtc::Event done;
+  blocking->PostTask([&] { posted.Wait(kTimeout); });
+  pool.PostTaskWithDeadline(late.get(), Timestamp::Millis(200), [&] {
+    record(2);
+    done.Set();
+  });
+  pool.PostTaskWithDeadline(early.get(), Timestamp::Millis(100),
+                            [&] { record(1); });
+  control->PostTask([&] { record(0); });
+  posted.Set();
+  ASSERT_TRUE(done.Wait(kTimeout));
+
+  MutexLock lock(&mutex);
+  EXPECT_THAT(order, ElementsAre(0, 1, 2));
+}
+
+TEST_F(DecodeThreadPoolTest, QueuesWithTheSameDeadlineTakeTurns) {
+  DecodeThreadPool pool(task_queue_factory_.get(), /*num_threads=*/1);
+  auto blocking = pool.CreateTaskQueue();
+  auto first = pool.CreateTaskQueue();
+  auto second = pool.CreateTaskQueue();
+  Mutex mutex;
+  std::vector<int> order;
+  auto record = [&](int value) {
+    MutexLock lock(&mutex);
+    order.push_back(value);
+  };
+  constexpr Timestamp kDeadline = Timestamp::Millis(100);
+  rtc::Event posted;
+  rtc::Event done;
+  blocking->PostTask([&] { posted.Wait(kTimeout); });
+  pool.PostTaskWithDeadline(first.get(), kDeadline, [&] { record(1); });
+  pool.PostTaskWithDeadline(first.get(), kDeadline, [&] { record(2); });
+  pool.PostTaskWithDeadline(second.get(), kDeadline, [&] { record(10); });
+  pool.PostTaskWithDeadline(second.get(), kDeadline, [&] {
+    record(20);
+    done.Set();
+  });
+  posted.Set();
+  ASSERT_TRUE(done.Wait(kTimeout));
+
+  MutexLock lock(&mutex);
+  EXPECT_THAT(order, ElementsAre(1, 10, 2, 20));
+}
+
+TEST_F(DecodeThreadPoolTest, RunsDelayedTasksOnTheQueue) {
+  DecodeThreadPool pool(task_queue_factory_.get(), /*num_threads=*/2);
+  auto queue = pool.CreateTaskQueue();
+  bool is_current = false;
+  rtc::Event done;
+  queue->PostDelayedTask(
+      [&] {
+        is_current = queue->IsCurrent();
+        done.Set();
+      },
+      TimeDelta::Millis(10));
+  ASSERT_TRUE(done.Wait(kTimeout));
+  EXPECT_TRUE(is_current);
+}
+
+TEST_F(DecodeThreadPoolTest, DeleteWaitsForRunningTaskAndDropsPendingTasks) {
+  DecodeThreadPool pool(task_queue_factory_.get(), /*num_threads=*/2);
+  auto queue = pool.CreateTaskQueue();
+  rtc::Event started;
+  rtc::Event release;
+  std::atomic<bool> finished(false);
+  std::atomic<bool> pending_ran(false);
+  queue->PostTask([&] {
+    started.Set();
+    release.Wait(kTimeout);
+    finished = true;
+  });
+  queue->PostTask([&] { pending_ran = true; });
+  queue->PostDelayedTask([&] { pending_ran = true; }, TimeDelta::Millis(1));
+  ASSERT_TRUE(started.Wait(kTimeout));
+
+  auto releaser = pool.CreateTaskQueue();
+  releaser->PostDelayedTask([&] { release.Set(); }, TimeDelta::Millis(20));
+  queue = nullptr;
+  EXPECT_TRUE(finished);
+
+  // Give the delayed task time to fire.
+  rtc::Event().Wait(TimeDelta::Millis(20));
+  EXPECT_FALSE(pending_ran);
+}
+
+}  // namespace
+}  // namespace webrtc
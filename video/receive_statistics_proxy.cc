@@ -807,6 +807,12 @@ void ReceiveStatisticsProxy::OnPreDecode(VideoCodecType codec_type, int qp) {
   }
 }
 
+void ReceiveStatisticsProxy::OnDecodeQueueDelay(TimeDelta queue_delay) {
+  RTC_DCHECK_RUN_ON(&main_thread_);
+  stats_.total_decode_queue_delay += queue_delay;
+  ++stats_.frames_queued_for_decode;
+}
+
 void ReceiveStatisticsProxy::OnStreamInactive() {
   RTC_DCHECK_RUN_ON(&main_thread_);
 
@@ -81,6 +81,10 @@ class ReceiveStatisticsProxy : public VideoStreamBufferControllerStatsObserver,
 
   void OnPreDecode(VideoCodecType codec_type, int qp);
 
+  // Called with the time a frame waited on the decode queue before decoding
+  // started.
+  void OnDecodeQueueDelay(TimeDelta queue_delay);
+
   void OnUniqueFramesCounted(int num_unique_frames);
 
   // Indicates video stream has been paused (no incoming packets).
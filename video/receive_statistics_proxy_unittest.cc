@@ -324,6 +324,15 @@ TEST_F(ReceiveStatisticsProxyTest, OnDecodedFrameIncreasesTotalDecodeTime) {
   EXPECT_EQ(11u, FlushAndGetStats().total_decode_time.ms());
 }
 
+TEST_F(ReceiveStatisticsProxyTest, OnDecodeQueueDelayIncreasesTotalDelay) {
+  EXPECT_EQ(0u, statistics_proxy_->GetStats().frames_queued_for_decode);
+  statistics_proxy_->OnDecodeQueueDelay(TimeDelta::Millis(3));
+  statistics_proxy_->OnDecodeQueueDelay(TimeDelta::Millis(5));
+  VideoReceiveStreamInterface::Stats stats = FlushAndGetStats();
+  EXPECT_EQ(TimeDelta::Millis(8), stats.total_decode_queue_delay);
+  EXPECT_EQ(2u, stats.frames_queued_for_decode);
+}
+
 TEST_F(ReceiveStatisticsProxyTest, ReportsContentType) {
   const std::string kRealtimeString("realtime");
   const std::string kScreenshareString("screen");
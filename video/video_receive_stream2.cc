@@ -185,7 +185,8 @@ VideoReceiveStream2::VideoReceiveStream2(
     CallStats* call_stats,
     std::unique_ptr<VCMTiming> timing,
     NackPeriodicProcessor* nack_periodic_processor,
-    DecodeSynchronizer* decode_sync)
+    DecodeSynchronizer* decode_sync,
+    DecodeThreadPool* decode_thread_pool)
     : env_(env),
       packet_sequence_checker_(SequenceChecker::kDetached),
       decode_sequence_checker_(SequenceChecker::kDetached),
@@ -221,9 +222,12 @@ VideoReceiveStream2::VideoReceiveStream2(
       max_wait_for_frame_(DetermineMaxWaitForFrame(
           TimeDelta::Millis(config_.rtp.nack.rtp_history_ms),
           false)),
-      decode_queue_(env_.task_queue_factory().CreateTaskQueue(
-          "DecodingQueue",
-          TaskQueueFactory::Priority::HIGH)) {
+      decode_thread_pool_(decode_thread_pool),
+      decode_queue_(decode_thread_pool
+                        ? decode_thread_pool->CreateTaskQueue()
+                        : env_.task_queue_factory().CreateTaskQueue(
+                              "DecodingQueue",
+                              TaskQueueFactory::Priority::HIGH)) {
   RTC_LOG(LS_INFO) << "VideoReceiveStream2: " << config_.ToString();
 
   RTC_DCHECK(call_->worker_thread());
@@ -777,21 +781,24 @@ void VideoReceiveStream2::OnEncodedFrame(std::unique_ptr<EncodedFrame> frame) {
   }
   stats_proxy_.OnPreDecode(frame->CodecSpecific()->codecType, qp);
 
-  decode_queue_->PostTask([this, now, keyframe_request_is_due,
-                           received_frame_is_keyframe, frame = std::move(frame),
-                           keyframe_required = keyframe_required_]() mutable {
+  absl::optional<Timestamp> render_time = frame->RenderTimestamp();
+  auto decode_task = [this, now, keyframe_request_is_due,
+                      received_frame_is_keyframe, frame = std::move(frame),
+                      keyframe_required = keyframe_required_]() mutable {
     RTC_DCHECK_RUN_ON(&decode_sequence_checker_);
     if (decoder_stopped_)
       return;
+    TimeDelta queue_delay = env_.clock().CurrentTime() - now;
     DecodeFrameResult result = HandleEncodedFrameOnDecodeQueue(
         std::move(frame), keyframe_request_is_due, keyframe_required);
 
     // TODO(bugs.webrtc.org/11993): Make this PostTask to the network thread.
     call_->worker_thread()->PostTask(
         SafeTask(task_safety_.flag(),
-                 [this, now, result = std::move(result),
+                 [this, now, queue_delay, result = std::move(result),
                   received_frame_is_keyframe, keyframe_request_is_due]() {
                    RTC_DCHECK_RUN_ON(&packet_sequence_checker_);
+                   stats_proxy_.OnDecodeQueueDelay(queue_delay);
                    keyframe_required_ = result.keyframe_required;
 
                    if (result.decoded_frame_picture_id) {
@@ -804,7 +811,16 @@ void VideoReceiveStream2::OnEncodedFrame(std::unique_ptr<EncodedFrame> frame) {
                                             keyframe_request_is_due);
                    buffer_->StartNextDecode(keyframe_required_);
                  }));
-  });
+  };
+  // With a shared decode thread pool, decode the frames of the streams that
+  // are closest to their render time first. A frame without a render time is
+  // due now; posting it without a deadline would put it ahead of all decodes.
+  if (decode_thread_pool_) {
+    decode_thread_pool_->PostTaskWithDeadline(
+        decode_queue_.get(), render_time.value_or(now), std::move(decode_task));
+  } else {
+    decode_queue_->PostTask(std::move(decode_task));
+  }
 }
 
 void VideoReceiveStream2::OnDecodableFrameTimeout(TimeDelta wait) {
@@ -33,6 +33,7 @@
 #include "modules/video_coding/video_receiver2.h"
 #include "rtc_base/system/no_unique_address.h"
 #include "rtc_base/thread_annotations.h"
+#include "video/decode_thread_pool.h"
 #include "video/receive_statistics_proxy.h"
 #include "video/rtp_streams_synchronizer2.h"
 #include "video/rtp_video_stream_receiver2.h"
@@ -101,7 +102,8 @@ class VideoReceiveStream2
                       CallStats* call_stats,
                       std::unique_ptr<VCMTiming> timing,
                       NackPeriodicProcessor* nack_periodic_processor,
-                      DecodeSynchronizer* decode_sync);
+                      DecodeSynchronizer* decode_sync,
+                      DecodeThreadPool* decode_thread_pool);
   // Destruction happens on the worker thread. Prior to destruction the caller
   // must ensure that a registration with the transport has been cleared. See
   // `RegisterWithTransport` for details.
@@ -345,6 +347,9 @@ class VideoReceiveStream2
   // Used to signal destruction to potentially pending tasks.
   ScopedTaskSafety task_safety_;
 
+  // Pool that runs `decode_queue_`, if any.
+  DecodeThreadPool* const decode_thread_pool_;
+
   // Defined last so they are destroyed before all other members, in particular
   // `decode_queue_` should be stopped before `decode_sequence_checker_` is
   // destructed to avoid races when running tasks on the `decode_queue_` during
@@ -44,6 +44,7 @@
 #include "modules/pacing/packet_router.h"
 #include "modules/rtp_rtcp/source/rtp_packet_to_send.h"
 #include "modules/video_coding/encoded_frame.h"
+#include "rtc_base/event.h"
 #include "rtc_base/logging.h"
 #include "system_wrappers/include/clock.h"
 #include "test/fake_decoder.h"
@@ -55,6 +56,7 @@
 #include "test/time_controller/simulated_time_controller.h"
 #include "test/video_decoder_proxy_factory.h"
 #include "video/call_stats2.h"
+#include "video/decode_thread_pool.h"
 
 namespace webrtc {
 
@@ -264,7 +266,8 @@ class VideoReceiveStream2Test : public ::testing::TestWithParam<bool> {
             env_, &fake_call_, kDefaultNumCpuCores, &packet_router_,
             config_.Copy(), &call_stats_, absl::WrapUnique(timing_),
             &nack_periodic_processor_,
-            UseMetronome() ? &decode_sync_ : nullptr);
+            UseMetronome() ? &decode_sync_ : nullptr,
+            decode_thread_pool_.get());
     video_receive_stream_->RegisterWithTransport(
         &rtp_stream_receiver_controller_);
     if (state)
@@ -285,6 +288,8 @@ class VideoReceiveStream2Test : public ::testing::TestWithParam<bool> {
   test::RtcpPacketParser rtcp_packet_parser_;
   PacketRouter packet_router_;
   RtpStreamReceiverController rtp_stream_receiver_controller_;
+  // Set before `RecreateReceiveStream()` to decode on a shared pool.
+  std::unique_ptr<DecodeThreadPool> decode_thread_pool_;
   std::unique_ptr<webrtc::internal::VideoReceiveStream2> video_receive_stream_;
   VCMTiming* timing_;
   test::FakeMetronome fake_metronome_;
@@ -527,6 +532,84 @@ TEST_P(VideoReceiveStream2Test, PassesPacketInfos) {
               RenderedFrameWith(PacketInfos(ElementsAreArray(packet_infos))));
 }
 
+TEST_P(VideoReceiveStream2Test, ReportsFramesQueuedForDecode) {
+  video_receive_stream_->Start();
+  video_receive_stream_->OnCompleteFrame(test::FakeFrameBuilder()
+                                             .Id(0)
+                                             .PayloadType(99)
+                                             .Time(kFirstRtpTimestamp)
+                                             .ReceivedTime(kStartTime)
+                                             .AsLast()
+                                             .Build());
+  EXPECT_THAT(fake_renderer_.WaitForFrame(TimeDelta::Zero()), RenderedFrame());
+  EXPECT_EQ(video_receive_stream_->GetStats().frames_queued_for_decode, 1u);
+
+  auto delta_frame = test::FakeFrameBuilder()
+                         .Id(1)
+                         .PayloadType(99)
+                         .Time(RtpTimestampForFrame(1))
+                         .ReceivedTime(ReceiveTimeForFrame(1))
+                         .Refs({0})
+                         .AsLast()
+                         .Build();
+  time_controller_.AdvanceTime(k30FpsDelay);
+  video_receive_stream_->OnCompleteFrame(std::move(delta_frame));
+  EXPECT_THAT(fake_renderer_.WaitForFrame(k30FpsDelay), RenderedFrame());
+  VideoReceiveStreamInterface::Stats stats = video_receive_stream_->GetStats();
+  EXPECT_EQ(stats.frames_queued_for_decode, 2u);
+  // The decode queue runs in simulated time, so the frames don't wait in it.
+  EXPECT_EQ(stats.total_decode_queue_delay, TimeDelta::Zero());
+
+  video_receive_stream_->Stop();
+}
+
+TEST_P(VideoReceiveStream2Test, ReportsDecodeQueueDelayWithDecodeThreadPool) {
+  constexpr TimeDelta kPoolBusyTime = TimeDelta::Millis(20);
+  decode_thread_pool_ = std::make_unique<DecodeThreadPool>(
+      &env_.task_queue_factory(), /*num_threads=*/1);
+  RecreateReceiveStream();
+
+  // Keep the only thread of the pool busy, so that the decode task waits in
+  // its queue while the clock advances.
+  std::unique_ptr<TaskQueueBase, TaskQueueDeleter> busy_queue =
+      decode_thread_pool_->CreateTaskQueue();
+  rtc::Event pool_busy;
+  rtc::Event release_pool;
+  busy_queue->PostTask([&] {
+    pool_busy.Set();
+    release_pool.Wait(rtc::Event::kForever);
+  });
+  ASSERT_TRUE(pool_busy.Wait(kDefaultTimeOut));
+
+  video_receive_stream_->Start();
+  video_receive_stream_->OnCompleteFrame(test::FakeFrameBuilder()
+                                             .Id(0)
+                                             .PayloadType(99)
+                                             .Time(kFirstRtpTimestamp)
+                                             .ReceivedTime(kStartTime)
+                                             .AsLast()
+                                             .Build());
+  time_controller_.AdvanceTime(kPoolBusyTime);
+  EXPECT_EQ(video_receive_stream_->GetStats().frames_queued_for_decode, 0u);
+
+  // With one thread, a task that is due last runs after the decode task.
+  rtc::Event decode_done;
+  decode_thread_pool_->PostTaskWithDeadline(
+      busy_queue.get(), Timestamp::PlusInfinity(), [&] { decode_done.Set(); });
+  release_pool.Set();
+  ASSERT_TRUE(decode_done.Wait(kDefaultTimeOut));
+  // Run the stats update that the decode task posted to the worker thread.
+  time_controller_.AdvanceTime(TimeDelta::Zero());
+
+  EXPECT_THAT(fake_renderer_.WaitForFrame(TimeDelta::Zero()), RenderedFrame());
+  VideoReceiveStreamInterface::Stats stats = video_receive_stream_->GetStats();
+  EXPECT_EQ(stats.frames_queued_for_decode, 1u);
+  EXPECT_GT(stats.total_decode_queue_delay, TimeDelta::Zero());
+  EXPECT_LE(stats.total_decode_queue_delay, kPoolBusyTime);
+
+  video_receive_stream_->Stop();
+}
+
 TEST_P(VideoReceiveStream2Test, RenderedFrameUpdatesGetSources) {
   constexpr uint32_t kSsrc = 1111;
   constexpr uint32_t kCsrc = 9001;